@@ -0,0 +1,135 @@
+/**
+ * @file ClockSync.h
+ * @brief Synchronisation of the autopilot clock with the host monotonic clock.
+ *
+ * @details This file contains the declaration of ClockSync- object which estimates offset and drift
+ *          between the autopilot boot clock and the host steady clock from MAVLink TIMESYNC
+ *          round trips (SYSTEM_TIME as a coarse fallback) and maps autopilot timestamps to host time.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+
+/**
+ * @class ClockSync
+ * @brief Class tracking offset (autopilot - host) and drift of the autopilot clock.
+ *		  Every TIMESYNC round trip gives an offset measurement taken at the midpoint of the round
+ *		  trip. Measurements with a round trip much longer than the shortest recent one are dropped,
+ *		  since radio queuing makes them asymmetric. Accepted ones feed an alpha-beta filter: offset
+ *		  follows the residual with ALPHA and drift with BETA. The first CONVERGENCE_SAMPLES_NUM
+ *		  samples only lock the offset with CONVERGENCE_ALPHA. Until the first TIMESYNC reply arrives,
+ *		  SYSTEM_TIME gives coarse measurements biased by one-way link latency.
+ *		  Not thread-safe- used only by the parse/publish stage of the receiver.
+ */
+class ClockSync {
+public:
+
+  static constexpr auto REQUEST_PERIOD = std::chrono::milliseconds(500);
+  static constexpr std::int64_t MAX_RTT_NS = 1'000'000'000;
+  static constexpr double RTT_ACCEPT_FACTOR = 1.5;             // of the shortest RTT in the window
+  static constexpr std::size_t RTT_WINDOW_NUM = 16;
+  static constexpr std::size_t CONVERGENCE_SAMPLES_NUM = 8;    // samples locking the offset before drift is tracked
+  static constexpr double ALPHA = 0.05;
+  static constexpr double BETA = 0.0005;
+  static constexpr double CONVERGENCE_ALPHA = 0.5;
+  static constexpr std::int64_t RESET_RESIDUAL_NS = 500'000'000; // autopilot rebooted or clock jumped
+
+  /**
+   * @brief Get the host monotonic time.
+   * @return Nanoseconds of the steady clock.
+   */
+  static std::int64_t nowNs();
+
+  /**
+   * @brief Account a TIMESYNC message.
+   * @param tc1: autopilot time in nanoseconds (0 for a request of the autopilot).
+   * @param ts1: host time of our request echoed by the autopilot.
+   * @param arrivalNs: host time the reply has been received.
+   * @return True, if the measurement has been accepted.
+   */
+  bool onTimesync(std::int64_t tc1, std::int64_t ts1, std::int64_t arrivalNs);
+
+  /**
+   * @brief Account a SYSTEM_TIME message, used only until the first TIMESYNC reply is accepted.
+   * @param timeBootMs: autopilot boot time in milliseconds.
+   * @param arrivalNs: host time the message has been received.
+   */
+  void onSystemTime(std::uint32_t timeBootMs, std::int64_t arrivalNs);
+
+  /**
+   * @brief Map autopilot boot time to host time.
+   * @param bootNs: autopilot boot time in nanoseconds.
+   * @return Host steady clock time in nanoseconds.
+   */
+  std::int64_t toHostNs(std::int64_t bootNs) const;
+
+  /**
+   * @brief True, if at least one measurement has been accepted.
+   */
+  bool isSynced() const;
+
+  /**
+   * @brief True, if the estimate comes from TIMESYNC round trips, not SYSTEM_TIME.
+   */
+  bool isPrecise() const;
+
+  /**
+   * @brief Get the offset (autopilot - host) at the last measurement.
+   */
+  std::int64_t getOffsetNs() const;
+
+  /**
+   * @brief Get the drift of the autopilot clock in parts per million.
+   */
+  double getDriftPpm() const;
+
+  /**
+   * @brief Get the round trip time of the last accepted measurement.
+   */
+  std::int64_t getRttNs() const;
+
+private:
+
+  /**
+   * @brief Feed the filter with an offset measurement.
+   * @param offsetNs: measured offset (autopilot - host).
+   * @param hostNs: host time of the measurement.
+   */
+  void update_(std::int64_t offsetNs, std::int64_t hostNs);
+
+  /**
+   * @brief Forget the estimate, e.g. after the autopilot rebooted.
+   */
+  void reset_();
+
+  /****************************************************
+  * Estimate
+  *****************************************************/
+  double m_offsetNs{0.0};   // at m_lastUpdateNs
+  double m_drift{0.0};      // ns of offset change per ns of host time
+  std::int64_t m_lastUpdateNs{0};
+  std::size_t m_samplesNum{0};
+  bool m_isPrecise{false};
+
+  /****************************************************
+  * Round trips
+  *****************************************************/
+  std::array<std::int64_t, RTT_WINDOW_NUM> m_rtts{};
+  std::size_t m_rttIdx{0};
+  std::size_t m_rttsNum{0};
+  std::int64_t m_lastRttNs{0};
+};
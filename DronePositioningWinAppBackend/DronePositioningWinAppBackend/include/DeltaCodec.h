@@ -0,0 +1,159 @@
+/**
+ * @file DeltaCodec.h
+ * @brief Quantised delta encoding of telemetry sent to the visualisation platform.
+ *
+ * @details This file contains the layout of the delta telemetry packet and declarations of
+ *          DeltaEncoder and DeltaDecoder, which quantise TelemetrySample to fixed point and
+ *          encode it as varint differences against the latest keyframe of the vehicle.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+#include "TelemetrySample.h"
+
+
+namespace wire {
+
+/**
+ * @brief Layout of the delta packet, version 1. Fixed-size fields are little-endian,
+ *		  varints are LEB128 and signed values are zigzag encoded.
+ *
+ *	type    field
+ *	u16     magic (0x5144, bytes "DQ")
+ *	u8      flags (DELTA_FLAG_KEYFRAME, DELTA_FLAG_TIME_SYNCED, DELTA_FLAG_LOCAL_FRAME, DELTA_FLAG_PREDICTED)
+ *	u8      vehicle id (MAVLink system id)
+ *	u16     sequence number, low 16 bits
+ *	u8      keyframe id: per-vehicle counter of keyframes, of the keyframe the packet refers to
+ *	varint  valid fields (TelemetrySample::Field flags)
+ *	keyframe: i64 timestamp, ns | delta: zigzag varint timestamp - keyframe timestamp, us
+ *	varint  capture age at sending, us
+ *	zigzag varint x10, absolute in a keyframe, difference to the keyframe in a delta:
+ *	        roll, pitch, yaw (ANGLE_RESOLUTION_RAD), latitude, longitude (degE7),
+ *	        altitude above MSL, altitude above home (mm), velocity north, east, down (VELOCITY_RESOLUTION_MS)
+ *	        With DELTA_FLAG_LOCAL_FRAME latitude, longitude and altitude are east, north and up of LocalFrame (mm).
+ *
+ * A lost delta loses only its own sample. A lost keyframe makes deltas undecodable until the next
+ * keyframe, at most KEYFRAME_INTERVAL samples of the vehicle later. Keyframe ids of a vehicle
+ * step by one, so a delta can be matched to a stale keyframe only after 255 keyframes in a row
+ * were lost.
+ */
+inline constexpr std::uint16_t DELTA_MAGIC = 0x5144;
+inline constexpr std::uint8_t DELTA_FLAG_KEYFRAME = 1u << 0;
+inline constexpr std::uint8_t DELTA_FLAG_TIME_SYNCED = 1u << 1;
+inline constexpr std::uint8_t DELTA_FLAG_LOCAL_FRAME = 1u << 2;
+inline constexpr std::uint8_t DELTA_FLAG_PREDICTED = 1u << 3;
+inline constexpr double ANGLE_RESOLUTION_RAD = 1E-4;       // 0.0057 deg
+inline constexpr double VELOCITY_RESOLUTION_MS = 1E-2;     // 1 cm/s
+inline constexpr std::size_t KEYFRAME_INTERVAL = 25;       // samples of a vehicle, 0.5 s at 50 Hz
+inline constexpr std::size_t QUANTISED_FIELDS_NUM = 10;
+inline constexpr std::size_t MAX_DELTA_PACKET_SIZE =
+    7 + 5 + 10 + 5 + QUANTISED_FIELDS_NUM * 5;             // header, varints of at most 5 (10 for i64) bytes
+
+/**
+ * @brief Sample quantised to the fixed point of the wire.
+ */
+struct QuantisedSample {
+  std::int64_t timestampNs{0};
+  std::uint32_t validFields{0};
+  std::array<std::int32_t, QUANTISED_FIELDS_NUM> values{};
+  std::uint32_t captureAgeUs{0}; // capture age at sending, filled only by DeltaDecoder
+  std::uint8_t flags{0};         // packet flags, filled only by DeltaDecoder
+  std::uint16_t sequence{0};     // low 16 bits of the sequence number, filled only by DeltaDecoder
+};
+
+/**
+ * @brief Outcome of decoding a delta packet.
+ */
+enum class DeltaStatus {
+  DECODED,
+  MALFORMED,        // the rest of the datagram can't be read
+  KEYFRAME_MISSING  // the packet is read through but not decoded, the next one can be
+};
+
+/**
+ * @brief Result of decoding a delta packet.
+ */
+struct DeltaResult {
+  std::size_t consumedNum{0}; // bytes of the packet, 0 if it's malformed
+  DeltaStatus status{DeltaStatus::MALFORMED};
+};
+
+/**
+ * @class DeltaEncoder
+ * @brief Class keeping the latest keyframe of every vehicle and encoding samples against it.
+ *		  Not thread-safe.
+ */
+class DeltaEncoder {
+public:
+
+  /**
+   * @brief Encode the sample.
+   * @param telemetry: sample to encode.
+   * @param sequence: sequence number of the packet.
+   * @param sendTimeNs: host steady clock time of sending, used for the capture age.
+   * @param buffer: destination of at least MAX_DELTA_PACKET_SIZE bytes.
+   * @return Number of written bytes.
+   */
+  std::size_t encode(const TelemetrySample &telemetry, std::uint32_t sequence,
+                     std::int64_t sendTimeNs, std::uint8_t *buffer);
+
+  /**
+   * @brief Quantise the sample to the fixed point of the wire.
+   */
+  static QuantisedSample quantise(const TelemetrySample &telemetry);
+
+private:
+
+  struct Keyframe {
+    QuantisedSample sample;
+    std::uint8_t id{0};                           // counts keyframes of the vehicle
+    std::size_t samplesSince{KEYFRAME_INTERVAL}; // the first sample of a vehicle is a keyframe
+  };
+
+  std::array<Keyframe, 256> m_keyframes{}; // by vehicle id
+};
+
+/**
+ * @class DeltaDecoder
+ * @brief Class decoding delta packets, used by tests and benchmarks. Not thread-safe.
+ */
+class DeltaDecoder {
+public:
+
+  /**
+   * @brief Decode a packet.
+   * @param buffer: packet, possibly followed by further packets of a coalesced datagram.
+   * @param size: number of bytes available in the buffer.
+   * @param vehicleId: decoded vehicle id.
+   * @param sample: decoded quantised sample, valid only if the packet is decoded.
+   * @return Number of consumed bytes and the status. A delta whose keyframe hasn't been received
+   *		 is read through, so the next packet of a coalesced datagram can be decoded.
+   */
+  DeltaResult decode(const std::uint8_t *buffer, std::size_t size,
+                     std::uint8_t &vehicleId, QuantisedSample &sample);
+
+private:
+
+  struct Keyframe {
+    QuantisedSample sample;
+    std::uint8_t id{0};
+    bool isValid{false};
+  };
+
+  std::array<Keyframe, 256> m_keyframes{}; // by vehicle id
+};
+
+} // namespace wire
@@ -1,71 +1,148 @@
-/**
- * @file Events.h
- * @brief Possible events which can occur during application run.
- *
- * @details This file contains structures declaring apllication events.
- *
- * @author Szymon Bogus
- * @date 2024-07-06
- *
- * @copyright Copyright 2024 Szymon Bogus
- * @license Apache License, Version 2.0 (see
- * https://www.apache.org/licenses/LICENSE-2.0)
- *
- * @version 1.0
- */
-
-#pragma once
-
-#include <vector>
-#include <string>
-#include <variant>
-
-#include "base/IEvent.h"
-
-
-/**
- * @brief Event holding new telemetry.
- */
-struct TelemetryEvent : public IEvent {
-
-  /**
-   * @brief Constructor
-   * @param data: vector of telemtry.
-   */
-  TelemetryEvent(std::vector<float> data);
-  const std::vector<float> telemetry;
-};
-
-/**
- * @brief Event holding new connection status.
- */
-struct ConnectionEvent : public IEvent {
-
-  /**
-   * @brief Constructor.
-   * @param status: current connection status from a component.
-   * @param who: component name.
-   * @param message: connection status message.
-   */
-  ConnectionEvent(bool status, const std::string& who, const std::string& message);
-  const bool isConnected;
-  const std::string whichComponent;
-  const std::string connMess;
-  
-};
-
-/**
- * @brief Event holding app termination call.
- */
-struct AppTerminationEvent : public IEvent {
-
-  /**
-   * @brief Constructor.
-   * @param status: app termination flag.
-   */
-  AppTerminationEvent(bool status);
-  const bool isAppTerminating;
-};
-
-using Event =
-    std::variant<TelemetryEvent, ConnectionEvent, AppTerminationEvent>;
+/**
+ * @file Events.h
+ * @brief Possible events which can occur during application run.
+ *
+ * @details This file contains structures declaring apllication events.
+ *
+ * @author Szymon Bogus
+ * @date 2024-07-06
+ *
+ * @copyright Copyright 2024 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <variant>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+
+#include "base/IEvent.h"
+#include "TelemetrySample.h"
+
+
+/**
+ * @brief Event holding new telemetry.
+ */
+struct TelemetryEvent : public IEvent {
+
+  /**
+   * @brief Constructor
+   * @param data: aggregated telemetry sample.
+   */
+  TelemetryEvent(const TelemetrySample &data);
+  const TelemetrySample telemetry;
+};
+
+/**
+ * @enum LinkState.
+ * @brief Quality state of a telemetry link as evaluated by LinkMonitor.
+ */
+enum class LinkState {
+  UP,       // heartbeat present, loss within limits
+  DEGRADED, // heartbeat present, but loss or jitter exceeded limits
+  LOST      // no heartbeat within the watchdog timeout
+};
+
+/**
+ * @brief Aggregated statistics of a single telemetry link.
+ */
+struct LinkQuality {
+  std::size_t linkId{0};
+  LinkState state{LinkState::LOST};
+  float lossRate{0.0f};           // rolling ratio of frames missing by sequence to expected [0,1]
+  float jitterMs{0.0f};           // inter-arrival jitter of the reference stream
+  float bytesPerSecond{0.0f};
+  std::uint32_t heartbeatAgeMs{0};
+  std::uint32_t seqGaps{0};       // total frames missing according to MAVLink sequence numbers
+  std::uint32_t parseErrors{0};   // total frames dropped by the MAVLink parser
+  float relativeLatencyMs{0.0f};  // lag behind the fastest of redundant links, 0 for a single link
+};
+
+/**
+ * @brief Event holding new connection status.
+ */
+struct ConnectionEvent : public IEvent {
+
+  /**
+   * @brief Constructor.
+   * @param status: current connection status from a component.
+   * @param who: component name.
+   * @param message: connection status message.
+   */
+  ConnectionEvent(bool status, const std::string& who, const std::string& message);
+
+  /**
+   * @brief Constructor of the link quality update.
+   * @param status: current connection status from a component.
+   * @param who: component name.
+   * @param message: connection status message.
+   * @param quality: statistics of the link which changed its state.
+   */
+  ConnectionEvent(bool status, const std::string &who,
+                  const std::string &message, const LinkQuality &quality);
+  const bool isConnected;
+  const std::string whichComponent;
+  const std::string connMess;
+  const std::optional<LinkQuality> linkQuality;
+  
+};
+
+/**
+ * @enum WaypointState.
+ * @brief Progress of a vehicle through the waypoints of the exercise, see WaypointProgression.
+ */
+enum class WaypointState : std::uint8_t {
+  APPROACHING, // flying to the waypoint
+  HOVERING,    // within the accuracy radius of the waypoint, pausing time not elapsed yet
+  COMPLETED    // all waypoints captured
+};
+
+/**
+ * @brief Progress of a vehicle after a state transition.
+ */
+struct WaypointProgress {
+  std::uint8_t vehicleId{0};
+  WaypointState state{WaypointState::APPROACHING};
+  std::uint16_t waypointIdx{0};     // approached or hovered at, number of waypoints once completed
+  std::uint16_t waypointsNum{0};
+  bool isCaptured{false};           // the transition captured the previous waypoint
+  bool isBearingCompliant{false};   // heading at the capture was within tolerance of the target bearing
+  std::uint32_t timeBootMs{0};      // autopilot time of the transition
+  float distance{0.0f};             // to the waypoint, m
+};
+
+/**
+ * @brief Event holding a waypoint progress transition of a vehicle.
+ */
+struct ProgressEvent : public IEvent {
+
+  /**
+   * @brief Constructor.
+   * @param data: progress after the transition.
+   */
+  ProgressEvent(const WaypointProgress &data);
+  const WaypointProgress progress;
+};
+
+/**
+ * @brief Event holding app termination call.
+ */
+struct AppTerminationEvent : public IEvent {
+
+  /**
+   * @brief Constructor.
+   * @param status: app termination flag.
+   */
+  AppTerminationEvent(bool status);
+  const bool isAppTerminating;
+};
+
+using Event =
+    std::variant<TelemetryEvent, ConnectionEvent, AppTerminationEvent, ProgressEvent>;
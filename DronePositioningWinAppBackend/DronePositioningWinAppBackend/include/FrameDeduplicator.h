@@ -0,0 +1,88 @@
+/**
+ * @file FrameDeduplicator.h
+ * @brief Deduplication of MAVLink frames received over redundant links.
+ *
+ * @details This file contains the declaration of FrameDeduplicator- object which recognizes
+ *          copies of the same MAVLink frame arriving over several radios of the same vehicle.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+#include <common/mavlink.h>
+
+
+/**
+ * @class FrameDeduplicator
+ * @brief Class identifying frames by (sysid, compid, msgid, seq) within a sliding window of
+ *		  the latest WINDOW_SIZE distinct frames. The first copy of a frame is forwarded whichever
+ *		  link delivered it, later copies are dropped and their lag behind the first copy is reported.
+ *		  The window is shorter than the 256 frames after which MAVLink sequence numbers of
+ *		  a component repeat, so distinct frames aren't mistaken for copies.
+ */
+class FrameDeduplicator {
+public:
+
+  static constexpr std::size_t WINDOW_SIZE = 128;
+  static constexpr std::size_t MAX_LINKS_NUM = 8;
+
+  /**
+   * @brief Result of accounting a frame.
+   */
+  struct Result {
+    bool isFirst;          // true, if the frame has to be forwarded
+    std::int64_t lagNs;    // lag of this copy behind the first one, 0 for the first copy
+  };
+
+  /**
+   * @brief Account a frame received over the link.
+   * @param message: parsed frame.
+   * @param linkIdx: index of the link which delivered the frame (< MAX_LINKS_NUM).
+   * @param arrivalNs: arrival time of the frame in nanoseconds (steady clock).
+   * @return Whether the frame is the first copy and its lag behind the first copy.
+   */
+  Result onFrame(const mavlink_message_t &message, const std::size_t linkIdx,
+                 const std::int64_t arrivalNs);
+
+  /**
+   * @brief Get the number of frames for which the link delivered the first copy.
+   * @param linkIdx: index of the link.
+   */
+  std::uint64_t getFirstNum(const std::size_t linkIdx) const;
+
+  /**
+   * @brief Get the number of dropped copies.
+   */
+  std::uint64_t getDuplicatesNum() const;
+
+private:
+
+  struct Entry {
+    std::uint64_t key{0};      // 0 is never a valid key, see FrameDeduplicator::key_
+    std::int64_t arrivalNs{0}; // arrival time of the first copy
+    std::uint8_t linksMask{0}; // links which delivered a copy
+  };
+
+  /**
+   * @brief Pack frame identity into a single word.
+   */
+  static std::uint64_t key_(const mavlink_message_t &message);
+
+  std::array<Entry, WINDOW_SIZE> m_window{};
+  std::size_t m_nextIdx{0}; // oldest entry, overwritten by the next new frame
+
+  std::array<std::uint64_t, MAX_LINKS_NUM> m_firstNum{};
+  std::uint64_t m_duplicatesNum{0};
+};
@@ -0,0 +1,414 @@
+/**
+ * @file Geodesy.h
+ * @brief WGS84 constants and conversions of GPS positions of different speed and accuracy.
+ *
+ * @details This file contains header-only geodesy used around the exercise area:
+ *          - EcefFrame: exact geodetic->ECEF->ENU conversion, the textbook reference. LocalFrame
+ *            computes the same, faster, and is what the processor and the sender use.
+ *          - TangentPlane: local-tangent approximations around the operator, first order
+ *            (flat earth) and second order (with the curvature of the ellipsoid).
+ *          - Haversine distance on the mean sphere.
+ *          Batch entry points take degE7 positions as MAVLink gives them. Those of TangentPlane
+ *          and haversine process two positions per SSE2 instruction, the batch of EcefFrame is
+ *          the scalar reference loop. tests/benchGeodesy.cpp measures the time and the largest
+ *          error of every method over the exercise radius, to choose the fastest one within the
+ *          tolerance of a use.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <numbers>
+
+#include "ConfigUtilities.h"
+
+// SSE2 is the x64 baseline, so batches don't need any /arch flag
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define GEODESY_SSE2
+#endif
+
+
+namespace geodesy {
+
+/****************************************************
+* WGS84
+*****************************************************/
+constexpr double SEMI_MAJOR_AXIS = 6378137.0;                                // m
+constexpr double FLATTENING = 1.0 / 298.257223563;
+constexpr double SEMI_MINOR_AXIS = SEMI_MAJOR_AXIS * (1.0 - FLATTENING);     // m
+constexpr double ECCENTRICITY_SQ = FLATTENING * (2.0 - FLATTENING);
+constexpr double MEAN_RADIUS = (2.0 * SEMI_MAJOR_AXIS + SEMI_MINOR_AXIS) / 3.0; // IUGG R1, m
+
+constexpr double DEG_TO_RAD = std::numbers::pi / 180.0;
+constexpr double DEG_E7_TO_RAD = DEG_TO_RAD * 1E-7;
+constexpr double MAX_SERIES_ANGLE = 0.02; // rad, ~127 km of latitude, batches are exact within it
+
+struct Ecef {
+  double x;
+  double y;
+  double z;
+};
+
+struct Enu {
+  double east;
+  double north;
+  double up;
+};
+
+/**
+ * @brief Radius of curvature in the prime vertical.
+ */
+inline double primeVerticalRadius(double sinLat) {
+  return SEMI_MAJOR_AXIS / std::sqrt(1.0 - ECCENTRICITY_SQ * sinLat * sinLat);
+}
+
+/**
+ * @brief Radius of curvature in the meridian.
+ */
+inline double meridionalRadius(double sinLat) {
+  const double w2 = 1.0 - ECCENTRICITY_SQ * sinLat * sinLat;
+  return SEMI_MAJOR_AXIS * (1.0 - ECCENTRICITY_SQ) / (w2 * std::sqrt(w2));
+}
+
+/**
+ * @brief Geodetic position to ECEF.
+ * @param lat, lon: rad.
+ * @param height: above the ellipsoid, m.
+ */
+inline Ecef toEcef(double lat, double lon, double height) {
+  const double sinLat = std::sin(lat);
+  const double cosLat = std::cos(lat);
+  const double n = primeVerticalRadius(sinLat);
+  return {(n + height) * cosLat * std::cos(lon), (n + height) * cosLat * std::sin(lon),
+          (n * (1.0 - ECCENTRICITY_SQ) + height) * sinLat};
+}
+
+/**
+ * @brief Great-circle distance on the mean sphere, horizontal only.
+ * @param lat1, lon1, lat2, lon2: rad.
+ * @return Distance, m.
+ */
+inline double haversineDistance(double lat1, double lon1, double lat2, double lon2) {
+  const double sinHalfLat = std::sin(0.5 * (lat2 - lat1));
+  const double sinHalfLon = std::sin(0.5 * (lon2 - lon1));
+  const double a = sinHalfLat * sinHalfLat + std::cos(lat1) * std::cos(lat2) * sinHalfLon * sinHalfLon;
+  return 2.0 * MEAN_RADIUS * std::asin(std::sqrt(std::min(a, 1.0)));
+}
+
+namespace detail {
+
+// Taylor coefficients, the first omitted terms are below 1E-20 within MAX_SERIES_ANGLE
+constexpr double SIN_C3 = -1.0 / 6.0;
+constexpr double SIN_C5 = 1.0 / 120.0;
+constexpr double SIN_C7 = -1.0 / 5040.0;
+constexpr double COS_C2 = -1.0 / 2.0;
+constexpr double COS_C4 = 1.0 / 24.0;
+constexpr double COS_C6 = -1.0 / 720.0;
+constexpr double COS_C8 = 1.0 / 40320.0;
+constexpr double ASIN_C3 = 1.0 / 6.0;
+constexpr double ASIN_C5 = 3.0 / 40.0;
+constexpr double ASIN_C7 = 5.0 / 112.0;
+
+#ifdef GEODESY_SSE2
+inline __m128d loadInt32Pair(const std::int32_t *values) {
+  return _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(values)));
+}
+
+inline __m128d mulAdd(__m128d a, __m128d b, __m128d c) {
+  return _mm_add_pd(_mm_mul_pd(a, b), c);
+}
+
+inline __m128d sinSeries(__m128d angle) {
+  const __m128d sq = _mm_mul_pd(angle, angle);
+  __m128d poly = mulAdd(sq, _mm_set1_pd(SIN_C7), _mm_set1_pd(SIN_C5));
+  poly = mulAdd(sq, poly, _mm_set1_pd(SIN_C3));
+  return mulAdd(_mm_mul_pd(angle, sq), poly, angle);
+}
+
+inline __m128d cosSeries(__m128d angle) {
+  const __m128d sq = _mm_mul_pd(angle, angle);
+  __m128d poly = mulAdd(sq, _mm_set1_pd(COS_C8), _mm_set1_pd(COS_C6));
+  poly = mulAdd(sq, poly, _mm_set1_pd(COS_C4));
+  poly = mulAdd(sq, poly, _mm_set1_pd(COS_C2));
+  return mulAdd(sq, poly, _mm_set1_pd(1.0));
+}
+
+inline __m128d asinSeries(__m128d value) {
+  const __m128d sq = _mm_mul_pd(value, value);
+  __m128d poly = mulAdd(sq, _mm_set1_pd(ASIN_C7), _mm_set1_pd(ASIN_C5));
+  poly = mulAdd(sq, poly, _mm_set1_pd(ASIN_C3));
+  return mulAdd(_mm_mul_pd(value, sq), poly, value);
+}
+
+/**
+ * @brief Mask of lanes further than MAX_SERIES_ANGLE from the origin in either angle.
+ */
+inline int farLanes(__m128d latDiff, __m128d lonDiff) {
+  const __m128d absMask = _mm_castsi128_pd(_mm_set1_epi64x(0x7FFFFFFFFFFFFFFF));
+  const __m128d maxAngle = _mm_set1_pd(MAX_SERIES_ANGLE);
+  return _mm_movemask_pd(_mm_or_pd(_mm_cmpgt_pd(_mm_and_pd(latDiff, absMask), maxAngle),
+                                   _mm_cmpgt_pd(_mm_and_pd(lonDiff, absMask), maxAngle)));
+}
+#endif
+
+} // namespace detail
+
+/**
+ * @brief Haversine distances of a batch of positions from the origin.
+ * @param origin: GPS latitude and longitude in degrees.
+ * @param latE7, lonE7: degE7, arrays of the same length.
+ * @param distances: horizontal, m.
+ */
+inline void haversineDistances(const Point &origin, const std::int32_t *latE7, const std::int32_t *lonE7,
+                               std::size_t count, double *distances) {
+  const double originLat = origin.latitude * DEG_TO_RAD;
+  const double originLon = origin.longitude * DEG_TO_RAD;
+  std::size_t idx = 0;
+#ifdef GEODESY_SSE2
+  using namespace detail;
+  const __m128d degE7ToRad = _mm_set1_pd(DEG_E7_TO_RAD);
+  const __m128d lat0 = _mm_set1_pd(originLat);
+  const __m128d lon0 = _mm_set1_pd(originLon);
+  const __m128d sinLat0 = _mm_set1_pd(std::sin(originLat));
+  const __m128d cosLat0 = _mm_set1_pd(std::cos(originLat));
+  const __m128d half = _mm_set1_pd(0.5);
+  const __m128d diameter = _mm_set1_pd(2.0 * MEAN_RADIUS);
+  for (; idx + 2 <= count; idx += 2) {
+    const __m128d latDiff = _mm_sub_pd(_mm_mul_pd(loadInt32Pair(latE7 + idx), degE7ToRad), lat0);
+    const __m128d lonDiff = _mm_sub_pd(_mm_mul_pd(loadInt32Pair(lonE7 + idx), degE7ToRad), lon0);
+    const __m128d sinHalfLat = sinSeries(_mm_mul_pd(latDiff, half));
+    const __m128d sinHalfLon = sinSeries(_mm_mul_pd(lonDiff, half));
+    const __m128d cosLat = _mm_sub_pd(_mm_mul_pd(cosLat0, cosSeries(latDiff)),
+                                      _mm_mul_pd(sinLat0, sinSeries(latDiff)));
+    const __m128d a = mulAdd(_mm_mul_pd(cosLat0, cosLat), _mm_mul_pd(sinHalfLon, sinHalfLon),
+                             _mm_mul_pd(sinHalfLat, sinHalfLat));
+    _mm_storeu_pd(distances + idx, _mm_mul_pd(diameter, asinSeries(_mm_sqrt_pd(a))));
+
+    // Lanes too far from the origin for the series are computed again by the scalar path
+    const int lanes = farLanes(latDiff, lonDiff);
+    for (int lane = 0; lane < 2; ++lane) {
+      if ((lanes & (1 << lane)) != 0) {
+        distances[idx + lane] = haversineDistance(originLat, originLon, latE7[idx + lane] * DEG_E7_TO_RAD,
+                                                  lonE7[idx + lane] * DEG_E7_TO_RAD);
+      }
+    }
+  }
+#endif
+  for (; idx < count; ++idx) {
+    distances[idx] = haversineDistance(originLat, originLon, latE7[idx] * DEG_E7_TO_RAD,
+                                       lonE7[idx] * DEG_E7_TO_RAD);
+  }
+}
+
+/**
+ * @class EcefFrame
+ * @brief Class converting geodetic positions into ENU of the origin exactly: ECEF of the position
+ *		  minus ECEF of the origin, rotated by the ECEF->ENU rotation of the origin.
+ *		  Immutable, so thread-safe.
+ */
+class EcefFrame {
+public:
+
+  /**
+   * @brief Constructor.
+   * @param origin: GPS latitude and longitude in degrees, altitude in metres.
+   */
+  explicit EcefFrame(const Point &origin)
+      : m_origin(toEcef(origin.latitude * DEG_TO_RAD, origin.longitude * DEG_TO_RAD, origin.altitude)),
+        m_sinLat0(std::sin(origin.latitude * DEG_TO_RAD)), m_cosLat0(std::cos(origin.latitude * DEG_TO_RAD)),
+        m_sinLon0(std::sin(origin.longitude * DEG_TO_RAD)), m_cosLon0(std::cos(origin.longitude * DEG_TO_RAD)) {}
+
+  Enu toEnu(const Ecef &point) const {
+    const double dx = point.x - m_origin.x;
+    const double dy = point.y - m_origin.y;
+    const double dz = point.z - m_origin.z;
+    const double w = m_cosLon0 * dx + m_sinLon0 * dy;
+    return {-m_sinLon0 * dx + m_cosLon0 * dy, -m_sinLat0 * w + m_cosLat0 * dz,
+            m_cosLat0 * w + m_sinLat0 * dz};
+  }
+
+  /**
+   * @param latE7, lonE7: degE7.
+   * @param altMm: mm.
+   */
+  Enu toEnu(std::int32_t latE7, std::int32_t lonE7, std::int32_t altMm) const {
+    return toEnu(toEcef(latE7 * DEG_E7_TO_RAD, lonE7 * DEG_E7_TO_RAD, altMm * 1E-3));
+  }
+
+  /**
+   * @brief Convert a batch of positions given as arrays of the same length, one at a time: the
+   *        scalar reference of the batches.
+   */
+  void toEnu(const std::int32_t *latE7, const std::int32_t *lonE7, const std::int32_t *altMm,
+             std::size_t count, double *east, double *north, double *up) const {
+    for (std::size_t idx = 0; idx < count; ++idx) {
+      const Enu enu = toEnu(latE7[idx], lonE7[idx], altMm[idx]);
+      east[idx] = enu.east;
+      north[idx] = enu.north;
+      up[idx] = enu.up;
+    }
+  }
+
+private:
+  Ecef m_origin;
+  double m_sinLat0;
+  double m_cosLat0;
+  double m_sinLon0;
+  double m_cosLon0;
+};
+
+/**
+ * @class TangentPlane
+ * @brief Class approximating ENU of the origin from latitude, longitude and altitude differences,
+ *		  with the radii of curvature of the origin, M in the meridian and N in the prime vertical:
+ *		  - first order, flat earth: east = (N + h) cos(lat0) dLon, north = (M + h) dLat,
+ *		    up = h - h0. The error grows with the square of the distance: the ground drops
+ *		    below the plane by d^2 / 2R, ~8 cm at 1 km.
+ *		  - second order: adds the convergence of meridians to east, the change of M and of the
+ *		    parallel to north and the drop of the ellipsoid to up. The error grows with the cube
+ *		    of the distance.
+ *		  No trigonometry per position, and batches add the terms in the order of single
+ *		  conversions, so they give the same results at any distance as long as the compiler
+ *		  doesn't contract them into FMA.
+ *		  Immutable, so thread-safe.
+ */
+class TangentPlane {
+public:
+
+  /**
+   * @brief Constructor.
+   * @param origin: GPS latitude and longitude in degrees, altitude in metres.
+   */
+  explicit TangentPlane(const Point &origin)
+      : m_lat0(origin.latitude * DEG_TO_RAD), m_lon0(origin.longitude * DEG_TO_RAD),
+        m_alt0(origin.altitude) {
+    const double sinLat0 = std::sin(m_lat0);
+    const double cosLat0 = std::cos(m_lat0);
+    const double n = primeVerticalRadius(sinLat0);
+    const double m = meridionalRadius(sinLat0);
+    const double w2 = 1.0 - ECCENTRICITY_SQ * sinLat0 * sinLat0;
+    m_eastScale = n * cosLat0;
+    m_northScale = m;
+    m_cosLat0 = cosLat0;
+    m_meridianTerm = -m * sinLat0;                         // d(N cos(lat)) / dLat
+    m_meridianSlopeTerm = 1.5 * m * ECCENTRICITY_SQ * sinLat0 * cosLat0 / w2; // (dM / dLat) / 2
+    m_parallelTerm = 0.5 * n * sinLat0 * cosLat0;
+    m_dropLatTerm = 0.5 * m;
+    m_dropLonTerm = 0.5 * n * cosLat0 * cosLat0;
+  }
+
+  /**
+   * @brief First order conversion.
+   * @param latE7, lonE7: degE7.
+   * @param altMm: mm.
+   */
+  Enu toEnu(std::int32_t latE7, std::int32_t lonE7, std::int32_t altMm) const {
+    const double latDiff = latE7 * DEG_E7_TO_RAD - m_lat0;
+    const double lonDiff = lonE7 * DEG_E7_TO_RAD - m_lon0;
+    const double alt = altMm * 1E-3;
+    return {(m_eastScale + alt * m_cosLat0) * lonDiff, (m_northScale + alt) * latDiff, alt - m_alt0};
+  }
+
+  /**
+   * @brief Second order conversion.
+   */
+  Enu toEnuCurved(std::int32_t latE7, std::int32_t lonE7, std::int32_t altMm) const {
+    const double latDiff = latE7 * DEG_E7_TO_RAD - m_lat0;
+    const double lonDiff = lonE7 * DEG_E7_TO_RAD - m_lon0;
+    const double alt = altMm * 1E-3;
+    const double latSq = latDiff * latDiff;
+    const double lonSq = lonDiff * lonDiff;
+    return {(m_eastScale + alt * m_cosLat0 + m_meridianTerm * latDiff) * lonDiff,
+            (m_northScale + alt) * latDiff + m_meridianSlopeTerm * latSq + m_parallelTerm * lonSq,
+            alt - m_alt0 - m_dropLatTerm * latSq - m_dropLonTerm * lonSq};
+  }
+
+  /**
+   * @brief First order conversion of a batch of positions given as arrays of the same length.
+   */
+  void toEnu(const std::int32_t *latE7, const std::int32_t *lonE7, const std::int32_t *altMm,
+             std::size_t count, double *east, double *north, double *up) const {
+    convert_<false>(latE7, lonE7, altMm, count, east, north, up);
+  }
+
+  /**
+   * @brief Second order conversion of a batch of positions given as arrays of the same length.
+   */
+  void toEnuCurved(const std::int32_t *latE7, const std::int32_t *lonE7, const std::int32_t *altMm,
+                   std::size_t count, double *east, double *north, double *up) const {
+    convert_<true>(latE7, lonE7, altMm, count, east, north, up);
+  }
+
+private:
+
+  template <bool IS_CURVED>
+  void convert_(const std::int32_t *latE7, const std::int32_t *lonE7, const std::int32_t *altMm,
+                std::size_t count, double *east, double *north, double *up) const {
+    std::size_t idx = 0;
+#ifdef GEODESY_SSE2
+    using namespace detail;
+    const __m128d degE7ToRad = _mm_set1_pd(DEG_E7_TO_RAD);
+    const __m128d mmToM = _mm_set1_pd(1E-3);
+    const __m128d lat0 = _mm_set1_pd(m_lat0);
+    const __m128d lon0 = _mm_set1_pd(m_lon0);
+    const __m128d alt0 = _mm_set1_pd(m_alt0);
+    const __m128d eastScale = _mm_set1_pd(m_eastScale);
+    const __m128d northScale = _mm_set1_pd(m_northScale);
+    const __m128d cosLat0 = _mm_set1_pd(m_cosLat0);
+    for (; idx + 2 <= count; idx += 2) {
+      const __m128d latDiff = _mm_sub_pd(_mm_mul_pd(loadInt32Pair(latE7 + idx), degE7ToRad), lat0);
+      const __m128d lonDiff = _mm_sub_pd(_mm_mul_pd(loadInt32Pair(lonE7 + idx), degE7ToRad), lon0);
+      const __m128d alt = _mm_mul_pd(loadInt32Pair(altMm + idx), mmToM);
+      __m128d eastFactor = mulAdd(alt, cosLat0, eastScale);
+      __m128d northValue = _mm_mul_pd(_mm_add_pd(northScale, alt), latDiff);
+      __m128d upValue = _mm_sub_pd(alt, alt0);
+      if constexpr (IS_CURVED) {
+        const __m128d latSq = _mm_mul_pd(latDiff, latDiff);
+        const __m128d lonSq = _mm_mul_pd(lonDiff, lonDiff);
+        eastFactor = mulAdd(_mm_set1_pd(m_meridianTerm), latDiff, eastFactor);
+        northValue = mulAdd(_mm_set1_pd(m_parallelTerm), lonSq,
+                            mulAdd(_mm_set1_pd(m_meridianSlopeTerm), latSq, northValue));
+        upValue = _mm_sub_pd(_mm_sub_pd(upValue, _mm_mul_pd(_mm_set1_pd(m_dropLatTerm), latSq)),
+                             _mm_mul_pd(_mm_set1_pd(m_dropLonTerm), lonSq));
+      }
+      _mm_storeu_pd(east + idx, _mm_mul_pd(eastFactor, lonDiff));
+      _mm_storeu_pd(north + idx, northValue);
+      _mm_storeu_pd(up + idx, upValue);
+    }
+#endif
+    for (; idx < count; ++idx) {
+      const Enu enu = IS_CURVED ? toEnuCurved(latE7[idx], lonE7[idx], altMm[idx])
+                                : toEnu(latE7[idx], lonE7[idx], altMm[idx]);
+      east[idx] = enu.east;
+      north[idx] = enu.north;
+      up[idx] = enu.up;
+    }
+  }
+
+  double m_lat0;               // rad
+  double m_lon0;               // rad
+  double m_alt0;               // m
+  double m_cosLat0;
+  double m_eastScale;          // N cos(lat0), m/rad
+  double m_northScale;         // M, m/rad
+  double m_meridianTerm;       // of east by dLat dLon
+  double m_meridianSlopeTerm;  // of north by dLat^2
+  double m_parallelTerm;       // of north by dLon^2
+  double m_dropLatTerm;        // of up by dLat^2
+  double m_dropLonTerm;        // of up by dLon^2
+};
+
+} // namespace geodesy
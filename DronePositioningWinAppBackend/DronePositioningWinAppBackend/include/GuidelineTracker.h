@@ -0,0 +1,125 @@
+/**
+ * @file GuidelineTracker.h
+ * @brief Incremental tracking of vehicles along the guideline.
+ *
+ * @details This file contains the declaration of GuidelineTracker, which projects positions of
+ *          vehicles onto the guideline, the polyline through waypoints raised by the guideline
+ *          offset, searching only around the segment of the previous position.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "ConfigUtilities.h"
+#include "LocalFrame.h"
+
+
+/**
+ * @class GuidelineTracker
+ * @brief Class projecting positions onto the guideline in O(1) amortised time.
+ *		  Direction, horizontal length and arc length from the first waypoint of every segment are
+ *		  computed once. Every vehicle keeps a Cursor at its segment, so a position is projected
+ *		  only onto segments within NEIGHBOURHOOD of it, walking further while the next segment
+ *		  along is closer. All segments are searched for the first position, and when the
+ *		  distance grows by more than JUMP_DISTANCE since the previous one, e.g. after a gap
+ *		  in telemetry. Where the course passes close to itself, the cursor stays on the leg
+ *		  being flown instead of jumping to the one nearby.
+ *		  Distance is horizontal, to the closest point of the guideline seen from above, as
+ *		  the scoring measures it. A single waypoint is a guideline of one point.
+ *		  Immutable after construction, so thread-safe for distinct cursors; doesn't allocate.
+ */
+class GuidelineTracker {
+public:
+
+  static constexpr std::size_t NEIGHBOURHOOD = 2; // segments searched on each side of the cursor
+  static constexpr double JUMP_DISTANCE = 5.0;    // m
+
+  /**
+   * @brief Segment of the guideline tracked by a vehicle.
+   */
+  struct Cursor {
+    std::size_t segmentIdx{0};
+    double distance{0.0};   // of the previous position, m
+    bool isValid{false};    // false until the first position
+  };
+
+  /**
+   * @brief Closest point of the guideline to a position.
+   */
+  struct Projection {
+    std::size_t segmentIdx{0};
+    double fraction{0.0};   // along the segment, [0, 1]
+    double distance{0.0};   // horizontal, m
+    double altitude{0.0};   // of the position above the guideline at the closest point, m
+    double progress{0.0};   // arc length of the guideline up to the closest point, m
+  };
+
+  /**
+   * @brief Constructor.
+   * @param waypoints: vertices of the guideline.
+   * @param frame: local frame of the exercise.
+   * @param coordinatesSystem: system of waypoints.
+   * @param guidelineOffset: height of the guideline above waypoints, m.
+   */
+  GuidelineTracker(const std::vector<Waypoint> &waypoints, const LocalFrame &frame,
+                   CoorindatesSystem coordinatesSystem, double guidelineOffset);
+
+  /**
+   * @brief Project a position of a vehicle around its cursor and move the cursor.
+   * @param cursor: state of the vehicle.
+   * @param east, north, up: position in the local frame, m.
+   */
+  Projection track(Cursor &cursor, double east, double north, double up) const;
+
+  /**
+   * @brief Project a position by searching all segments.
+   */
+  Projection findClosest(double east, double north, double up) const;
+
+  bool isEmpty() const { return m_segments.empty(); }
+  std::size_t getSegmentsNum() const { return m_segments.size(); }
+  double getLength() const; // arc length, m
+
+private:
+
+  /**
+   * @brief Segment of the guideline with its direction precomputed.
+   */
+  struct Segment {
+    double startEast;
+    double startNorth;
+    double startUp;
+    double deltaEast;
+    double deltaNorth;
+    double deltaUp;
+    double inverseLengthSq;   // of the horizontal delta, 0 for a vertical or empty segment
+    double length;            // m
+    double startProgress;     // arc length up to the start, m
+  };
+
+  /**
+   * @brief Project a position onto a segment.
+   * @return Squared horizontal distance.
+   */
+  double project_(std::size_t segmentIdx, double east, double north, double up,
+                  Projection &projection) const;
+
+  /**
+   * @brief Project a position onto segments [first, last), keeping the first closest.
+   */
+  double search_(std::size_t first, std::size_t last, double east, double north, double up,
+                 Projection &projection) const;
+
+  std::vector<Segment> m_segments;
+};
@@ -0,0 +1,130 @@
+/**
+ * @file LatestValueMailbox.h
+ * @brief Lock-free single-slot mailboxes keeping only the latest value of each key.
+ *
+ * @details This file contains the declaration and definition of LatestValueMailbox- set of seqlock
+ *          protected slots, written by any thread and drained by a single consumer thread.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+
+/**
+ * @class LatestValueMailbox
+ * @brief Array of slots, each holding the latest value written under its key. A new value
+ *		  overwrites the one which hasn't been taken yet, so the consumer always gets the freshest
+ *		  value and never a backlog. Every slot is a seqlock: the version is odd while a writer copies
+ *		  the value in, the consumer retries if the version changed during its copy. Writers of the
+ *		  same slot exclude each other by claiming the odd version, the consumer never blocks them.
+ *		  The value is stored in relaxed atomic words, so torn reads are detected instead of being races.
+ * @tparam T: trivially copyable value type.
+ * @tparam SlotsNum: number of keys.
+ */
+template <typename T, std::size_t SlotsNum>
+class LatestValueMailbox {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Values of LatestValueMailbox have to be trivially copyable");
+
+public:
+
+  static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+  /**
+   * @brief Store the value under the key, replacing the previous one. Called by any thread.
+   * @param key: slot index (< SlotsNum).
+   * @param value: value to store.
+   */
+  void put(std::size_t key, const T &value) {
+    Slot &slot = m_slots[key];
+    std::array<std::uint64_t, WORDS_NUM> words{};
+    std::memcpy(words.data(), &value, sizeof(T));
+
+    // Claim the slot by making its version odd
+    std::uint32_t version = slot.version.load(std::memory_order_relaxed);
+    while ((version & 1) != 0 ||
+           !slot.version.compare_exchange_weak(version, version + 1,
+                                               std::memory_order_acquire,
+                                               std::memory_order_relaxed)) {
+      version = slot.version.load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t idx = 0; idx < WORDS_NUM; ++idx) {
+      slot.words[idx].store(words[idx], std::memory_order_relaxed);
+    }
+    slot.version.store(version + 2, std::memory_order_release);
+
+    if (version != slot.takenVersion.load(std::memory_order_relaxed)) {
+      m_overwrittenNum.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Take the value of the key if it has been replaced since the last take.
+   *		Called only by the consumer thread.
+   * @param key: slot index (< SlotsNum).
+   * @param value: destination of the value.
+   * @return True, if a new value has been taken.
+   */
+  bool take(std::size_t key, T &value) {
+    Slot &slot = m_slots[key];
+    std::array<std::uint64_t, WORDS_NUM> words;
+    std::uint32_t version;
+    while (true) {
+      version = slot.version.load(std::memory_order_acquire);
+      if (version == slot.takenVersion.load(std::memory_order_relaxed)) {
+        return false; // nothing new, including never written slots
+      }
+      if ((version & 1) != 0) {
+        continue; // a writer is copying
+      }
+      for (std::size_t idx = 0; idx < WORDS_NUM; ++idx) {
+        words[idx] = slot.words[idx].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.version.load(std::memory_order_relaxed) == version) {
+        break;
+      }
+    }
+    std::memcpy(static_cast<void *>(&value), words.data(), sizeof(T));
+    slot.takenVersion.store(version, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief Get the number of values replaced before the consumer took them.
+   */
+  std::uint64_t getOverwrittenNum() const {
+    return m_overwrittenNum.load(std::memory_order_relaxed);
+  }
+
+  static constexpr std::size_t size() { return SlotsNum; }
+
+private:
+
+  static constexpr std::size_t WORDS_NUM = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+  struct alignas(CACHE_LINE_SIZE) Slot {
+    std::atomic<std::uint32_t> version{0};
+    std::atomic<std::uint32_t> takenVersion{0}; // written by the consumer, read by writers for statistics
+    std::array<std::atomic<std::uint64_t>, WORDS_NUM> words{};
+  };
+
+  std::array<Slot, SlotsNum> m_slots{};
+  std::atomic<std::uint64_t> m_overwrittenNum{0};
+};
@@ -0,0 +1,218 @@
+/**
+ * @file LinkMonitor.h
+ * @brief Telemetry link quality monitor.
+ *
+ * @details This file contains the declaration of LinkMonitor- object which keeps statistics
+ *          of telemetry links (loss, jitter, throughput, heartbeat age) and watches heartbeats.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <cmath>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+#include <common/mavlink.h>
+
+#include "base/IPublisher.h"
+#include "TimerWheel.h"
+
+
+/**
+ * @class LinkMonitor
+ * @brief Class responsible for evaluating quality of telemetry links.
+ *		  Receiving side feeds it with bytes, frames and heartbeats; all watchdogs and
+ *		  periodic statistics of all links are driven by a single TimerWheel ticking
+ *		  on one thread. A ConnectionEvent carrying LinkQuality is published only when
+ *		  the state of a link changes.
+ */
+class LinkMonitor {
+public:
+
+  static constexpr std::size_t MAX_LINKS_NUM = 4;
+  static constexpr std::chrono::milliseconds TICK{100};
+  static constexpr std::uint64_t HEARTBEAT_TIMEOUT_TICKS = 30; // 3 missed heartbeats at 1 Hz
+  static constexpr std::uint64_t STATS_PERIOD_TICKS = 10;      // 1 s
+  static constexpr std::size_t LOSS_WINDOW_NUM = 5;            // rolling window of 5 statistics periods
+  static constexpr float DEGRADED_LOSS_RATE = 0.2f;
+
+  /**
+   * @brief Constructor.
+   * @param publisher: publisher used to announce link state changes.
+   * @param who: name of the component owning monitored links.
+   * @param referenceMsgId: id of the stream used for inter-arrival jitter.
+   * @param isVerbose: logs verbosity flag.
+   */
+  explicit LinkMonitor(IPublisher *publisher, const std::string &who,
+                       std::uint32_t referenceMsgId = MAVLINK_MSG_ID_ATTITUDE,
+                       bool isVerbose = false);
+  ~LinkMonitor();
+
+  /**
+   * @brief Register a new link. Links must be added before LinkMonitor::start.
+   * @return Identifier of the link.
+   */
+  std::size_t addLink();
+
+  /**
+   * @brief Start the ticking thread.
+   */
+  void start();
+
+  /**
+   * @brief Stop the ticking thread.
+   */
+  void stop();
+
+  /**
+   * @brief Account bytes read from the link.
+   * @param linkId: link identifier.
+   * @param bytesNum: number of bytes.
+   */
+  void onBytes(const std::size_t linkId, const std::size_t bytesNum);
+
+  /**
+   * @brief Account a complete MAVLink frame: sequence gaps and jitter.
+   * @param linkId: link identifier.
+   * @param message: parsed frame.
+   */
+  void onFrame(const std::size_t linkId, const mavlink_message_t &message);
+
+  /**
+   * @brief Account frames dropped by the parser (packet_rx_drop_count reported by mavlink_parse_char).
+   *        Counted apart from the loss rate, as the dropped frame leaves a sequence gap too.
+   * @param linkId: link identifier.
+   * @param errorsNum: number of dropped frames.
+   */
+  void onParseErrors(const std::size_t linkId, const std::uint32_t errorsNum);
+
+  /**
+   * @brief Feed the heartbeat watchdog.
+   * @param linkId: link identifier.
+   * @param systemStatus: MAV_STATE reported by the heartbeat.
+   */
+  void onHeartbeat(const std::size_t linkId, const std::uint8_t systemStatus);
+
+  /**
+   * @brief Account the lag of a frame behind its first copy received over a redundant link.
+   * @param linkId: link identifier.
+   * @param lagMs: lag in milliseconds, 0 if this link delivered the first copy.
+   */
+  void onRelativeLatency(const std::size_t linkId, const float lagMs);
+
+  /**
+   * @brief Mark the link as failing on the medium level (read error).
+   * @param linkId: link identifier.
+   */
+  void onReadError(const std::size_t linkId);
+
+  /**
+   * @brief Get the latest statistics of the link.
+   * @param linkId: link identifier.
+   * @return Snapshot of link statistics.
+   */
+  LinkQuality getQuality(const std::size_t linkId) const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr std::size_t TRACKED_SENDERS_NUM = 8;
+
+  struct SequenceTracker {
+    std::uint8_t systemId{0};
+    std::uint8_t componentId{0};
+    std::uint8_t lastSeq{0};
+  };
+
+  struct LinkStats {
+    // Written only by the receiving thread
+    std::array<SequenceTracker, TRACKED_SENDERS_NUM> senders{};
+    std::size_t sendersNum{0};
+    Clock::time_point lastReferenceArrival{};
+    float lastReferenceIntervalMs{-1.0f};
+
+    // Shared between the receiving and ticking threads
+    std::atomic<std::uint64_t> bytes{0};
+    std::atomic<std::uint64_t> frames{0};
+    std::atomic<std::uint32_t> seqGaps{0};
+    std::atomic<std::uint32_t> parseErrors{0};
+    std::atomic<float> jitterMs{0.0f};
+    std::atomic<float> relativeLatencyMs{0.0f};
+    std::atomic<std::int64_t> lastHeartbeatNs{0};
+    std::atomic<std::uint8_t> systemStatus{MAV_STATE_UNINIT};
+    std::atomic_bool isHeartbeatLost{true};
+    std::atomic_bool isReadError{false};
+
+    // Written only by the ticking thread
+    std::array<std::uint64_t, LOSS_WINDOW_NUM> windowFrames{};
+    std::array<std::uint64_t, LOSS_WINDOW_NUM> windowGaps{};
+    std::size_t windowIdx{0};
+    std::uint64_t prevBytes{0};
+    std::uint64_t prevFrames{0};
+    std::uint32_t prevGaps{0};
+    std::atomic<float> lossRate{0.0f};
+    std::atomic<float> bytesPerSecond{0.0f};
+    std::atomic<LinkState> state{LinkState::LOST};
+    TimerWheel::TimerId heartbeatTimer{0};
+    TimerWheel::TimerId statsTimer{0};
+  };
+
+  /**
+   * @brief Update rolling statistics of the link, called by the statistics timer.
+   * @param linkId: link identifier.
+   */
+  void updateStats_(const std::size_t linkId);
+
+  /**
+   * @brief Evaluate the state of the link and publish it, if it has changed.
+   * @param linkId: link identifier.
+   */
+  void evaluate_(const std::size_t linkId);
+
+  /**
+   * @brief Ticking thread loop.
+   * @param stopToken: token requesting the loop to finish.
+   */
+  void run_(std::stop_token stopToken);
+
+  static std::int64_t nowNs_();
+
+  /****************************************************
+  * Links
+  *****************************************************/
+  std::array<LinkStats, MAX_LINKS_NUM> m_links;
+  std::size_t m_linksNum{0};
+  const std::uint32_t m_referenceMsgId;
+
+  /****************************************************
+  * Timing
+  *****************************************************/
+  TimerWheel m_wheel;
+  std::jthread m_tickThread;
+
+  /****************************************************
+  * Publishing
+  *****************************************************/
+  IPublisher *m_publisher;
+  const std::string m_who;
+
+  /****************************************************
+  * Logging
+  *****************************************************/
+  bool m_verbose;
+};
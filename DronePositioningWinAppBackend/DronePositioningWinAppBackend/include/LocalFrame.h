@@ -0,0 +1,112 @@
+/**
+ * @file LocalFrame.h
+ * @brief Conversion of GPS positions into the local frame of the exercise.
+ *
+ * @details This file contains the declaration of LocalFrame, which converts WGS84 positions of
+ *          telemetry into east-north-up metres from the operator position, so headsets don't
+ *          have to do any geodesy.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "ConfigUtilities.h"
+#include "Geodesy.h"
+#include "TelemetrySample.h"
+
+
+/**
+ * @class LocalFrame
+ * @brief Class converting WGS84 positions into ENU metres from the origin with double precision.
+ *		  The position is expressed in ECEF relative to the meridian of the origin and rotated by
+ *		  the ECEF->ENU rotation of the origin, precomputed once. Only sin/cos of the latitude and
+ *		  longitude differences to the origin depend on the sample. The result is that of
+ *		  geodesy::EcefFrame, for a fraction of its time.
+ *		  The batched conversion evaluates them as polynomials, exact to double precision within
+ *		  MAX_SERIES_ANGLE of the origin, two samples per SSE2 instruction. Samples further away
+ *		  take the scalar path. Altitudes above MSL are used as ellipsoidal heights: the geoid
+ *		  separation is practically constant over an exercise area, so it cancels out.
+ *		  Immutable, so thread-safe.
+ */
+class LocalFrame {
+public:
+
+  static constexpr double SEMI_MAJOR_AXIS = geodesy::SEMI_MAJOR_AXIS;
+  static constexpr double FLATTENING = geodesy::FLATTENING;
+  static constexpr double MAX_SERIES_ANGLE = geodesy::MAX_SERIES_ANGLE;
+  static constexpr std::size_t BLOCK_SIZE = 64;                    // samples gathered per batch
+
+  /**
+   * @brief Constructor.
+   * @param origin: origin of the frame, GPS latitude and longitude in degrees, altitude in metres.
+   */
+  explicit LocalFrame(const Point &origin);
+
+  /**
+   * @brief Convert a position.
+   * @param latE7: latitude, degE7.
+   * @param lonE7: longitude, degE7.
+   * @param altMm: altitude, mm.
+   * @param east, north, up: position in the frame, m.
+   */
+  void toEnu(std::int32_t latE7, std::int32_t lonE7, std::int32_t altMm,
+             double &east, double &north, double &up) const;
+
+  /**
+   * @brief Convert a point of the configuration.
+   * @param point: GPS latitude and longitude in degrees and altitude in metres, or UCS metres
+   *			   from the operator: x right (east), y up, z forward (north).
+   * @param coordinatesSystem: system of the point.
+   * @param east, north, up: position in the frame, m.
+   */
+  void toEnu(const Point &point, CoorindatesSystem coordinatesSystem,
+             double &east, double &north, double &up) const;
+
+  /**
+   * @brief Convert a batch of positions given as arrays of the same length.
+   * @param count: number of positions.
+   */
+  void toEnu(const std::int32_t *latE7, const std::int32_t *lonE7, const std::int32_t *altMm,
+             std::size_t count, double *east, double *north, double *up) const;
+
+  /**
+   * @brief Fill the local position of the sample, if its global position is valid.
+   */
+  void transform(TelemetrySample &telemetry) const;
+
+  /**
+   * @brief Fill local positions of samples with a valid global position using the batched conversion.
+   * @param samples: samples to transform.
+   * @param count: number of samples.
+   */
+  void transform(TelemetrySample *samples, std::size_t count) const;
+
+private:
+
+  /**
+   * @brief Convert a position given by its angular differences to the origin and sin/cos of them.
+   */
+  void toEnu_(double sinLatDiff, double cosLatDiff, double sinLonDiff, double cosLonDiff,
+              double alt, double &east, double &north, double &up) const;
+
+  /****************************************************
+  * Origin and its ECEF->ENU rotation
+  *****************************************************/
+  double m_lat0;      // rad
+  double m_lon0;      // rad
+  double m_sinLat0;
+  double m_cosLat0;
+  double m_north0;    // rotated ECEF of the origin
+  double m_up0;
+};
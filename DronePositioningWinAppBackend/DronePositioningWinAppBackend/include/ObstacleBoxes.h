@@ -0,0 +1,123 @@
+/**
+ * @file ObstacleBoxes.h
+ * @brief Oriented boxes of obstacles laid out for SIMD tests.
+ *
+ * @details This file contains the declarations of OrientedBox and ObstacleBoxes, which keeps
+ *          oriented boxes in structure-of-arrays blocks and tests positions against a whole
+ *          block at once.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+
+/**
+ * @brief Obstacle as an oriented box in the local frame of the exercise.
+ */
+struct OrientedBox {
+  std::array<double, 3> center{};      // east, north, up, m
+  std::array<double, 3> halfExtents{}; // along the box axes: width, height, length, m
+  std::array<double, 9> toBox{};       // rows of the inverse rotation, local frame -> box axes
+  std::size_t obstacleId{0};           // index in FlightConfig::getObstacles()
+
+  /**
+   * @brief Distance from a position to the box surface, negative inside: minus the depth.
+   */
+  double signedDistance(double east, double north, double up) const;
+};
+
+/**
+ * @class ObstacleBoxes
+ * @brief Class keeping oriented boxes in blocks of BLOCK_SIZE: every field of the boxes of
+ *		  a block (centre, half extents, rows of the inverse rotation) is an aligned array,
+ *		  so the kernels load a field of several boxes in one instruction.
+ *		  With AVX2 enabled (/arch:AVX2) a block is tested in two steps of 4 doubles, with SSE2,
+ *		  the x64 baseline, in four steps of 2, otherwise lane by lane. All paths evaluate
+ *		  the expressions of OrientedBox::signedDistance in the same order.
+ *		  Unused lanes of the last block have negative infinite half extents: they never
+ *		  contain a position and are infinitely far.
+ *		  Immutable after construction, so thread-safe; tests don't allocate.
+ */
+class ObstacleBoxes {
+public:
+
+  static constexpr std::size_t BLOCK_SIZE = 8;
+  static constexpr std::uint32_t NO_OBSTACLE = 0xFFFFFFFF;
+  static constexpr std::size_t POSITIONS_TILE_SIZE = 256; // positions of a batch tested block by block
+
+  /**
+   * @brief Boxes of a block, field by field.
+   */
+  struct alignas(64) Block {
+    double centerEast[BLOCK_SIZE];
+    double centerNorth[BLOCK_SIZE];
+    double centerUp[BLOCK_SIZE];
+    double halfExtents[3][BLOCK_SIZE];  // along the box axes
+    double toBox[9][BLOCK_SIZE];        // rows of the inverse rotation, local frame -> box axes
+    std::uint32_t obstacleIds[BLOCK_SIZE];
+  };
+
+  ObstacleBoxes() = default;
+
+  /**
+   * @brief Constructor.
+   * @param boxes: boxes to pack, consecutive ones share blocks.
+   */
+  explicit ObstacleBoxes(const std::vector<OrientedBox> &boxes);
+
+  /**
+   * @brief Pack boxes into new blocks.
+   * @param boxes: first box.
+   * @param count: number of boxes.
+   * @return Index of the first block.
+   */
+  std::size_t append(const OrientedBox *boxes, std::size_t count);
+
+  /**
+   * @brief Test a position against all boxes of a block.
+   * @return Bit per lane of boxes containing the position, surface included.
+   */
+  static std::uint32_t containsMask(const Block &block, double east, double north, double up);
+
+  /**
+   * @brief Signed distances of a position to all boxes of a block, as OrientedBox::signedDistance.
+   * @param distances: destination of BLOCK_SIZE distances.
+   */
+  static void signedDistances(const Block &block, double east, double north, double up,
+                              double *distances);
+
+  /**
+   * @brief Find a box containing a position by testing all blocks.
+   * @return Obstacle id of the first such box, NO_OBSTACLE if there's none.
+   */
+  std::uint32_t findContaining(double east, double north, double up) const;
+
+  /**
+   * @brief Find boxes containing a batch of positions given as arrays of the same length,
+   *		e.g. a log being scored again.
+   * @param count: number of positions.
+   * @param obstacleIds: destination of count obstacle ids, NO_OBSTACLE for positions outside.
+   */
+  void findContaining(const double *east, const double *north, const double *up,
+                      std::size_t count, std::uint32_t *obstacleIds) const;
+
+  const Block &getBlock(std::size_t blockIdx) const { return m_blocks[blockIdx]; }
+  std::size_t getBlocksNum() const { return m_blocks.size(); }
+
+private:
+
+  std::vector<Block> m_blocks;
+};
@@ -0,0 +1,116 @@
+/**
+ * @file ObstacleIndex.h
+ * @brief Spatial index of obstacles of the exercise.
+ *
+ * @details This file contains the declaration of ObstacleIndex, a bounding volume hierarchy over
+ *          the oriented boxes of configured obstacles, answering whether a position is inside an
+ *          obstacle and how far the nearest one is.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "ConfigUtilities.h"
+#include "LocalFrame.h"
+#include "ObstacleBoxes.h"
+
+
+/**
+ * @class ObstacleIndex
+ * @brief Class answering proximity queries against obstacles in logarithmic time.
+ *		  Obstacles are converted once into oriented boxes in ENU metres of LocalFrame:
+ *		  centres as waypoints of the same coordinates system, rotations as Unity Euler
+ *		  angles in degrees (Z, then X, then Y) of the UCS axes: x east, y up, z north.
+ *		  Boxes are split recursively at the median of their centres along the longest axis,
+ *		  until at most LEAF_SIZE remain in a leaf. Nodes hold axis-aligned bounds of their
+ *		  boxes, which no box surface is closer than, so queries visit only nodes which may
+ *		  contain the position or a closer obstacle. Boxes of every leaf are a block of
+ *		  ObstacleBoxes, tested at once by its SIMD kernels.
+ *		  Immutable after construction, so thread-safe; queries don't allocate.
+ */
+class ObstacleIndex {
+public:
+
+  static constexpr std::size_t LEAF_SIZE = 8;
+  static constexpr std::size_t MAX_DEPTH = 64; // traversal stack, the tree of 2^32 boxes is shallower
+
+  /**
+   * @brief Result of a nearest obstacle query.
+   */
+  struct Proximity {
+    double distance{0.0};    // to the surface, negative inside
+    std::size_t obstacleId{0};
+  };
+
+  /**
+   * @brief Constructor.
+   * @param obstacles: obstacles of the exercise.
+   * @param frame: local frame of the exercise.
+   * @param coordinatesSystem: system of obstacle centres.
+   */
+  ObstacleIndex(const std::vector<Obstackle> &obstacles, const LocalFrame &frame,
+                CoorindatesSystem coordinatesSystem);
+
+  /**
+   * @brief Check whether a position is inside any obstacle.
+   * @param obstacleId: an obstacle containing the position.
+   */
+  bool isInside(double east, double north, double up, std::size_t &obstacleId) const;
+
+  /**
+   * @brief Find the obstacle nearest to a position.
+   * @param proximity: distance to the nearest obstacle surface and its id.
+   * @return False, if there are no obstacles.
+   */
+  bool findNearest(double east, double north, double up, Proximity &proximity) const;
+
+  std::size_t getObstaclesNum() const { return m_boxes.size(); }
+  const ObstacleBoxes &getLeafBoxes() const { return m_leafBoxes; }
+  const std::vector<OrientedBox> &getBoxes() const { return m_boxes; }
+
+  /**
+   * @brief Convert an obstacle of the configuration into an oriented box.
+   */
+  static OrientedBox toBox(const Obstackle &obstacle, std::size_t obstacleId,
+                           const LocalFrame &frame, CoorindatesSystem coordinatesSystem);
+
+private:
+
+  /**
+   * @brief Node of the hierarchy. Children of an inner node are the next node and rightIdx.
+   */
+  struct Node {
+    std::array<double, 3> min{};
+    std::array<double, 3> max{};
+    std::uint32_t blockIdx{0};    // block of ObstacleBoxes in leaves
+    std::uint32_t boxesNum{0};    // non-zero in leaves
+    std::uint32_t rightIdx{0};
+
+    bool contains(double east, double north, double up) const;
+    double distanceSq(double east, double north, double up) const;
+  };
+
+  /**
+   * @brief Build the subtree of boxes [first, last).
+   * @return Index of its root.
+   */
+  std::uint32_t build_(std::size_t first, std::size_t last,
+                       const std::vector<std::array<double, 6>> &bounds);
+
+  std::vector<OrientedBox> m_boxes;   // in leaf order
+  std::vector<Node> m_nodes;
+  ObstacleBoxes m_leafBoxes;          // a block per leaf
+};
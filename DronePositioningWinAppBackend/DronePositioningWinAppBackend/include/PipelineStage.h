@@ -0,0 +1,330 @@
+/**
+ * @file PipelineStage.h
+ * @brief Stage of a processing pipeline running on its own thread.
+ *
+ * @details This file contains the definition of a pipeline stage template, which takes items
+ *          from its lock-free input queue in batches, processes them on its own, optionally
+ *          pinned thread and hands them over to the next stage, and of the latency histogram
+ *          stages measure themselves with.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "SpscRingBuffer.h"
+
+
+/**
+ * @brief Pin the calling thread to a core.
+ * @param core: index of the core, from 0.
+ * @return True, if the thread is pinned.
+ */
+bool pinCurrentThread(int core);
+
+/**
+ * @brief Get the steady clock in nanoseconds, the time base of pipeline latencies.
+ */
+inline std::int64_t pipelineNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * @class LatencyHistogram
+ * @brief Histogram of latencies in nanoseconds with 4 buckets per power of two, so percentiles
+ *		  are within 25 % of the exact ones, at a constant cost and size however many are added.
+ *		  Added to by one thread, read by any.
+ */
+class LatencyHistogram {
+public:
+
+  static constexpr std::size_t SUB_BUCKETS_NUM = 4;
+  static constexpr std::size_t BUCKETS_NUM = 64 * SUB_BUCKETS_NUM;
+
+  void add(std::int64_t latencyNs) {
+    const std::uint64_t value = latencyNs > 0 ? static_cast<std::uint64_t>(latencyNs) : 0;
+    std::atomic<std::uint64_t> &bucket = m_buckets[bucketIdx_(value)];
+    // Single writer, no read-modify-write needed
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    m_count.store(m_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (value > m_maxNs.load(std::memory_order_relaxed)) {
+      m_maxNs.store(value, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Get the upper bound of the bucket holding the percentile.
+   * @param percentile: from 0 to 100.
+   */
+  std::uint64_t getPercentileNs(double percentile) const {
+    const std::uint64_t count = getCount();
+    if (count == 0) {
+      return 0;
+    }
+    const std::uint64_t rank = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::min(percentile, 100.0) / 100.0 * count + 0.5));
+    std::uint64_t seenNum = 0;
+    for (std::size_t idx = 0; idx < BUCKETS_NUM; ++idx) {
+      seenNum += m_buckets[idx].load(std::memory_order_relaxed);
+      if (seenNum >= rank) {
+        return std::min(bucketUpperNs_(idx), getMaxNs());
+      }
+    }
+    return getMaxNs();
+  }
+
+  std::uint64_t getCount() const { return m_count.load(std::memory_order_relaxed); }
+  std::uint64_t getMaxNs() const { return m_maxNs.load(std::memory_order_relaxed); }
+
+private:
+
+  static std::size_t bucketIdx_(std::uint64_t value) {
+    if (value < SUB_BUCKETS_NUM) {
+      return static_cast<std::size_t>(value);
+    }
+    // Highest bit selects the power of two, the next two bits the sub-bucket
+    const std::size_t msb = std::bit_width(value) - 1;
+    return (msb - 1) * SUB_BUCKETS_NUM + ((value >> (msb - 2)) & (SUB_BUCKETS_NUM - 1));
+  }
+
+  static std::uint64_t bucketUpperNs_(std::size_t idx) {
+    if (idx < SUB_BUCKETS_NUM) {
+      return idx;
+    }
+    const std::size_t msb = idx / SUB_BUCKETS_NUM + 1;
+    const std::uint64_t lower = (SUB_BUCKETS_NUM + idx % SUB_BUCKETS_NUM) << (msb - 2);
+    return lower + (std::uint64_t{1} << (msb - 2)) - 1;
+  }
+
+  std::array<std::atomic<std::uint64_t>, BUCKETS_NUM> m_buckets{};
+  std::atomic<std::uint64_t> m_count{0};
+  std::atomic<std::uint64_t> m_maxNs{0};
+};
+
+/**
+ * @class PipelineStage
+ * @brief Stage of a pipeline of threads connected by SpscRingBuffer queues:
+ *		  - The thread pops up to BatchSize items from the input queue, calls the handler on the
+ *		    batch and pushes the batch into the queue of the next stage, if any. It sleeps while
+ *		    the queue is empty.
+ *		  - A slower next stage only fills its own queue. The stage sleeps until the next one
+ *		    pops and makes room, rather than dropping processed items, so only the first stage of
+ *		    a pipeline ever drops, when the whole pipeline falls behind by the capacity of its
+ *		    queues.
+ *		  - Latency of an item is measured from entering the input queue to the end of the batch
+ *		    it was processed in, so it holds both the wait in the queue and the processing.
+ *		  - stop() lets the thread drain its queue before it ends. Stages are stopped in pipeline
+ *		    order, once the producer of the first one stopped pushing, so no item is lost.
+ *		  push() is called by one thread: the producer of the first stage or the previous stage.
+ * @tparam Item: trivially copyable item with a std::int64_t enqueueNs member.
+ * @tparam QueueCapacity: capacity of the input queue, has to be a power of two.
+ * @tparam BatchSize: most items processed at once.
+ */
+template <typename Item, std::size_t QueueCapacity, std::size_t BatchSize>
+class PipelineStage {
+public:
+
+  using Handler = std::function<void(Item *items, std::size_t count)>;
+
+  /**
+   * @brief Occupancy and latency of a stage.
+   */
+  struct Metrics {
+    std::uint64_t itemsNum{0};
+    std::uint64_t batchesNum{0};
+    double serviceNs{0.0};          // mean processing time of an item
+    double utilisation{0.0};        // share of the running time spent processing, 0..1
+    std::uint64_t latencyP50Ns{0};  // from entering the queue to processed
+    std::uint64_t latencyP99Ns{0};
+    std::uint64_t latencyMaxNs{0};
+    std::size_t queueDepth{0};
+    std::size_t queueMaxDepth{0};
+    std::size_t queueCapacity{QueueCapacity};
+    std::uint64_t droppedNum{0};    // didn't fit into the queue
+    std::uint64_t stallsNum{0};     // sleeps waiting for room in the queue of the next stage
+  };
+
+  PipelineStage() = default;
+
+  /**
+   * @brief Destructor. Stops the thread, the next stage has to outlive it.
+   */
+  ~PipelineStage() {
+    stop();
+  }
+
+  PipelineStage(const PipelineStage &) = delete;
+  PipelineStage &operator=(const PipelineStage &) = delete;
+
+  /**
+   * @brief Start the thread of the stage.
+   * @param name: name of the stage for logs.
+   * @param handler: processing of a batch of items, called on the thread of the stage.
+   * @param next: stage items are handed over to, null for the last one.
+   * @param core: core to pin the thread to, negative not to pin it.
+   */
+  void start(std::string name, Handler handler, PipelineStage *next, int core) {
+    m_name = std::move(name);
+    m_handler = std::move(handler);
+    m_next = next;
+    m_startNs.store(pipelineNowNs(), std::memory_order_relaxed);
+    m_thread = std::jthread([this, core](std::stop_token stopToken) { run_(stopToken, core); });
+  }
+
+  /**
+   * @brief Push items into the input queue, stamping the time they entered it.
+   * @return Number of pushed items, the rest is dropped.
+   */
+  std::size_t push(Item *items, std::size_t count) {
+    const std::int64_t nowNs = pipelineNowNs();
+    for (std::size_t idx = 0; idx < count; ++idx) {
+      items[idx].enqueueNs = nowNs;
+    }
+    const std::size_t pushedNum = m_queue.push(items, count);
+    if (pushedNum > 0) {
+      m_queue.wake();
+    }
+    return pushedNum;
+  }
+
+  /**
+   * @brief Process items left in the queue and end the thread. Next calls do nothing.
+   */
+  void stop() {
+    if (m_thread.joinable()) {
+      m_thread.request_stop();
+      m_queue.wake();
+      m_thread.join();
+    }
+  }
+
+  Metrics getMetrics() const {
+    Metrics metrics;
+    metrics.itemsNum = m_itemsNum.load(std::memory_order_relaxed);
+    metrics.batchesNum = m_batchesNum.load(std::memory_order_relaxed);
+    const std::int64_t busyNs = m_busyNs.load(std::memory_order_relaxed);
+    metrics.serviceNs = metrics.itemsNum > 0 ? static_cast<double>(busyNs) / metrics.itemsNum : 0.0;
+    const std::int64_t stopNs = m_stopNs.load(std::memory_order_relaxed);
+    const std::int64_t runningNs =
+        (stopNs > 0 ? stopNs : pipelineNowNs()) - m_startNs.load(std::memory_order_relaxed);
+    metrics.utilisation = runningNs > 0 ? static_cast<double>(busyNs) / runningNs : 0.0;
+    metrics.latencyP50Ns = m_latency.getPercentileNs(50.0);
+    metrics.latencyP99Ns = m_latency.getPercentileNs(99.0);
+    metrics.latencyMaxNs = m_latency.getMaxNs();
+    metrics.queueDepth = m_queue.size();
+    metrics.queueMaxDepth = m_queue.getMaxDepth();
+    metrics.droppedNum = m_queue.getOverflowNum();
+    metrics.stallsNum = m_stallsNum.load(std::memory_order_relaxed);
+    return metrics;
+  }
+
+  const std::string &getName() const { return m_name; }
+
+private:
+
+  void run_(std::stop_token stopToken, int core) {
+    if (core >= 0 && !pinCurrentThread(core)) {
+      std::cout << "PipelineStage: " << m_name << " couldn't be pinned to core " << core << "\n";
+    }
+    std::array<Item, BatchSize> batch;
+    while (true) {
+      // Read the signal before checking the queue, so a push or stop in between isn't missed
+      const std::uint32_t signal = m_queue.getSignal();
+      const std::size_t count = m_queue.pop(batch.data(), BatchSize);
+      if (count == 0) {
+        if (stopToken.stop_requested()) {
+          break;
+        }
+        m_queue.waitForData(signal);
+        continue;
+      }
+      // Room for the previous stage, if it sleeps waiting for it
+      m_spaceSignal.fetch_add(1, std::memory_order_release);
+      m_spaceSignal.notify_one();
+
+      const std::int64_t startNs = pipelineNowNs();
+      m_handler(batch.data(), count);
+      const std::int64_t endNs = pipelineNowNs();
+      for (std::size_t idx = 0; idx < count; ++idx) {
+        m_latency.add(endNs - batch[idx].enqueueNs);
+      }
+      // Single writer, no read-modify-write needed
+      m_busyNs.store(m_busyNs.load(std::memory_order_relaxed) + (endNs - startNs), std::memory_order_relaxed);
+      m_itemsNum.store(m_itemsNum.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+      m_batchesNum.store(m_batchesNum.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      if (m_next) {
+        forward_(batch.data(), count);
+      }
+    }
+    m_stopNs.store(pipelineNowNs(), std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Hand items over to the next stage, sleeping while its queue is full.
+   */
+  void forward_(Item *items, std::size_t count) {
+    std::size_t forwardedNum = 0;
+    bool isStalled = false;
+    while (forwardedNum < count) {
+      // Read the signal before checking the room, so a pop in between isn't missed
+      const std::uint32_t spaceSignal = m_next->m_spaceSignal.load(std::memory_order_acquire);
+      // Room only grows while the next stage pops, so the push never overflows
+      const std::size_t freeNum = QueueCapacity - m_next->m_queue.size();
+      if (freeNum == 0) {
+        isStalled = true;
+        m_next->m_spaceSignal.wait(spaceSignal, std::memory_order_acquire);
+        continue;
+      }
+      forwardedNum += m_next->push(items + forwardedNum, std::min(freeNum, count - forwardedNum));
+    }
+    if (isStalled) {
+      m_stallsNum.store(m_stallsNum.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+  }
+
+  /****************************************************
+  * Stage
+  *****************************************************/
+  std::string m_name;
+  Handler m_handler;
+  PipelineStage *m_next{nullptr};
+  SpscRingBuffer<Item, QueueCapacity> m_queue;
+
+  /****************************************************
+  * Metrics
+  *****************************************************/
+  LatencyHistogram m_latency;
+  std::atomic<std::uint64_t> m_itemsNum{0};
+  std::atomic<std::uint64_t> m_batchesNum{0};
+  std::atomic<std::int64_t> m_busyNs{0};
+  std::atomic<std::uint64_t> m_stallsNum{0};
+  std::atomic<std::int64_t> m_startNs{0};
+  std::atomic<std::int64_t> m_stopNs{0};
+
+  /****************************************************
+  * Threading
+  *****************************************************/
+  std::atomic<std::uint32_t> m_spaceSignal{0}; // changed by every pop
+  std::jthread m_thread;
+};
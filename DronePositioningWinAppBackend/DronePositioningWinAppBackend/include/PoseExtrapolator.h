@@ -0,0 +1,114 @@
+/**
+ * @file PoseExtrapolator.h
+ * @brief Prediction of vehicle poses between telemetry samples.
+ *
+ * @details This file contains the declaration of PoseExtrapolator, which keeps a short history
+ *          of every vehicle and extrapolates its position and attitude to the time of sending,
+ *          so the headset gets poses at its frame rate instead of the telemetry rate.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+#include "TelemetrySample.h"
+
+
+/**
+ * @class PoseExtrapolator
+ * @brief Class predicting the pose of every vehicle at a given host time.
+ *		  Capture times of samples are mapped to the host clock by ClockSync, so the prediction
+ *		  horizon is the measured age of the latest sample: link latency plus the time since.
+ *		  Position follows a constant turn model: the reported NED velocity rotated by the turn
+ *		  rate estimated from the course change over the history, a constant velocity model when
+ *		  the vehicle isn't turning. Velocity is differentiated from positions of the history if
+ *		  the autopilot doesn't report it. Attitude is advanced by its reported body rates,
+ *		  converted into rates of the Euler angles.
+ *		  Nothing is predicted further than the maximum horizon past the latest sample.
+ *		  Every vehicle keeps at most HISTORY_SIZE positions in a fixed array, predicting
+ *		  doesn't allocate. Not thread-safe.
+ */
+class PoseExtrapolator {
+public:
+
+  static constexpr std::size_t HISTORY_SIZE = 4;
+  static constexpr std::size_t MAX_VEHICLES_NUM = 256;  // by MAVLink system id
+  static constexpr double MIN_TURN_SPEED = 1.0;         // m/s, course of a slower vehicle is noise
+  static constexpr double MAX_TURN_RATE = 1.5;          // rad/s
+
+  /**
+   * @brief Constructor.
+   * @param maxHorizon: longest time poses are predicted ahead of the latest sample.
+   */
+  explicit PoseExtrapolator(std::chrono::nanoseconds maxHorizon);
+
+  /**
+   * @brief Add a sample of a vehicle. Its position enters the history only if it's newer
+   *		than the latest one.
+   */
+  void update(const TelemetrySample &telemetry);
+
+  /**
+   * @brief Predict the pose of a vehicle.
+   * @param vehicleId: MAVLink system id.
+   * @param timeNs: host steady clock time of the prediction.
+   * @param prediction: latest sample with position, velocity and attitude predicted, and host times set to timeNs.
+   * @return False, if the vehicle is unknown or its latest sample is older than the maximum horizon.
+   */
+  bool predict(std::uint8_t vehicleId, std::int64_t timeNs, TelemetrySample &prediction) const;
+
+  /**
+   * @brief Predict poses of all vehicles.
+   * @param timeNs: host steady clock time of the prediction.
+   * @param predictions: destination of at least MAX_VEHICLES_NUM samples.
+   * @return Number of predicted poses.
+   */
+  std::size_t predictAll(std::int64_t timeNs, TelemetrySample *predictions) const;
+
+private:
+
+  struct Fix {
+    std::int64_t timeNs{0};
+    double north{0.0};      // m, from the first fix of the vehicle
+    double east{0.0};
+    float velocityNorth{0.0f};
+    float velocityEast{0.0f};
+  };
+
+  struct Track {
+    TelemetrySample latest;
+    std::array<Fix, HISTORY_SIZE> history{}; // ring of position fixes
+    std::size_t historyNext{0};
+    std::size_t historyNum{0};
+    std::int32_t originLatE7{0};             // first fix, origin of north/east of the history
+    std::int32_t originLonE7{0};
+    double metresPerDegE7Lon{0.0};
+    bool hasReportedVelocity{false};
+    float velocityNorth{0.0f};               // estimate of the latest fix, m/s
+    float velocityEast{0.0f};
+    double turnRate{0.0};                    // rad/s, positive clockwise seen from above
+    bool isKnown{false};
+  };
+
+  /**
+   * @brief Update velocity and turn rate estimates of the track after a new fix.
+   */
+  static void estimateMotion_(Track &track);
+
+  const std::int64_t m_maxHorizonNs;
+  std::array<Track, MAX_VEHICLES_NUM> m_tracks{};
+  std::array<std::uint8_t, MAX_VEHICLES_NUM> m_vehicleIds{}; // known vehicles in order of appearance
+  std::size_t m_vehiclesNum{0};
+};
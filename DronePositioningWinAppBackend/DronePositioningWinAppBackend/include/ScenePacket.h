@@ -0,0 +1,111 @@
+/**
+ * @file ScenePacket.h
+ * @brief Wire format of the scene pushed to the visualisation platform.
+ *
+ * @details This file contains the layout of the binary scene blob built from FlightConfig and of
+ *          the datagrams transferring it in chunks, together with functions building and parsing them.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "FlightConfig.h"
+
+
+namespace wire {
+
+/**
+ * @brief Layout of the scene blob, version 1. All fields are little-endian.
+ *
+ *	u16 magic (0x5344, bytes "DS"), u8 version, u8 reserved
+ *	u8 coordinates system, u8 altitude difference, u8 scoring method,
+ *	u8 flags (SCENE_FLAG_SHOW_WAYPOINTS, SCENE_FLAG_SHOW_GUIDELINE)
+ *	f32 guideline offset, f32 target speed, i32 accuracy, i32 pausing time, i32 target bearings,
+ *	i32 distance weight, i32 altitude weight, i32 speed weight
+ *	u16 length + bytes: title, author
+ *	f64 x3 operator position (latitude, longitude, altitude)
+ *	u16 waypoints number, f64 x3 each
+ *	u16 markers number, f64 x3 + f32 radius each
+ *	u16 obstacles number, f32 x9 each (center, dimensions, rotation)
+ *
+ * Transfer: the sender announces the blob (SceneAnnounce: magic "DA") and sends its chunks
+ * (SceneChunk: magic "DC"), both with the header below. The headset answers with SceneAck
+ * (magic "DK") carrying the bitmap of received chunks- all bits set if it has the blob with
+ * this hash cached, so nothing is sent. Missing chunks are sent again every retransmit period.
+ * A SceneAck with another hash is a request for the current scene.
+ *
+ *	header: u16 magic, u8 version, u8 reserved, u64 FNV-1a hash of the blob, u32 blob size,
+ *	        u16 chunk index (0 in an announce), u16 chunks number
+ *	chunk:  header + up to SCENE_CHUNK_PAYLOAD_SIZE bytes of the blob at index * SCENE_CHUNK_PAYLOAD_SIZE
+ *	ack:    u16 magic, u8 version, u8 reserved, u64 hash, u16 chunks number, bitmap (bit i of byte i / 8)
+ */
+inline constexpr std::uint16_t SCENE_MAGIC = 0x5344;
+inline constexpr std::uint16_t SCENE_ANNOUNCE_MAGIC = 0x4144;
+inline constexpr std::uint16_t SCENE_CHUNK_MAGIC = 0x4344;
+inline constexpr std::uint16_t SCENE_ACK_MAGIC = 0x4B44;
+inline constexpr std::uint8_t SCENE_VERSION = 1;
+inline constexpr std::uint8_t SCENE_FLAG_SHOW_WAYPOINTS = 1u << 0;
+inline constexpr std::uint8_t SCENE_FLAG_SHOW_GUIDELINE = 1u << 1;
+inline constexpr std::size_t SCENE_HEADER_SIZE = 20;
+inline constexpr std::size_t SCENE_ACK_HEADER_SIZE = 14;
+inline constexpr std::size_t SCENE_DATAGRAM_SIZE = 1472;   // Ethernet MTU without IPv4 and UDP headers
+inline constexpr std::size_t SCENE_CHUNK_PAYLOAD_SIZE = SCENE_DATAGRAM_SIZE - SCENE_HEADER_SIZE;
+inline constexpr std::size_t MAX_SCENE_CHUNKS_NUM = 1024;  // 1.4 MB, far above any exercise
+
+/**
+ * @brief FNV-1a 64-bit hash.
+ */
+std::uint64_t fnv1a64(const std::uint8_t *data, std::size_t size);
+
+/**
+ * @brief Serialise the scene of the flight configuration.
+ */
+std::vector<std::uint8_t> serializeScene(const configuration::FlightConfig &flightConfig);
+
+/**
+ * @brief Get the number of chunks the blob is transferred in.
+ */
+std::size_t getSceneChunksNum(std::size_t blobSize);
+
+/**
+ * @brief Write the announce of the blob.
+ * @param buffer: destination of at least SCENE_HEADER_SIZE bytes.
+ * @return Number of written bytes.
+ */
+std::size_t writeSceneAnnounce(const std::vector<std::uint8_t> &blob, std::uint64_t hash,
+                               std::uint8_t *buffer);
+
+/**
+ * @brief Write a chunk of the blob.
+ * @param chunkIdx: index of the chunk (< getSceneChunksNum).
+ * @param buffer: destination of at least SCENE_DATAGRAM_SIZE bytes.
+ * @return Number of written bytes.
+ */
+std::size_t writeSceneChunk(const std::vector<std::uint8_t> &blob, std::uint64_t hash,
+                            std::size_t chunkIdx, std::uint8_t *buffer);
+
+/**
+ * @brief Parse an ack of the headset.
+ * @param buffer: received datagram.
+ * @param size: size of the datagram.
+ * @param hash: hash of the acknowledged blob.
+ * @param chunksNum: number of chunks of the acknowledged blob.
+ * @param bitmap: start of the bitmap of received chunks within the buffer.
+ * @return False, if the datagram isn't a valid ack.
+ */
+bool parseSceneAck(const std::uint8_t *buffer, std::size_t size, std::uint64_t &hash,
+                   std::size_t &chunksNum, const std::uint8_t *&bitmap);
+
+} // namespace wire
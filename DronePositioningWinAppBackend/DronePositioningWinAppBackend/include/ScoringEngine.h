@@ -0,0 +1,152 @@
+/**
+ * @file ScoringEngine.h
+ * @brief Streaming scoring of the flight of every vehicle.
+ *
+ * @details This file contains the declaration of ScoringEngine, which accumulates distance,
+ *          altitude and speed errors of every sample and scores the flight with MAE or RMSE
+ *          weighted as configured in ExerciseInfo.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+#include "ConfigUtilities.h"
+
+
+/**
+ * @class ErrorAccumulator
+ * @brief Class accumulating a stream of signed errors in O(1) memory.
+ *		  Mean and variance follow Welford's update, which doesn't lose the variance of
+ *		  small errors on top of a large bias. Sums of |e| and e^2 for MAE and RMSE are
+ *		  Kahan-compensated, so an hour at 100 Hz adds no visible rounding.
+ */
+class ErrorAccumulator {
+public:
+
+  void add(double error);
+
+  std::uint64_t getCount() const { return m_count; }
+  double getMean() const { return m_mean; }       // signed, bias of the error
+  double getStdDev() const;
+  double getMae() const;
+  double getRmse() const;
+  double getMaxAbs() const { return m_maxAbs; }
+
+private:
+
+  /**
+   * @brief Kahan-compensated sum.
+   */
+  struct CompensatedSum {
+    double sum{0.0};
+    double compensation{0.0};
+
+    void add(double value);
+  };
+
+  std::uint64_t m_count{0};
+  double m_mean{0.0};
+  double m_m2{0.0};                 // sum of squared differences to the mean
+  CompensatedSum m_absSum;
+  CompensatedSum m_squareSum;
+  double m_maxAbs{0.0};
+};
+
+/**
+ * @class ScoringEngine
+ * @brief Class scoring the flight of every vehicle from per-sample errors:
+ *		  - distance: horizontal distance to the guideline, m,
+ *		  - altitude: height above the guideline at the closest point, m,
+ *		  - speed: ground speed minus the target speed, m/s.
+ *		  Every error is reduced to its MAE or RMSE, as ScoringMethod says, and the score is
+ *		  their average weighted by the distance, altitude and speed weights. Altitude isn't
+ *		  scored when altitude differences are ignored. Adding a sample is O(1) and doesn't
+ *		  allocate, state of all vehicles is preallocated. Not thread-safe.
+ */
+class ScoringEngine {
+public:
+
+  static constexpr std::size_t MAX_VEHICLES_NUM = 256; // by MAVLink system id
+
+  /**
+   * @brief Errors of a sample.
+   */
+  struct Errors {
+    double distance{0.0};
+    double altitude{0.0};
+    double speed{0.0};
+  };
+
+  /**
+   * @brief Score of a vehicle.
+   */
+  struct Score {
+    std::uint64_t samplesNum{0};
+    double distance{0.0};   // MAE or RMSE of the error
+    double altitude{0.0};
+    double speed{0.0};
+    double weighted{0.0};   // weighted average of the above
+  };
+
+  /**
+   * @brief Constructor.
+   * @param exerciseInfo: scoring method, weights and altitude handling of the exercise.
+   */
+  explicit ScoringEngine(const ExerciseInfo &exerciseInfo);
+
+  /**
+   * @brief Add errors of a sample of a vehicle.
+   */
+  void add(std::uint8_t vehicleId, const Errors &errors);
+
+  /**
+   * @brief Score of a vehicle, all zeros if it has no samples.
+   */
+  Score getScore(std::uint8_t vehicleId) const;
+
+  const ErrorAccumulator &getDistanceErrors(std::uint8_t vehicleId) const { return m_vehicles[vehicleId].distance; }
+  const ErrorAccumulator &getAltitudeErrors(std::uint8_t vehicleId) const { return m_vehicles[vehicleId].altitude; }
+  const ErrorAccumulator &getSpeedErrors(std::uint8_t vehicleId) const { return m_vehicles[vehicleId].speed; }
+
+  /**
+   * @brief Scored vehicles in order of their first sample.
+   * @return Number of vehicles, their ids are in vehicleIds.
+   */
+  std::size_t getVehicles(const std::uint8_t *&vehicleIds) const;
+
+  ScoringMethod getScoringMethod() const { return m_scoringMethod; }
+
+private:
+
+  struct Vehicle {
+    ErrorAccumulator distance;
+    ErrorAccumulator altitude;
+    ErrorAccumulator speed;
+    bool isKnown{false};
+  };
+
+  /**
+   * @brief MAE or RMSE of the accumulator, as the scoring method says.
+   */
+  double reduce_(const ErrorAccumulator &errors) const;
+
+  const ScoringMethod m_scoringMethod;
+  const double m_distanceWeight;
+  const double m_altitudeWeight;
+  const double m_speedWeight;
+  std::array<Vehicle, MAX_VEHICLES_NUM> m_vehicles{};
+  std::array<std::uint8_t, MAX_VEHICLES_NUM> m_vehicleIds{}; // scored vehicles in order of appearance
+  std::size_t m_vehiclesNum{0};
+};
@@ -0,0 +1,157 @@
+/**
+ * @file SerialPort.h
+ * @brief Serial port connection to the UAV telemetry radio or board.
+ *
+ * @details This file contains the declaration of SerialPort- wrapper of windows serial port API
+ *          which opens and configures the port and optionally detects its baud rate.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <windows.h>
+
+#include <array>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <iostream>
+#include <stdexcept>
+#include <cstdint>
+
+#include <common/mavlink.h>
+
+#include "ConfigUtilities.h"
+
+
+/**
+ * @class SerialPort
+ * @brief Class owning the handle of the serial port. The port is configured 8N1 with
+ *		  read timeouts, so SerialPort::read returns within READ_TIMEOUT even if nothing arrives.
+ *		  The port is opened overlapped, so a write from one thread doesn't wait behind a read
+ *		  pending on another. Reads are called by one thread at a time, writes too.
+ */
+class SerialPort {
+public:
+
+  // Probed from the fastest, the first one carrying MAVLink is used
+  static constexpr std::array<std::uint32_t, 5> CANDIDATE_BAUD_RATES{
+      921600, 460800, 230400, 115200, 57600};
+  static constexpr auto PROBE_WINDOW = std::chrono::milliseconds(2500); // covers two 1 Hz heartbeats
+  static constexpr int PROBE_MIN_FRAMES = 2;
+  static constexpr DWORD READ_TIMEOUT_MS = 100;
+
+  /**
+   * @brief Constructor. Opens and configures the port. Throws std::runtime_error if
+   *		the port cannot be opened, configured or no baud rate carries MAVLink.
+   * @param portCom: name of the port, e.g. COM3.
+   * @param baudRate: baud rate or ConnectionConfigurationInfo::AUTO_BAUD_RATE to detect it.
+   * @param isVerbose: logs verbosity flag.
+   */
+  explicit SerialPort(const std::string &portCom, std::uint32_t baudRate,
+                      bool isVerbose = false);
+  ~SerialPort();
+
+  SerialPort(const SerialPort &) = delete;
+  SerialPort &operator=(const SerialPort &) = delete;
+
+  /**
+   * @brief Read available bytes. Waits at most READ_TIMEOUT_MS for the first byte.
+   * @param buffer: destination.
+   * @param size: capacity of the destination.
+   * @return Number of bytes read (0 on timeout) or -1 on error.
+   */
+  int read(std::uint8_t *buffer, DWORD size);
+
+  /**
+   * @brief Write bytes to the port. Waits only until the driver took them, not for a read.
+   * @param buffer: source.
+   * @param size: number of bytes to write.
+   * @return True, if all bytes have been written.
+   */
+  bool write(const std::uint8_t *buffer, DWORD size);
+
+  /**
+   * @brief Query the serial driver, how many received bytes wait to be read and whether
+   *		any were lost since the previous query (driver or UART buffer overrun).
+   * @param inQueueBytes: number of bytes in the driver input queue.
+   * @param isOverrun: true, if bytes were lost.
+   * @return True, if the status has been read.
+   */
+  bool getInputStatus(DWORD &inQueueBytes, bool &isOverrun);
+
+  /**
+   * @brief Close the port. Pending reads are cancelled, they and following reads fail.
+   */
+  void close();
+
+  /**
+   * @brief Get the baud rate the port works with.
+   */
+  std::uint32_t getBaudRate() const;
+
+  /**
+   * @brief Get the name of the port.
+   */
+  const std::string &getPortCom() const;
+
+private:
+
+  /**
+   * @brief Wait for an overlapped operation started by ReadFile or WriteFile.
+   * @param isStarted: result of ReadFile or WriteFile.
+   * @param overlapped: structure of the operation.
+   * @param transferredNum: number of transferred bytes.
+   * @return True, if the operation succeeded.
+   */
+  bool complete_(BOOL isStarted, OVERLAPPED &overlapped, DWORD &transferredNum);
+
+  /**
+   * @brief Close the port and events of overlapped operations.
+   */
+  void release_();
+
+  /**
+   * @brief Apply the baud rate with 8N1 framing.
+   * @return True, if the serial driver accepted the configuration.
+   */
+  bool setBaudRate_(std::uint32_t baudRate);
+
+  /**
+   * @brief Count MAVLink frames with a valid checksum received within PROBE_WINDOW.
+   */
+  int countFrames_();
+
+  /**
+   * @brief Probe CANDIDATE_BAUD_RATES and settle on the fastest one carrying MAVLink.
+   * @return Detected baud rate.
+   */
+  std::uint32_t detectBaudRate_();
+
+  /****************************************************
+  * UAV connection specification
+  ****************************************************/
+  const std::string m_portCom;
+  HANDLE m_comSerial;
+  DCB m_dcbSerialParams;
+  std::uint32_t m_baudRate;
+
+  /****************************************************
+  * Overlapped I/O
+  ****************************************************/
+  OVERLAPPED m_readOverlapped{};  // used by the reading thread only
+  OVERLAPPED m_writeOverlapped{}; // used by the writing thread only
+
+  /****************************************************
+  * Logging
+  *****************************************************/
+  bool m_verbose;
+};
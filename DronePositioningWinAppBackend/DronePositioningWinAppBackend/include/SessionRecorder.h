@@ -0,0 +1,278 @@
+/**
+ * @file SessionRecorder.h
+ * @brief Recording of scored positions of a session to a columnar file.
+ *
+ * @details This file contains the declaration of SessionRecorder, which collects per-position
+ *          results of the processor in preallocated columnar chunks and writes them from a
+ *          background thread to a binary columnar file, with per-vehicle CSV and JSON summaries
+ *          written when the session is closed.
+ *
+ *          Session file (.dps), little-endian:
+ *            header:    "DPSR", version u16, columns number u16, then per column its name
+ *                       char[16], type u8 (ColumnType) and 3 padding bytes
+ *            row group: "DPRG", rows number u32, then values of every column in header order,
+ *                       rows number of them each, contiguous
+ *            footer:    "DPSE", row groups number u32, rows number u64, dropped rows number u64
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "ScoringEngine.h"
+
+
+/**
+ * @class SessionRecorder
+ * @brief Class recording a row of results for every scored position without blocking the
+ *		  telemetry path:
+ *		  - append() stores the row into columns of the current chunk, taken from a pool
+ *		    preallocated at construction. A full chunk is handed to the writer thread and the next
+ *		    one is taken from the pool under a short lock, once per CHUNK_ROWS_NUM rows.
+ *		  - The writer thread writes every chunk as a row group of the session file and updates
+ *		    per-vehicle summaries, then returns the chunk to the pool. If the disk falls behind so
+ *		    far that the pool is empty, rows are dropped and counted instead of waiting.
+ *		  - close() hands over the last, partial chunk; the writer completes the file and writes
+ *		    summaries, with errors as scored by the ScoringEngine given to it. Only the rows since
+ *		    the last full chunk are left to write at that point, so closing doesn't depend on the
+ *		    length of the session. waitClosed() bounds the wait.
+ *		  append() and close() are called by one thread at a time, waitClosed() by any.
+ *		  If files can't be created, the recorder is disabled and rows are ignored.
+ */
+class SessionRecorder {
+public:
+
+  static constexpr std::uint32_t FILE_MAGIC = 0x52535044;      // "DPSR"
+  static constexpr std::uint32_t ROW_GROUP_MAGIC = 0x47525044; // "DPRG"
+  static constexpr std::uint32_t FOOTER_MAGIC = 0x45535044;    // "DPSE"
+  static constexpr std::uint16_t FILE_VERSION = 1;
+  static constexpr std::size_t COLUMN_NAME_SIZE = 16;
+  static constexpr std::size_t CHUNK_ROWS_NUM = 8192;
+  static constexpr std::size_t CHUNKS_NUM = 16;                // 68 B a row, ~9 MB preallocated
+  static constexpr std::size_t MAX_VEHICLES_NUM = 256;
+
+  /**
+   * @brief Flags of a row.
+   */
+  static constexpr std::uint8_t FLAG_INSIDE_OBSTACLE = 0x01;
+  static constexpr std::uint8_t FLAG_COLLISION = 0x02;       // first position inside an obstacle
+  static constexpr std::uint8_t FLAG_WAYPOINT_CAPTURED = 0x04;
+  static constexpr std::uint8_t FLAG_BEARING_COMPLIANT = 0x08;
+  static constexpr std::uint8_t FLAG_TIME_SYNCED = 0x10;     // host time is valid
+
+  enum class ColumnType : std::uint8_t { U8 = 0, U16 = 1, U32 = 2, I64 = 3, F32 = 4 };
+
+  struct Column {
+    const char *name;
+    ColumnType type;
+  };
+
+  /**
+   * @brief Columns of the session file, in order.
+   */
+  static constexpr std::array<Column, 17> COLUMNS = {{
+      {"host_time_ns", ColumnType::I64},
+      {"time_boot_ms", ColumnType::U32},
+      {"vehicle_id", ColumnType::U8},
+      {"flags", ColumnType::U8},
+      {"east", ColumnType::F32},
+      {"north", ColumnType::F32},
+      {"up", ColumnType::F32},
+      {"roll", ColumnType::F32},
+      {"pitch", ColumnType::F32},
+      {"yaw", ColumnType::F32},
+      {"distance_error", ColumnType::F32},
+      {"altitude_error", ColumnType::F32},
+      {"speed_error", ColumnType::F32},
+      {"segment_idx", ColumnType::U32},
+      {"progress", ColumnType::F32},
+      {"clearance", ColumnType::F32},
+      {"waypoint_idx", ColumnType::U16},
+  }};
+
+  /**
+   * @brief Results of a scored position. Errors and progress are NaN without a guideline,
+   *        clearance without obstacles.
+   */
+  struct Row {
+    std::int64_t hostTimeNs{0};
+    std::uint32_t timeBootMs{0};
+    std::uint8_t vehicleId{0};
+    std::uint8_t flags{0};
+    float east{0.0f};
+    float north{0.0f};
+    float up{0.0f};
+    float roll{0.0f};
+    float pitch{0.0f};
+    float yaw{0.0f};
+    float distanceError{std::numeric_limits<float>::quiet_NaN()};
+    float altitudeError{std::numeric_limits<float>::quiet_NaN()};
+    float speedError{std::numeric_limits<float>::quiet_NaN()};
+    std::uint32_t segmentIdx{0};
+    float progress{std::numeric_limits<float>::quiet_NaN()};
+    float clearance{std::numeric_limits<float>::quiet_NaN()};
+    std::uint16_t waypointIdx{0};
+  };
+
+  /**
+   * @brief Constructor. Creates the directory and the session file, starts the writer.
+   * @param basePath: path of session files without the extension; <basePath>.dps,
+   *		  <basePath>_summary.csv and <basePath>_summary.json are written.
+   * @param isVerbose: logs verbosity flag.
+   */
+  explicit SessionRecorder(const std::filesystem::path &basePath, bool isVerbose=false);
+
+  /**
+   * @brief Destructor. Stops the writer, rows not yet written are lost.
+   */
+  ~SessionRecorder();
+
+  SessionRecorder(const SessionRecorder &) = delete;
+  SessionRecorder &operator=(const SessionRecorder &) = delete;
+
+  /**
+   * @brief Record a row. Never waits for the writer.
+   */
+  void append(const Row &row);
+
+  /**
+   * @brief Stop recording and have the writer complete the files. Next calls do nothing.
+   * @param scoring: scores of the session, copied for the summaries. Without it, summaries
+   *		  leave errors out.
+   */
+  void close(const ScoringEngine *scoring=nullptr);
+
+  /**
+   * @brief Wait for the files to be completed after close().
+   * @param timeout: longest wait.
+   * @return True, if files are complete or the recorder is disabled.
+   */
+  bool waitClosed(std::chrono::milliseconds timeout);
+
+  bool isEnabled() const { return m_isEnabled; }
+  const std::filesystem::path &getPath() const { return m_path; }
+  std::uint64_t getRowsNum() const { return m_rowsNum; }
+  std::uint64_t getDroppedNum() const { return m_droppedNum; }
+
+private:
+
+  /**
+   * @brief Rows of a row group, one array per column.
+   */
+  struct Chunk {
+    std::size_t rowsNum{0};
+    std::array<std::int64_t, CHUNK_ROWS_NUM> hostTimeNs;
+    std::array<std::uint32_t, CHUNK_ROWS_NUM> timeBootMs;
+    std::array<std::uint8_t, CHUNK_ROWS_NUM> vehicleId;
+    std::array<std::uint8_t, CHUNK_ROWS_NUM> flags;
+    std::array<float, CHUNK_ROWS_NUM> east;
+    std::array<float, CHUNK_ROWS_NUM> north;
+    std::array<float, CHUNK_ROWS_NUM> up;
+    std::array<float, CHUNK_ROWS_NUM> roll;
+    std::array<float, CHUNK_ROWS_NUM> pitch;
+    std::array<float, CHUNK_ROWS_NUM> yaw;
+    std::array<float, CHUNK_ROWS_NUM> distanceError;
+    std::array<float, CHUNK_ROWS_NUM> altitudeError;
+    std::array<float, CHUNK_ROWS_NUM> speedError;
+    std::array<std::uint32_t, CHUNK_ROWS_NUM> segmentIdx;
+    std::array<float, CHUNK_ROWS_NUM> progress;
+    std::array<float, CHUNK_ROWS_NUM> clearance;
+    std::array<std::uint16_t, CHUNK_ROWS_NUM> waypointIdx;
+  };
+
+  /**
+   * @brief Summary of a vehicle, updated by the writer.
+   */
+  struct VehicleSummary {
+    std::uint64_t rowsNum{0};
+    std::uint32_t firstTimeBootMs{0};
+    std::uint32_t lastTimeBootMs{0};
+    double progress{0.0};                 // at the last scored row, m
+    std::uint32_t capturedNum{0};
+    std::uint32_t compliantNum{0};
+    std::uint32_t collisionsNum{0};
+    std::uint64_t insideNum{0};
+    double minClearance{std::numeric_limits<double>::infinity()};
+  };
+
+  /**
+   * @brief Hand the current chunk to the writer and take a free one, if any.
+   */
+  void handOver_();
+
+  /**
+   * @brief Write chunks as they are handed over, then complete the files.
+   */
+  void writeLoop_(std::stop_token stopToken);
+
+  void writeHeader_();
+  void writeChunk_(const Chunk &chunk);
+  void writeFooter_();
+  void summarise_(const Chunk &chunk);
+  void writeSummaries_() const;
+
+  /****************************************************
+  * Files
+  *****************************************************/
+  const std::filesystem::path m_basePath;
+  std::filesystem::path m_path;
+  std::ofstream m_file;
+  bool m_isEnabled{false};
+  std::uint32_t m_rowGroupsNum{0};
+  std::uint64_t m_writtenNum{0};
+
+  /****************************************************
+  * Chunks
+  *****************************************************/
+  std::vector<std::unique_ptr<Chunk>> m_chunks;
+  Chunk *m_current{nullptr};           // owned by the appending thread
+  std::vector<Chunk *> m_free;
+  std::deque<Chunk *> m_full;
+  std::atomic<std::uint64_t> m_rowsNum{0};
+  std::atomic<std::uint64_t> m_droppedNum{0};
+  bool m_isClosing{false};             // set by close(), guarded by m_chunksMtx
+  bool m_isAppendClosed{false};        // seen by the appending thread only
+
+  /****************************************************
+  * Summaries
+  *****************************************************/
+  std::array<VehicleSummary, MAX_VEHICLES_NUM> m_summaries{};
+  std::optional<ScoringEngine> m_scoring; // set by close(), read by the writer after it
+
+  /****************************************************
+  * Threading
+  *****************************************************/
+  std::mutex m_chunksMtx;
+  std::condition_variable_any m_chunksCv;
+  bool m_isClosed{false};              // guarded by m_chunksMtx
+  std::condition_variable m_closedCv;
+  std::jthread m_writerThread;
+
+  /****************************************************
+  * Logging
+  *****************************************************/
+  bool m_verbose;
+};
@@ -0,0 +1,162 @@
+/**
+ * @file SpscRingBuffer.h
+ * @brief Lock-free single-producer single-consumer ring buffer.
+ *
+ * @details This file contains the definition of a bounded ring buffer template used to hand data
+ *          over between two threads without locks, e.g. from the serial I/O stage to the parser.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+
+/**
+ * @class SpscRingBuffer
+ * @brief Bounded ring buffer for exactly one producer and one consumer thread.
+ *		  Head is written only by the producer and tail only by the consumer, each on its own
+ *		  cache line, so both sides progress without locks. The producer never blocks- elements
+ *		  which don't fit are dropped and counted as overflow. The consumer may sleep in
+ *		  SpscRingBuffer::waitForData until the producer calls SpscRingBuffer::wake after a push,
+ *		  or once after several. Producers with a signal of their own don't need to wake it.
+ * @tparam T: trivially copyable element type.
+ * @tparam Capacity: number of elements, has to be a power of two.
+ */
+template <typename T, std::size_t Capacity>
+class SpscRingBuffer {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity of SpscRingBuffer has to be a power of two");
+
+public:
+
+  static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+  /**
+   * @brief Push elements. Called only by the producer thread.
+   * @param data: source of elements.
+   * @param count: number of elements to push.
+   * @return Number of pushed elements, the rest is counted as overflow.
+   */
+  std::size_t push(const T *data, std::size_t count) {
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    const std::size_t tail = m_tail.load(std::memory_order_acquire);
+    const std::size_t depth = head - tail;
+    const std::size_t pushedNum = std::min(count, Capacity - depth);
+
+    for (std::size_t idx = 0; idx < pushedNum; ++idx) {
+      m_buffer[(head + idx) & MASK] = data[idx];
+    }
+    m_head.store(head + pushedNum, std::memory_order_release);
+
+    if (pushedNum < count) {
+      m_overflowNum.fetch_add(count - pushedNum, std::memory_order_relaxed);
+    }
+    if (depth + pushedNum > m_maxDepth.load(std::memory_order_relaxed)) {
+      m_maxDepth.store(depth + pushedNum, std::memory_order_relaxed);
+    }
+    return pushedNum;
+  }
+
+  /**
+   * @brief Pop elements. Called only by the consumer thread.
+   * @param data: destination of elements.
+   * @param maxCount: capacity of the destination.
+   * @return Number of popped elements.
+   */
+  std::size_t pop(T *data, std::size_t maxCount) {
+    const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    const std::size_t head = m_head.load(std::memory_order_acquire);
+    const std::size_t poppedNum = std::min(maxCount, head - tail);
+
+    for (std::size_t idx = 0; idx < poppedNum; ++idx) {
+      data[idx] = m_buffer[(tail + idx) & MASK];
+    }
+    m_tail.store(tail + poppedNum, std::memory_order_release);
+    return poppedNum;
+  }
+
+  /**
+   * @brief Block the consumer unless the buffer isn't empty, until SpscRingBuffer::wake is called.
+   */
+  void waitForData() const {
+    waitForData(getSignal());
+  }
+
+  /**
+   * @brief Block the consumer unless the buffer isn't empty, until the signal changed since it
+   *        was read, so a SpscRingBuffer::wake after reading it isn't missed.
+   * @param signal: read with SpscRingBuffer::getSignal before checking the stop condition.
+   */
+  void waitForData(std::uint32_t signal) const {
+    if (size() == 0) {
+      m_signal.wait(signal, std::memory_order_acquire);
+    }
+  }
+
+  /**
+   * @brief Get the signal changed by every SpscRingBuffer::wake.
+   */
+  std::uint32_t getSignal() const {
+    return m_signal.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Wake the consumer waiting in SpscRingBuffer::waitForData, after a push or to let it stop.
+   */
+  void wake() {
+    m_signal.fetch_add(1, std::memory_order_release);
+    m_signal.notify_one();
+  }
+
+  /**
+   * @brief Get the current number of elements.
+   */
+  std::size_t size() const {
+    return m_head.load(std::memory_order_acquire) -
+           m_tail.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Get the capacity.
+   */
+  static constexpr std::size_t capacity() { return Capacity; }
+
+  /**
+   * @brief Get the highest number of elements observed by the producer.
+   */
+  std::size_t getMaxDepth() const {
+    return m_maxDepth.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get the number of elements dropped, because the buffer was full.
+   */
+  std::uint64_t getOverflowNum() const {
+    return m_overflowNum.load(std::memory_order_relaxed);
+  }
+
+private:
+
+  static constexpr std::size_t MASK = Capacity - 1;
+
+  // Indexes grow monotonically, position in the buffer is index & MASK
+  alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_head{0}; // written by the producer
+  alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail{0}; // written by the consumer
+  alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> m_signal{0};
+  std::atomic<std::size_t> m_maxDepth{0};
+  std::atomic<std::uint64_t> m_overflowNum{0};
+  alignas(CACHE_LINE_SIZE) std::array<T, Capacity> m_buffer{};
+};
@@ -0,0 +1,145 @@
+/**
+ * @file StreamRateController.h
+ * @brief Adaptive controller of MAVLink stream rates.
+ *
+ * @details This file contains the declaration of StreamRateController- object which fits
+ *          rates of requested MAVLink streams into the throughput budget of the serial link.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "Events.h"
+
+
+/**
+ * @enum StreamPriority.
+ * @brief Priority of a stream when the link budget is distributed.
+ */
+enum class StreamPriority {
+  POSE,        // served first: attitude, position, velocity
+  HOUSEKEEPING // served with what's left: HUD, IMU diagnostics, heartbeat
+};
+
+/**
+ * @brief Structure describing a controlled MAVLink stream.
+ */
+struct StreamConfig {
+  std::uint16_t messageId;
+  StreamPriority priority;
+  std::uint16_t frameBytes; // bytes on the wire per message, including MAVLink framing
+  float minRateHz;
+  float maxRateHz;
+};
+
+/**
+ * @class StreamRateController
+ * @brief Class estimating the available link throughput and distributing it among streams.
+ *		  Budget follows additive-increase/multiplicative-decrease: it grows while the link
+ *		  delivers what was requested without loss and backs off when loss is observed.
+ *		  Every stream is granted its minimum rate, pose streams are then raised towards their
+ *		  maximum rate and housekeeping streams get the rest. A new interval is reissued only
+ *		  when the rate changed more than RATE_HYSTERESIS.
+ */
+class StreamRateController {
+public:
+
+  static constexpr float TARGET_UTILISATION = 0.7f;  // of the raw serial capacity
+  static constexpr float LOSS_BACKOFF_RATE = 0.05f;  // loss above which the budget backs off
+  static constexpr float BACKOFF_FACTOR = 0.7f;
+  static constexpr float INCREASE_STEP = 0.05f;      // of the raw serial capacity per update
+  static constexpr float RATE_HYSTERESIS = 0.1f;     // relative change needed to reissue a stream
+
+  /**
+   * @brief Constructor.
+   * @param baudRate: serial link baud rate (8N1 framing is assumed).
+   * @param isVerbose: logs verbosity flag.
+   */
+  explicit StreamRateController(std::uint32_t baudRate, bool isVerbose = false);
+  ~StreamRateController() = default;
+
+  /**
+   * @brief Register a stream. Streams must be added before the first StreamRateController::update.
+   * @param config: stream description.
+   * @return Index of the stream.
+   */
+  std::size_t addStream(const StreamConfig &config);
+
+  /**
+   * @brief Distribute the current budget among streams without looking at link statistics.
+   *		Used to compute initial rates.
+   * @return Indexes of streams which rate has to be reissued.
+   */
+  const std::vector<std::size_t> &allocate();
+
+  /**
+   * @brief Update the budget with observed link statistics and redistribute it.
+   * @param quality: latest link statistics.
+   * @return Indexes of streams which rate has to be reissued.
+   */
+  const std::vector<std::size_t> &update(const LinkQuality &quality);
+
+  /**
+   * @brief Get the number of registered streams.
+   */
+  std::size_t getStreamsNum() const;
+
+  /**
+   * @brief Get the configuration of the stream.
+   * @param idx: index of the stream.
+   */
+  const StreamConfig &getStream(const std::size_t idx) const;
+
+  /**
+   * @brief Get the interval which has to be requested for the stream.
+   * @param idx: index of the stream.
+   * @return Interval in microseconds.
+   */
+  std::uint32_t getIntervalUs(const std::size_t idx) const;
+
+  /**
+   * @brief Get the current budget.
+   * @return Budget in bytes per second.
+   */
+  float getBudget() const;
+
+private:
+
+  /**
+   * @brief Raise streams of the given priority from their minimum towards their maximum rate
+   *		with the same fraction for all of them.
+   * @param priority: priority of streams to raise.
+   * @param budget: bytes per second available for the raise.
+   * @return Bytes per second left after the raise.
+   */
+  float raise_(const StreamPriority priority, const float budget);
+
+  struct Stream {
+    StreamConfig config;
+    float rateHz{0.0f};          // rate computed by the last allocation
+    float requestedRateHz{0.0f}; // rate which has been sent to the UAV
+  };
+
+  std::vector<Stream> m_streams;
+  std::vector<std::size_t> m_changed;
+
+  const float m_capacity; // raw link capacity in bytes per second
+  float m_budget;
+
+  /****************************************************
+  * Logging
+  *****************************************************/
+  bool m_verbose;
+};
@@ -0,0 +1,85 @@
+/**
+ * @file TelemetryDecoder.h
+ * @brief Decoding of MAVLink messages into the aggregated telemetry sample.
+ *
+ * @details This file contains the declaration of TelemetryDecoder- the part of the parse/publish
+ *          stage of TelemetryReceiver which doesn't touch the serial port, so it builds on any host
+ *          and can be benchmarked over recorded bytes.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <common/mavlink.h>
+
+#include "ClockSync.h"
+#include "TelemetrySample.h"
+
+
+/**
+ * @class TelemetryDecoder
+ * @brief Class decoding MAVLink messages of one vehicle. Every stream only updates its fields of
+ *		  the aggregated sample, which is complete once per PUBLISH_TRIGGER_MSG_ID. TIMESYNC and
+ *		  SYSTEM_TIME feed ClockSync, which maps capture times of the streams to host time.
+ *		  Messages needing an answer are handed back to the caller, which owns the links.
+ *		  Not thread-safe- used only by the parse/publish stage of the receiver.
+ */
+class TelemetryDecoder {
+public:
+
+  static constexpr std::uint32_t PUBLISH_TRIGGER_MSG_ID = MAVLINK_MSG_ID_ATTITUDE;
+
+  /**
+   * @brief What the caller has to do after a message.
+   */
+  enum class Action {
+    NONE,
+    PUBLISH,        // the sample is complete
+    REPLY_TIMESYNC, // the autopilot requests TIMESYNC, Result::timesyncTs1 is to be echoed
+    INTERVAL_ACK    // SET_MESSAGE_INTERVAL has been answered with Result::ackResult
+  };
+
+  struct Result {
+    Action action{Action::NONE};
+    std::int64_t timesyncTs1{0};
+    std::uint8_t ackResult{0};    // MAV_RESULT
+  };
+
+  /**
+   * @brief Decode a complete MAVLink frame into the aggregated sample.
+   * @param message: parsed frame.
+   * @param arrivalNs: host time the frame has been received.
+   * @return Action for the caller.
+   */
+  Result decode(const mavlink_message_t &message, std::int64_t arrivalNs);
+
+  /**
+   * @brief Get the aggregated sample. The caller clears updatedFields after publishing it.
+   */
+  TelemetrySample &getSample() { return m_sample; }
+
+  const ClockSync &getClockSync() const { return m_clockSync; }
+
+private:
+
+  /**
+   * @brief Map the autopilot capture time of a message to host time.
+   * @param bootNs: autopilot boot time of the capture in nanoseconds.
+   * @param arrivalNs: host time the message has been received, used until clocks are synchronised.
+   * @return Host steady clock time in nanoseconds.
+   */
+  std::int64_t toCaptureHostNs_(std::int64_t bootNs, std::int64_t arrivalNs) const;
+
+  TelemetrySample m_sample;
+  ClockSync m_clockSync;
+};
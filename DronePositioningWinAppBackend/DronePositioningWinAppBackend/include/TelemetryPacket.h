@@ -0,0 +1,116 @@
+/**
+ * @file TelemetryPacket.h
+ * @brief Wire formats of telemetry sent to the visualisation platform.
+ *
+ * @details This file contains the layout of the versioned binary telemetry packet and
+ *          declarations of functions serialising TelemetrySample into binary or legacy text format.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "Events.h"
+#include "TelemetrySample.h"
+
+
+namespace wire {
+
+/**
+ * @brief Layout of the binary packet, version 1. All fields are little-endian.
+ *
+ *	offset type  field
+ *	---- header ----
+ *	 0     u16   magic (0x5044, bytes "DP")
+ *	 2     u8    version
+ *	 3     u8    vehicle id (MAVLink system id)
+ *	 4     u32   sequence number, wraps around
+ *	 8     i64   timestamp: host steady clock ns at which the autopilot captured attitude
+ *	---- body ----
+ *	16     u16   valid fields (TelemetrySample::Field flags)
+ *	18     u8    flags (FLAG_TIME_SYNCED, FLAG_LOCAL_FRAME, FLAG_PREDICTED)
+ *	19     u8    reserved, 0
+ *	20     f32   roll, rad
+ *	24     f32   pitch, rad
+ *	28     f32   yaw, rad
+ *	32     i32   latitude, degE7 | with FLAG_LOCAL_FRAME: east, mm
+ *	36     i32   longitude, degE7 | north, mm
+ *	40     i32   altitude above MSL, mm | up, mm
+ *	44     i32   altitude above home, mm
+ *	48     f32   velocity north, m/s
+ *	52     f32   velocity east, m/s
+ *	56     f32   velocity down, m/s
+ *	60     u32   capture age at sending, us
+ */
+inline constexpr std::uint16_t MAGIC = 0x5044;
+inline constexpr std::uint8_t VERSION = 1;
+inline constexpr std::size_t HEADER_SIZE = 16;
+inline constexpr std::size_t BINARY_PACKET_SIZE = 64;
+inline constexpr std::uint8_t FLAG_TIME_SYNCED = 1u << 0;
+inline constexpr std::uint8_t FLAG_LOCAL_FRAME = 1u << 1;   // position in metres of LocalFrame
+inline constexpr std::uint8_t FLAG_PREDICTED = 1u << 2;     // pose extrapolated to the timestamp
+
+/**
+ * @brief Layout of the progress packet, sent once per waypoint progress transition in its own
+ *		  datagram, whatever the wire format. All fields are little-endian.
+ *
+ *	offset type  field
+ *	 0     u16   magic (0x5744, bytes "DW")
+ *	 2     u8    version
+ *	 3     u8    vehicle id (MAVLink system id)
+ *	 4     u8    state (WaypointState: 0 approaching, 1 hovering, 2 completed)
+ *	 5     u8    flags (PROGRESS_FLAG_CAPTURED, PROGRESS_FLAG_BEARING_COMPLIANT)
+ *	 6     u16   waypoint index, approached or hovered at
+ *	 8     u16   waypoints number
+ *	10     u16   reserved, 0
+ *	12     u32   autopilot time of the transition, ms since boot
+ *	16     f32   distance to the waypoint, m
+ */
+inline constexpr std::uint16_t PROGRESS_MAGIC = 0x5744;
+inline constexpr std::size_t PROGRESS_PACKET_SIZE = 20;
+inline constexpr std::uint8_t PROGRESS_FLAG_CAPTURED = 1u << 0;           // the previous waypoint was captured
+inline constexpr std::uint8_t PROGRESS_FLAG_BEARING_COMPLIANT = 1u << 1;  // at the target bearing when captured
+
+// Six "%f " values of at most 16 characters for coordinates and angles, plus the legacy NUL
+inline constexpr std::size_t MAX_TEXT_PACKET_SIZE = 128;
+
+/**
+ * @brief Serialise the sample into the binary packet.
+ * @param telemetry: sample to serialise.
+ * @param sequence: sequence number of the packet.
+ * @param sendTimeNs: host steady clock time of sending, used for the capture age.
+ * @param buffer: destination of at least BINARY_PACKET_SIZE bytes.
+ * @return Number of written bytes.
+ */
+std::size_t serializeBinary(const TelemetrySample &telemetry, std::uint32_t sequence,
+                            std::int64_t sendTimeNs, std::uint8_t *buffer);
+
+/**
+ * @brief Serialise the sample into the legacy text format: "roll pitch yaw lat lon alt " with
+ *		  std::to_string formatting and a terminating NUL, which existing clients expect.
+ *		  A sample in the local frame is sent as "roll pitch yaw east north up " in metres.
+ * @param telemetry: sample to serialise.
+ * @param buffer: destination of at least MAX_TEXT_PACKET_SIZE bytes.
+ * @return Number of written bytes, including the NUL.
+ */
+std::size_t serializeText(const TelemetrySample &telemetry, char *buffer);
+
+/**
+ * @brief Serialise a waypoint progress transition into the progress packet.
+ * @param progress: progress to serialise.
+ * @param buffer: destination of at least PROGRESS_PACKET_SIZE bytes.
+ * @return Number of written bytes.
+ */
+std::size_t serializeProgress(const WaypointProgress &progress, std::uint8_t *buffer);
+
+} // namespace wire
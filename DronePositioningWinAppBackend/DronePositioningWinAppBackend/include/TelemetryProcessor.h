@@ -1,63 +1,251 @@
-/**
- * @file TelemetryProcessor.h
- * @brief Concrete implementation of IProcessor interface.
- *
- * @details This file contains the declaration of a concrete telemetry processing entity.
- *
- * @author Szymon Bogus
- * @date 2024-05-22
- *
- * @copyright Copyright 2024 Szymon Bogus
- * @license Apache License, Version 2.0 (see
- * https://www.apache.org/licenses/LICENSE-2.0)
- *
- * @version 1.0
- */
-
-#pragma once
-
-#include <iostream>
-
-#include "base/IProcessor.h"
-#include "base/ISubscriber.h"
-
-
-/**
- * @class TelemetryProcessor
- * @brief Class representing specific telemetry processor implementation.
- *		  This class implements both ISubscriber and IProcessor interfaces
- *		  in order to be able to process data and subscriber to events via EventsBus
- */
-class TelemetryProcessor : public ISubscriber, public IProcessor {
-public:
-
-  /**
-   * @brief Constructor.
-   * @param isVerbose: logs verbosity flag. 
-   */
-  explicit TelemetryProcessor(bool isVerbose=false);
-
-private:
-  /**
-  * @brief Process telemetry.
-  * @param telemetry: new telemetry to process.
-  */
-  void process_(const std::vector<float> &telemetry) override final;
-
-  /**
-  * @brief Generate report.
-  */
-  void generateReport_() override final;
-
-  /**
-  * @brief Handle new telemetry.
-  * @param event: new telemetry data.
-  */
-  void onEvent_(const TelemetryEvent &event) override final;
-
-  /****************************************************
-  * Logging
-  *****************************************************/
-  bool m_verbose;
-};
-
+/**
+ * @file TelemetryProcessor.h
+ * @brief Concrete implementation of IProcessor interface.
+ *
+ * @details This file contains the declaration of a concrete telemetry processing entity.
+ *
+ * @author Szymon Bogus
+ * @date 2024-05-22
+ *
+ * @copyright Copyright 2024 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+#include "base/IProcessor.h"
+#include "base/ISubscriber.h"
+#include "base/IPublisher.h"
+#include "EventsBus.h"
+#include "FlightConfig.h"
+#include "GuidelineTracker.h"
+#include "LocalFrame.h"
+#include "ObstacleIndex.h"
+#include "PipelineStage.h"
+#include "ScoringEngine.h"
+#include "SessionRecorder.h"
+#include "WaypointProgression.h"
+
+
+/**
+ * @class TelemetryProcessor
+ * @brief Class representing specific telemetry processor implementation.
+ *		  This class implements both ISubscriber and IProcessor interfaces
+ *		  in order to be able to process data and subscriber to events via EventsBus.
+ *		  Every new position of a vehicle is converted into the local frame of the exercise.
+ *		  It is scored against the guideline, the polyline through waypoints raised by the
+ *		  guideline offset, which is tracked incrementally per vehicle.
+ *		  It is also checked against obstacles; collisions and the smallest clearance are
+ *		  counted per vehicle.
+ *		  Waypoint captures are decided by WaypointProgression, and its transitions are
+ *		  published as ProgressEvent on PROGRESS_UPDATE.
+ *		  Results of every position are recorded by SessionRecorder, whose files are completed
+ *		  at AppTerminationEvent or the report, whichever comes first, waiting at most
+ *		  SESSION_CLOSE_TIMEOUT.
+ *		  Processing of a position is split into stages: transform into the local frame, score
+ *		  against the guideline and waypoints, check collisions and report (record and publish).
+ *		  - INLINE runs the stages one after another on the calling thread. Bus callbacks run on
+ *		    several threads, so they are serialised by a mutex.
+ *		  - PIPELINED runs every stage on its own thread, optionally pinned to a core, connected
+ *		    by lock-free PipelineStage queues. Callbacks only push positions into the queue of the
+ *		    first stage, and a stage is only held up by the ones ahead of it, so a heavier
+ *		    analysis added at the end doesn't delay scoring. Every stage owns the state it
+ *		    updates; the pipeline is drained and stopped before the report reads it.
+ */
+class TelemetryProcessor : public ISubscriber, public IProcessor {
+public:
+
+  static constexpr std::chrono::milliseconds SESSION_CLOSE_TIMEOUT{500};
+  static constexpr std::size_t STAGES_NUM = 4;
+  static constexpr std::size_t STAGE_QUEUE_CAPACITY = 1024;         // positions, ~3 s of 6 vehicles at 50 Hz
+  static constexpr std::size_t STAGE_BATCH_SIZE = LocalFrame::BLOCK_SIZE;
+  static constexpr std::array<const char *, STAGES_NUM> STAGE_NAMES = {"transform", "score", "collide",
+                                                                       "report"};
+
+  enum class ProcessingMode { INLINE, PIPELINED };
+
+  /**
+   * @brief Position passed between stages, filled in by every stage.
+   */
+  struct StageItem {
+    TelemetrySample telemetry;
+    double east{0.0};
+    double north{0.0};
+    double up{0.0};
+    SessionRecorder::Row row;
+    WaypointProgress progress;
+    bool isTransition{false};
+    std::int64_t entryNs{0};    // into the first stage
+    std::int64_t enqueueNs{0};  // into the current stage
+  };
+
+  using Stage = PipelineStage<StageItem, STAGE_QUEUE_CAPACITY, STAGE_BATCH_SIZE>;
+
+  /**
+   * @brief Constructor.
+   * @param bus: bus progress events are published to.
+   * @param flightConfig: exercise to score.
+   * @param sessionPath: path of session files without the extension, empty not to record.
+   * @param mode: whether stages run inline or on their own threads, pinned to processingCores
+   *		  of the connection configuration, which has to list STAGES_NUM cores, if any.
+   * @param isVerbose: logs verbosity flag. 
+   */
+  TelemetryProcessor(EventsBus &bus, const configuration::FlightConfig &flightConfig,
+                     const std::filesystem::path &sessionPath = {},
+                     ProcessingMode mode = ProcessingMode::INLINE, bool isVerbose=false);
+
+  /**
+   * @brief Destructor. Drains and stops the pipeline.
+   */
+  ~TelemetryProcessor();
+
+  /**
+   * @brief Get the occupancy and latency of a stage, PIPELINED only.
+   * @param stageIdx: index of the stage, in STAGE_NAMES order.
+   */
+  Stage::Metrics getStageMetrics(std::size_t stageIdx) const;
+
+  /**
+   * @brief Get latencies from entering the first stage to reported, PIPELINED only.
+   */
+  const LatencyHistogram &getPipelineLatency() const { return m_pipelineLatency; }
+
+  /**
+   * @brief Get the score of a vehicle. In PIPELINED mode, complete after the report.
+   */
+  ScoringEngine::Score getScore(std::uint8_t vehicleId);
+
+private:
+  /**
+  * @brief Process telemetry.
+  * @param telemetry: new telemetry to process.
+  */
+  void process_(const TelemetrySample &telemetry) override final;
+
+  /**
+  * @brief Generate report.
+  */
+  void generateReport_() override final;
+
+  /**
+  * @brief Handle new telemetry.
+  * @param event: new telemetry data.
+  */
+  void onEvent_(const TelemetryEvent &event) override final;
+
+  /**
+  * @brief Complete the session files before the application terminates.
+  * @param event: termination of the application.
+  */
+  void onEvent_(const AppTerminationEvent &event) override final;
+
+  /**
+  * @brief Stop recording and wait for the session files, at most SESSION_CLOSE_TIMEOUT.
+  *		  The pipeline is stopped first, so every position it took is recorded.
+  */
+  void closeSession_();
+
+  /**
+  * @brief Stop taking positions, process the ones in queues and stop the stages in order.
+  *		  Next calls wait until the pipeline is stopped.
+  */
+  void stopPipeline_();
+
+  /**
+  * @brief Convert positions into the local frame, batched.
+  */
+  void transform_(StageItem *items, std::size_t count) const;
+
+  /**
+  * @brief Update waypoint progression and score positions against the guideline.
+  */
+  void score_(StageItem *items, std::size_t count);
+
+  /**
+  * @brief Check positions against obstacles.
+  */
+  void collide_(StageItem *items, std::size_t count);
+
+  /**
+  * @brief Record positions and publish waypoint transitions.
+  */
+  void report_(StageItem *items, std::size_t count);
+
+  /**
+  * @brief Publish a waypoint transition as ProgressEvent.
+  */
+  void publishProgress_(const WaypointProgress &progress);
+
+  /**
+  * @brief Errors of a position against the guideline and the target speed.
+  * @param projection: position projected onto the guideline.
+  */
+  ScoringEngine::Errors computeErrors_(const GuidelineTracker::Projection &projection,
+                                       const TelemetrySample &telemetry) const;
+
+  /****************************************************
+  * Exercise
+  *****************************************************/
+  const LocalFrame m_localFrame;
+  const GuidelineTracker m_guideline;
+  const double m_targetSpeed;
+  const ObstacleIndex m_obstacles;
+
+  /****************************************************
+  * Scoring
+  *****************************************************/
+  struct ObstacleStats {
+    bool isInside{false};
+    std::uint32_t collisionsNum{0};      // entries into obstacles
+    std::uint64_t positionsInsideNum{0};
+    double minClearance{std::numeric_limits<double>::infinity()}; // m, negative is the deepest penetration
+    std::size_t closestObstacleId{0};
+  };
+
+  struct GuidelineState {
+    GuidelineTracker::Cursor cursor;
+    double progress{0.0};   // along the guideline at the last position, m
+  };
+
+  std::mutex m_scoringMtx;
+  ScoringEngine m_scoring;
+  WaypointProgression m_progression;
+  std::array<GuidelineState, ScoringEngine::MAX_VEHICLES_NUM> m_guidelineStates{};
+  std::array<ObstacleStats, ScoringEngine::MAX_VEHICLES_NUM> m_obstacleStats{};
+
+  /****************************************************
+  * Recording
+  *****************************************************/
+  std::unique_ptr<SessionRecorder> m_session; // null when not recording
+
+  /****************************************************
+  * Pipeline
+  *****************************************************/
+  std::mutex m_entryMtx;                       // producers of the first stage
+  bool m_isStopped{false};                     // guarded by m_entryMtx
+  std::mutex m_stopMtx;
+  LatencyHistogram m_pipelineLatency;          // added to by the report stage
+  std::unique_ptr<std::array<Stage, STAGES_NUM>> m_stages; // null when INLINE
+
+  /****************************************************
+  * Logging
+  *****************************************************/
+  bool m_verbose;
+
+  /****************************************************
+  * Publishing
+  *****************************************************/
+  IPublisher *m_publisher;
+};
+
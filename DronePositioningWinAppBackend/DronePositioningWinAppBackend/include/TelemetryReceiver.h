@@ -1,94 +1,246 @@
-/**
- * @file TelemetryReceiver.h
- * @brief Concrete implementation of ITelemetryReceiver interface which uses mavlink for communication with UAV.
- *
- * @details This file contains the declaration of a concrete telemtry receiver implementation.
- *
- * @author Szymon Bogus
- * @date 2024-05-22
- *
- * @copyright Copyright 2024 Szymon Bogus
- * @license Apache License, Version 2.0 (see
- * https://www.apache.org/licenses/LICENSE-2.0)
- *
- * @version 1.0
- */
-
-#pragma once
-
-#include <vector>
-#include <thread>
-#include <memory>
-#include <atomic>
-#include <math.h>
-#include <chrono>
-#include <iostream>
-
-#include <common/mavlink.h>
-// #include <cubepilot/mavlink.h> // Even though it is a more specific dialetc of mavlink
-                                  // it doesnt improve the performance
-
-#include "base/ITelemetryReceiver.h"
-#include "EventsBus.h"
-
-
-/**
- * @class TelemetryReceiver
- * @brief Telemetry receiver implementation.
- */
-class TelemetryReceiver : public ITelemetryReceiver {
-public:
-
-	/**
-	 * @brief Constructor.
-	 * @param bus: EventsBus reference in order to access publisher
-	 * @param isVerbose: logs verbosity flag.
-	 */
-	explicit TelemetryReceiver(EventsBus &bus, const std::string& portCom, bool isVerbose=false); 
-	~TelemetryReceiver();
-
-
-private:
-
-   /**
-   * @brief Begin receiving telemetry.
-   */
-   void receive_() override final;
-
-    /**
-    * @brief Stop receiving telemetry.
-    */
-    void stop_() override final;
-
-	/**
-    * @brief Register received telemetry to the EventBus.
-    */
-	void registerTelemetryEvent_() override final;
-
-    /****************************************************
-    * UAV connection specification
-    ****************************************************/
-    const std::string m_portCom;
-    HANDLE m_comSerial;
-    DCB m_dcbSerialParams;
-
-    /****************************************************
-    * Logging
-    *****************************************************/
-    bool m_verbose;
-
-	/****************************************************
-    * Publishing
-    *****************************************************/
-	IPublisher *m_publisher;
-    std::vector<float> m_currTelemetry;
-
-	/****************************************************
-    * Synchronization
-    *****************************************************/
-    std::atomic_bool m_running; // Flag which indicates if receiver loop should run.
-                                // It's set to be atomic_bool in order to be securely 
-                                // - set by TelemetryReceiver::stop
-                                // - checked by TelemetryReceiver::receive which runs on a separate thread
-};
-
+/**
+ * @file TelemetryReceiver.h
+ * @brief Concrete implementation of ITelemetryReceiver interface which uses mavlink for communication with UAV.
+ *
+ * @details This file contains the declaration of a concrete telemtry receiver implementation.
+ *
+ * @author Szymon Bogus
+ * @date 2024-05-22
+ *
+ * @copyright Copyright 2024 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <thread>
+#include <memory>
+#include <atomic>
+#include <math.h>
+#include <chrono>
+#include <iostream>
+
+#include <common/mavlink.h>
+// #include <cubepilot/mavlink.h> // Even though it is a more specific dialetc of mavlink
+                                  // it doesnt improve the performance
+
+#include "base/ITelemetryReceiver.h"
+#include "EventsBus.h"
+#include "LinkMonitor.h"
+#include "FrameDeduplicator.h"
+#include "SerialPort.h"
+#include "SpscRingBuffer.h"
+#include "StreamRateController.h"
+#include "ClockSync.h"
+#include "TelemetryDecoder.h"
+#include "TelemetrySample.h"
+
+
+/**
+ * @class TelemetryReceiver
+ * @brief Telemetry receiver implementation. Reads the same vehicle over one or several
+ *		  redundant serial links; copies of a frame are deduplicated and the first one is used.
+ */
+class TelemetryReceiver : public ITelemetryReceiver {
+public:
+
+	/**
+	 * @brief Constructor.
+	 * @param bus: EventsBus reference in order to access publisher
+	 * @param portsCom: names of serial ports, more than one for redundant radios of the same vehicle.
+	 * @param baudRate: baud rate of serial ports or ConnectionConfigurationInfo::AUTO_BAUD_RATE.
+	 * @param isVerbose: logs verbosity flag.
+	 */
+	explicit TelemetryReceiver(EventsBus &bus, const std::vector<std::string>& portsCom,
+	                           uint32_t baudRate, bool isVerbose=false); 
+	~TelemetryReceiver();
+
+
+private:
+
+   /**
+   * @brief Begin receiving telemetry. Every link gets its own I/O stage thread, which only
+   *        drains the serial port into the ring of the link. The calling thread becomes
+   *        the parse/publish stage.
+   */
+   void receive_() override final;
+
+    /**
+    * @brief Stop receiving telemetry.
+    */
+    void stop_() override final;
+
+	/**
+    * @brief Register received telemetry to the EventBus.
+    */
+	void registerTelemetryEvent_() override final;
+
+    struct SerialLink;
+
+    /**
+    * @brief I/O stage of the link: drain the port into the ring of the link.
+    * @param link: served link.
+    */
+    void ioLoop_(SerialLink &link);
+
+    /**
+    * @brief Parse/publish stage: pop bytes from rings of all links, parse frames and publish samples.
+    */
+    void parseLoop_();
+
+    /**
+    * @brief Parse bytes of the link, deduplicate frames and handle the first copies.
+    * @param link: link which delivered bytes.
+    * @param bytes: popped bytes.
+    * @param bytesNum: number of popped bytes.
+    * @param arrivalNs: time the bytes have been popped, steady clock.
+    */
+    void parseBytes_(SerialLink &link, const uint8_t *bytes, std::size_t bytesNum,
+                     std::int64_t arrivalNs);
+
+    /**
+    * @brief Query the serial driver queue depth and overruns. Called by the I/O stage.
+    * @param link: served link.
+    */
+    void pollSerialStatus_(SerialLink &link);
+
+    /**
+    * @brief Decode a complete MAVLink frame into the aggregated sample with TelemetryDecoder
+    *        and answer what it hands back.
+    * @param message: parsed frame.
+    * @param arrivalNs: host time the frame has been received.
+    * @return True, if the frame should trigger publishing of the sample.
+    */
+    bool handleMessage_(const mavlink_message_t &message, std::int64_t arrivalNs);
+
+    /**
+    * @brief Write a message to every link.
+    * @param message: message to send.
+    * @return Number of links which accepted the message.
+    */
+    std::size_t sendToLinks_(const mavlink_message_t &message);
+
+    /**
+    * @brief Send TIMESYNC- a request (tc1 = 0) or a reply to a request of the autopilot over
+    *        every link. Host time is stamped per link, right before its write.
+    * @param isReply: true for a reply, false for a request.
+    * @param ts1: echoed time of the autopilot request, ignored for a request.
+    */
+    void sendTimesync_(bool isReply, std::int64_t ts1);
+
+    /**
+    * @brief Request the interval of a MAVLink stream over every link. Doesn't wait for
+    *        the acknowledgement, COMMAND_ACK is handled by TelemetryReceiver::handleMessage_.
+    * @param messageId: id of the requested message.
+    * @param intervalUs: interval between two messages in microseconds.
+    */
+    void sendMessageInterval_(uint16_t messageId, uint32_t intervalUs);
+
+    /**
+    * @brief Feed StreamRateController with statistics of the worst working link
+    *        and reissue intervals which changed.
+    */
+    void updateStreamRates_();
+
+    /**
+    * @brief Get the bytes a message takes on the wire, including MAVLink framing.
+    * @param payloadLen: length of the payload, MAVLINK_MSG_ID_*_LEN.
+    */
+    static constexpr std::uint16_t frameBytes_(std::uint16_t payloadLen) {
+      return static_cast<std::uint16_t>(payloadLen + MAVLINK_NUM_NON_PAYLOAD_BYTES);
+    }
+
+    /**
+    * @brief Print CPU time which the parsing thread spends per decoded message
+    *        together with depth and overflow counters of both stages.
+    */
+    void reportCpuUsage_();
+
+    /****************************************************
+    * Requested telemetry streams
+    ****************************************************/
+    // Streams are requested with independent rates. High-rate streams only update
+    // the aggregated sample, which is published once per TelemetryDecoder::PUBLISH_TRIGGER_MSG_ID,
+    // so the rate of events on the bus equals the rate of the fastest pose stream.
+    // Actual rates between min and max are chosen by StreamRateController.
+    // Defined with the code, where frameBytes_ can be evaluated.
+    static const std::array<StreamConfig, 7> STREAMS;
+    static constexpr auto RATE_UPDATE_PERIOD = std::chrono::seconds(1);
+
+    /****************************************************
+    * I/O and parse/publish stages
+    ****************************************************/
+    static constexpr std::size_t SERIAL_RING_CAPACITY = 1 << 16; // ~0.7 s of 921600 baud
+    static constexpr DWORD READ_CHUNK_SIZE = 512;
+    static constexpr auto SERIAL_STATUS_POLL_PERIOD = std::chrono::milliseconds(100);
+
+    /****************************************************
+    * UAV connection specification
+    ****************************************************/
+    // Every link parses on its own MAVLink channel, channel 0 is used by SerialPort to probe baud rates
+    static constexpr std::size_t MAX_LINKS_NUM = 3;
+    static_assert(MAX_LINKS_NUM <= LinkMonitor::MAX_LINKS_NUM &&
+                  MAX_LINKS_NUM <= FrameDeduplicator::MAX_LINKS_NUM);
+
+    struct SerialLink {
+      std::unique_ptr<SerialPort> port;
+      std::size_t linkId{0};                        // LinkMonitor and FrameDeduplicator index
+      mavlink_channel_t channel{MAVLINK_COMM_1};
+      SpscRingBuffer<uint8_t, SERIAL_RING_CAPACITY> ring; // I/O stage -> parse/publish stage
+      std::jthread ioThread;
+      std::atomic<uint32_t> maxDriverQueueBytes{0}; // I/O stage: bytes waiting in the serial driver
+      std::atomic<uint64_t> driverOverrunsNum{0};   // I/O stage: driver reported lost bytes
+    };
+    std::vector<std::unique_ptr<SerialLink>> m_links;
+
+    /****************************************************
+    * Link quality
+    *****************************************************/
+    std::unique_ptr<LinkMonitor> m_linkMonitor;
+    FrameDeduplicator m_deduplicator; // used only by the parse/publish stage
+    std::unique_ptr<StreamRateController> m_rateController;
+    std::chrono::steady_clock::time_point m_lastRateUpdate;
+
+    /****************************************************
+    * Time synchronisation
+    *****************************************************/
+    std::chrono::steady_clock::time_point m_lastTimesyncRequest;
+
+    /****************************************************
+    * Logging
+    *****************************************************/
+    bool m_verbose;
+
+	/****************************************************
+    * Publishing
+    *****************************************************/
+	IPublisher *m_publisher;
+    TelemetryDecoder m_decoder; // aggregated sample and clock sync, used only by the parse/publish stage
+
+    /****************************************************
+    * Stages handoff
+    *****************************************************/
+    std::atomic<uint32_t> m_dataSignal{0}; // bumped by I/O stages after a push, waited on by the parser
+
+    /****************************************************
+    * Profiling
+    *****************************************************/
+    uint64_t m_decodedMsgsNum{0};
+    uint64_t m_lastReportMsgsNum{0};
+    uint64_t m_lastReportCpuTime{0}; // 100 ns units, as reported by GetThreadTimes
+    std::chrono::steady_clock::time_point m_lastReportTime;
+
+	/****************************************************
+    * Synchronization
+    *****************************************************/
+    std::atomic_bool m_running; // Flag which indicates if receiver loop should run.
+                                // It's set to be atomic_bool in order to be securely 
+                                // - set by TelemetryReceiver::stop
+                                // - checked by TelemetryReceiver::receive which runs on a separate thread
+};
+
@@ -0,0 +1,107 @@
+/**
+ * @file TelemetrySample.h
+ * @brief Aggregated telemetry sample of a single vehicle.
+ *
+ * @details This file contains the definition of a fixed-layout structure which aggregates the latest
+ *          values of all MAVLink streams requested from the UAV. It is passed by value through
+ *          the pipeline, so publishing a sample doesn't allocate.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+
+
+/**
+ * @brief Structure holding the latest state of a vehicle built from several MAVLink streams.
+ *		  Positions are kept in their native fixed-point representation, since float32 cannot
+ *		  hold latitude/longitude with 1e-7 degree precision.
+ *		  Every group carries the host steady clock time (ns) at which the autopilot captured it,
+ *		  mapped by ClockSync. Until the clocks are synchronised it's the arrival time instead.
+ */
+struct TelemetrySample {
+
+  /**
+   * @brief Flags marking groups of fields of the sample.
+   */
+  enum Field : std::uint32_t {
+    ATTITUDE        = 1u << 0, // ATTITUDE
+    GLOBAL_POSITION = 1u << 1, // GLOBAL_POSITION_INT
+    LOCAL_POSITION  = 1u << 2, // LOCAL_POSITION_NED
+    IMU             = 1u << 3, // HIGHRES_IMU
+    VFR_HUD         = 1u << 4, // VFR_HUD
+    LOCAL_FRAME     = 1u << 5  // global position converted by LocalFrame
+  };
+
+  std::uint8_t systemId{0};
+  std::uint32_t validFields{0};   // groups received at least once
+  std::uint32_t updatedFields{0}; // groups updated since the previous published sample
+  bool isTimeSynced{false};       // host times below are capture times, not arrival times
+  bool isPredicted{false};        // extrapolated by PoseExtrapolator, host times are the prediction time
+
+  // ATTITUDE: rad, rad/s
+  std::uint32_t attitudeTimeBootMs{0};
+  std::int64_t attitudeHostTimeNs{0};
+  float roll{0.0f};
+  float pitch{0.0f};
+  float yaw{0.0f};
+  float rollSpeed{0.0f};
+  float pitchSpeed{0.0f};
+  float yawSpeed{0.0f};
+
+  // GLOBAL_POSITION_INT: degE7, mm, m/s (NED)
+  std::uint32_t globalPositionTimeBootMs{0};
+  std::int64_t globalPositionHostTimeNs{0};
+  std::int32_t latE7{0};
+  std::int32_t lonE7{0};
+  std::int32_t altMm{0};         // above MSL
+  std::int32_t relativeAltMm{0}; // above home
+  float velocityNorth{0.0f};
+  float velocityEast{0.0f};
+  float velocityDown{0.0f};
+
+  // LOCAL_POSITION_NED: m, m/s
+  std::uint32_t localPositionTimeBootMs{0};
+  std::int64_t localPositionHostTimeNs{0};
+  float localX{0.0f};
+  float localY{0.0f};
+  float localZ{0.0f};
+  float localVx{0.0f};
+  float localVy{0.0f};
+  float localVz{0.0f};
+
+  // HIGHRES_IMU: m/s^2, rad/s
+  std::uint64_t imuTimeUs{0};
+  std::int64_t imuHostTimeNs{0};
+  float accX{0.0f};
+  float accY{0.0f};
+  float accZ{0.0f};
+  float gyroX{0.0f};
+  float gyroY{0.0f};
+  float gyroZ{0.0f};
+
+  // VFR_HUD: m/s, deg
+  float airSpeed{0.0f};
+  float groundSpeed{0.0f};
+  float climbRate{0.0f};
+  std::int16_t heading{0};
+
+  // LocalFrame: m, east north up from the exercise origin
+  double east{0.0};
+  double north{0.0};
+  double up{0.0};
+
+  inline bool has(const Field field) const { return (validFields & field) != 0; }
+  inline double latitudeDeg() const { return latE7 * 1E-7; }
+  inline double longitudeDeg() const { return lonE7 * 1E-7; }
+  inline double altitudeM() const { return altMm * 1E-3; }
+};
@@ -1,82 +1,350 @@
-/**
- * @file TelemetrySender.h
- * @brief Concrete implementation of ITelemetrySender interface using UDP protocol for sending data to a remote endpoint.
- *
- * @details This file contains the declaration of a concrete telemetry sender entity implementation.
- *
- * @author Szymon Bogus
- * @date 2024-05-22
- *
- * @copyright Copyright 2024 Szymon Bogus
- * @license Apache License, Version 2.0 (see
- * https://www.apache.org/licenses/LICENSE-2.0)
- *
- * @version 1.0
- */
-
-#pragma once
-
-#include <iostream>
-#include <vector>
-#include <string>
-
-#include <WS2tcpip.h>
-
-#include "base/ITelemetrySender.h"
-#include "base/ISubscriber.h"
-#include "EventsBus.h"
-
-
-/**
-* @class TelemetrySender
-* @brief Implementation of UDP telemetry sender.
-*/
-class TelemetrySender : public ITelemetrySender, public ISubscriber {
-public:
-
-    /**
-     * @brief Constructor.
-     * @param ip: endpoint ip address.
-     * @param port: endpoint port.
-     * @param isVerbose: logs verbosity flag.
-     */
-  explicit TelemetrySender(EventsBus &bus, const std::string &ip,
-                           const std::string& port, bool isVerbose = false);
-
-  ~TelemetrySender();
-
-private:
-
-    /**
-    * @brief Send telemetry via UDP protocol.
-    * @param telemetry: new telemetry extracted from the event.
-    */
-    void sendPosition_(const std::vector<float> &telemetry) override final;
-
-    /**
-     * @brief Send telemetry to external platform.
-     * @param event: new telemetry data.
-     */
-    void onEvent_(const TelemetryEvent &event) override final;
-
-    /****************************************************
-    * Networking
-    *****************************************************/
-    WSADATA m_winSockdata;
-    WORD m_winSockVersion;
-    SOCKET m_socket;
-    sockaddr_in m_remoteTarget;
-    const char *m_ip;
-    const int m_port;
-
-    /****************************************************
-    * Logging
-    *****************************************************/
-    bool m_verbose;
-
-    /****************************************************
-    * Publishing
-    *****************************************************/
-    IPublisher *m_publisher;
-};
-
+/**
+ * @file TelemetrySender.h
+ * @brief Concrete implementation of ITelemetrySender interface using UDP protocol for sending data to a remote endpoint.
+ *
+ * @details This file contains the declaration of a concrete telemetry sender entity implementation.
+ *          Samples can be coalesced within a short time window into a single datagram to reduce the number
+ *          of send calls at the cost of added latency. Every datagram is sent to all endpoints
+ *          over connected UDP sockets (see UdpSocket.h), or with a single sendmmsg on POSIX.
+ *          Optionally samples are sent by a dedicated thread at a fixed output rate, only the
+ *          latest sample of each vehicle.
+ *
+ * @author Szymon Bogus
+ * @date 2024-05-22
+ *
+ * @copyright Copyright 2024 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <memory>
+#include <optional>
+#include <thread>
+
+#include "base/ITelemetrySender.h"
+#include "UdpSocket.h"
+#include "DeltaCodec.h"
+#include "ScenePacket.h"
+#include "LatestValueMailbox.h"
+#include "LocalFrame.h"
+#include "PoseExtrapolator.h"
+#include "ConfigUtilities.h"
+#include "base/ISubscriber.h"
+#include "EventsBus.h"
+
+
+/**
+* @class TelemetrySender
+* @brief Implementation of UDP telemetry sender.
+*		 With a non-zero coalescing window serialised samples are appended to a batch, which is sent
+*		 as one datagram once the window since its first sample elapses or the next sample wouldn't
+*		 fit MAX_DATAGRAM_SIZE. Packets of both wire formats are self-delimiting (fixed size binary,
+*		 NUL-terminated text), so a client splits the datagram back into samples.
+*		 A sample is serialised once and the same buffer is sent to every endpoint (unicast or
+*		 multicast group). On POSIX several endpoints get it from one sendmmsg call on an
+*		 unconnected socket, on WinSock every endpoint costs a send on its connected socket.
+*		 Endpoints live in a fixed-size table, so adding or removing one at runtime doesn't touch
+*		 the hot path and senders only take a shared lock.
+*		 Send errors are published as ConnectionEvent once per endpoint when it starts failing and
+*		 again when it has been sending without errors for ENDPOINT_RECOVERY_PERIOD.
+*		 With a non-zero output rate bus threads only put samples into a per-vehicle mailbox, and
+*		 a pacing thread sends what's new in it once per period. Samples arriving in bursts after
+*		 a stall replace each other instead of being sent back-to-back. With a prediction horizon the
+*		 pacing thread sends every vehicle once per period, its pose extrapolated to the time of sending.
+*		 With a local frame origin positions are sent as east-north-up metres of LocalFrame. Paced
+*		 samples of all vehicles are converted together by its batched path.
+*		 The scene of the exercise is pushed to every endpoint in chunks, see ScenePacket.h. A unicast
+*		 endpoint is announced the scene first and sent only the chunks it acknowledges as missing, so
+*		 a headset with the scene cached skips the download. Missing chunks are sent again every
+*		 SCENE_RETRANSMIT_PERIOD until acknowledged or MAX_SCENE_ATTEMPTS_NUM is reached, a later ack
+*		 with another hash (e.g. the headset reconnected) starts the transfer again. Multicast groups
+*		 can't acknowledge, so the whole scene is sent to them every SCENE_CAROUSEL_PERIOD.
+*		 Waypoint progress transitions are sent as they're published, bypassing coalescing and pacing.
+*/
+class TelemetrySender : public ITelemetrySender, public ISubscriber {
+public:
+
+  static constexpr std::size_t MAX_DATAGRAM_SIZE = 1472; // Ethernet MTU without IPv4 and UDP headers
+  static constexpr std::size_t MAX_ENDPOINTS_NUM = 16;
+  static constexpr auto ENDPOINT_RECOVERY_PERIOD = std::chrono::seconds(1);
+  static constexpr auto SCENE_POLL_PERIOD = std::chrono::milliseconds(20);
+  static constexpr auto SCENE_RETRANSMIT_PERIOD = std::chrono::milliseconds(200);
+  static constexpr auto SCENE_CAROUSEL_PERIOD = std::chrono::seconds(2);
+  static constexpr std::size_t MAX_SCENE_ATTEMPTS_NUM = 25; // 5 s without acknowledgement
+
+    /**
+     * @brief Constructor.
+     * @param endpoints: receivers of telemetry, at most MAX_ENDPOINTS_NUM.
+     * @param wireFormat: format of sent packets, see TelemetryPacket.h.
+     * @param coalescingWindowUs: time samples are held to be sent together, 0 sends each at once.
+     * @param outputRateHz: rate of sending the latest sample of each vehicle, 0 sends each sample as it arrives.
+     * @param predictionHorizonMs: longest extrapolation past the latest sample of a vehicle, 0 disables it. Needs outputRateHz.
+     * @param isVerbose: logs verbosity flag.
+     * @param localFrameOrigin: origin of the local frame positions are sent in, GPS positions are sent without it.
+     */
+  explicit TelemetrySender(EventsBus &bus,
+                           const std::vector<ConnectionConfigurationInfo::Endpoint> &endpoints,
+                           WireFormat wireFormat = WireFormat::TEXT,
+                           std::uint32_t coalescingWindowUs = 0,
+                           std::uint32_t outputRateHz = 0,
+                           std::uint32_t predictionHorizonMs = 0,
+                           bool isVerbose = false,
+                           const std::optional<OperatorPosition> &localFrameOrigin = std::nullopt);
+
+  ~TelemetrySender();
+
+  /**
+   * @brief Start sending telemetry to the endpoint.
+   * @param ip: IPv4 address or multicast group.
+   * @param port: endpoint port.
+   * @return False, if the address is invalid, already added or the table is full.
+   */
+  bool addEndpoint(const std::string &ip, int port);
+
+  /**
+   * @brief Stop sending telemetry to the endpoint.
+   * @param ip: IPv4 address or multicast group.
+   * @param port: endpoint port.
+   * @return False, if the endpoint hasn't been added.
+   */
+  bool removeEndpoint(const std::string &ip, int port);
+
+  /**
+   * @brief Get the number of endpoints.
+   */
+  std::size_t getEndpointsNum() const;
+
+  /**
+   * @brief Push the scene of the exercise to all endpoints, replacing the previous one.
+   * @param flightConfig: configuration the scene is serialised from.
+   * @return False, if the scene exceeds MAX_SCENE_CHUNKS_NUM chunks.
+   */
+  bool pushScene(const configuration::FlightConfig &flightConfig);
+
+  /**
+   * @brief Check whether all unicast endpoints acknowledged the whole scene.
+   */
+  bool isSceneAcknowledged() const;
+
+  /**
+   * @brief Get the number of sent scene chunks, announces excluded.
+   */
+  std::uint64_t getSceneChunksSentNum() const;
+
+  /**
+   * @brief Get the number of serialised samples.
+   */
+  std::uint64_t getSamplesNum() const;
+
+  /**
+   * @brief Get the number of samples replaced in the mailbox by a newer one before being sent.
+   */
+  std::uint64_t getSupersededNum() const;
+
+  /**
+   * @brief Get the number of sent datagrams, each sent once to every endpoint.
+   */
+  std::uint64_t getDatagramsNum() const;
+
+  /**
+   * @brief Get the number of send calls. A sendmmsg covering several endpoints counts once.
+   */
+  std::uint64_t getSendCallsNum() const;
+
+  /**
+   * @brief Get the mean time samples spent in a batch before being sent.
+   */
+  std::chrono::nanoseconds getMeanHoldTime() const;
+
+  /**
+   * @brief Get the longest time a sample spent in a batch before being sent.
+   */
+  std::chrono::nanoseconds getMaxHoldTime() const;
+
+private:
+
+    struct Endpoint {
+      explicit Endpoint(const std::string &ip, int port) : socket(ip, port) {}
+
+      UdpSocket socket;
+      std::atomic<bool> isFailing{false};
+      std::atomic<std::int64_t> lastErrorNs{0};
+
+      // Scene transfer, used only by the scene thread
+      std::uint64_t sceneHash{0};                                              // scene the state refers to
+      std::array<std::uint8_t, wire::MAX_SCENE_CHUNKS_NUM / 8> sceneAcked{};   // bitmap of acknowledged chunks
+      std::size_t sceneAttemptsNum{0};
+      std::chrono::steady_clock::time_point nextSceneSend;
+      std::atomic<bool> isSceneAcked{false};
+    };
+
+    /**
+    * @brief Send telemetry via UDP protocol.
+    * @param telemetry: new telemetry extracted from the event.
+    */
+    void sendPosition_(const TelemetrySample &telemetry) override final;
+
+    /**
+     * @brief Send telemetry to external platform.
+     * @param event: new telemetry data.
+     */
+    void onEvent_(const TelemetryEvent &event) override final;
+
+    /**
+     * @brief Send a waypoint progress transition to all endpoints at once, see TelemetryPacket.h.
+     * @param event: new progress of a vehicle.
+     */
+    void onEvent_(const ProgressEvent &event) override final;
+
+    /**
+     * @brief Serialise the sample and send it or append it to the batch.
+     * @param telemetry: sample to send.
+     */
+    void sendSample_(const TelemetrySample &telemetry);
+
+    /**
+     * @brief Send new samples of the mailbox once per output period.
+     * @param stopToken: token stopping the loop.
+     */
+    void paceLoop_(std::stop_token stopToken);
+
+    /**
+     * @brief Append a serialised sample to the batch, sending the batch if it's full.
+     * @param packet: serialised sample.
+     * @param size: size of the sample in bytes.
+     */
+    void enqueue_(const char *packet, std::size_t size);
+
+    /**
+     * @brief Send the batch. Requires m_batchMtx to be held.
+     */
+    void flushBatch_();
+
+    /**
+     * @brief Send batches whose coalescing window elapsed.
+     * @param stopToken: token stopping the loop, the pending batch is sent before exit.
+     */
+    void flushLoop_(std::stop_token stopToken);
+
+    /**
+     * @brief Send a single datagram to all endpoints.
+     * @param data: datagram payload.
+     * @param size: payload size in bytes.
+     */
+    void sendDatagram_(const char *data, std::size_t size);
+
+    /**
+     * @brief Account the result of sending to the endpoint, publishing its state changes.
+     * @param endpoint: endpoint the datagram has been sent to.
+     * @param errorCode: result of UdpSocket::send.
+     */
+    void onSendResult_(Endpoint &endpoint, int errorCode);
+
+    /**
+     * @brief Receive acks of the scene and send its chunks until every endpoint has it.
+     * @param stopToken: token stopping the loop.
+     */
+    void sceneLoop_(std::stop_token stopToken);
+
+    /**
+     * @brief Apply pending acks of the endpoint. Requires m_sceneMtx to be held.
+     * @param endpoint: endpoint to receive acks from.
+     * @param now: current time.
+     */
+    void receiveSceneAcks_(Endpoint &endpoint, std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Send chunks of the scene not acknowledged by the endpoint, followed by the announce
+     *		  requesting the next ack. The first attempt is the announce alone. Requires m_sceneMtx to be held.
+     * @param endpoint: endpoint to send to.
+     * @param now: current time.
+     */
+    void sendScene_(Endpoint &endpoint, std::chrono::steady_clock::time_point now);
+
+    /****************************************************
+    * Endpoints
+    *****************************************************/
+    mutable std::shared_mutex m_endpointsMtx;
+    std::array<std::unique_ptr<Endpoint>, MAX_ENDPOINTS_NUM> m_endpoints{};
+    std::size_t m_endpointsNum{0};
+    std::unique_ptr<UdpSocket> m_fanoutSocket;          // unconnected, null sends on every endpoint socket
+
+    /****************************************************
+    * Wire format
+    *****************************************************/
+    const WireFormat m_wireFormat;
+    std::atomic<std::uint32_t> m_sequence{0};
+    std::mutex m_deltaEncoderMtx;
+    wire::DeltaEncoder m_deltaEncoder;
+    std::optional<LocalFrame> m_localFrame;             // empty for GPS positions
+
+    /****************************************************
+    * Pacing
+    *****************************************************/
+    const std::chrono::nanoseconds m_outputPeriod;      // 0 without pacing
+    LatestValueMailbox<TelemetrySample, 256> m_mailbox; // by vehicle id
+    std::array<TelemetrySample, 256> m_paceBatch;       // samples taken in a tick, used only by the pacing thread
+    std::optional<PoseExtrapolator> m_extrapolator;     // used only by the pacing thread
+    std::mutex m_paceMtx;                               // only for sleeping interruptibly
+    std::condition_variable_any m_paceCv;
+    std::jthread m_paceThread;
+
+    /****************************************************
+    * Coalescing
+    *****************************************************/
+    const std::chrono::microseconds m_coalescingWindow;
+    std::mutex m_batchMtx;
+    std::condition_variable_any m_batchCv;
+    std::array<char, MAX_DATAGRAM_SIZE> m_batch{};
+    std::size_t m_batchSize{0};
+    std::size_t m_batchSamplesNum{0};
+    std::int64_t m_batchHoldSumNs{0};       // sum of enqueue times, to get the hold time of all samples at once
+    std::chrono::steady_clock::time_point m_batchStart;
+    std::uint64_t m_batchGeneration{0};     // bumped by every flush, so a stale deadline isn't applied to a new batch
+    std::jthread m_flushThread;
+
+    /****************************************************
+    * Scene
+    *****************************************************/
+    std::mutex m_sceneMtx;
+    std::condition_variable_any m_sceneCv;
+    std::vector<std::uint8_t> m_scene;
+    std::uint64_t m_sceneHash{0};
+    std::size_t m_sceneChunksNum{0};
+    std::atomic<std::uint64_t> m_sceneChunksSentNum{0};
+    std::jthread m_sceneThread;
+
+    /****************************************************
+    * Statistics
+    *****************************************************/
+    std::atomic<std::uint64_t> m_samplesNum{0};
+    std::atomic<std::uint64_t> m_datagramsNum{0};
+    std::atomic<std::uint64_t> m_sendCallsNum{0};
+    std::atomic<std::int64_t> m_holdSumNs{0};
+    std::atomic<std::int64_t> m_maxHoldNs{0};
+
+    /****************************************************
+    * Logging
+    *****************************************************/
+    bool m_verbose;
+
+    /****************************************************
+    * Publishing
+    *****************************************************/
+    IPublisher *m_publisher;
+};
+
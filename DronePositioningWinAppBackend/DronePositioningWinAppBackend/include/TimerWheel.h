@@ -0,0 +1,96 @@
+/**
+ * @file TimerWheel.h
+ * @brief Hashed timer wheel.
+ *
+ * @details This file contains the declaration of a timer wheel which multiplexes
+ *          many timeouts (watchdogs, periodic statistics) over a single ticking thread.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+
+/**
+ * @class TimerWheel
+ * @brief Hashed timer wheel with a fixed number of slots.
+ *		  Timers are registered once (callback is stored at registration) and later
+ *		  only (re)armed or cancelled, so arming a watchdog on every received message
+ *		  doesn't allocate. A stale entry left in a slot by re-arming is recognized
+ *		  by its generation and dropped when the slot is visited.
+ *		  Callbacks are executed by the thread calling TimerWheel::tick, outside of the
+ *		  internal lock, so they can safely re-arm timers.
+ */
+class TimerWheel {
+public:
+  using TimerId = std::size_t;
+  using Callback = std::function<void()>;
+
+  static constexpr std::size_t SLOTS_NUM = 64;
+
+  /**
+   * @brief Constructor.
+   */
+  TimerWheel() = default;
+  ~TimerWheel() = default;
+
+  /**
+   * @brief Register a new timer. The timer is disarmed until TimerWheel::arm is called.
+   * @param callback: action executed when the timer expires.
+   * @return Identifier of the timer.
+   */
+  TimerId addTimer(Callback callback);
+
+  /**
+   * @brief Arm (or re-arm) the timer so it expires after the given number of ticks.
+   *		Re-arming an already armed timer moves its expiry.
+   * @param id: timer identifier.
+   * @param ticks: number of ticks to expiry, 0 is treated as 1.
+   */
+  void arm(const TimerId id, const std::uint64_t ticks);
+
+  /**
+   * @brief Disarm the timer.
+   * @param id: timer identifier.
+   */
+  void cancel(const TimerId id);
+
+  /**
+   * @brief Advance the wheel by one tick and run callbacks of expired timers.
+   */
+  void tick();
+
+private:
+
+  struct Timer {
+    Callback callback;
+    std::uint64_t expiryTick{0};
+    std::uint32_t generation{0};
+    bool isArmed{false};
+  };
+
+  struct SlotEntry {
+    TimerId id;
+    std::uint32_t generation;
+  };
+
+  std::vector<Timer> m_timers;
+  std::array<std::vector<SlotEntry>, SLOTS_NUM> m_slots;
+  std::vector<TimerId> m_expired; // reused between ticks, callbacks run outside of the lock
+  std::uint64_t m_currentTick{0};
+  std::mutex m_wheelMtx;
+};
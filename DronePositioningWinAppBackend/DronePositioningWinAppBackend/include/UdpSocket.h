@@ -0,0 +1,155 @@
+/**
+ * @file UdpSocket.h
+ * @brief Portable connected UDP socket.
+ *
+ * @details This file contains the declaration of UdpSocket- wrapper of a UDP socket connected to
+ *          a single endpoint, implemented with WinSock on Windows and BSD sockets elsewhere.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#ifdef _WIN32
+#include <WS2tcpip.h>
+#else
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
+
+#include <string>
+#include <cstddef>
+
+
+/**
+ * @class UdpSocket
+ * @brief Class owning a UDP socket connected once to its endpoint, so sending doesn't pass
+ *		  and check the address on every call. A connected socket also reports ICMP errors of
+ *		  the endpoint (e.g. nothing listening on the port) on the next send.
+ *		  An unconnected socket instead sends one datagram to many endpoints with
+ *		  UdpSocket::sendToMany, which takes a single sendmmsg call on POSIX. It doesn't report
+ *		  ICMP errors of the endpoints. WinSock has no sendmmsg, so it isn't available there.
+ *		  Sending is thread-safe, receiving is done by a single thread. The socket isn't copyable.
+ */
+class UdpSocket {
+public:
+
+#ifdef _WIN32
+  using NativeHandle = SOCKET;
+#else
+  using NativeHandle = int;
+#endif
+
+  static constexpr int SEND_BUFFER_SIZE = 256 * 1024; // bursts of coalesced datagrams don't block or drop
+  static constexpr int MULTICAST_TTL = 1;             // multicast stays within the local network
+  static constexpr std::size_t MAX_FANOUT_NUM = 64;   // endpoints per sendmmsg call
+
+  /**
+   * @brief Constructor. Creates the socket and connects it. Throws std::runtime_error if
+   *		the address is invalid or the socket cannot be created.
+   * @param ip: IPv4 address or multicast group.
+   * @param port: endpoint port.
+   */
+  explicit UdpSocket(const std::string &ip, int port);
+
+  /**
+   * @brief Constructor. Creates an unconnected socket sending to any endpoint. Throws
+   *		std::runtime_error if the socket cannot be created.
+   */
+  UdpSocket();
+  ~UdpSocket();
+
+  UdpSocket(const UdpSocket &) = delete;
+  UdpSocket &operator=(const UdpSocket &) = delete;
+
+  /**
+   * @brief Send a datagram to the endpoint.
+   * @param data: datagram payload.
+   * @param size: payload size in bytes.
+   * @return 0 on success, otherwise the error code of the platform.
+   */
+  int send(const char *data, std::size_t size);
+
+#ifndef _WIN32
+  /**
+   * @brief Send the same datagram to several endpoints with one sendmmsg call, or a few if
+   *		some endpoint fails or there are more than MAX_FANOUT_NUM of them. Used on an
+   *		unconnected socket.
+   * @param data: datagram payload.
+   * @param size: payload size in bytes.
+   * @param addresses: endpoint addresses.
+   * @param addressesNum: number of endpoints.
+   * @param errorCodes: result for every endpoint, 0 on success, otherwise the error code of the platform.
+   * @return Number of send calls made.
+   */
+  std::size_t sendToMany(const char *data, std::size_t size, const sockaddr_in *const *addresses,
+                         std::size_t addressesNum, int *errorCodes);
+#endif
+
+  /**
+   * @brief Receive a pending datagram of the endpoint without blocking. Only datagrams sent
+   *		by the endpoint are delivered to a connected socket.
+   * @param buffer: destination of the datagram.
+   * @param size: buffer size in bytes.
+   * @return Size of the received datagram, 0 if none is pending or receiving failed.
+   */
+  std::size_t receive(char *buffer, std::size_t size);
+
+  /**
+   * @brief Check whether the endpoint is a multicast group.
+   */
+  bool isMulticast() const;
+
+  /**
+   * @brief Get the endpoint address.
+   */
+  const sockaddr_in &getAddress() const;
+
+  /**
+   * @brief Get the endpoint as "ip:port".
+   */
+  const std::string &getName() const;
+
+  /**
+   * @brief Resolve the endpoint address.
+   * @return False, if the ip isn't a valid IPv4 address or the port is out of range.
+   */
+  static bool toAddress(const std::string &ip, int port, sockaddr_in &address);
+
+  /**
+   * @brief Get the description of an error code returned by UdpSocket::send.
+   */
+  static std::string describeError(int errorCode);
+
+private:
+
+  /**
+   * @brief Get the last socket error of the calling thread.
+   */
+  static int lastError_();
+
+  /**
+   * @brief Start the socket library and create the socket with its options.
+   * @param isMulticastSender: whether datagrams may be sent to a multicast group.
+   */
+  void open_(bool isMulticastSender);
+
+  /**
+   * @brief Close the socket and release the socket library.
+   */
+  void close_();
+
+  NativeHandle m_socket;
+  sockaddr_in m_address{};
+  std::string m_name;
+};
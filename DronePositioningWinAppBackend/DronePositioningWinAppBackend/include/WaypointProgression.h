@@ -0,0 +1,130 @@
+/**
+ * @file WaypointProgression.h
+ * @brief Progress of vehicles through the waypoints of the exercise.
+ *
+ * @details This file contains the declaration of WaypointProgression, a per-vehicle state machine
+ *          capturing waypoints in order within the accuracy radius, after hovering for the pausing
+ *          time, and checking the heading against the target bearing.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "ConfigUtilities.h"
+#include "Events.h"
+#include "LocalFrame.h"
+
+
+/**
+ * @class WaypointProgression
+ * @brief Class deciding which waypoint every vehicle is at from its positions:
+ *		  - APPROACHING: the vehicle flies to the next waypoint. Entering its accuracy radius,
+ *		    3D around the waypoint raised by the guideline offset, starts HOVERING, or captures
+ *		    it at once without pausing time.
+ *		  - HOVERING: the waypoint is captured once the vehicle has spent pausingTime seconds
+ *		    within the radius, by the autopilot clock of the position fixes, so delays on the link
+ *		    don't shorten or stretch the hover. Fixes outside the radius pause the hover. Staying
+ *		    further than EXIT_MARGIN outside the radius for EXIT_TIME_MS is APPROACHING the same
+ *		    waypoint again, so position noise at its edge and single glitched fixes don't restart
+ *		    the approach.
+ *		  - COMPLETED: the last waypoint has been captured.
+ *		  At the capture the heading (yaw) is compared with the target bearing: a fixed UCS bearing,
+ *		  the bearing to the next waypoint, or none, which is always compliant.
+ *		  Positions only produce a WaypointProgress on transitions, so a vehicle hovering or flying
+ *		  between waypoints costs a distance check per fix and nothing is published.
+ *		  State of all vehicles is preallocated. Not thread-safe.
+ */
+class WaypointProgression {
+public:
+
+  static constexpr std::size_t MAX_VEHICLES_NUM = 256;
+  static constexpr double BEARING_TOLERANCE = 15.0; // deg
+  static constexpr double EXIT_MARGIN = 1.0;        // beyond the accuracy radius to stop hovering, m
+  static constexpr std::uint32_t EXIT_TIME_MS = 500; // outside the margin to stop hovering
+
+  /**
+   * @brief Statistics of a vehicle.
+   */
+  struct Stats {
+    std::uint16_t capturedNum{0};
+    std::uint16_t compliantNum{0};         // captures with the heading at the target bearing
+    std::uint32_t transitionsNum{0};
+    std::uint32_t startTimeBootMs{0};      // of the first position
+    std::uint32_t completionTimeBootMs{0}; // of the last capture
+    bool isStarted{false};
+  };
+
+  /**
+   * @brief Constructor.
+   * @param waypoints: waypoints of the exercise, captured in order.
+   * @param frame: local frame of the exercise.
+   * @param exerciseInfo: coordinates system, guideline offset, accuracy, pausing time and
+   *		  target bearings.
+   */
+  WaypointProgression(const std::vector<Waypoint> &waypoints, const LocalFrame &frame,
+                      const ExerciseInfo &exerciseInfo);
+
+  /**
+   * @brief Advance the state of a vehicle by its new position fix.
+   * @param telemetry: sample of the fix, for the vehicle id, autopilot time and heading.
+   * @param east, north, up: position in the local frame, m.
+   * @param progress: state after the transition, if there was one.
+   * @return True, if the state changed.
+   */
+  bool update(const TelemetrySample &telemetry, double east, double north, double up,
+              WaypointProgress &progress);
+
+  std::size_t getWaypointsNum() const { return m_targets.size(); }
+  WaypointState getState(std::uint8_t vehicleId) const { return m_vehicles[vehicleId].state; }
+  std::uint16_t getWaypointIdx(std::uint8_t vehicleId) const { return m_vehicles[vehicleId].waypointIdx; }
+  const Stats &getStats(std::uint8_t vehicleId) const { return m_vehicles[vehicleId].stats; }
+
+private:
+
+  /**
+   * @brief Waypoint raised by the guideline offset, with the bearing required at its capture.
+   */
+  struct Target {
+    double east;
+    double north;
+    double up;
+    double bearing;     // deg from north, clockwise
+    bool hasBearing;
+  };
+
+  struct VehicleState {
+    WaypointState state{WaypointState::APPROACHING};
+    std::uint16_t waypointIdx{0};
+    std::uint32_t hoveredMs{0};            // within the radius since HOVERING started
+    std::uint32_t lastInsideTimeBootMs{0};
+    std::uint32_t exitStartTimeBootMs{0};
+    bool isInside{false};                  // hovering, the last fix within the radius
+    bool isExiting{false};                 // hovering, but outside the exit distance
+    Stats stats;
+  };
+
+  /**
+   * @brief Capture the current waypoint and target the next one.
+   */
+  void capture_(VehicleState &vehicle, const TelemetrySample &telemetry,
+                WaypointProgress &progress) const;
+
+  std::vector<Target> m_targets;
+  const double m_accuracySq;         // m^2
+  const double m_exitDistanceSq;     // m^2
+  const std::uint32_t m_pausingTimeMs;
+  std::array<VehicleState, MAX_VEHICLES_NUM> m_vehicles{};
+};
@@ -0,0 +1,116 @@
+/**
+ * @file ClockSync.cpp
+ * @brief Code of the synchronisation of the autopilot clock with the host clock.
+ *
+ * @details This file contains the definition of ClockSync.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "../include/ClockSync.h"
+
+
+std::int64_t ClockSync::nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+bool ClockSync::onTimesync(std::int64_t tc1, std::int64_t ts1,
+                           std::int64_t arrivalNs) {
+  const std::int64_t rttNs = arrivalNs - ts1;
+  if (tc1 <= 0 || rttNs <= 0 || rttNs > MAX_RTT_NS) {
+    return false; // a request of the autopilot or a reply to someone else
+  }
+
+  m_rtts[m_rttIdx] = rttNs;
+  m_rttIdx = (m_rttIdx + 1) % RTT_WINDOW_NUM;
+  m_rttsNum = std::min(m_rttsNum + 1, RTT_WINDOW_NUM);
+  const std::int64_t minRttNs =
+      *std::min_element(m_rtts.begin(), m_rtts.begin() + m_rttsNum);
+  if (rttNs > minRttNs * RTT_ACCEPT_FACTOR) {
+    return false; // queued somewhere on the way, the path wasn't symmetric
+  }
+
+  if (!m_isPrecise) {
+    reset_(); // drop the coarse SYSTEM_TIME estimate
+    m_isPrecise = true;
+  }
+  // The autopilot sampled its clock roughly in the middle of the round trip
+  const std::int64_t midpointNs = ts1 + rttNs / 2;
+  update_(tc1 - midpointNs, midpointNs);
+  m_lastRttNs = rttNs;
+  return true;
+}
+
+void ClockSync::onSystemTime(std::uint32_t timeBootMs, std::int64_t arrivalNs) {
+  if (m_isPrecise) {
+    return;
+  }
+  update_(static_cast<std::int64_t>(timeBootMs) * 1'000'000 - arrivalNs,
+          arrivalNs);
+}
+
+std::int64_t ClockSync::toHostNs(std::int64_t bootNs) const {
+  // bootNs = hostNs + offset(hostNs), offset changes by m_drift per ns of host time
+  const double hostNs =
+      (bootNs - m_offsetNs + m_drift * m_lastUpdateNs) / (1.0 + m_drift);
+  return static_cast<std::int64_t>(hostNs);
+}
+
+bool ClockSync::isSynced() const { return m_samplesNum > 0; }
+
+bool ClockSync::isPrecise() const { return m_isPrecise; }
+
+std::int64_t ClockSync::getOffsetNs() const {
+  return static_cast<std::int64_t>(m_offsetNs);
+}
+
+double ClockSync::getDriftPpm() const { return m_drift * 1E6; }
+
+std::int64_t ClockSync::getRttNs() const { return m_lastRttNs; }
+
+void ClockSync::update_(std::int64_t offsetNs, std::int64_t hostNs) {
+  if (m_samplesNum == 0) {
+    m_offsetNs = static_cast<double>(offsetNs);
+    m_lastUpdateNs = hostNs;
+    m_samplesNum = 1;
+    return;
+  }
+
+  const double dtNs = static_cast<double>(hostNs - m_lastUpdateNs);
+  const double predictedNs = m_offsetNs + m_drift * dtNs;
+  const double residualNs = offsetNs - predictedNs;
+  if (std::abs(residualNs) > RESET_RESIDUAL_NS) {
+    reset_();
+    update_(offsetNs, hostNs);
+    return;
+  }
+
+  const bool isConverging = m_samplesNum < CONVERGENCE_SAMPLES_NUM;
+  const double alpha = isConverging ? CONVERGENCE_ALPHA : ALPHA;
+  const double beta = isConverging ? 0.0 : BETA;
+  m_offsetNs = predictedNs + alpha * residualNs;
+  if (dtNs > 0.0) {
+    m_drift += beta * residualNs / dtNs;
+  }
+  m_lastUpdateNs = hostNs;
+  m_samplesNum++;
+}
+
+void ClockSync::reset_() {
+  m_offsetNs = 0.0;
+  m_drift = 0.0;
+  m_lastUpdateNs = 0;
+  m_samplesNum = 0;
+}
@@ -1,246 +1,328 @@
-/**
- * @file ConfigurationManager.cpp
- * @brief Configuration file parser code.
- *
- * @details This file contains the definition of configuration file parser.
- *
- * @author Szymon Bogus
- * @date 2024-05-26
- *
- * @copyright Copyright 2024 Szymon Bogus
- * @license Apache License, Version 2.0 (see
- * https://www.apache.org/licenses/LICENSE-2.0)
- *
- * @version 1.0
- */
-
-#include "../include/ConfigurationManager.h"
-
-
-namespace configuration {
-
-	std::unique_ptr<FlightConfig> ConfigurationManager::loadConfig(const std::filesystem::path& configFilePath)
-	{
-		if (!std::filesystem::exists(configFilePath))
-		{
-			throw std::runtime_error("File not found: " + configFilePath.string());
-		}
-
-		/***********************************************
-		* Initializing vectors and objects to hold 
-		* particular part of the configuration file
-		************************************************/
-		OperatorPosition operatorPosition;
-		std::vector<Waypoint> waypoints;
-		std::vector<Marker> markers;
-		std::vector<Obstackle> obstacles;
-		ExerciseInfo exerciseInfo;
-		ConnectionConfigurationInfo connectionInfo;
-
-		std::ifstream file(configFilePath);
-		std::string line;
-		std::string currentSection;
-
-		while (std::getline(file, line)) {
-			// Ignore comments and empty lines
-			if (line.empty() || line[0] == '#') {
-				continue;
-			}
-
-			// Check for section headers (e.g., "Waypoints:")
-			if (line.back() == ':') {
-				currentSection = line.substr(0, line.size() - 1); // Remove the trailing ':'
-				continue;
-			}
-
-            if (line == "File End") {
-                break; // Break iterating and move to FlighConfig instantiation
-            }
-
-			// Process data based on the current section
-            if (currentSection == "Title") {
-                exerciseInfo.title = line;
-            } else if (currentSection == "Author") {
-                exerciseInfo.author = line;
-            } else if (currentSection == "Operator position") {
-                std::istringstream iss(line);
-                double lat, lon, alt;
-                if (iss >> lat >> lon >> alt) {
-                    operatorPosition = OperatorPosition(lat, lon, alt);
-                }
-                else {
-                    throw std::runtime_error("Invalid operator position format: " + line);
-                }
-            } else if (currentSection == "Waypoints") {
-                std::istringstream iss(line);
-                double x, y, z; // Depending on the coordinate system, this could be lat, lon, alt
-                if (iss >> x >> y >> z) {
-                    waypoints.emplace_back(x, y, z);
-                }
-                else {
-                    throw std::runtime_error("Invalid waypoint format: " + line);
-                }
-            } else if (currentSection == "Markers") {
-                std::istringstream iss(line);
-                double x, y, z, radius; // Depending on the coordinate system, this could be lat, lon, alt + radius
-                if (iss >> x >> y >> z >> radius) {
-                    markers.emplace_back(x, y, z, radius);
-                }
-                else {
-                    throw std::runtime_error("Invalid marker format: " + line);
-                }
-            } else if (currentSection == "Obstacles") {
-                std::istringstream iss(line);
-                double centerX, centerY, centerZ, width, length, height, rotX, rotY, rotZ;
-                if (iss >> centerX >> centerY >> centerZ >> width >> length >> height >> rotX >> rotY >> rotZ) {
-                    obstacles.emplace_back(centerX, centerY, centerZ, width, length, height, rotX, rotY, rotZ);
-                }
-                else {
-                    throw std::runtime_error("Invalid obstackle format: " + line);
-                }
-            } else if (currentSection == "CoordsInGps") {
-                std::istringstream iss(line);
-                int coordsInGps;
-                if (iss >> coordsInGps) {
-                    exerciseInfo.coordinatesSystem = static_cast<CoorindatesSystem>(coordsInGps);
-                }
-                else {
-                    throw std::runtime_error("Invalid coordsInGps format: " + line);
-                }
-            } else if (currentSection == "AltitudeDiffIgnore") {
-                std::istringstream iss(line);
-                int altitudeDifference;
-                if (iss >> altitudeDifference) {
-                    exerciseInfo.altitudeDifference = static_cast<AltitudeDifference>(altitudeDifference);
-                }
-                else {
-                    throw std::runtime_error("Invalid altitudeDifference format: " + line);
-                }
-            } else if (currentSection == "GuidelineOffset") {
-                std::istringstream iss(line);
-                float guidelineOffset;
-                if (iss >> guidelineOffset) {
-                    exerciseInfo.guidelineOffset = guidelineOffset;
-                }
-                else {
-                    throw std::runtime_error("Invalid guidelineOffset format: " + line);
-                }
-            } else if (currentSection == "DistanceWeight") {
-                std::istringstream iss(line);
-                int distanceWeight;
-                if (iss >> distanceWeight) {
-                    exerciseInfo.distanceWeight = distanceWeight;
-                }
-                else {
-                    throw std::runtime_error("Invalid distanceWeight format: " + line);
-                }
-            } else if (currentSection == "AltitudeWeight") {
-                std::istringstream iss(line);
-                int attitudeWeight;
-                if (iss >> attitudeWeight) {
-                    exerciseInfo.altitudeWeight = attitudeWeight;
-                }
-                else {
-                    throw std::runtime_error("Invalid attitudeWeight format: " + line);
-                }
-            } else if (currentSection == "SpeedWeight") {
-                std::istringstream iss(line);
-                int speedWeight;
-                if (iss >> speedWeight) {
-                    exerciseInfo.speedWeight = speedWeight;
-                }
-                else {
-                    throw std::runtime_error("Invalid speedWeight format: " + line);
-                }  
-            } else if (currentSection == "TargetSpeed") {
-                std::istringstream iss(line);
-                float targetSpeed;
-                if (iss >> targetSpeed) {
-                    exerciseInfo.targetSpeed = targetSpeed;
-                }
-                else {
-                    throw std::runtime_error("Invalid targetSpeed format: " + line);
-                }
-            }
-            else if (currentSection == "Accuracy") {
-                std::istringstream iss(line);
-                int accuracy;
-                if (iss >> accuracy) {
-                    exerciseInfo.accuracy = accuracy;
-                }
-                else {
-                    throw std::runtime_error("Invalid accuracy format: " + line);
-                }
-            } else if (currentSection == "PausingTime") {
-                std::istringstream iss(line);
-                int pausingTime;
-                if (iss >> pausingTime) {
-                    exerciseInfo.pausingTime = pausingTime;
-                }
-                else {
-                    throw std::runtime_error("Invalid pausingTime format: " + line);
-                }
-            } else if (currentSection == "TargetBearing") {
-                std::istringstream iss(line);
-                signed int targetBearing;
-                if (iss >> targetBearing) {
-                    exerciseInfo.targetBearings = targetBearing;
-                }
-                else {
-                    throw std::runtime_error("Invalid targetBearing format: " + line);
-                }
-            }  else if (currentSection == "ShowWaypoints") {
-                std::istringstream iss(line);
-                int showWaypoints;
-                if (iss >> showWaypoints) {
-                    exerciseInfo.showWaypoints = static_cast<bool>(showWaypoints);
-                }
-                else {
-                    throw std::runtime_error("Invalid showWaypoints format: " + line);
-                }
-            } else if (currentSection == "ShowGuideline") {
-                std::istringstream iss(line);
-                int showGuideline;
-                if (iss >> showGuideline) {
-                    exerciseInfo.showGuideline = static_cast<bool>(showGuideline);
-                }
-                else {
-                    throw std::runtime_error("Invalid showGuideline format: " + line);
-                }
-            } else if (currentSection == "ScoringMethod") {
-                std::istringstream iss(line);
-                int scoringMethod;
-                if (iss >> scoringMethod) {
-                    exerciseInfo.scoringMethod = static_cast<ScoringMethod>(scoringMethod);
-                }
-                else {
-                    throw std::runtime_error("Invalid scoringMethod format: " + line);
-                }
-            } else if (currentSection == "ConnectionInfo") {
-                std::istringstream iss(line);
-                std::string remoteIp;
-                int port;
-                if (iss >> remoteIp >> port) {
-                    connectionInfo = ConnectionConfigurationInfo(remoteIp, port);
-                }
-                else {
-                    throw std::runtime_error("Invalid connectionInfo format: " + line);
-                }
-            }
-		}
-
-        file.close();
-
-        std::unique_ptr<FlightConfig> flConf = std::make_unique<FlightConfig>(
-            std::move(operatorPosition),
-            std::move(waypoints),
-            std::move(markers),
-            std::move(obstacles),
-            std::move(exerciseInfo),
-            std::move(connectionInfo)
-        );
-
-		return flConf;
-	}
-
-} // namespace configuration
+/**
+ * @file ConfigurationManager.cpp
+ * @brief Configuration file parser code.
+ *
+ * @details This file contains the definition of configuration file parser.
+ *
+ * @author Szymon Bogus
+ * @date 2024-05-26
+ *
+ * @copyright Copyright 2024 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include "../include/ConfigurationManager.h"
+
+
+namespace configuration {
+
+	std::unique_ptr<FlightConfig> ConfigurationManager::loadConfig(const std::filesystem::path& configFilePath)
+	{
+		if (!std::filesystem::exists(configFilePath))
+		{
+			throw std::runtime_error("File not found: " + configFilePath.string());
+		}
+
+		/***********************************************
+		* Initializing vectors and objects to hold 
+		* particular part of the configuration file
+		************************************************/
+		OperatorPosition operatorPosition;
+		std::vector<Waypoint> waypoints;
+		std::vector<Marker> markers;
+		std::vector<Obstackle> obstacles;
+		ExerciseInfo exerciseInfo;
+		ConnectionConfigurationInfo connectionInfo;
+		std::uint32_t baudRate = ConnectionConfigurationInfo::DEFAULT_BAUD_RATE;
+		WireFormat wireFormat = WireFormat::TEXT;
+		std::uint32_t coalescingWindowUs = 0;
+		std::uint32_t outputRateHz = 0;
+		PositionFrame positionFrame = PositionFrame::GPS;
+		std::uint32_t predictionHorizonMs = 0;
+		std::vector<int> processingCores;
+		std::vector<ConnectionConfigurationInfo::Endpoint> endpoints;
+
+		std::ifstream file(configFilePath);
+		std::string line;
+		std::string currentSection;
+
+		while (std::getline(file, line)) {
+			// Ignore comments and empty lines
+			if (line.empty() || line[0] == '#') {
+				continue;
+			}
+
+			// Check for section headers (e.g., "Waypoints:")
+			if (line.back() == ':') {
+				currentSection = line.substr(0, line.size() - 1); // Remove the trailing ':'
+				continue;
+			}
+
+            if (line == "File End") {
+                break; // Break iterating and move to FlighConfig instantiation
+            }
+
+			// Process data based on the current section
+            if (currentSection == "Title") {
+                exerciseInfo.title = line;
+            } else if (currentSection == "Author") {
+                exerciseInfo.author = line;
+            } else if (currentSection == "Operator position") {
+                std::istringstream iss(line);
+                double lat, lon, alt;
+                if (iss >> lat >> lon >> alt) {
+                    operatorPosition = OperatorPosition(lat, lon, alt);
+                }
+                else {
+                    throw std::runtime_error("Invalid operator position format: " + line);
+                }
+            } else if (currentSection == "Waypoints") {
+                std::istringstream iss(line);
+                double x, y, z; // Depending on the coordinate system, this could be lat, lon, alt
+                if (iss >> x >> y >> z) {
+                    waypoints.emplace_back(x, y, z);
+                }
+                else {
+                    throw std::runtime_error("Invalid waypoint format: " + line);
+                }
+            } else if (currentSection == "Markers") {
+                std::istringstream iss(line);
+                double x, y, z, radius; // Depending on the coordinate system, this could be lat, lon, alt + radius
+                if (iss >> x >> y >> z >> radius) {
+                    markers.emplace_back(x, y, z, radius);
+                }
+                else {
+                    throw std::runtime_error("Invalid marker format: " + line);
+                }
+            } else if (currentSection == "Obstacles") {
+                std::istringstream iss(line);
+                double centerX, centerY, centerZ, width, length, height, rotX, rotY, rotZ;
+                if (iss >> centerX >> centerY >> centerZ >> width >> length >> height >> rotX >> rotY >> rotZ) {
+                    obstacles.emplace_back(centerX, centerY, centerZ, width, length, height, rotX, rotY, rotZ);
+                }
+                else {
+                    throw std::runtime_error("Invalid obstackle format: " + line);
+                }
+            } else if (currentSection == "CoordsInGps") {
+                std::istringstream iss(line);
+                int coordsInGps;
+                if (iss >> coordsInGps) {
+                    exerciseInfo.coordinatesSystem = static_cast<CoorindatesSystem>(coordsInGps);
+                }
+                else {
+                    throw std::runtime_error("Invalid coordsInGps format: " + line);
+                }
+            } else if (currentSection == "AltitudeDiffIgnore") {
+                std::istringstream iss(line);
+                int altitudeDifference;
+                if (iss >> altitudeDifference) {
+                    exerciseInfo.altitudeDifference = static_cast<AltitudeDifference>(altitudeDifference);
+                }
+                else {
+                    throw std::runtime_error("Invalid altitudeDifference format: " + line);
+                }
+            } else if (currentSection == "GuidelineOffset") {
+                std::istringstream iss(line);
+                float guidelineOffset;
+                if (iss >> guidelineOffset) {
+                    exerciseInfo.guidelineOffset = guidelineOffset;
+                }
+                else {
+                    throw std::runtime_error("Invalid guidelineOffset format: " + line);
+                }
+            } else if (currentSection == "DistanceWeight") {
+                std::istringstream iss(line);
+                int distanceWeight;
+                if (iss >> distanceWeight) {
+                    exerciseInfo.distanceWeight = distanceWeight;
+                }
+                else {
+                    throw std::runtime_error("Invalid distanceWeight format: " + line);
+                }
+            } else if (currentSection == "AltitudeWeight") {
+                std::istringstream iss(line);
+                int attitudeWeight;
+                if (iss >> attitudeWeight) {
+                    exerciseInfo.altitudeWeight = attitudeWeight;
+                }
+                else {
+                    throw std::runtime_error("Invalid attitudeWeight format: " + line);
+                }
+            } else if (currentSection == "SpeedWeight") {
+                std::istringstream iss(line);
+                int speedWeight;
+                if (iss >> speedWeight) {
+                    exerciseInfo.speedWeight = speedWeight;
+                }
+                else {
+                    throw std::runtime_error("Invalid speedWeight format: " + line);
+                }  
+            } else if (currentSection == "TargetSpeed") {
+                std::istringstream iss(line);
+                float targetSpeed;
+                if (iss >> targetSpeed) {
+                    exerciseInfo.targetSpeed = targetSpeed;
+                }
+                else {
+                    throw std::runtime_error("Invalid targetSpeed format: " + line);
+                }
+            }
+            else if (currentSection == "Accuracy") {
+                std::istringstream iss(line);
+                int accuracy;
+                if (iss >> accuracy) {
+                    exerciseInfo.accuracy = accuracy;
+                }
+                else {
+                    throw std::runtime_error("Invalid accuracy format: " + line);
+                }
+            } else if (currentSection == "PausingTime") {
+                std::istringstream iss(line);
+                int pausingTime;
+                if (iss >> pausingTime) {
+                    exerciseInfo.pausingTime = pausingTime;
+                }
+                else {
+                    throw std::runtime_error("Invalid pausingTime format: " + line);
+                }
+            } else if (currentSection == "TargetBearing") {
+                std::istringstream iss(line);
+                signed int targetBearing;
+                if (iss >> targetBearing) {
+                    exerciseInfo.targetBearings = targetBearing;
+                }
+                else {
+                    throw std::runtime_error("Invalid targetBearing format: " + line);
+                }
+            }  else if (currentSection == "ShowWaypoints") {
+                std::istringstream iss(line);
+                int showWaypoints;
+                if (iss >> showWaypoints) {
+                    exerciseInfo.showWaypoints = static_cast<bool>(showWaypoints);
+                }
+                else {
+                    throw std::runtime_error("Invalid showWaypoints format: " + line);
+                }
+            } else if (currentSection == "ShowGuideline") {
+                std::istringstream iss(line);
+                int showGuideline;
+                if (iss >> showGuideline) {
+                    exerciseInfo.showGuideline = static_cast<bool>(showGuideline);
+                }
+                else {
+                    throw std::runtime_error("Invalid showGuideline format: " + line);
+                }
+            } else if (currentSection == "ScoringMethod") {
+                std::istringstream iss(line);
+                int scoringMethod;
+                if (iss >> scoringMethod) {
+                    exerciseInfo.scoringMethod = static_cast<ScoringMethod>(scoringMethod);
+                }
+                else {
+                    throw std::runtime_error("Invalid scoringMethod format: " + line);
+                }
+            } else if (currentSection == "ConnectionInfo") {
+                std::istringstream iss(line);
+                std::string remoteIp;
+                int port;
+                if (iss >> remoteIp >> port) {
+                    // Every line is a receiver, the first one is the primary
+                    const ConnectionConfigurationInfo endpointInfo(remoteIp, port);
+                    if (endpoints.empty()) {
+                        connectionInfo = endpointInfo;
+                    }
+                    endpoints.push_back({remoteIp, port});
+                }
+                else {
+                    throw std::runtime_error("Invalid connectionInfo format: " + line);
+                }
+            } else if (currentSection == "BaudRate") {
+                std::istringstream iss(line);
+                std::string baudRateStr;
+                iss >> baudRateStr;
+                if (baudRateStr == "auto") {
+                    baudRate = ConnectionConfigurationInfo::AUTO_BAUD_RATE;
+                } else {
+                    std::istringstream baudIss(baudRateStr);
+                    if (!(baudIss >> baudRate)) {
+                        throw std::runtime_error("Invalid baudRate format: " + line);
+                    }
+                }
+            } else if (currentSection == "WireFormat") {
+                std::istringstream iss(line);
+                int wireFormatNum;
+                if (iss >> wireFormatNum && wireFormatNum >= 0 && wireFormatNum <= 2) {
+                    wireFormat = static_cast<WireFormat>(wireFormatNum);
+                }
+                else {
+                    throw std::runtime_error("Invalid wireFormat format: " + line);
+                }
+            } else if (currentSection == "CoalescingWindow") {
+                std::istringstream iss(line);
+                if (!(iss >> coalescingWindowUs)) {
+                    throw std::runtime_error("Invalid coalescingWindow format: " + line);
+                }
+            } else if (currentSection == "OutputRate") {
+                std::istringstream iss(line);
+                if (!(iss >> outputRateHz)) {
+                    throw std::runtime_error("Invalid outputRate format: " + line);
+                }
+            } else if (currentSection == "PositionFrame") {
+                std::istringstream iss(line);
+                int positionFrameNum;
+                if (iss >> positionFrameNum && positionFrameNum >= 0 && positionFrameNum <= 1) {
+                    positionFrame = static_cast<PositionFrame>(positionFrameNum);
+                }
+                else {
+                    throw std::runtime_error("Invalid positionFrame format: " + line);
+                }
+            } else if (currentSection == "PredictionHorizon") {
+                std::istringstream iss(line);
+                if (!(iss >> predictionHorizonMs)) {
+                    throw std::runtime_error("Invalid predictionHorizon format: " + line);
+                }
+            } else if (currentSection == "ProcessingCores") {
+                // Checked against the number of stages by TelemetryProcessor
+                std::istringstream iss(line);
+                int core;
+                processingCores.clear();
+                while (iss >> core && core >= -1) {
+                    processingCores.push_back(core);
+                }
+                if (processingCores.empty() || !iss.eof()) {
+                    throw std::runtime_error("Invalid processingCores format: " + line);
+                }
+            }
+		}
+
+        file.close();
+
+        // Sections may come in any order, so connection details are applied last
+        connectionInfo.baudRate = baudRate;
+        connectionInfo.wireFormat = wireFormat;
+        connectionInfo.coalescingWindowUs = coalescingWindowUs;
+        connectionInfo.outputRateHz = outputRateHz;
+        connectionInfo.positionFrame = positionFrame;
+        connectionInfo.predictionHorizonMs = predictionHorizonMs;
+        connectionInfo.processingCores = processingCores;
+        if (endpoints.empty()) {
+            endpoints.push_back({connectionInfo.remoteIp, connectionInfo.port});
+        }
+        connectionInfo.endpoints = endpoints;
+
+        std::unique_ptr<FlightConfig> flConf = std::make_unique<FlightConfig>(
+            std::move(operatorPosition),
+            std::move(waypoints),
+            std::move(markers),
+            std::move(obstacles),
+            std::move(exerciseInfo),
+            std::move(connectionInfo)
+        );
+
+		return flConf;
+	}
+
+} // namespace configuration
@@ -0,0 +1,227 @@
+/**
+ * @file DeltaCodec.cpp
+ * @brief Code of the quantised delta encoding of telemetry.
+ *
+ * @details This file contains the definition of DeltaEncoder and DeltaDecoder. Differences are
+ *          computed modulo 2^32, so they always fit 32-bit zigzag varints, even when a value
+ *          wraps, e.g. yaw crossing +-pi.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "../include/DeltaCodec.h"
+
+
+namespace wire {
+
+namespace {
+
+inline std::uint8_t *putVarint(std::uint8_t *out, std::uint64_t value) {
+  while (value >= 0x80) {
+    *out++ = static_cast<std::uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  *out++ = static_cast<std::uint8_t>(value);
+  return out;
+}
+
+inline std::uint32_t zigzag32(std::int32_t value) {
+  return (static_cast<std::uint32_t>(value) << 1) ^
+         static_cast<std::uint32_t>(value >> 31);
+}
+
+inline std::uint64_t zigzag64(std::int64_t value) {
+  return (static_cast<std::uint64_t>(value) << 1) ^
+         static_cast<std::uint64_t>(value >> 63);
+}
+
+inline std::int64_t unzigzag(std::uint64_t value) {
+  return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+inline bool getVarint(const std::uint8_t *&in, const std::uint8_t *end,
+                      std::uint64_t &value) {
+  value = 0;
+  for (unsigned shift = 0; shift < 64 && in < end; shift += 7) {
+    const std::uint8_t byte = *in++;
+    value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+inline std::int32_t toFixed(double value, double resolution) {
+  const double scaled = std::round(value / resolution);
+  if (!(scaled == scaled)) {
+    return 0; // NaN
+  }
+  return static_cast<std::int32_t>(
+      std::clamp(scaled, static_cast<double>(std::numeric_limits<std::int32_t>::min()),
+                 static_cast<double>(std::numeric_limits<std::int32_t>::max())));
+}
+
+// Difference modulo 2^32, undone by wrapAdd
+inline std::int32_t wrapSub(std::int32_t value, std::int32_t base) {
+  return static_cast<std::int32_t>(static_cast<std::uint32_t>(value) -
+                                   static_cast<std::uint32_t>(base));
+}
+
+inline std::int32_t wrapAdd(std::int32_t base, std::int32_t delta) {
+  return static_cast<std::int32_t>(static_cast<std::uint32_t>(base) +
+                                   static_cast<std::uint32_t>(delta));
+}
+
+} // namespace
+
+QuantisedSample DeltaEncoder::quantise(const TelemetrySample &telemetry) {
+  QuantisedSample sample;
+  sample.timestampNs = telemetry.attitudeHostTimeNs;
+  sample.validFields = telemetry.validFields;
+  const bool isLocal = telemetry.has(TelemetrySample::LOCAL_FRAME);
+  sample.values = {toFixed(telemetry.roll, ANGLE_RESOLUTION_RAD),
+                   toFixed(telemetry.pitch, ANGLE_RESOLUTION_RAD),
+                   toFixed(telemetry.yaw, ANGLE_RESOLUTION_RAD),
+                   isLocal ? toFixed(telemetry.east, 1E-3) : telemetry.latE7,
+                   isLocal ? toFixed(telemetry.north, 1E-3) : telemetry.lonE7,
+                   isLocal ? toFixed(telemetry.up, 1E-3) : telemetry.altMm,
+                   telemetry.relativeAltMm,
+                   toFixed(telemetry.velocityNorth, VELOCITY_RESOLUTION_MS),
+                   toFixed(telemetry.velocityEast, VELOCITY_RESOLUTION_MS),
+                   toFixed(telemetry.velocityDown, VELOCITY_RESOLUTION_MS)};
+  return sample;
+}
+
+std::size_t DeltaEncoder::encode(const TelemetrySample &telemetry,
+                                 std::uint32_t sequence,
+                                 std::int64_t sendTimeNs, std::uint8_t *buffer) {
+  const QuantisedSample sample = quantise(telemetry);
+  Keyframe &keyframe = m_keyframes[telemetry.systemId];
+  const bool isKeyframe = keyframe.samplesSince >= KEYFRAME_INTERVAL;
+  if (isKeyframe) {
+    keyframe.sample = sample;
+    keyframe.id++;
+    keyframe.samplesSince = 0;
+  }
+  keyframe.samplesSince++;
+
+  std::uint8_t flags = isKeyframe ? DELTA_FLAG_KEYFRAME : 0;
+  if (telemetry.isTimeSynced) {
+    flags |= DELTA_FLAG_TIME_SYNCED;
+  }
+  if (telemetry.has(TelemetrySample::LOCAL_FRAME)) {
+    flags |= DELTA_FLAG_LOCAL_FRAME;
+  }
+  if (telemetry.isPredicted) {
+    flags |= DELTA_FLAG_PREDICTED;
+  }
+  const std::int64_t captureAgeUs =
+      std::max<std::int64_t>(0, sendTimeNs - sample.timestampNs) / 1000;
+
+  std::uint8_t *out = buffer;
+  *out++ = static_cast<std::uint8_t>(DELTA_MAGIC);
+  *out++ = static_cast<std::uint8_t>(DELTA_MAGIC >> 8);
+  *out++ = flags;
+  *out++ = telemetry.systemId;
+  *out++ = static_cast<std::uint8_t>(sequence);
+  *out++ = static_cast<std::uint8_t>(sequence >> 8);
+  *out++ = keyframe.id;
+  out = putVarint(out, sample.validFields);
+  if (isKeyframe) {
+    for (std::size_t idx = 0; idx < sizeof(std::int64_t); ++idx) {
+      *out++ = static_cast<std::uint8_t>(
+          static_cast<std::uint64_t>(sample.timestampNs) >> (8 * idx));
+    }
+  } else {
+    out = putVarint(out, zigzag64((sample.timestampNs - keyframe.sample.timestampNs) / 1000));
+  }
+  out = putVarint(out, static_cast<std::uint64_t>(
+                           std::min<std::int64_t>(captureAgeUs, UINT32_MAX)));
+  for (std::size_t idx = 0; idx < QUANTISED_FIELDS_NUM; ++idx) {
+    const std::int32_t value =
+        isKeyframe ? sample.values[idx]
+                   : wrapSub(sample.values[idx], keyframe.sample.values[idx]);
+    out = putVarint(out, zigzag32(value));
+  }
+  return static_cast<std::size_t>(out - buffer);
+}
+
+DeltaResult DeltaDecoder::decode(const std::uint8_t *buffer, std::size_t size,
+                                 std::uint8_t &vehicleId,
+                                 QuantisedSample &sample) {
+  const std::uint8_t *in = buffer;
+  const std::uint8_t *end = buffer + size;
+  if (size < 7 || (in[0] | (in[1] << 8)) != DELTA_MAGIC) {
+    return {};
+  }
+  const std::uint8_t flags = in[2];
+  vehicleId = in[3];
+  sample.flags = flags;
+  sample.sequence = static_cast<std::uint16_t>(in[4] | (in[5] << 8));
+  const std::uint8_t keyframeId = in[6];
+  in += 7;
+
+  std::uint64_t value;
+  if (!getVarint(in, end, value)) {
+    return {};
+  }
+  sample.validFields = static_cast<std::uint32_t>(value);
+
+  const bool isKeyframe = (flags & DELTA_FLAG_KEYFRAME) != 0;
+  if (isKeyframe) {
+    if (end - in < 8) {
+      return {};
+    }
+    std::uint64_t timestampNs = 0;
+    for (std::size_t idx = 0; idx < sizeof(std::int64_t); ++idx) {
+      timestampNs |= static_cast<std::uint64_t>(*in++) << (8 * idx);
+    }
+    sample.timestampNs = static_cast<std::int64_t>(timestampNs);
+  } else {
+    if (!getVarint(in, end, value)) {
+      return {};
+    }
+    sample.timestampNs = unzigzag(value) * 1000; // relative until the keyframe is added
+  }
+  if (!getVarint(in, end, value)) {
+    return {};
+  }
+  sample.captureAgeUs = static_cast<std::uint32_t>(value);
+  for (std::size_t idx = 0; idx < QUANTISED_FIELDS_NUM; ++idx) {
+    if (!getVarint(in, end, value)) {
+      return {};
+    }
+    sample.values[idx] = static_cast<std::int32_t>(unzigzag(value));
+  }
+
+  const std::size_t consumedNum = static_cast<std::size_t>(in - buffer);
+  Keyframe &keyframe = m_keyframes[vehicleId];
+  if (isKeyframe) {
+    keyframe.sample = sample;
+    keyframe.id = keyframeId;
+    keyframe.isValid = true;
+  } else {
+    if (!keyframe.isValid || keyframe.id != keyframeId) {
+      return {consumedNum, DeltaStatus::KEYFRAME_MISSING}; // the keyframe has been lost
+    }
+    sample.timestampNs += keyframe.sample.timestampNs;
+    for (std::size_t idx = 0; idx < QUANTISED_FIELDS_NUM; ++idx) {
+      sample.values[idx] = wrapAdd(keyframe.sample.values[idx], sample.values[idx]);
+    }
+  }
+  return {consumedNum, DeltaStatus::DECODED};
+}
+
+} // namespace wire
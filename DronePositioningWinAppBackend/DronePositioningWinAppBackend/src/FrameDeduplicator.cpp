@@ -0,0 +1,57 @@
+/**
+ * @file FrameDeduplicator.cpp
+ * @brief Code of the deduplication of MAVLink frames received over redundant links.
+ *
+ * @details This file contains the definition of FrameDeduplicator.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include "../include/FrameDeduplicator.h"
+
+
+FrameDeduplicator::Result
+FrameDeduplicator::onFrame(const mavlink_message_t &message,
+                           const std::size_t linkIdx,
+                           const std::int64_t arrivalNs) {
+  const std::uint64_t key = key_(message);
+  const std::uint8_t linkBit = static_cast<std::uint8_t>(1u << linkIdx);
+
+  // The window is small enough for a linear scan to beat hashing
+  for (Entry &entry : m_window) {
+    if (entry.key == key) {
+      entry.linksMask |= linkBit;
+      m_duplicatesNum++;
+      return Result{false, arrivalNs - entry.arrivalNs};
+    }
+  }
+
+  m_window[m_nextIdx] = Entry{key, arrivalNs, linkBit};
+  m_nextIdx = (m_nextIdx + 1) % WINDOW_SIZE;
+  m_firstNum[linkIdx]++;
+  return Result{true, 0};
+}
+
+std::uint64_t FrameDeduplicator::getFirstNum(const std::size_t linkIdx) const {
+  return m_firstNum.at(linkIdx);
+}
+
+std::uint64_t FrameDeduplicator::getDuplicatesNum() const {
+  return m_duplicatesNum;
+}
+
+std::uint64_t FrameDeduplicator::key_(const mavlink_message_t &message) {
+  // 1 in the top bit keeps every key non-zero, so empty entries never match
+  return (1ull << 63) |
+         (static_cast<std::uint64_t>(message.sysid) << 40) |
+         (static_cast<std::uint64_t>(message.compid) << 32) |
+         (static_cast<std::uint64_t>(message.msgid) << 8) |
+         message.seq;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file GuidelineTracker.cpp
+ * @brief Code of the incremental tracking of vehicles along the guideline.
+ *
+ * @details This file contains the definition of GuidelineTracker.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "../include/GuidelineTracker.h"
+
+
+GuidelineTracker::GuidelineTracker(const std::vector<Waypoint> &waypoints, const LocalFrame &frame,
+                                   CoorindatesSystem coordinatesSystem, double guidelineOffset) {
+  if (waypoints.empty()) {
+    return;
+  }
+  std::vector<std::array<double, 3>> vertices(waypoints.size());
+  for (std::size_t idx = 0; idx < waypoints.size(); ++idx) {
+    frame.toEnu(waypoints[idx], coordinatesSystem, vertices[idx][0], vertices[idx][1],
+                vertices[idx][2]);
+    vertices[idx][2] += guidelineOffset;
+  }
+
+  // A single waypoint is a segment from and to itself
+  const std::size_t segmentsNum = std::max<std::size_t>(vertices.size() - 1, 1);
+  m_segments.reserve(segmentsNum);
+  double progress = 0.0;
+  for (std::size_t idx = 0; idx < segmentsNum; ++idx) {
+    const std::array<double, 3> &start = vertices[idx];
+    const std::array<double, 3> &end = vertices[std::min(idx + 1, vertices.size() - 1)];
+    Segment segment;
+    segment.startEast = start[0];
+    segment.startNorth = start[1];
+    segment.startUp = start[2];
+    segment.deltaEast = end[0] - start[0];
+    segment.deltaNorth = end[1] - start[1];
+    segment.deltaUp = end[2] - start[2];
+    const double lengthSq = segment.deltaEast * segment.deltaEast + segment.deltaNorth * segment.deltaNorth;
+    segment.inverseLengthSq = lengthSq > 0.0 ? 1.0 / lengthSq : 0.0;
+    segment.length = std::sqrt(lengthSq + segment.deltaUp * segment.deltaUp);
+    segment.startProgress = progress;
+    progress += segment.length;
+    m_segments.push_back(segment);
+  }
+}
+
+GuidelineTracker::Projection GuidelineTracker::track(Cursor &cursor, double east, double north,
+                                                     double up) const {
+  Projection projection;
+  if (m_segments.empty()) {
+    return projection;
+  }
+  if (cursor.isValid) {
+    std::size_t first = cursor.segmentIdx > NEIGHBOURHOOD ? cursor.segmentIdx - NEIGHBOURHOOD : 0;
+    std::size_t last = std::min(cursor.segmentIdx + NEIGHBOURHOOD + 1, m_segments.size());
+    double distanceSq = search_(first, last, east, north, up, projection);
+
+    // The closest segment at an end of the window, the vehicle may be further along
+    Projection candidate;
+    while (projection.segmentIdx == last - 1 && last < m_segments.size()) {
+      const double candidateDistanceSq = project_(last++, east, north, up, candidate);
+      if (candidateDistanceSq >= distanceSq) {
+        break;
+      }
+      distanceSq = candidateDistanceSq;
+      projection = candidate;
+    }
+    while (projection.segmentIdx == first && first > 0) {
+      const double candidateDistanceSq = project_(--first, east, north, up, candidate);
+      if (candidateDistanceSq >= distanceSq) {
+        break;
+      }
+      distanceSq = candidateDistanceSq;
+      projection = candidate;
+    }
+    projection.distance = std::sqrt(distanceSq);
+  }
+  if (!cursor.isValid || projection.distance > cursor.distance + JUMP_DISTANCE) {
+    projection = findClosest(east, north, up);
+  }
+  cursor.segmentIdx = projection.segmentIdx;
+  cursor.distance = projection.distance;
+  cursor.isValid = true;
+  return projection;
+}
+
+GuidelineTracker::Projection GuidelineTracker::findClosest(double east, double north,
+                                                           double up) const {
+  Projection projection;
+  if (!m_segments.empty()) {
+    projection.distance = std::sqrt(search_(0, m_segments.size(), east, north, up, projection));
+  }
+  return projection;
+}
+
+double GuidelineTracker::getLength() const {
+  return m_segments.empty() ? 0.0 : m_segments.back().startProgress + m_segments.back().length;
+}
+
+double GuidelineTracker::project_(std::size_t segmentIdx, double east, double north, double up,
+                                  Projection &projection) const {
+  const Segment &segment = m_segments[segmentIdx];
+  const double relativeEast = east - segment.startEast;
+  const double relativeNorth = north - segment.startNorth;
+  const double fraction = std::clamp(
+      (relativeEast * segment.deltaEast + relativeNorth * segment.deltaNorth) * segment.inverseLengthSq,
+      0.0, 1.0);
+  const double offsetEast = relativeEast - fraction * segment.deltaEast;
+  const double offsetNorth = relativeNorth - fraction * segment.deltaNorth;
+  projection.segmentIdx = segmentIdx;
+  projection.fraction = fraction;
+  projection.altitude = up - (segment.startUp + fraction * segment.deltaUp);
+  projection.progress = segment.startProgress + fraction * segment.length;
+  return offsetEast * offsetEast + offsetNorth * offsetNorth;
+}
+
+double GuidelineTracker::search_(std::size_t first, std::size_t last, double east, double north,
+                                 double up, Projection &projection) const {
+  double closestDistanceSq = std::numeric_limits<double>::infinity();
+  Projection candidate;
+  for (std::size_t idx = first; idx < last; ++idx) {
+    const double distanceSq = project_(idx, east, north, up, candidate);
+    if (distanceSq < closestDistanceSq) {
+      closestDistanceSq = distanceSq;
+      projection = candidate;
+    }
+  }
+  return closestDistanceSq;
+}
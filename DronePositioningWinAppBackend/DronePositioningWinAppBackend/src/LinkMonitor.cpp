@@ -0,0 +1,248 @@
+/**
+ * @file LinkMonitor.cpp
+ * @brief Code of the telemetry link quality monitor.
+ *
+ * @details This file contains the definition of LinkMonitor. Counters are fed by the receiving
+ *          thread through relaxed atomics, while the evaluation of link state happens on the
+ *          single thread which ticks the TimerWheel.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include "../include/LinkMonitor.h"
+
+
+LinkMonitor::LinkMonitor(IPublisher *publisher, const std::string &who,
+                         std::uint32_t referenceMsgId, bool isVerbose)
+    : m_referenceMsgId(referenceMsgId), m_publisher(publisher), m_who(who),
+      m_verbose(isVerbose) {}
+
+LinkMonitor::~LinkMonitor() {
+  stop();
+  m_publisher = nullptr;
+}
+
+std::size_t LinkMonitor::addLink() {
+  if (m_linksNum == MAX_LINKS_NUM) {
+    throw std::runtime_error("LinkMonitor: too many links");
+  }
+  const std::size_t linkId = m_linksNum++;
+  m_links[linkId].heartbeatTimer = m_wheel.addTimer([this, linkId]() {
+    m_links[linkId].isHeartbeatLost.store(true, std::memory_order_relaxed);
+    evaluate_(linkId);
+  });
+  m_links[linkId].statsTimer = m_wheel.addTimer([this, linkId]() {
+    updateStats_(linkId);
+    evaluate_(linkId);
+    m_wheel.arm(m_links[linkId].statsTimer, STATS_PERIOD_TICKS);
+  });
+  return linkId;
+}
+
+void LinkMonitor::start() {
+  for (std::size_t linkId = 0; linkId < m_linksNum; ++linkId) {
+    m_wheel.arm(m_links[linkId].statsTimer, STATS_PERIOD_TICKS);
+  }
+  m_tickThread = std::jthread([this](std::stop_token stopToken) { run_(stopToken); });
+}
+
+void LinkMonitor::stop() {
+  if (m_tickThread.joinable()) {
+    m_tickThread.request_stop();
+    m_tickThread.join();
+  }
+}
+
+void LinkMonitor::onBytes(const std::size_t linkId, const std::size_t bytesNum) {
+  LinkStats &link = m_links[linkId];
+  link.bytes.fetch_add(bytesNum, std::memory_order_relaxed);
+  if (link.isReadError.load(std::memory_order_relaxed)) {
+    link.isReadError.store(false, std::memory_order_relaxed);
+  }
+}
+
+void LinkMonitor::onFrame(const std::size_t linkId,
+                          const mavlink_message_t &message) {
+  LinkStats &link = m_links[linkId];
+  link.frames.fetch_add(1, std::memory_order_relaxed);
+
+  // Sequence numbers are kept separately by every sender (sysid, compid)
+  SequenceTracker *tracker = nullptr;
+  for (std::size_t i = 0; i < link.sendersNum; ++i) {
+    if (link.senders[i].systemId == message.sysid &&
+        link.senders[i].componentId == message.compid) {
+      tracker = &link.senders[i];
+      break;
+    }
+  }
+  if (tracker) {
+    const std::uint8_t gap =
+        static_cast<std::uint8_t>(message.seq - tracker->lastSeq - 1);
+    // Large "gaps" are duplicates, reordering or a sender restart- not a loss
+    if (gap > 0 && gap < 128) {
+      link.seqGaps.fetch_add(gap, std::memory_order_relaxed);
+    }
+    tracker->lastSeq = message.seq;
+  } else if (link.sendersNum < TRACKED_SENDERS_NUM) {
+    link.senders[link.sendersNum++] = {message.sysid, message.compid, message.seq};
+  }
+
+  // Inter-arrival jitter of the reference stream (RFC 3550 estimator)
+  if (message.msgid == m_referenceMsgId) {
+    const Clock::time_point now = Clock::now();
+    if (link.lastReferenceArrival != Clock::time_point{}) {
+      const float intervalMs =
+          std::chrono::duration<float, std::milli>(now - link.lastReferenceArrival).count();
+      if (link.lastReferenceIntervalMs >= 0.0f) {
+        const float jitter = link.jitterMs.load(std::memory_order_relaxed);
+        const float d = std::abs(intervalMs - link.lastReferenceIntervalMs);
+        link.jitterMs.store(jitter + (d - jitter) / 16.0f, std::memory_order_relaxed);
+      }
+      link.lastReferenceIntervalMs = intervalMs;
+    }
+    link.lastReferenceArrival = now;
+  }
+}
+
+void LinkMonitor::onParseErrors(const std::size_t linkId,
+                                const std::uint32_t errorsNum) {
+  m_links[linkId].parseErrors.fetch_add(errorsNum, std::memory_order_relaxed);
+}
+
+void LinkMonitor::onHeartbeat(const std::size_t linkId,
+                              const std::uint8_t systemStatus) {
+  LinkStats &link = m_links[linkId];
+  link.lastHeartbeatNs.store(nowNs_(), std::memory_order_relaxed);
+  link.systemStatus.store(systemStatus, std::memory_order_relaxed);
+  link.isHeartbeatLost.store(false, std::memory_order_relaxed);
+  m_wheel.arm(link.heartbeatTimer, HEARTBEAT_TIMEOUT_TICKS);
+}
+
+void LinkMonitor::onRelativeLatency(const std::size_t linkId,
+                                    const float lagMs) {
+  // Exponentially weighted mean, same gain as RFC 3550 jitter
+  std::atomic<float> &latency = m_links[linkId].relativeLatencyMs;
+  const float prevLatency = latency.load(std::memory_order_relaxed);
+  latency.store(prevLatency + (lagMs - prevLatency) / 16.0f,
+                std::memory_order_relaxed);
+}
+
+void LinkMonitor::onReadError(const std::size_t linkId) {
+  m_links[linkId].isReadError.store(true, std::memory_order_relaxed);
+}
+
+LinkQuality LinkMonitor::getQuality(const std::size_t linkId) const {
+  const LinkStats &link = m_links[linkId];
+  LinkQuality quality;
+  quality.linkId = linkId;
+  quality.state = link.state.load(std::memory_order_relaxed);
+  quality.lossRate = link.lossRate.load(std::memory_order_relaxed);
+  quality.jitterMs = link.jitterMs.load(std::memory_order_relaxed);
+  quality.bytesPerSecond = link.bytesPerSecond.load(std::memory_order_relaxed);
+  quality.seqGaps = link.seqGaps.load(std::memory_order_relaxed);
+  quality.parseErrors = link.parseErrors.load(std::memory_order_relaxed);
+  quality.relativeLatencyMs = link.relativeLatencyMs.load(std::memory_order_relaxed);
+
+  const std::int64_t lastHeartbeatNs = link.lastHeartbeatNs.load(std::memory_order_relaxed);
+  quality.heartbeatAgeMs =
+      lastHeartbeatNs == 0
+          ? UINT32_MAX
+          : static_cast<std::uint32_t>((nowNs_() - lastHeartbeatNs) / 1000000);
+  return quality;
+}
+
+void LinkMonitor::updateStats_(const std::size_t linkId) {
+  LinkStats &link = m_links[linkId];
+  const std::uint64_t bytes = link.bytes.load(std::memory_order_relaxed);
+  const std::uint64_t frames = link.frames.load(std::memory_order_relaxed);
+  // A frame dropped by the parser also leaves a sequence gap, so parse errors aren't added
+  const std::uint32_t gaps = link.seqGaps.load(std::memory_order_relaxed);
+
+  const float periodS = std::chrono::duration<float>(TICK * STATS_PERIOD_TICKS).count();
+  link.bytesPerSecond.store((bytes - link.prevBytes) / periodS, std::memory_order_relaxed);
+
+  link.windowFrames[link.windowIdx] = frames - link.prevFrames;
+  link.windowGaps[link.windowIdx] = gaps - link.prevGaps;
+  link.windowIdx = (link.windowIdx + 1) % LOSS_WINDOW_NUM;
+  link.prevBytes = bytes;
+  link.prevFrames = frames;
+  link.prevGaps = gaps;
+
+  std::uint64_t windowFrames = 0;
+  std::uint64_t windowGaps = 0;
+  for (std::size_t i = 0; i < LOSS_WINDOW_NUM; ++i) {
+    windowFrames += link.windowFrames[i];
+    windowGaps += link.windowGaps[i];
+  }
+  const std::uint64_t expected = windowFrames + windowGaps;
+  link.lossRate.store(expected ? static_cast<float>(windowGaps) / expected : 0.0f,
+                      std::memory_order_relaxed);
+}
+
+void LinkMonitor::evaluate_(const std::size_t linkId) {
+  LinkStats &link = m_links[linkId];
+
+  LinkState newState = LinkState::UP;
+  const std::uint8_t systemStatus = link.systemStatus.load(std::memory_order_relaxed);
+  if (link.isHeartbeatLost.load(std::memory_order_relaxed) ||
+      link.isReadError.load(std::memory_order_relaxed)) {
+    newState = LinkState::LOST;
+  } else if (link.lossRate.load(std::memory_order_relaxed) > DEGRADED_LOSS_RATE ||
+             systemStatus == MAV_STATE_CRITICAL ||
+             systemStatus == MAV_STATE_EMERGENCY) {
+    newState = LinkState::DEGRADED;
+  }
+
+  if (newState == link.state.load(std::memory_order_relaxed)) {
+    return;
+  }
+  link.state.store(newState, std::memory_order_relaxed);
+
+  const LinkQuality quality = getQuality(linkId);
+  std::string message = "Link " + std::to_string(linkId);
+  switch (newState) {
+    case LinkState::UP: {
+      message += " UP";
+    } break;
+
+    case LinkState::DEGRADED: {
+      message += " DEGRADED";
+      if (systemStatus == MAV_STATE_CRITICAL) {
+        message += " (Mavlink Heartbeat CRITICAL)";
+      } else if (systemStatus == MAV_STATE_EMERGENCY) {
+        message += " (Mavlink Heartbeat EMERGENCY)";
+      }
+    } break;
+
+    case LinkState::LOST: {
+      message += link.isReadError.load(std::memory_order_relaxed)
+                     ? " LOST (serial connection error)"
+                     : " LOST (no heartbeat)";
+    } break;
+  }
+
+  ConnectionEvent connEvent(newState != LinkState::LOST, m_who, message, quality);
+  m_publisher->publish(EventType::CONNECTION_UPDATE, connEvent);
+}
+
+void LinkMonitor::run_(std::stop_token stopToken) {
+  Clock::time_point nextTick = Clock::now() + TICK;
+  while (!stopToken.stop_requested()) {
+    std::this_thread::sleep_until(nextTick);
+    nextTick += TICK;
+    m_wheel.tick();
+  }
+}
+
+std::int64_t LinkMonitor::nowNs_() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             Clock::now().time_since_epoch())
+      .count();
+}
@@ -0,0 +1,183 @@
+/**
+ * @file LocalFrame.cpp
+ * @brief Code of the conversion of GPS positions into the local frame of the exercise.
+ *
+ * @details This file contains the definition of LocalFrame. For the latitude phi = phi0 + dPhi and
+ *          the longitude difference dLambda, with N the prime vertical radius and e2 the squared
+ *          eccentricity:
+ *            r = (N + h) cos(phi), z = (N (1 - e2) + h) sin(phi)
+ *            east = r sin(dLambda), w = r cos(dLambda)
+ *            north = -sin(phi0) w + cos(phi0) z - north0, up = cos(phi0) w + sin(phi0) z - up0
+ *          which is the ECEF->ENU rotation applied to ECEF coordinates in the meridian of the origin.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <array>
+#include <cmath>
+
+#include "../include/LocalFrame.h"
+
+
+namespace {
+
+using geodesy::DEG_E7_TO_RAD;
+using geodesy::DEG_TO_RAD;
+using geodesy::ECCENTRICITY_SQ;
+
+} // namespace
+
+LocalFrame::LocalFrame(const Point &origin)
+    : m_lat0(origin.latitude * DEG_TO_RAD), m_lon0(origin.longitude * DEG_TO_RAD),
+      m_sinLat0(std::sin(m_lat0)), m_cosLat0(std::cos(m_lat0)) {
+  const double primeVerticalRadius =
+      SEMI_MAJOR_AXIS / std::sqrt(1.0 - ECCENTRICITY_SQ * m_sinLat0 * m_sinLat0);
+  const double w0 = (primeVerticalRadius + origin.altitude) * m_cosLat0;
+  const double z0 =
+      (primeVerticalRadius * (1.0 - ECCENTRICITY_SQ) + origin.altitude) * m_sinLat0;
+  m_north0 = -m_sinLat0 * w0 + m_cosLat0 * z0;
+  m_up0 = m_cosLat0 * w0 + m_sinLat0 * z0;
+}
+
+void LocalFrame::toEnu_(double sinLatDiff, double cosLatDiff, double sinLonDiff,
+                        double cosLonDiff, double alt, double &east, double &north,
+                        double &up) const {
+  const double sinLat = m_sinLat0 * cosLatDiff + m_cosLat0 * sinLatDiff;
+  const double cosLat = m_cosLat0 * cosLatDiff - m_sinLat0 * sinLatDiff;
+  const double primeVerticalRadius =
+      SEMI_MAJOR_AXIS / std::sqrt(1.0 - ECCENTRICITY_SQ * sinLat * sinLat);
+  const double r = (primeVerticalRadius + alt) * cosLat;
+  const double z = (primeVerticalRadius * (1.0 - ECCENTRICITY_SQ) + alt) * sinLat;
+  const double w = r * cosLonDiff;
+  east = r * sinLonDiff;
+  north = -m_sinLat0 * w + m_cosLat0 * z - m_north0;
+  up = m_cosLat0 * w + m_sinLat0 * z - m_up0;
+}
+
+void LocalFrame::toEnu(std::int32_t latE7, std::int32_t lonE7, std::int32_t altMm,
+                       double &east, double &north, double &up) const {
+  const double latDiff = latE7 * DEG_E7_TO_RAD - m_lat0;
+  const double lonDiff = lonE7 * DEG_E7_TO_RAD - m_lon0;
+  toEnu_(std::sin(latDiff), std::cos(latDiff), std::sin(lonDiff), std::cos(lonDiff),
+         altMm * 1E-3, east, north, up);
+}
+
+void LocalFrame::toEnu(const Point &point, CoorindatesSystem coordinatesSystem,
+                       double &east, double &north, double &up) const {
+  if (coordinatesSystem == CoorindatesSystem::UCS) {
+    east = point.latitude; // Point keeps UCS x y z in latitude longitude altitude order
+    north = point.altitude;
+    up = point.longitude;
+    return;
+  }
+  const double latDiff = point.latitude * DEG_TO_RAD - m_lat0;
+  const double lonDiff = point.longitude * DEG_TO_RAD - m_lon0;
+  toEnu_(std::sin(latDiff), std::cos(latDiff), std::sin(lonDiff), std::cos(lonDiff),
+         point.altitude, east, north, up);
+}
+
+void LocalFrame::toEnu(const std::int32_t *latE7, const std::int32_t *lonE7,
+                       const std::int32_t *altMm, std::size_t count, double *east,
+                       double *north, double *up) const {
+  std::size_t idx = 0;
+#ifdef GEODESY_SSE2
+  using namespace geodesy::detail;
+  const __m128d degE7ToRad = _mm_set1_pd(DEG_E7_TO_RAD);
+  const __m128d lat0 = _mm_set1_pd(m_lat0);
+  const __m128d lon0 = _mm_set1_pd(m_lon0);
+  const __m128d sinLat0 = _mm_set1_pd(m_sinLat0);
+  const __m128d cosLat0 = _mm_set1_pd(m_cosLat0);
+  const __m128d north0 = _mm_set1_pd(m_north0);
+  const __m128d up0 = _mm_set1_pd(m_up0);
+  const __m128d one = _mm_set1_pd(1.0);
+  const __m128d semiMajorAxis = _mm_set1_pd(SEMI_MAJOR_AXIS);
+  const __m128d eccentricitySq = _mm_set1_pd(ECCENTRICITY_SQ);
+  const __m128d polarFactor = _mm_set1_pd(1.0 - ECCENTRICITY_SQ);
+  const __m128d mmToM = _mm_set1_pd(1E-3);
+
+  for (; idx + 2 <= count; idx += 2) {
+    const __m128d latDiff = _mm_sub_pd(_mm_mul_pd(loadInt32Pair(latE7 + idx), degE7ToRad), lat0);
+    const __m128d lonDiff = _mm_sub_pd(_mm_mul_pd(loadInt32Pair(lonE7 + idx), degE7ToRad), lon0);
+    const __m128d alt = _mm_mul_pd(loadInt32Pair(altMm + idx), mmToM);
+
+    const __m128d sinLatDiff = sinSeries(latDiff);
+    const __m128d cosLatDiff = cosSeries(latDiff);
+    const __m128d sinLonDiff = sinSeries(lonDiff);
+    const __m128d cosLonDiff = cosSeries(lonDiff);
+
+    const __m128d sinLat = mulAdd(sinLat0, cosLatDiff, _mm_mul_pd(cosLat0, sinLatDiff));
+    const __m128d cosLat = _mm_sub_pd(_mm_mul_pd(cosLat0, cosLatDiff), _mm_mul_pd(sinLat0, sinLatDiff));
+    const __m128d primeVerticalRadius = _mm_div_pd(
+        semiMajorAxis,
+        _mm_sqrt_pd(_mm_sub_pd(one, _mm_mul_pd(eccentricitySq, _mm_mul_pd(sinLat, sinLat)))));
+    const __m128d r = _mm_mul_pd(_mm_add_pd(primeVerticalRadius, alt), cosLat);
+    const __m128d z = _mm_mul_pd(mulAdd(primeVerticalRadius, polarFactor, alt), sinLat);
+    const __m128d w = _mm_mul_pd(r, cosLonDiff);
+
+    _mm_storeu_pd(east + idx, _mm_mul_pd(r, sinLonDiff));
+    _mm_storeu_pd(north + idx,
+                  _mm_sub_pd(_mm_sub_pd(_mm_mul_pd(cosLat0, z), _mm_mul_pd(sinLat0, w)), north0));
+    _mm_storeu_pd(up + idx,
+                  _mm_sub_pd(mulAdd(cosLat0, w, _mm_mul_pd(sinLat0, z)), up0));
+
+    // Lanes too far from the origin for the series are converted again by the scalar path
+    const int lanes = farLanes(latDiff, lonDiff);
+    for (int lane = 0; lane < 2; ++lane) {
+      if ((lanes & (1 << lane)) != 0) {
+        toEnu(latE7[idx + lane], lonE7[idx + lane], altMm[idx + lane],
+              east[idx + lane], north[idx + lane], up[idx + lane]);
+      }
+    }
+  }
+#endif
+  for (; idx < count; ++idx) {
+    toEnu(latE7[idx], lonE7[idx], altMm[idx], east[idx], north[idx], up[idx]);
+  }
+}
+
+void LocalFrame::transform(TelemetrySample &telemetry) const {
+  if (!telemetry.has(TelemetrySample::GLOBAL_POSITION)) {
+    return;
+  }
+  toEnu(telemetry.latE7, telemetry.lonE7, telemetry.altMm, telemetry.east,
+        telemetry.north, telemetry.up);
+  telemetry.validFields |= TelemetrySample::LOCAL_FRAME;
+}
+
+void LocalFrame::transform(TelemetrySample *samples, std::size_t count) const {
+  // Positions are gathered into arrays, so the batched conversion loads them contiguously
+  std::array<std::int32_t, BLOCK_SIZE> latE7, lonE7, altMm;
+  std::array<double, BLOCK_SIZE> east, north, up;
+  std::array<TelemetrySample *, BLOCK_SIZE> targets;
+
+  std::size_t idx = 0;
+  while (idx < count) {
+    std::size_t gatheredNum = 0;
+    for (; idx < count && gatheredNum < BLOCK_SIZE; ++idx) {
+      TelemetrySample &telemetry = samples[idx];
+      if (!telemetry.has(TelemetrySample::GLOBAL_POSITION)) {
+        continue;
+      }
+      latE7[gatheredNum] = telemetry.latE7;
+      lonE7[gatheredNum] = telemetry.lonE7;
+      altMm[gatheredNum] = telemetry.altMm;
+      targets[gatheredNum++] = &telemetry;
+    }
+
+    toEnu(latE7.data(), lonE7.data(), altMm.data(), gatheredNum, east.data(),
+          north.data(), up.data());
+    for (std::size_t target = 0; target < gatheredNum; ++target) {
+      targets[target]->east = east[target];
+      targets[target]->north = north[target];
+      targets[target]->up = up[target];
+      targets[target]->validFields |= TelemetrySample::LOCAL_FRAME;
+    }
+  }
+}
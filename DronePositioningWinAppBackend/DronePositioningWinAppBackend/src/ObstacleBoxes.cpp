@@ -0,0 +1,242 @@
+/**
+ * @file ObstacleBoxes.cpp
+ * @brief Code of the oriented boxes of obstacles laid out for SIMD tests.
+ *
+ * @details This file contains the definitions of OrientedBox and ObstacleBoxes. The kernels are written once
+ *          against a few vector operations, defined for AVX2, SSE2 or plain doubles.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#include "../include/ObstacleBoxes.h"
+
+// AVX2 needs /arch:AVX2 (-mavx2), SSE2 is the x64 baseline
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define OBSTACLE_BOXES_AVX2
+#elif defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define OBSTACLE_BOXES_SSE2
+#endif
+
+// Kernels match OrientedBox::signedDistance bit by bit only if no multiply and add is contracted
+// into an FMA. GCC ignores these pragmas and needs -ffp-contract=off for this file.
+#if defined(_MSC_VER) && !defined(__clang__)
+#pragma fp_contract(off)
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+
+namespace {
+
+// Vector operations of the instruction set, lanes of doubles
+namespace simd {
+
+#if defined(OBSTACLE_BOXES_AVX2)
+constexpr std::size_t LANES = 4;
+using Vector = __m256d;
+inline Vector load(const double *values) { return _mm256_load_pd(values); }
+inline void store(double *values, Vector vector) { _mm256_store_pd(values, vector); }
+inline Vector broadcast(double value) { return _mm256_set1_pd(value); }
+inline Vector add(Vector a, Vector b) { return _mm256_add_pd(a, b); }
+inline Vector sub(Vector a, Vector b) { return _mm256_sub_pd(a, b); }
+inline Vector mul(Vector a, Vector b) { return _mm256_mul_pd(a, b); }
+inline Vector max(Vector a, Vector b) { return _mm256_max_pd(a, b); }
+inline Vector sqrt(Vector a) { return _mm256_sqrt_pd(a); }
+inline Vector abs(Vector a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+inline Vector lessEqual(Vector a, Vector b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+inline Vector greater(Vector a, Vector b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+inline Vector select(Vector condition, Vector a, Vector b) { return _mm256_blendv_pd(b, a, condition); }
+inline std::uint32_t laneMask(Vector condition) { return static_cast<std::uint32_t>(_mm256_movemask_pd(condition)); }
+#elif defined(OBSTACLE_BOXES_SSE2)
+constexpr std::size_t LANES = 2;
+using Vector = __m128d;
+inline Vector load(const double *values) { return _mm_load_pd(values); }
+inline void store(double *values, Vector vector) { _mm_store_pd(values, vector); }
+inline Vector broadcast(double value) { return _mm_set1_pd(value); }
+inline Vector add(Vector a, Vector b) { return _mm_add_pd(a, b); }
+inline Vector sub(Vector a, Vector b) { return _mm_sub_pd(a, b); }
+inline Vector mul(Vector a, Vector b) { return _mm_mul_pd(a, b); }
+inline Vector max(Vector a, Vector b) { return _mm_max_pd(a, b); }
+inline Vector sqrt(Vector a) { return _mm_sqrt_pd(a); }
+inline Vector abs(Vector a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+inline Vector lessEqual(Vector a, Vector b) { return _mm_cmple_pd(a, b); }
+inline Vector greater(Vector a, Vector b) { return _mm_cmpgt_pd(a, b); }
+inline Vector select(Vector condition, Vector a, Vector b) {
+  return _mm_or_pd(_mm_and_pd(condition, a), _mm_andnot_pd(condition, b));
+}
+inline std::uint32_t laneMask(Vector condition) { return static_cast<std::uint32_t>(_mm_movemask_pd(condition)); }
+#else
+constexpr std::size_t LANES = 1;
+using Vector = double;
+inline Vector load(const double *values) { return *values; }
+inline void store(double *values, Vector vector) { *values = vector; }
+inline Vector broadcast(double value) { return value; }
+inline Vector add(Vector a, Vector b) { return a + b; }
+inline Vector sub(Vector a, Vector b) { return a - b; }
+inline Vector mul(Vector a, Vector b) { return a * b; }
+inline Vector max(Vector a, Vector b) { return std::max(a, b); }
+inline Vector sqrt(Vector a) { return std::sqrt(a); }
+inline Vector abs(Vector a) { return std::abs(a); }
+inline Vector lessEqual(Vector a, Vector b) { return a <= b ? 1.0 : 0.0; }
+inline Vector greater(Vector a, Vector b) { return a > b ? 1.0 : 0.0; }
+inline Vector select(Vector condition, Vector a, Vector b) { return condition != 0.0 ? a : b; }
+inline std::uint32_t laneMask(Vector condition) { return condition != 0.0 ? 1u : 0u; }
+#endif
+
+} // namespace simd
+
+/**
+ * @brief Excess of |position in box axes| over the half extents of LANES boxes from the lane.
+ */
+inline void computeExcess(const ObstacleBoxes::Block &block, std::size_t lane, simd::Vector east,
+                          simd::Vector north, simd::Vector up, simd::Vector (&excess)[3]) {
+  using namespace simd;
+  const Vector dEast = sub(east, load(block.centerEast + lane));
+  const Vector dNorth = sub(north, load(block.centerNorth + lane));
+  const Vector dUp = sub(up, load(block.centerUp + lane));
+  for (std::size_t axis = 0; axis < 3; ++axis) {
+    const Vector local = add(add(mul(load(block.toBox[axis * 3] + lane), dEast),
+                                 mul(load(block.toBox[axis * 3 + 1] + lane), dNorth)),
+                             mul(load(block.toBox[axis * 3 + 2] + lane), dUp));
+    excess[axis] = sub(abs(local), load(block.halfExtents[axis] + lane));
+  }
+}
+
+} // namespace
+
+double OrientedBox::signedDistance(double east, double north, double up) const {
+  const double dEast = east - center[0];
+  const double dNorth = north - center[1];
+  const double dUp = up - center[2];
+  double outsideSq = 0.0;
+  double insideMax = -std::numeric_limits<double>::infinity();
+  for (std::size_t axis = 0; axis < 3; ++axis) {
+    const double local = toBox[axis * 3] * dEast + toBox[axis * 3 + 1] * dNorth +
+                         toBox[axis * 3 + 2] * dUp;
+    const double excess = std::abs(local) - halfExtents[axis];
+    outsideSq += excess > 0.0 ? excess * excess : 0.0;
+    insideMax = std::max(insideMax, excess);
+  }
+  return outsideSq > 0.0 ? std::sqrt(outsideSq) : insideMax;
+}
+
+ObstacleBoxes::ObstacleBoxes(const std::vector<OrientedBox> &boxes) {
+  append(boxes.data(), boxes.size());
+}
+
+std::size_t ObstacleBoxes::append(const OrientedBox *boxes, std::size_t count) {
+  const std::size_t firstBlock = m_blocks.size();
+  for (std::size_t first = 0; first < count; first += BLOCK_SIZE) {
+    Block &block = m_blocks.emplace_back();
+    for (std::size_t lane = 0; lane < BLOCK_SIZE; ++lane) {
+      if (first + lane >= count) {
+        block.centerEast[lane] = block.centerNorth[lane] = block.centerUp[lane] = 0.0;
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+          block.halfExtents[axis][lane] = -std::numeric_limits<double>::infinity();
+        }
+        for (std::size_t element = 0; element < 9; ++element) {
+          block.toBox[element][lane] = 0.0;
+        }
+        block.obstacleIds[lane] = NO_OBSTACLE;
+        continue;
+      }
+      const OrientedBox &box = boxes[first + lane];
+      block.centerEast[lane] = box.center[0];
+      block.centerNorth[lane] = box.center[1];
+      block.centerUp[lane] = box.center[2];
+      for (std::size_t axis = 0; axis < 3; ++axis) {
+        block.halfExtents[axis][lane] = box.halfExtents[axis];
+      }
+      for (std::size_t element = 0; element < 9; ++element) {
+        block.toBox[element][lane] = box.toBox[element];
+      }
+      block.obstacleIds[lane] = static_cast<std::uint32_t>(box.obstacleId);
+    }
+  }
+  return firstBlock;
+}
+
+std::uint32_t ObstacleBoxes::containsMask(const Block &block, double east, double north,
+                                          double up) {
+  const simd::Vector eastVector = simd::broadcast(east);
+  const simd::Vector northVector = simd::broadcast(north);
+  const simd::Vector upVector = simd::broadcast(up);
+  const simd::Vector zero = simd::broadcast(0.0);
+  std::uint32_t mask = 0;
+  for (std::size_t lane = 0; lane < BLOCK_SIZE; lane += simd::LANES) {
+    simd::Vector excess[3];
+    computeExcess(block, lane, eastVector, northVector, upVector, excess);
+    const simd::Vector maxExcess = simd::max(simd::max(excess[0], excess[1]), excess[2]);
+    mask |= simd::laneMask(simd::lessEqual(maxExcess, zero)) << lane;
+  }
+  return mask;
+}
+
+void ObstacleBoxes::signedDistances(const Block &block, double east, double north, double up,
+                                    double *distances) {
+  using namespace simd;
+  const Vector eastVector = broadcast(east);
+  const Vector northVector = broadcast(north);
+  const Vector upVector = broadcast(up);
+  const Vector zero = broadcast(0.0);
+  alignas(64) double laneDistances[BLOCK_SIZE];
+  for (std::size_t lane = 0; lane < BLOCK_SIZE; lane += LANES) {
+    Vector excess[3];
+    computeExcess(block, lane, eastVector, northVector, upVector, excess);
+    const Vector outside0 = simd::max(excess[0], zero);
+    const Vector outside1 = simd::max(excess[1], zero);
+    const Vector outside2 = simd::max(excess[2], zero);
+    const Vector outsideSq =
+        add(add(mul(outside0, outside0), mul(outside1, outside1)), mul(outside2, outside2));
+    const Vector maxExcess = simd::max(simd::max(excess[0], excess[1]), excess[2]);
+    store(laneDistances + lane, select(greater(outsideSq, zero), simd::sqrt(outsideSq), maxExcess));
+  }
+  std::copy(laneDistances, laneDistances + BLOCK_SIZE, distances);
+}
+
+std::uint32_t ObstacleBoxes::findContaining(double east, double north, double up) const {
+  for (const Block &block : m_blocks) {
+    const std::uint32_t mask = containsMask(block, east, north, up);
+    if (mask != 0) {
+      return block.obstacleIds[std::countr_zero(mask)];
+    }
+  }
+  return NO_OBSTACLE;
+}
+
+void ObstacleBoxes::findContaining(const double *east, const double *north, const double *up,
+                                   std::size_t count, std::uint32_t *obstacleIds) const {
+  // Positions are tested in tiles against every block in turn, so a block is loaded once per tile
+  for (std::size_t first = 0; first < count; first += POSITIONS_TILE_SIZE) {
+    const std::size_t last = std::min(first + POSITIONS_TILE_SIZE, count);
+    std::fill(obstacleIds + first, obstacleIds + last, NO_OBSTACLE);
+    std::size_t unresolvedNum = last - first;
+    for (std::size_t blockIdx = 0; blockIdx < m_blocks.size() && unresolvedNum > 0; ++blockIdx) {
+      const Block &block = m_blocks[blockIdx];
+      for (std::size_t idx = first; idx < last; ++idx) {
+        if (obstacleIds[idx] != NO_OBSTACLE) {
+          continue;
+        }
+        const std::uint32_t mask = containsMask(block, east[idx], north[idx], up[idx]);
+        if (mask != 0) {
+          obstacleIds[idx] = block.obstacleIds[std::countr_zero(mask)];
+          unresolvedNum--;
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,223 @@
+/**
+ * @file ObstacleIndex.cpp
+ * @brief Code of the spatial index of obstacles of the exercise.
+ *
+ * @details This file contains the definition of ObstacleIndex.
+ *          Rotations of Unity are R = Ry Rx Rz of the UCS axes. The local frame swaps y and z,
+ *          so a position d relative to the centre is in box axes R^T P d, where P swaps
+ *          north and up back to UCS order.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+#include "../include/ObstacleIndex.h"
+
+
+namespace {
+
+constexpr double DEG_TO_RAD = std::numbers::pi / 180.0;
+
+using Matrix = std::array<double, 9>; // row-major 3x3
+
+Matrix multiply(const Matrix &a, const Matrix &b) {
+  Matrix product{};
+  for (std::size_t row = 0; row < 3; ++row) {
+    for (std::size_t col = 0; col < 3; ++col) {
+      product[row * 3 + col] = a[row * 3] * b[col] + a[row * 3 + 1] * b[3 + col] +
+                               a[row * 3 + 2] * b[6 + col];
+    }
+  }
+  return product;
+}
+
+} // namespace
+
+bool ObstacleIndex::Node::contains(double east, double north, double up) const {
+  return east >= min[0] && east <= max[0] && north >= min[1] && north <= max[1] &&
+         up >= min[2] && up <= max[2];
+}
+
+double ObstacleIndex::Node::distanceSq(double east, double north, double up) const {
+  const double position[3] = {east, north, up};
+  double distanceSq = 0.0;
+  for (std::size_t axis = 0; axis < 3; ++axis) {
+    const double excess =
+        std::max({min[axis] - position[axis], position[axis] - max[axis], 0.0});
+    distanceSq += excess * excess;
+  }
+  return distanceSq;
+}
+
+OrientedBox ObstacleIndex::toBox(const Obstackle &obstacle, std::size_t obstacleId,
+                                 const LocalFrame &frame, CoorindatesSystem coordinatesSystem) {
+  OrientedBox box;
+  box.obstacleId = obstacleId;
+  frame.toEnu(Point(obstacle.centerX, obstacle.centerY, obstacle.centerZ), coordinatesSystem,
+              box.center[0], box.center[1], box.center[2]);
+  box.halfExtents = {obstacle.width / 2.0, obstacle.height / 2.0, obstacle.lenght / 2.0};
+
+  const double sinX = std::sin(obstacle.rX * DEG_TO_RAD), cosX = std::cos(obstacle.rX * DEG_TO_RAD);
+  const double sinY = std::sin(obstacle.rY * DEG_TO_RAD), cosY = std::cos(obstacle.rY * DEG_TO_RAD);
+  const double sinZ = std::sin(obstacle.rZ * DEG_TO_RAD), cosZ = std::cos(obstacle.rZ * DEG_TO_RAD);
+  const Matrix rotationX = {1, 0, 0, 0, cosX, -sinX, 0, sinX, cosX};
+  const Matrix rotationY = {cosY, 0, sinY, 0, 1, 0, -sinY, 0, cosY};
+  const Matrix rotationZ = {cosZ, -sinZ, 0, sinZ, cosZ, 0, 0, 0, 1};
+  const Matrix rotation = multiply(rotationY, multiply(rotationX, rotationZ));
+
+  // R^T P: row i of R^T is column i of R, P maps east north up to x y z of UCS
+  for (std::size_t axis = 0; axis < 3; ++axis) {
+    box.toBox[axis * 3] = rotation[axis];         // east  <- x
+    box.toBox[axis * 3 + 1] = rotation[6 + axis]; // north <- z
+    box.toBox[axis * 3 + 2] = rotation[3 + axis]; // up    <- y
+  }
+  return box;
+}
+
+ObstacleIndex::ObstacleIndex(const std::vector<Obstackle> &obstacles, const LocalFrame &frame,
+                             CoorindatesSystem coordinatesSystem) {
+  m_boxes.reserve(obstacles.size());
+  for (std::size_t idx = 0; idx < obstacles.size(); ++idx) {
+    m_boxes.push_back(toBox(obstacles[idx], idx, frame, coordinatesSystem));
+  }
+  if (m_boxes.empty()) {
+    return;
+  }
+
+  // Axis-aligned bounds of every box: extent along an axis is sum of |rotation| * half extents
+  std::vector<std::array<double, 6>> bounds(m_boxes.size());
+  for (std::size_t idx = 0; idx < m_boxes.size(); ++idx) {
+    const OrientedBox &box = m_boxes[idx];
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      const double extent = std::abs(box.toBox[axis]) * box.halfExtents[0] +
+                            std::abs(box.toBox[3 + axis]) * box.halfExtents[1] +
+                            std::abs(box.toBox[6 + axis]) * box.halfExtents[2];
+      bounds[idx][axis] = box.center[axis] - extent;
+      bounds[idx][3 + axis] = box.center[axis] + extent;
+    }
+  }
+  m_nodes.reserve(2 * (m_boxes.size() / LEAF_SIZE + 1));
+  build_(0, m_boxes.size(), bounds);
+}
+
+std::uint32_t ObstacleIndex::build_(std::size_t first, std::size_t last,
+                                    const std::vector<std::array<double, 6>> &bounds) {
+  const std::uint32_t nodeIdx = static_cast<std::uint32_t>(m_nodes.size());
+  m_nodes.emplace_back();
+  Node node;
+  node.min.fill(std::numeric_limits<double>::infinity());
+  node.max.fill(-std::numeric_limits<double>::infinity());
+  std::array<double, 3> centerMin = node.min, centerMax = node.max;
+  for (std::size_t idx = first; idx < last; ++idx) {
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      node.min[axis] = std::min(node.min[axis], bounds[m_boxes[idx].obstacleId][axis]);
+      node.max[axis] = std::max(node.max[axis], bounds[m_boxes[idx].obstacleId][3 + axis]);
+      centerMin[axis] = std::min(centerMin[axis], m_boxes[idx].center[axis]);
+      centerMax[axis] = std::max(centerMax[axis], m_boxes[idx].center[axis]);
+    }
+  }
+
+  if (last - first <= LEAF_SIZE) {
+    node.blockIdx = static_cast<std::uint32_t>(m_leafBoxes.append(&m_boxes[first], last - first));
+    node.boxesNum = static_cast<std::uint32_t>(last - first);
+    m_nodes[nodeIdx] = node;
+    return nodeIdx;
+  }
+
+  std::size_t axis = 0;
+  for (std::size_t candidate = 1; candidate < 3; ++candidate) {
+    if (centerMax[candidate] - centerMin[candidate] > centerMax[axis] - centerMin[axis]) {
+      axis = candidate;
+    }
+  }
+  const std::size_t middle = first + (last - first) / 2;
+  std::nth_element(m_boxes.begin() + first, m_boxes.begin() + middle, m_boxes.begin() + last,
+                   [axis](const OrientedBox &a, const OrientedBox &b) {
+                     return a.center[axis] < b.center[axis];
+                   });
+  m_nodes[nodeIdx] = node;
+  build_(first, middle, bounds);
+  const std::uint32_t rightIdx = build_(middle, last, bounds);
+  m_nodes[nodeIdx].rightIdx = rightIdx;
+  return nodeIdx;
+}
+
+bool ObstacleIndex::isInside(double east, double north, double up,
+                             std::size_t &obstacleId) const {
+  if (m_nodes.empty()) {
+    return false;
+  }
+  std::array<std::uint32_t, MAX_DEPTH> stack;
+  std::size_t stackSize = 0;
+  stack[stackSize++] = 0;
+  while (stackSize > 0) {
+    const std::uint32_t nodeIdx = stack[--stackSize];
+    const Node &node = m_nodes[nodeIdx];
+    if (!node.contains(east, north, up)) {
+      continue;
+    }
+    if (node.boxesNum > 0) {
+      const ObstacleBoxes::Block &block = m_leafBoxes.getBlock(node.blockIdx);
+      const std::uint32_t mask = ObstacleBoxes::containsMask(block, east, north, up);
+      if (mask != 0) {
+        obstacleId = block.obstacleIds[std::countr_zero(mask)];
+        return true;
+      }
+      continue;
+    }
+    stack[stackSize++] = node.rightIdx;
+    stack[stackSize++] = nodeIdx + 1;
+  }
+  return false;
+}
+
+bool ObstacleIndex::findNearest(double east, double north, double up,
+                                Proximity &proximity) const {
+  if (m_nodes.empty()) {
+    return false;
+  }
+  proximity.distance = std::numeric_limits<double>::infinity();
+  std::array<std::uint32_t, MAX_DEPTH> stack;
+  std::size_t stackSize = 0;
+  stack[stackSize++] = 0;
+  while (stackSize > 0) {
+    const Node &node = m_nodes[stack[--stackSize]];
+    const double boundDistanceSq = node.distanceSq(east, north, up);
+    if (proximity.distance <= 0.0 ? boundDistanceSq > 0.0
+                                  : boundDistanceSq >= proximity.distance * proximity.distance) {
+      continue; // no box of the node is closer
+    }
+    if (node.boxesNum > 0) {
+      const ObstacleBoxes::Block &block = m_leafBoxes.getBlock(node.blockIdx);
+      double distances[ObstacleBoxes::BLOCK_SIZE];
+      ObstacleBoxes::signedDistances(block, east, north, up, distances);
+      for (std::uint32_t lane = 0; lane < node.boxesNum; ++lane) {
+        if (distances[lane] < proximity.distance) {
+          proximity.distance = distances[lane];
+          proximity.obstacleId = block.obstacleIds[lane];
+        }
+      }
+      continue;
+    }
+
+    // Nearer child last, so it's visited first and prunes the other one
+    const std::uint32_t leftIdx = static_cast<std::uint32_t>(&node - m_nodes.data()) + 1;
+    const bool isLeftNearer = m_nodes[leftIdx].distanceSq(east, north, up) <=
+                              m_nodes[node.rightIdx].distanceSq(east, north, up);
+    stack[stackSize++] = isLeftNearer ? node.rightIdx : leftIdx;
+    stack[stackSize++] = isLeftNearer ? leftIdx : node.rightIdx;
+  }
+  return true;
+}
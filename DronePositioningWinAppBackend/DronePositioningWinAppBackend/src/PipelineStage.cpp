@@ -0,0 +1,43 @@
+/**
+ * @file PipelineStage.cpp
+ * @brief Code of pinning pipeline stages to cores.
+ *
+ * @details This file contains the platform-specific code pinning the thread of a pipeline stage
+ *          to a core.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "../include/PipelineStage.h"
+
+
+bool pinCurrentThread(int core) {
+#ifdef _WIN32
+  if (core < 0 || core >= static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+    return false;
+  }
+  return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << core) != 0;
+#else
+  if (core < 0 || core >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(core, &cpuSet);
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#endif
+}
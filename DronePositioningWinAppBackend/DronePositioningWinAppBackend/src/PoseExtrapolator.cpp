@@ -0,0 +1,188 @@
+/**
+ * @file PoseExtrapolator.cpp
+ * @brief Code of the prediction of vehicle poses between telemetry samples.
+ *
+ * @details This file contains the definition of PoseExtrapolator. Positions are handled in
+ *          north/east metres of a local tangent plane at the first fix of the vehicle, which is
+ *          accurate to millimetres over the few metres a prediction moves it.
+ *          The constant turn model rotates the velocity v0 = (north, east) by w t, so the
+ *          displacement after h is v0 (sin(w h), 1 - cos(w h)) / w in the rotating basis.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include "../include/PoseExtrapolator.h"
+
+
+namespace {
+
+constexpr double METRES_PER_DEG_E7_LAT = 0.011131949; // WGS84 mean, 1E-7 deg of latitude
+constexpr double MIN_TURN_RATE = 1E-3;                // rad/s, below it the model is constant velocity
+constexpr double MIN_COS_PITCH = 1E-2;                // Euler rates diverge at +-90 deg of pitch
+
+inline double wrapAngle(double angle) {
+  return std::remainder(angle, 2.0 * std::numbers::pi);
+}
+
+inline std::int32_t toInt32(double value) {
+  return static_cast<std::int32_t>(std::lround(value));
+}
+
+} // namespace
+
+PoseExtrapolator::PoseExtrapolator(std::chrono::nanoseconds maxHorizon)
+    : m_maxHorizonNs(maxHorizon.count()) {}
+
+void PoseExtrapolator::update(const TelemetrySample &telemetry) {
+  Track &track = m_tracks[telemetry.systemId];
+  if (!track.isKnown) {
+    track.isKnown = true;
+    m_vehicleIds[m_vehiclesNum++] = telemetry.systemId;
+  }
+  track.latest = telemetry;
+
+  if (!telemetry.has(TelemetrySample::GLOBAL_POSITION)) {
+    return;
+  }
+  if (track.historyNum == 0) {
+    track.originLatE7 = telemetry.latE7;
+    track.originLonE7 = telemetry.lonE7;
+    track.metresPerDegE7Lon =
+        METRES_PER_DEG_E7_LAT * std::cos(telemetry.latitudeDeg() * std::numbers::pi / 180.0);
+  } else {
+    const std::size_t newestIdx = (track.historyNext + HISTORY_SIZE - 1) % HISTORY_SIZE;
+    if (telemetry.globalPositionHostTimeNs <= track.history[newestIdx].timeNs) {
+      return; // position of an attitude-triggered sample, already in the history
+    }
+  }
+
+  Fix &fix = track.history[track.historyNext];
+  fix.timeNs = telemetry.globalPositionHostTimeNs;
+  fix.north = (telemetry.latE7 - track.originLatE7) * METRES_PER_DEG_E7_LAT;
+  fix.east = (telemetry.lonE7 - track.originLonE7) * track.metresPerDegE7Lon;
+  fix.velocityNorth = telemetry.velocityNorth;
+  fix.velocityEast = telemetry.velocityEast;
+  track.historyNext = (track.historyNext + 1) % HISTORY_SIZE;
+  track.historyNum = std::min(track.historyNum + 1, HISTORY_SIZE);
+  track.hasReportedVelocity = track.hasReportedVelocity ||
+                              telemetry.velocityNorth != 0.0f ||
+                              telemetry.velocityEast != 0.0f;
+  estimateMotion_(track);
+}
+
+void PoseExtrapolator::estimateMotion_(Track &track) {
+  const Fix &newest = track.history[(track.historyNext + HISTORY_SIZE - 1) % HISTORY_SIZE];
+  const Fix &oldest =
+      track.history[(track.historyNext + HISTORY_SIZE - track.historyNum) % HISTORY_SIZE];
+  const double spanS = (newest.timeNs - oldest.timeNs) * 1E-9;
+
+  if (track.hasReportedVelocity) {
+    track.velocityNorth = newest.velocityNorth;
+    track.velocityEast = newest.velocityEast;
+  } else if (spanS > 0.0) {
+    track.velocityNorth = static_cast<float>((newest.north - oldest.north) / spanS);
+    track.velocityEast = static_cast<float>((newest.east - oldest.east) / spanS);
+  } else {
+    track.velocityNorth = 0.0f;
+    track.velocityEast = 0.0f;
+  }
+
+  // Course change over the history, reported velocities only: differentiated ones lag and are noisy
+  track.turnRate = 0.0;
+  if (track.hasReportedVelocity && spanS > 0.0 &&
+      std::hypot(newest.velocityNorth, newest.velocityEast) >= MIN_TURN_SPEED &&
+      std::hypot(oldest.velocityNorth, oldest.velocityEast) >= MIN_TURN_SPEED) {
+    const double courseChange =
+        wrapAngle(std::atan2(newest.velocityEast, newest.velocityNorth) -
+                  std::atan2(oldest.velocityEast, oldest.velocityNorth));
+    track.turnRate = std::clamp(courseChange / spanS, -MAX_TURN_RATE, MAX_TURN_RATE);
+  }
+}
+
+bool PoseExtrapolator::predict(std::uint8_t vehicleId, std::int64_t timeNs,
+                               TelemetrySample &prediction) const {
+  const Track &track = m_tracks[vehicleId];
+  if (!track.isKnown) {
+    return false;
+  }
+  const TelemetrySample &latest = track.latest;
+  const std::int64_t latestNs =
+      std::max(latest.attitudeHostTimeNs, latest.globalPositionHostTimeNs);
+  if (timeNs - latestNs > m_maxHorizonNs) {
+    return false; // too old to be extrapolated
+  }
+
+  prediction = latest;
+  prediction.isPredicted = true;
+
+  if (latest.has(TelemetrySample::ATTITUDE)) {
+    const double horizonS =
+        std::clamp<std::int64_t>(timeNs - latest.attitudeHostTimeNs, 0, m_maxHorizonNs) * 1E-9;
+    // ATTITUDE rates are body rates p, q, r, converted into rates of the Euler angles
+    const double roll = latest.roll;
+    const double pitch = latest.pitch;
+    const double sinRoll = std::sin(roll);
+    const double cosRoll = std::cos(roll);
+    const double cosPitch = std::max(std::cos(pitch), MIN_COS_PITCH);
+    const double tanPitch = std::sin(pitch) / cosPitch;
+    const double yawPlaneRate = latest.pitchSpeed * sinRoll + latest.yawSpeed * cosRoll;
+    const double rollRate = latest.rollSpeed + yawPlaneRate * tanPitch;
+    const double pitchRate = latest.pitchSpeed * cosRoll - latest.yawSpeed * sinRoll;
+    const double yawRate = yawPlaneRate / cosPitch;
+    prediction.roll = static_cast<float>(wrapAngle(roll + rollRate * horizonS));
+    prediction.pitch = static_cast<float>(wrapAngle(pitch + pitchRate * horizonS));
+    prediction.yaw = static_cast<float>(wrapAngle(latest.yaw + yawRate * horizonS));
+    prediction.attitudeHostTimeNs = timeNs;
+  }
+
+  if (latest.has(TelemetrySample::GLOBAL_POSITION) && track.historyNum > 0) {
+    const double horizonS =
+        std::clamp<std::int64_t>(timeNs - latest.globalPositionHostTimeNs, 0, m_maxHorizonNs) * 1E-9;
+    const double velocityNorth = track.velocityNorth;
+    const double velocityEast = track.velocityEast;
+    double north, east;
+    if (std::abs(track.turnRate) < MIN_TURN_RATE) {
+      north = velocityNorth * horizonS;
+      east = velocityEast * horizonS;
+    } else {
+      const double turn = track.turnRate * horizonS;
+      const double sinTurn = std::sin(turn);
+      const double cosTurnLess = std::cos(turn) - 1.0;
+      north = (velocityNorth * sinTurn + velocityEast * cosTurnLess) / track.turnRate;
+      east = (velocityEast * sinTurn - velocityNorth * cosTurnLess) / track.turnRate;
+      prediction.velocityNorth =
+          static_cast<float>(velocityNorth * std::cos(turn) - velocityEast * sinTurn);
+      prediction.velocityEast =
+          static_cast<float>(velocityEast * std::cos(turn) + velocityNorth * sinTurn);
+    }
+    const double down = latest.velocityDown * horizonS;
+    prediction.latE7 = toInt32(latest.latE7 + north / METRES_PER_DEG_E7_LAT);
+    prediction.lonE7 = toInt32(latest.lonE7 + east / track.metresPerDegE7Lon);
+    prediction.altMm = toInt32(latest.altMm - down * 1E3);
+    prediction.relativeAltMm = toInt32(latest.relativeAltMm - down * 1E3);
+    prediction.globalPositionHostTimeNs = timeNs;
+  }
+  return true;
+}
+
+std::size_t PoseExtrapolator::predictAll(std::int64_t timeNs,
+                                         TelemetrySample *predictions) const {
+  std::size_t predictionsNum = 0;
+  for (std::size_t idx = 0; idx < m_vehiclesNum; ++idx) {
+    if (predict(m_vehicleIds[idx], timeNs, predictions[predictionsNum])) {
+      predictionsNum++;
+    }
+  }
+  return predictionsNum;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file ScenePacket.cpp
+ * @brief Code of the scene wire format.
+ *
+ * @details This file contains the definition of functions serialising the scene of FlightConfig
+ *          and building/parsing datagrams of its transfer. Values are written byte by byte, so the
+ *          output is little-endian regardless of the host byte order.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include "../include/ScenePacket.h"
+
+
+namespace wire {
+
+namespace {
+
+/**
+ * @brief Appends little-endian values to the blob.
+ */
+class BlobWriter {
+public:
+  explicit BlobWriter(std::vector<std::uint8_t> &blob) : m_blob(blob) {}
+
+  template <typename T> void put(T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+      using Bits = std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>;
+      put(std::bit_cast<Bits>(value));
+    } else {
+      using Unsigned = std::make_unsigned_t<T>;
+      const Unsigned bits = static_cast<Unsigned>(value);
+      for (std::size_t idx = 0; idx < sizeof(T); ++idx) {
+        m_blob.push_back(static_cast<std::uint8_t>(bits >> (8 * idx)));
+      }
+    }
+  }
+
+  void put(const std::string &text) {
+    const std::size_t length =
+        std::min<std::size_t>(text.size(), std::numeric_limits<std::uint16_t>::max());
+    put(static_cast<std::uint16_t>(length));
+    m_blob.insert(m_blob.end(), text.begin(), text.begin() + length);
+  }
+
+private:
+  std::vector<std::uint8_t> &m_blob;
+};
+
+template <typename T> inline std::uint8_t *putLe(std::uint8_t *out, T value) {
+  for (std::size_t idx = 0; idx < sizeof(T); ++idx) {
+    *out++ = static_cast<std::uint8_t>(static_cast<std::uint64_t>(value) >> (8 * idx));
+  }
+  return out;
+}
+
+template <typename T> inline T getLe(const std::uint8_t *in) {
+  std::uint64_t value = 0;
+  for (std::size_t idx = 0; idx < sizeof(T); ++idx) {
+    value |= static_cast<std::uint64_t>(in[idx]) << (8 * idx);
+  }
+  return static_cast<T>(value);
+}
+
+std::uint8_t *putHeader(std::uint8_t *out, std::uint16_t magic,
+                        const std::vector<std::uint8_t> &blob,
+                        std::uint64_t hash, std::size_t chunkIdx) {
+  out = putLe(out, magic);
+  out = putLe(out, SCENE_VERSION);
+  out = putLe(out, std::uint8_t{0});
+  out = putLe(out, hash);
+  out = putLe(out, static_cast<std::uint32_t>(blob.size()));
+  out = putLe(out, static_cast<std::uint16_t>(chunkIdx));
+  out = putLe(out, static_cast<std::uint16_t>(getSceneChunksNum(blob.size())));
+  return out;
+}
+
+} // namespace
+
+std::uint64_t fnv1a64(const std::uint8_t *data, std::size_t size) {
+  std::uint64_t hash = 0xCBF29CE484222325ull;
+  for (std::size_t idx = 0; idx < size; ++idx) {
+    hash ^= data[idx];
+    hash *= 0x100000001B3ull;
+  }
+  return hash;
+}
+
+std::vector<std::uint8_t> serializeScene(const configuration::FlightConfig &flightConfig) {
+  const ExerciseInfo &exercise = flightConfig.getExerciseInfo();
+  const OperatorPosition &operatorPosition = flightConfig.getOperatorPosition();
+  const auto &waypoints = flightConfig.getWaypoints();
+  const auto &markers = flightConfig.getMarkers();
+  const auto &obstacles = flightConfig.getObstacles();
+
+  std::vector<std::uint8_t> blob;
+  blob.reserve(128 + exercise.title.size() + exercise.author.size() +
+               waypoints.size() * 24 + markers.size() * 28 + obstacles.size() * 36);
+  BlobWriter writer(blob);
+
+  writer.put(SCENE_MAGIC);
+  writer.put(SCENE_VERSION);
+  writer.put(std::uint8_t{0});
+
+  std::uint8_t flags = 0;
+  if (exercise.showWaypoints) {
+    flags |= SCENE_FLAG_SHOW_WAYPOINTS;
+  }
+  if (exercise.showGuideline) {
+    flags |= SCENE_FLAG_SHOW_GUIDELINE;
+  }
+  writer.put(static_cast<std::uint8_t>(exercise.coordinatesSystem));
+  writer.put(static_cast<std::uint8_t>(exercise.altitudeDifference));
+  writer.put(static_cast<std::uint8_t>(exercise.scoringMethod));
+  writer.put(flags);
+  writer.put(exercise.guidelineOffset);
+  writer.put(exercise.targetSpeed);
+  writer.put(static_cast<std::int32_t>(exercise.accuracy));
+  writer.put(static_cast<std::int32_t>(exercise.pausingTime));
+  writer.put(static_cast<std::int32_t>(exercise.targetBearings));
+  writer.put(static_cast<std::int32_t>(exercise.distanceWeight));
+  writer.put(static_cast<std::int32_t>(exercise.altitudeWeight));
+  writer.put(static_cast<std::int32_t>(exercise.speedWeight));
+  writer.put(exercise.title);
+  writer.put(exercise.author);
+
+  writer.put(operatorPosition.latitude);
+  writer.put(operatorPosition.longitude);
+  writer.put(operatorPosition.altitude);
+
+  writer.put(static_cast<std::uint16_t>(waypoints.size()));
+  for (const Waypoint &waypoint : waypoints) {
+    writer.put(waypoint.latitude);
+    writer.put(waypoint.longitude);
+    writer.put(waypoint.altitude);
+  }
+
+  writer.put(static_cast<std::uint16_t>(markers.size()));
+  for (const Marker &marker : markers) {
+    writer.put(marker.latitude);
+    writer.put(marker.longitude);
+    writer.put(marker.altitude);
+    writer.put(static_cast<float>(marker.radius));
+  }
+
+  writer.put(static_cast<std::uint16_t>(obstacles.size()));
+  for (const Obstackle &obstacle : obstacles) {
+    for (const double value : {obstacle.centerX, obstacle.centerY, obstacle.centerZ,
+                               obstacle.width, obstacle.lenght, obstacle.height,
+                               obstacle.rX, obstacle.rY, obstacle.rZ}) {
+      writer.put(static_cast<float>(value));
+    }
+  }
+  return blob;
+}
+
+std::size_t getSceneChunksNum(std::size_t blobSize) {
+  return (blobSize + SCENE_CHUNK_PAYLOAD_SIZE - 1) / SCENE_CHUNK_PAYLOAD_SIZE;
+}
+
+std::size_t writeSceneAnnounce(const std::vector<std::uint8_t> &blob, std::uint64_t hash,
+                               std::uint8_t *buffer) {
+  return static_cast<std::size_t>(
+      putHeader(buffer, SCENE_ANNOUNCE_MAGIC, blob, hash, 0) - buffer);
+}
+
+std::size_t writeSceneChunk(const std::vector<std::uint8_t> &blob, std::uint64_t hash,
+                            std::size_t chunkIdx, std::uint8_t *buffer) {
+  std::uint8_t *out = putHeader(buffer, SCENE_CHUNK_MAGIC, blob, hash, chunkIdx);
+  const std::size_t offset = chunkIdx * SCENE_CHUNK_PAYLOAD_SIZE;
+  const std::size_t payloadSize =
+      std::min(SCENE_CHUNK_PAYLOAD_SIZE, blob.size() - offset);
+  std::memcpy(out, blob.data() + offset, payloadSize);
+  return static_cast<std::size_t>(out - buffer) + payloadSize;
+}
+
+bool parseSceneAck(const std::uint8_t *buffer, std::size_t size, std::uint64_t &hash,
+                   std::size_t &chunksNum, const std::uint8_t *&bitmap) {
+  if (size < SCENE_ACK_HEADER_SIZE || getLe<std::uint16_t>(buffer) != SCENE_ACK_MAGIC ||
+      buffer[2] != SCENE_VERSION) {
+    return false;
+  }
+  hash = getLe<std::uint64_t>(buffer + 4);
+  chunksNum = getLe<std::uint16_t>(buffer + 12);
+  bitmap = buffer + SCENE_ACK_HEADER_SIZE;
+  return chunksNum <= MAX_SCENE_CHUNKS_NUM &&
+         size >= SCENE_ACK_HEADER_SIZE + (chunksNum + 7) / 8;
+}
+
+} // namespace wire
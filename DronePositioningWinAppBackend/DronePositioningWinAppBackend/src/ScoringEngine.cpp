@@ -0,0 +1,98 @@
+/**
+ * @file ScoringEngine.cpp
+ * @brief Code of the streaming scoring of the flight of every vehicle.
+ *
+ * @details This file contains the definitions of ErrorAccumulator and ScoringEngine.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "../include/ScoringEngine.h"
+
+
+void ErrorAccumulator::CompensatedSum::add(double value) {
+  const double corrected = value - compensation;
+  const double next = sum + corrected;
+  compensation = (next - sum) - corrected;
+  sum = next;
+}
+
+void ErrorAccumulator::add(double error) {
+  m_count++;
+  const double delta = error - m_mean;
+  m_mean += delta / static_cast<double>(m_count);
+  m_m2 += delta * (error - m_mean);
+  m_absSum.add(std::abs(error));
+  m_squareSum.add(error * error);
+  m_maxAbs = std::max(m_maxAbs, std::abs(error));
+}
+
+double ErrorAccumulator::getStdDev() const {
+  return m_count > 1 ? std::sqrt(m_m2 / static_cast<double>(m_count - 1)) : 0.0;
+}
+
+double ErrorAccumulator::getMae() const {
+  return m_count > 0 ? m_absSum.sum / static_cast<double>(m_count) : 0.0;
+}
+
+double ErrorAccumulator::getRmse() const {
+  return m_count > 0 ? std::sqrt(m_squareSum.sum / static_cast<double>(m_count)) : 0.0;
+}
+
+ScoringEngine::ScoringEngine(const ExerciseInfo &exerciseInfo)
+    : m_scoringMethod(exerciseInfo.scoringMethod),
+      m_distanceWeight(std::max(exerciseInfo.distanceWeight, 0)),
+      m_altitudeWeight(exerciseInfo.altitudeDifference == AltitudeDifference::IGNORE_ALT_DIFF
+                           ? 0
+                           : std::max(exerciseInfo.altitudeWeight, 0)),
+      m_speedWeight(std::max(exerciseInfo.speedWeight, 0)) {}
+
+void ScoringEngine::add(std::uint8_t vehicleId, const Errors &errors) {
+  Vehicle &vehicle = m_vehicles[vehicleId];
+  if (!vehicle.isKnown) {
+    vehicle.isKnown = true;
+    m_vehicleIds[m_vehiclesNum++] = vehicleId;
+  }
+  vehicle.distance.add(errors.distance);
+  vehicle.altitude.add(errors.altitude);
+  vehicle.speed.add(errors.speed);
+}
+
+double ScoringEngine::reduce_(const ErrorAccumulator &errors) const {
+  return m_scoringMethod == ScoringMethod::RMSE ? errors.getRmse() : errors.getMae();
+}
+
+ScoringEngine::Score ScoringEngine::getScore(std::uint8_t vehicleId) const {
+  const Vehicle &vehicle = m_vehicles[vehicleId];
+  Score score;
+  score.samplesNum = vehicle.distance.getCount();
+  if (score.samplesNum == 0) {
+    return score;
+  }
+  score.distance = reduce_(vehicle.distance);
+  score.altitude = reduce_(vehicle.altitude);
+  score.speed = reduce_(vehicle.speed);
+
+  const double weightsSum = m_distanceWeight + m_altitudeWeight + m_speedWeight;
+  if (weightsSum > 0.0) {
+    score.weighted = (m_distanceWeight * score.distance + m_altitudeWeight * score.altitude +
+                      m_speedWeight * score.speed) /
+                     weightsSum;
+  }
+  return score;
+}
+
+std::size_t ScoringEngine::getVehicles(const std::uint8_t *&vehicleIds) const {
+  vehicleIds = m_vehicleIds.data();
+  return m_vehiclesNum;
+}
@@ -0,0 +1,227 @@
+/**
+ * @file SerialPort.cpp
+ * @brief Code of the serial port connection.
+ *
+ * @details This file contains the definition of SerialPort, which utilizes:
+ *          - serial port connection for receiving telemetry data (windows.h)
+ *          - mavlink parser for validating baud rate candidates
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include "../include/SerialPort.h"
+
+
+SerialPort::SerialPort(const std::string &portCom, std::uint32_t baudRate,
+                       bool isVerbose)
+    : m_portCom(portCom), m_baudRate(baudRate), m_verbose(isVerbose) {
+
+  // Validating, if port COM works
+  int retryCnt = 5;
+  DWORD isCOM = 0;
+  CHAR lpTargetPath[5000];
+  while (retryCnt > 0) {
+    isCOM = QueryDosDeviceA(m_portCom.c_str(), lpTargetPath, 5000);
+    if (isCOM) {
+      break;
+    } else {
+      std::cout << "You have: " << retryCnt * 5
+                << " s to plug in the receiver..\n";
+      std::this_thread::sleep_for(std::chrono::milliseconds(5000)); // wait 5 seconds before checking again
+      retryCnt--;
+    }
+  } // wait overall 25 seconds for connection
+
+  if (!isCOM) {
+    throw std::runtime_error("Receiving device is not connected or port COM "
+                             "has been incorrectly specified");
+  }
+
+  // Establishing connection
+  m_comSerial = HANDLE(INVALID_HANDLE_VALUE);
+  m_dcbSerialParams = {0};
+
+  std::wstring wideComPort(m_portCom.begin(), m_portCom.end());
+  LPCWSTR comPortName = wideComPort.c_str();
+
+  m_comSerial = CreateFile(
+	  comPortName,
+	  GENERIC_READ | GENERIC_WRITE,
+	  0,
+	  0,
+	  OPEN_EXISTING,
+	  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, // writes don't queue behind the pending read
+	  0
+  );
+
+  if (m_comSerial == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Error opening serial port");
+  }
+
+  // Manual-reset, as GetOverlappedResult expects
+  m_readOverlapped.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+  m_writeOverlapped.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+  if (m_readOverlapped.hEvent == NULL || m_writeOverlapped.hEvent == NULL) {
+    release_();
+    throw std::runtime_error("Error creating serial port events");
+  }
+
+  SecureZeroMemory(&m_dcbSerialParams, sizeof(m_dcbSerialParams));
+  m_dcbSerialParams.DCBlength = sizeof(m_dcbSerialParams);
+
+  if (!GetCommState(m_comSerial, &m_dcbSerialParams)) {
+    release_();
+    throw std::runtime_error("Error getting com state");
+  }
+
+  // Return as soon as any bytes are available, wait at most READ_TIMEOUT_MS
+  // for the first one, so reading loops can check their stop flags
+  COMMTIMEOUTS timeouts = {0};
+  timeouts.ReadIntervalTimeout = MAXDWORD;
+  timeouts.ReadTotalTimeoutMultiplier = MAXDWORD;
+  timeouts.ReadTotalTimeoutConstant = READ_TIMEOUT_MS;
+  if (!SetCommTimeouts(m_comSerial, &timeouts)) {
+    release_();
+    throw std::runtime_error("Error setting serial port timeouts");
+  }
+
+  if (m_baudRate == ConnectionConfigurationInfo::AUTO_BAUD_RATE) {
+    m_baudRate = detectBaudRate_();
+  } else if (!setBaudRate_(m_baudRate)) {
+    release_();
+    throw std::runtime_error("Error setting serial port state, baud rate: " +
+                             std::to_string(m_baudRate));
+  }
+
+  if (m_verbose) {
+    std::cout << "SerialPort: " << m_portCom << " opened at " << m_baudRate
+              << " baud\n";
+  }
+}
+
+SerialPort::~SerialPort() { release_(); }
+
+int SerialPort::read(std::uint8_t *buffer, DWORD size) {
+  DWORD bytesRead = 0;
+  const BOOL isStarted = ReadFile(m_comSerial, buffer, size, NULL, &m_readOverlapped);
+  if (!complete_(isStarted, m_readOverlapped, bytesRead)) {
+    return -1;
+  }
+  return static_cast<int>(bytesRead);
+}
+
+bool SerialPort::write(const std::uint8_t *buffer, DWORD size) {
+  DWORD bytesWritten = 0;
+  const BOOL isStarted = WriteFile(m_comSerial, buffer, size, NULL, &m_writeOverlapped);
+  return complete_(isStarted, m_writeOverlapped, bytesWritten) && bytesWritten == size;
+}
+
+bool SerialPort::complete_(BOOL isStarted, OVERLAPPED &overlapped, DWORD &transferredNum) {
+  if (!isStarted && GetLastError() != ERROR_IO_PENDING) {
+    return false;
+  }
+  // Reads end within READ_TIMEOUT_MS, as set by the timeouts, cancelled ones at once
+  return GetOverlappedResult(m_comSerial, &overlapped, &transferredNum, TRUE);
+}
+
+bool SerialPort::getInputStatus(DWORD &inQueueBytes, bool &isOverrun) {
+  DWORD errors = 0;
+  COMSTAT comStat = {0};
+  if (!ClearCommError(m_comSerial, &errors, &comStat)) {
+    return false;
+  }
+  inQueueBytes = comStat.cbInQue;
+  isOverrun = (errors & (CE_OVERRUN | CE_RXOVER)) != 0;
+  return true;
+}
+
+void SerialPort::close() {
+  if (m_comSerial != INVALID_HANDLE_VALUE) {
+    CancelIoEx(m_comSerial, NULL); // the pending read completes with an error
+    CloseHandle(m_comSerial);
+    m_comSerial = INVALID_HANDLE_VALUE;
+  }
+}
+
+void SerialPort::release_() {
+  close();
+  for (HANDLE *event : {&m_readOverlapped.hEvent, &m_writeOverlapped.hEvent}) {
+    if (*event != NULL) {
+      CloseHandle(*event);
+      *event = NULL;
+    }
+  }
+}
+
+std::uint32_t SerialPort::getBaudRate() const { return m_baudRate; }
+
+const std::string &SerialPort::getPortCom() const { return m_portCom; }
+
+bool SerialPort::setBaudRate_(std::uint32_t baudRate) {
+  m_dcbSerialParams.BaudRate = baudRate;   //  baud rate
+  m_dcbSerialParams.ByteSize = 8;          //  data size, xmit and rcv
+  m_dcbSerialParams.Parity = NOPARITY;     //  parity bit
+  m_dcbSerialParams.StopBits = ONESTOPBIT; //  stop bit
+
+  if (!SetCommState(m_comSerial, &m_dcbSerialParams)) {
+    return false;
+  }
+  if (!GetCommState(m_comSerial, &m_dcbSerialParams)) {
+    return false;
+  }
+  // Bytes received with the previous setting are garbage
+  PurgeComm(m_comSerial, PURGE_RXCLEAR | PURGE_TXCLEAR);
+  return true;
+}
+
+int SerialPort::countFrames_() {
+  mavlink_message_t message;
+  mavlink_status_t status;
+  std::uint8_t buffer[256];
+  int framesNum = 0;
+
+  // Probing uses its own channel, so the parser state of receivers isn't touched
+  mavlink_reset_channel_status(MAVLINK_COMM_0);
+  const auto deadline = std::chrono::steady_clock::now() + PROBE_WINDOW;
+  while (std::chrono::steady_clock::now() < deadline &&
+         framesNum < PROBE_MIN_FRAMES) {
+    const int bytesRead = read(buffer, sizeof(buffer));
+    if (bytesRead < 0) {
+      break;
+    }
+    for (int idx = 0; idx < bytesRead; ++idx) {
+      // Only frames with a valid CRC are reported, a wrong baud rate produces none
+      if (mavlink_parse_char(MAVLINK_COMM_0, buffer[idx], &message, &status) == 1) {
+        framesNum++;
+      }
+    }
+  }
+  return framesNum;
+}
+
+std::uint32_t SerialPort::detectBaudRate_() {
+  for (const std::uint32_t baudRate : CANDIDATE_BAUD_RATES) {
+    if (!setBaudRate_(baudRate)) {
+      continue; // not supported by the serial driver
+    }
+    const int framesNum = countFrames_();
+    if (m_verbose) {
+      std::cout << "SerialPort: probing " << baudRate << " baud, "
+                << framesNum << " valid frame(s)\n";
+    }
+    if (framesNum >= PROBE_MIN_FRAMES) {
+      return baudRate;
+    }
+  }
+
+  release_();
+  throw std::runtime_error("Couldnt detect baud rate, no MAVLink frames received on " +
+                           m_portCom);
+}
@@ -0,0 +1,353 @@
+/**
+ * @file SessionRecorder.cpp
+ * @brief Code of the recording of scored positions of a session.
+ *
+ * @details This file contains the definition of SessionRecorder.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+#include "../include/SessionRecorder.h"
+
+
+namespace {
+
+template <typename T>
+void writeValue(std::ofstream &file, const T &value) {
+  file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T, std::size_t N>
+void writeColumn(std::ofstream &file, const std::array<T, N> &column, std::size_t rowsNum) {
+  file.write(reinterpret_cast<const char *>(column.data()),
+             static_cast<std::streamsize>(rowsNum * sizeof(T)));
+}
+
+} // namespace
+
+SessionRecorder::SessionRecorder(const std::filesystem::path &basePath, bool isVerbose)
+    : m_basePath(basePath), m_verbose(isVerbose) {
+  std::error_code error;
+  if (basePath.has_parent_path()) {
+    std::filesystem::create_directories(basePath.parent_path(), error);
+  }
+  m_path = basePath;
+  m_path += ".dps";
+  m_file.open(m_path, std::ios::binary | std::ios::trunc);
+  if (!m_file) {
+    std::cout << "SessionRecorder: couldn't create " << m_path.string()
+              << ", the session won't be recorded\n";
+    return;
+  }
+
+  // All chunks are allocated and touched now, not during the session
+  m_chunks.reserve(CHUNKS_NUM);
+  m_free.reserve(CHUNKS_NUM);
+  for (std::size_t idx = 0; idx < CHUNKS_NUM; ++idx) {
+    m_chunks.push_back(std::make_unique<Chunk>());
+    m_free.push_back(m_chunks.back().get());
+  }
+  m_current = m_free.back();
+  m_free.pop_back();
+
+  writeHeader_();
+  m_isEnabled = true;
+  m_writerThread = std::jthread(
+      [this](std::stop_token stopToken) { writeLoop_(stopToken); });
+
+  if (m_verbose) {
+    std::cout << "SessionRecorder: recording to " << m_path.string() << "\n";
+  }
+}
+
+SessionRecorder::~SessionRecorder() {
+  if (m_writerThread.joinable()) {
+    m_writerThread.request_stop();
+    m_writerThread.join();
+  }
+}
+
+void SessionRecorder::append(const Row &row) {
+  if (!m_isEnabled || m_isAppendClosed) {
+    return;
+  }
+  if (m_current == nullptr) {
+    handOver_();
+    if (m_current == nullptr) {
+      m_droppedNum.store(m_droppedNum.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      return;
+    }
+  }
+
+  Chunk &chunk = *m_current;
+  const std::size_t idx = chunk.rowsNum++;
+  chunk.hostTimeNs[idx] = row.hostTimeNs;
+  chunk.timeBootMs[idx] = row.timeBootMs;
+  chunk.vehicleId[idx] = row.vehicleId;
+  chunk.flags[idx] = row.flags;
+  chunk.east[idx] = row.east;
+  chunk.north[idx] = row.north;
+  chunk.up[idx] = row.up;
+  chunk.roll[idx] = row.roll;
+  chunk.pitch[idx] = row.pitch;
+  chunk.yaw[idx] = row.yaw;
+  chunk.distanceError[idx] = row.distanceError;
+  chunk.altitudeError[idx] = row.altitudeError;
+  chunk.speedError[idx] = row.speedError;
+  chunk.segmentIdx[idx] = row.segmentIdx;
+  chunk.progress[idx] = row.progress;
+  chunk.clearance[idx] = row.clearance;
+  chunk.waypointIdx[idx] = row.waypointIdx;
+  // Single writer, no read-modify-write needed
+  m_rowsNum.store(m_rowsNum.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+  if (chunk.rowsNum == CHUNK_ROWS_NUM) {
+    handOver_();
+  }
+}
+
+void SessionRecorder::handOver_() {
+  bool isHandedOver = false;
+  {
+    std::lock_guard<std::mutex> lock(m_chunksMtx);
+    if (m_current != nullptr) {
+      m_full.push_back(m_current);
+      isHandedOver = true;
+    }
+    m_current = nullptr;
+    if (!m_free.empty()) {
+      m_current = m_free.back();
+      m_free.pop_back();
+    }
+  }
+  if (isHandedOver) {
+    m_chunksCv.notify_one();
+  }
+}
+
+void SessionRecorder::close(const ScoringEngine *scoring) {
+  if (!m_isEnabled || m_isAppendClosed) {
+    return;
+  }
+  m_isAppendClosed = true;
+  {
+    std::lock_guard<std::mutex> lock(m_chunksMtx);
+    if (scoring != nullptr) {
+      m_scoring.emplace(*scoring);
+    }
+    if (m_current != nullptr) {
+      if (m_current->rowsNum > 0) {
+        m_full.push_back(m_current);
+      } else {
+        m_free.push_back(m_current);
+      }
+      m_current = nullptr;
+    }
+    m_isClosing = true;
+  }
+  m_chunksCv.notify_one();
+}
+
+bool SessionRecorder::waitClosed(std::chrono::milliseconds timeout) {
+  if (!m_isEnabled) {
+    return true;
+  }
+  std::unique_lock<std::mutex> lock(m_chunksMtx);
+  return m_closedCv.wait_for(lock, timeout, [this]() { return m_isClosed; });
+}
+
+void SessionRecorder::writeLoop_(std::stop_token stopToken) {
+  std::unique_lock<std::mutex> lock(m_chunksMtx);
+  while (true) {
+    if (!m_chunksCv.wait(lock, stopToken, [this]() { return !m_full.empty() || m_isClosing; })) {
+      break; // stopped, chunks not yet written are lost
+    }
+    if (m_full.empty()) {
+      break; // closing, everything is written
+    }
+    Chunk *chunk = m_full.front();
+    m_full.pop_front();
+
+    // Written unlocked, appending only needs the lock to exchange chunks
+    lock.unlock();
+    writeChunk_(*chunk);
+    summarise_(*chunk);
+    chunk->rowsNum = 0;
+    lock.lock();
+    m_free.push_back(chunk);
+  }
+  lock.unlock();
+
+  writeFooter_();
+  m_file.close();
+  if (!m_file) {
+    std::cout << "SessionRecorder: writing " << m_path.string() << " failed\n";
+  }
+  writeSummaries_();
+
+  lock.lock();
+  m_isClosed = true;
+  lock.unlock();
+  m_closedCv.notify_all();
+}
+
+void SessionRecorder::writeHeader_() {
+  writeValue(m_file, FILE_MAGIC);
+  writeValue(m_file, FILE_VERSION);
+  writeValue(m_file, static_cast<std::uint16_t>(COLUMNS.size()));
+  for (const Column &column : COLUMNS) {
+    char name[COLUMN_NAME_SIZE]{};
+    std::strncpy(name, column.name, COLUMN_NAME_SIZE - 1);
+    m_file.write(name, COLUMN_NAME_SIZE);
+    const std::uint8_t typeAndPadding[4] = {static_cast<std::uint8_t>(column.type), 0, 0, 0};
+    m_file.write(reinterpret_cast<const char *>(typeAndPadding), sizeof(typeAndPadding));
+  }
+}
+
+void SessionRecorder::writeChunk_(const Chunk &chunk) {
+  const std::size_t rowsNum = chunk.rowsNum;
+  writeValue(m_file, ROW_GROUP_MAGIC);
+  writeValue(m_file, static_cast<std::uint32_t>(rowsNum));
+  // In the order of COLUMNS
+  writeColumn(m_file, chunk.hostTimeNs, rowsNum);
+  writeColumn(m_file, chunk.timeBootMs, rowsNum);
+  writeColumn(m_file, chunk.vehicleId, rowsNum);
+  writeColumn(m_file, chunk.flags, rowsNum);
+  writeColumn(m_file, chunk.east, rowsNum);
+  writeColumn(m_file, chunk.north, rowsNum);
+  writeColumn(m_file, chunk.up, rowsNum);
+  writeColumn(m_file, chunk.roll, rowsNum);
+  writeColumn(m_file, chunk.pitch, rowsNum);
+  writeColumn(m_file, chunk.yaw, rowsNum);
+  writeColumn(m_file, chunk.distanceError, rowsNum);
+  writeColumn(m_file, chunk.altitudeError, rowsNum);
+  writeColumn(m_file, chunk.speedError, rowsNum);
+  writeColumn(m_file, chunk.segmentIdx, rowsNum);
+  writeColumn(m_file, chunk.progress, rowsNum);
+  writeColumn(m_file, chunk.clearance, rowsNum);
+  writeColumn(m_file, chunk.waypointIdx, rowsNum);
+  m_rowGroupsNum++;
+  m_writtenNum += rowsNum;
+}
+
+void SessionRecorder::writeFooter_() {
+  writeValue(m_file, FOOTER_MAGIC);
+  writeValue(m_file, m_rowGroupsNum);
+  writeValue(m_file, m_writtenNum);
+  writeValue(m_file, m_droppedNum.load());
+}
+
+void SessionRecorder::summarise_(const Chunk &chunk) {
+  for (std::size_t idx = 0; idx < chunk.rowsNum; ++idx) {
+    VehicleSummary &summary = m_summaries[chunk.vehicleId[idx]];
+    const std::uint8_t flags = chunk.flags[idx];
+    if (summary.rowsNum++ == 0) {
+      summary.firstTimeBootMs = chunk.timeBootMs[idx];
+    }
+    summary.lastTimeBootMs = chunk.timeBootMs[idx];
+    summary.capturedNum += (flags & FLAG_WAYPOINT_CAPTURED) != 0;
+    summary.compliantNum += (flags & FLAG_BEARING_COMPLIANT) != 0;
+    summary.collisionsNum += (flags & FLAG_COLLISION) != 0;
+    summary.insideNum += (flags & FLAG_INSIDE_OBSTACLE) != 0;
+    if (!std::isnan(chunk.clearance[idx])) {
+      summary.minClearance = std::min<double>(summary.minClearance, chunk.clearance[idx]);
+    }
+    if (!std::isnan(chunk.distanceError[idx])) {
+      summary.progress = chunk.progress[idx];
+    }
+  }
+}
+
+void SessionRecorder::writeSummaries_() const {
+  std::filesystem::path csvPath = m_basePath;
+  csvPath += "_summary.csv";
+  std::filesystem::path jsonPath = m_basePath;
+  jsonPath += "_summary.json";
+  std::ofstream csv(csvPath, std::ios::trunc);
+  std::ofstream json(jsonPath, std::ios::trunc);
+  if (!csv || !json) {
+    std::cout << "SessionRecorder: couldn't write summaries of " << m_path.string() << "\n";
+    return;
+  }
+
+  // Errors are the ones scored, reduced by the method of the exercise, left empty unscored
+  const char *method = "error";
+  if (m_scoring) {
+    method = m_scoring->getScoringMethod() == ScoringMethod::RMSE ? "rmse" : "mae";
+  }
+  csv << fmt::format("vehicle_id,positions,duration_s,scored_positions,score,distance_{0}_m,"
+                     "distance_max_m,altitude_{0}_m,altitude_max_m,speed_{0}_mps,speed_max_mps,"
+                     "progress_m,waypoints_captured,waypoints_at_bearing,collisions,"
+                     "positions_inside,min_clearance_m\n",
+                     method);
+  json << fmt::format("{{\n  \"session\": \"{}\",\n  \"rows\": {},\n  \"dropped_rows\": {},\n"
+                      "  \"row_groups\": {},\n  \"scoring_method\": {},\n  \"vehicles\": [",
+                      m_path.filename().string(), m_writtenNum, m_droppedNum.load(),
+                      m_rowGroupsNum, m_scoring ? fmt::format("\"{}\"", method) : "null");
+
+  bool isFirst = true;
+  for (std::size_t vehicleId = 0; vehicleId < MAX_VEHICLES_NUM; ++vehicleId) {
+    const VehicleSummary &summary = m_summaries[vehicleId];
+    if (summary.rowsNum == 0) {
+      continue;
+    }
+    // Time since boot wraps, the difference doesn't
+    const double duration =
+        static_cast<std::uint32_t>(summary.lastTimeBootMs - summary.firstTimeBootMs) / 1E3;
+    const bool hasClearance = std::isfinite(summary.minClearance);
+
+    std::uint64_t scoredNum = 0;
+    std::string csvErrors = ",,,,,,";
+    std::string jsonErrors = fmt::format("\"score\": null, \"distance_{0}_m\": null, \"distance_max_m\": null, "
+                                         "\"altitude_{0}_m\": null, \"altitude_max_m\": null, "
+                                         "\"speed_{0}_mps\": null, \"speed_max_mps\": null",
+                                         method);
+    const std::uint8_t id = static_cast<std::uint8_t>(vehicleId);
+    const ScoringEngine::Score score = m_scoring ? m_scoring->getScore(id) : ScoringEngine::Score{};
+    if (score.samplesNum > 0) {
+      const double distanceMax = m_scoring->getDistanceErrors(id).getMaxAbs();
+      const double altitudeMax = m_scoring->getAltitudeErrors(id).getMaxAbs();
+      const double speedMax = m_scoring->getSpeedErrors(id).getMaxAbs();
+      scoredNum = score.samplesNum;
+      csvErrors = fmt::format("{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f}", score.weighted,
+                              score.distance, distanceMax, score.altitude, altitudeMax, score.speed,
+                              speedMax);
+      jsonErrors = fmt::format("\"score\": {1:.3f}, \"distance_{0}_m\": {2:.3f}, \"distance_max_m\": {3:.3f}, "
+                               "\"altitude_{0}_m\": {4:.3f}, \"altitude_max_m\": {5:.3f}, "
+                               "\"speed_{0}_mps\": {6:.3f}, \"speed_max_mps\": {7:.3f}",
+                               method, score.weighted, score.distance, distanceMax, score.altitude,
+                               altitudeMax, score.speed, speedMax);
+    }
+
+    csv << fmt::format("{},{},{:.3f},{},{},{:.1f},{},{},{},{},{}\n", vehicleId, summary.rowsNum,
+                       duration, scoredNum, csvErrors, summary.progress, summary.capturedNum,
+                       summary.compliantNum, summary.collisionsNum, summary.insideNum,
+                       hasClearance ? fmt::format("{:.3f}", summary.minClearance) : "");
+    json << fmt::format("{}\n    {{\"vehicle_id\": {}, \"positions\": {}, \"duration_s\": {:.3f}, "
+                        "\"scored_positions\": {}, {}, \"progress_m\": {:.1f}, "
+                        "\"waypoints_captured\": {}, \"waypoints_at_bearing\": {}, "
+                        "\"collisions\": {}, \"positions_inside\": {}, \"min_clearance_m\": {}}}",
+                        isFirst ? "" : ",", vehicleId, summary.rowsNum, duration, scoredNum,
+                        jsonErrors, summary.progress, summary.capturedNum, summary.compliantNum,
+                        summary.collisionsNum, summary.insideNum,
+                        hasClearance ? fmt::format("{:.3f}", summary.minClearance) : "null");
+    isFirst = false;
+  }
+  json << "\n  ]\n}\n";
+}
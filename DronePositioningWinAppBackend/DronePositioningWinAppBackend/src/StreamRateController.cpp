@@ -0,0 +1,129 @@
+/**
+ * @file StreamRateController.cpp
+ * @brief Code of the adaptive controller of MAVLink stream rates.
+ *
+ * @details This file contains the definition of StreamRateController, which estimates the throughput
+ *          of the serial link from observed bytes per second and loss and derives interval of every stream.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+
+#include "../include/StreamRateController.h"
+
+
+StreamRateController::StreamRateController(std::uint32_t baudRate, bool isVerbose)
+    : m_capacity(baudRate / 10.0f), // 8N1: 10 bits on the wire per byte
+      m_budget(baudRate / 10.0f * TARGET_UTILISATION), m_verbose(isVerbose) {}
+
+std::size_t StreamRateController::addStream(const StreamConfig &config) {
+  m_streams.push_back(Stream{config});
+  m_changed.reserve(m_streams.size());
+  return m_streams.size() - 1;
+}
+
+const std::vector<std::size_t> &StreamRateController::allocate() {
+  float left = m_budget;
+  for (Stream &stream : m_streams) {
+    stream.rateHz = stream.config.minRateHz;
+    left -= stream.config.frameBytes * stream.config.minRateHz;
+  }
+  left = raise_(StreamPriority::POSE, left);
+  raise_(StreamPriority::HOUSEKEEPING, left);
+
+  m_changed.clear();
+  for (std::size_t idx = 0; idx < m_streams.size(); ++idx) {
+    Stream &stream = m_streams[idx];
+    const bool isChanged =
+        stream.requestedRateHz <= 0.0f ||
+        std::abs(stream.rateHz - stream.requestedRateHz) >
+            RATE_HYSTERESIS * stream.requestedRateHz;
+    if (isChanged) {
+      stream.requestedRateHz = stream.rateHz;
+      m_changed.push_back(idx);
+    }
+  }
+  return m_changed;
+}
+
+const std::vector<std::size_t> &
+StreamRateController::update(const LinkQuality &quality) {
+  if (quality.state == LinkState::LOST) {
+    m_changed.clear();
+    return m_changed; // nothing to learn from a dead link
+  }
+
+  float minBudget = 0.0f;
+  float requestedBytes = 0.0f;
+  for (const Stream &stream : m_streams) {
+    minBudget += stream.config.frameBytes * stream.config.minRateHz;
+    requestedBytes += stream.config.frameBytes * stream.requestedRateHz;
+  }
+
+  const float previousBudget = m_budget;
+  if (quality.lossRate > LOSS_BACKOFF_RATE) {
+    // The link doesn't carry what it receives- back off below what it delivered
+    m_budget = std::max(minBudget, std::min(m_budget, quality.bytesPerSecond) *
+                                       BACKOFF_FACTOR);
+  } else if (quality.bytesPerSecond >= 0.8f * requestedBytes) {
+    // Requested rates are delivered without loss- probe for more
+    m_budget = std::min(m_capacity * TARGET_UTILISATION,
+                        m_budget + m_capacity * INCREASE_STEP);
+  }
+
+  allocate();
+
+  if (m_verbose && m_budget != previousBudget) {
+    std::cout << "StreamRateController: budget " << m_budget << " B/s ("
+              << 100.0f * m_budget / m_capacity << " % of the link), "
+              << m_changed.size() << " stream(s) to reissue\n";
+  }
+  return m_changed;
+}
+
+std::size_t StreamRateController::getStreamsNum() const {
+  return m_streams.size();
+}
+
+const StreamConfig &StreamRateController::getStream(const std::size_t idx) const {
+  return m_streams.at(idx).config;
+}
+
+std::uint32_t StreamRateController::getIntervalUs(const std::size_t idx) const {
+  return static_cast<std::uint32_t>(1000000.0f / m_streams.at(idx).rateHz);
+}
+
+float StreamRateController::getBudget() const { return m_budget; }
+
+float StreamRateController::raise_(const StreamPriority priority,
+                                   const float budget) {
+  float span = 0.0f; // bytes per second needed to bring all streams to their maximum
+  for (const Stream &stream : m_streams) {
+    if (stream.config.priority == priority) {
+      span += stream.config.frameBytes *
+              (stream.config.maxRateHz - stream.config.minRateHz);
+    }
+  }
+  if (span <= 0.0f || budget <= 0.0f) {
+    return budget;
+  }
+
+  const float fraction = std::min(1.0f, budget / span);
+  for (Stream &stream : m_streams) {
+    if (stream.config.priority == priority) {
+      stream.rateHz = stream.config.minRateHz +
+                      fraction * (stream.config.maxRateHz - stream.config.minRateHz);
+    }
+  }
+  return budget - fraction * span;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file TelemetryDecoder.cpp
+ * @brief Code of the decoding of MAVLink messages into the aggregated telemetry sample.
+ *
+ * @details This file contains the definition of TelemetryDecoder.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+
+#include "../include/TelemetryDecoder.h"
+
+
+TelemetryDecoder::Result TelemetryDecoder::decode(const mavlink_message_t &message,
+                                                  std::int64_t arrivalNs) {
+  switch (message.msgid) {
+    case MAVLINK_MSG_ID_ATTITUDE: {
+      mavlink_attitude_t attitude;
+      mavlink_msg_attitude_decode(&message, &attitude);
+      m_sample.attitudeTimeBootMs = attitude.time_boot_ms;
+      m_sample.attitudeHostTimeNs =
+          toCaptureHostNs_(attitude.time_boot_ms * 1'000'000ll, arrivalNs);
+      m_sample.roll       = attitude.roll;
+      m_sample.pitch      = attitude.pitch;
+      m_sample.yaw        = attitude.yaw;
+      m_sample.rollSpeed  = attitude.rollspeed;
+      m_sample.pitchSpeed = attitude.pitchspeed;
+      m_sample.yawSpeed   = attitude.yawspeed;
+      m_sample.updatedFields |= TelemetrySample::ATTITUDE;
+    } break;
+
+    case MAVLINK_MSG_ID_GLOBAL_POSITION_INT: {
+      mavlink_global_position_int_t gps;
+      mavlink_msg_global_position_int_decode(&message, &gps);
+      m_sample.globalPositionTimeBootMs = gps.time_boot_ms;
+      m_sample.globalPositionHostTimeNs =
+          toCaptureHostNs_(gps.time_boot_ms * 1'000'000ll, arrivalNs);
+      m_sample.latE7         = gps.lat;          // Latitude in degrees * 1E7
+      m_sample.lonE7         = gps.lon;          // Longitude in degrees * 1E7
+      m_sample.altMm         = gps.alt;          // Altitude in millimeters (above MSL)
+      m_sample.relativeAltMm = gps.relative_alt; // Altitude in millimeters (above home)
+      m_sample.velocityNorth = gps.vx / 100.0f;  // cm/s
+      m_sample.velocityEast  = gps.vy / 100.0f;
+      m_sample.velocityDown  = gps.vz / 100.0f;
+      m_sample.updatedFields |= TelemetrySample::GLOBAL_POSITION;
+    } break;
+
+    case MAVLINK_MSG_ID_LOCAL_POSITION_NED: {
+      mavlink_local_position_ned_t local;
+      mavlink_msg_local_position_ned_decode(&message, &local);
+      m_sample.localPositionTimeBootMs = local.time_boot_ms;
+      m_sample.localPositionHostTimeNs =
+          toCaptureHostNs_(local.time_boot_ms * 1'000'000ll, arrivalNs);
+      m_sample.localX  = local.x;
+      m_sample.localY  = local.y;
+      m_sample.localZ  = local.z;
+      m_sample.localVx = local.vx;
+      m_sample.localVy = local.vy;
+      m_sample.localVz = local.vz;
+      m_sample.updatedFields |= TelemetrySample::LOCAL_POSITION;
+    } break;
+
+    case MAVLINK_MSG_ID_HIGHRES_IMU: {
+      mavlink_highres_imu_t imu;
+      mavlink_msg_highres_imu_decode(&message, &imu);
+      m_sample.imuTimeUs = imu.time_usec;
+      m_sample.imuHostTimeNs = toCaptureHostNs_(
+          static_cast<std::int64_t>(imu.time_usec) * 1'000, arrivalNs);
+      m_sample.accX  = imu.xacc;
+      m_sample.accY  = imu.yacc;
+      m_sample.accZ  = imu.zacc;
+      m_sample.gyroX = imu.xgyro;
+      m_sample.gyroY = imu.ygyro;
+      m_sample.gyroZ = imu.zgyro;
+      m_sample.updatedFields |= TelemetrySample::IMU;
+    } break;
+
+    case MAVLINK_MSG_ID_VFR_HUD: {
+      mavlink_vfr_hud_t hud;
+      mavlink_msg_vfr_hud_decode(&message, &hud);
+      m_sample.airSpeed    = hud.airspeed;
+      m_sample.groundSpeed = hud.groundspeed;
+      m_sample.climbRate   = hud.climb;
+      m_sample.heading     = hud.heading;
+      m_sample.updatedFields |= TelemetrySample::VFR_HUD;
+    } break;
+
+    case MAVLINK_MSG_ID_TIMESYNC: {
+      mavlink_timesync_t timesync;
+      mavlink_msg_timesync_decode(&message, &timesync);
+      if (timesync.tc1 == 0) {
+        // The autopilot synchronises its own clock with ours
+        return {Action::REPLY_TIMESYNC, timesync.ts1, 0};
+      }
+      m_clockSync.onTimesync(timesync.tc1, timesync.ts1, arrivalNs);
+      return {};
+    }
+
+    case MAVLINK_MSG_ID_SYSTEM_TIME: {
+      mavlink_system_time_t systemTime;
+      mavlink_msg_system_time_decode(&message, &systemTime);
+      m_clockSync.onSystemTime(systemTime.time_boot_ms, arrivalNs);
+      return {};
+    }
+
+    case MAVLINK_MSG_ID_COMMAND_ACK: {
+      mavlink_command_ack_t commandAck;
+      mavlink_msg_command_ack_decode(&message, &commandAck);
+      if (commandAck.command != MAV_CMD_SET_MESSAGE_INTERVAL) {
+        return {};
+      }
+      return {Action::INTERVAL_ACK, 0, commandAck.result};
+    }
+
+    default: {
+      return {};
+    }
+  }
+
+  m_sample.systemId = message.sysid;
+  m_sample.isTimeSynced = m_clockSync.isSynced();
+  m_sample.validFields |= m_sample.updatedFields;
+  if (message.msgid != PUBLISH_TRIGGER_MSG_ID) {
+    return {};
+  }
+  return {Action::PUBLISH, 0, 0};
+}
+
+std::int64_t TelemetryDecoder::toCaptureHostNs_(std::int64_t bootNs,
+                                                std::int64_t arrivalNs) const {
+  if (!m_clockSync.isSynced()) {
+    return arrivalNs;
+  }
+  // A capture can't happen after the arrival, estimate noise is clamped
+  return std::min(m_clockSync.toHostNs(bootNs), arrivalNs);
+}
@@ -0,0 +1,135 @@
+/**
+ * @file TelemetryPacket.cpp
+ * @brief Code of the telemetry wire formats.
+ *
+ * @details This file contains the definition of functions serialising TelemetrySample.
+ *          Values are written byte by byte with shifts, so the output is little-endian
+ *          regardless of the host byte order and no packed structures are needed.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <bit>
+#include <cstdio>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "../include/TelemetryPacket.h"
+
+
+namespace wire {
+
+namespace {
+
+template <typename T>
+inline std::uint8_t *putLe(std::uint8_t *out, T value) {
+  using Unsigned = std::make_unsigned_t<T>;
+  const Unsigned bits = static_cast<Unsigned>(value);
+  for (std::size_t idx = 0; idx < sizeof(T); ++idx) {
+    *out++ = static_cast<std::uint8_t>(bits >> (8 * idx));
+  }
+  return out;
+}
+
+inline std::uint8_t *putLe(std::uint8_t *out, float value) {
+  return putLe(out, std::bit_cast<std::uint32_t>(value));
+}
+
+inline std::int32_t toMm(double metres) {
+  const double mm = std::round(metres * 1E3);
+  if (!(mm == mm)) {
+    return 0; // NaN
+  }
+  return static_cast<std::int32_t>(
+      std::clamp(mm, static_cast<double>(std::numeric_limits<std::int32_t>::min()),
+                 static_cast<double>(std::numeric_limits<std::int32_t>::max())));
+}
+
+} // namespace
+
+std::size_t serializeBinary(const TelemetrySample &telemetry, std::uint32_t sequence,
+                            std::int64_t sendTimeNs, std::uint8_t *buffer) {
+  const std::int64_t captureAgeNs =
+      std::max<std::int64_t>(0, sendTimeNs - telemetry.attitudeHostTimeNs);
+  const bool isLocal = telemetry.has(TelemetrySample::LOCAL_FRAME);
+  std::uint8_t flags = telemetry.isTimeSynced ? FLAG_TIME_SYNCED : 0;
+  if (isLocal) {
+    flags |= FLAG_LOCAL_FRAME;
+  }
+  if (telemetry.isPredicted) {
+    flags |= FLAG_PREDICTED;
+  }
+
+  std::uint8_t *out = buffer;
+  // Header
+  out = putLe(out, MAGIC);
+  out = putLe(out, VERSION);
+  out = putLe(out, telemetry.systemId);
+  out = putLe(out, sequence);
+  out = putLe(out, telemetry.attitudeHostTimeNs);
+  // Body
+  out = putLe(out, static_cast<std::uint16_t>(telemetry.validFields));
+  out = putLe(out, flags);
+  out = putLe(out, std::uint8_t{0});
+  out = putLe(out, telemetry.roll);
+  out = putLe(out, telemetry.pitch);
+  out = putLe(out, telemetry.yaw);
+  out = putLe(out, isLocal ? toMm(telemetry.east) : telemetry.latE7);
+  out = putLe(out, isLocal ? toMm(telemetry.north) : telemetry.lonE7);
+  out = putLe(out, isLocal ? toMm(telemetry.up) : telemetry.altMm);
+  out = putLe(out, telemetry.relativeAltMm);
+  out = putLe(out, telemetry.velocityNorth);
+  out = putLe(out, telemetry.velocityEast);
+  out = putLe(out, telemetry.velocityDown);
+  out = putLe(out, static_cast<std::uint32_t>(
+                       std::min<std::int64_t>(captureAgeNs / 1000, UINT32_MAX)));
+  return static_cast<std::size_t>(out - buffer);
+}
+
+std::size_t serializeText(const TelemetrySample &telemetry, char *buffer) {
+  // Same "%f" formatting of floats as std::to_string, without building strings
+  const bool isLocal = telemetry.has(TelemetrySample::LOCAL_FRAME);
+  const int written = std::snprintf(
+      buffer, MAX_TEXT_PACKET_SIZE, "%f %f %f %f %f %f ", telemetry.roll,
+      telemetry.pitch, telemetry.yaw,
+      isLocal ? telemetry.east : static_cast<float>(telemetry.latitudeDeg()),
+      isLocal ? telemetry.north : static_cast<float>(telemetry.longitudeDeg()),
+      isLocal ? telemetry.up : static_cast<float>(telemetry.altitudeM()));
+  if (written < 0) {
+    return 0;
+  }
+  const std::size_t length =
+      std::min(static_cast<std::size_t>(written), MAX_TEXT_PACKET_SIZE - 1);
+  return length + 1; // the NUL written by snprintf is sent as well
+}
+
+std::size_t serializeProgress(const WaypointProgress &progress, std::uint8_t *buffer) {
+  std::uint8_t flags = progress.isCaptured ? PROGRESS_FLAG_CAPTURED : 0;
+  if (progress.isBearingCompliant) {
+    flags |= PROGRESS_FLAG_BEARING_COMPLIANT;
+  }
+
+  std::uint8_t *out = buffer;
+  out = putLe(out, PROGRESS_MAGIC);
+  out = putLe(out, VERSION);
+  out = putLe(out, progress.vehicleId);
+  out = putLe(out, static_cast<std::uint8_t>(progress.state));
+  out = putLe(out, flags);
+  out = putLe(out, progress.waypointIdx);
+  out = putLe(out, progress.waypointsNum);
+  out = putLe(out, std::uint16_t{0});
+  out = putLe(out, progress.timeBootMs);
+  out = putLe(out, progress.distance);
+  return static_cast<std::size_t>(out - buffer);
+}
+
+} // namespace wire
@@ -1,43 +1,378 @@
-/**
- * @file TelemetryProcessor.cpp
- * @brief Code of the concrete implementation of IProcessor.
- *
- * @details This file contains the declaration of the concrete implementation of
- *          telemetry processor.
- *
- * @author Szymon Bogus
- * @date 2024-05-22
- *
- * @copyright Copyright 2024 Szymon Bogus
- * @license Apache License, Version 2.0 (see
- * https://www.apache.org/licenses/LICENSE-2.0)
- *
- * @version 1.0
- *
- * @note This is still a work in progress.
- */
-
-#include "../include/TelemetryProcessor.h"
-
-
-TelemetryProcessor::TelemetryProcessor(bool isVerbose) : m_verbose(isVerbose) {
-  if (m_verbose) {
-    std::cout << "TelemetryProcessor: instantiated\n";
-  }
-}
-
-void TelemetryProcessor::process_(const std::vector<float> &telemetry) {
-  if (m_verbose) {
-    std::cout << "TelemetryProcessor received: \n";
-    for (const auto &t : telemetry) {
-      std::cout << t << " ";
-    }
-    std::cout << "\n";
-  }
-}
-
-void TelemetryProcessor::generateReport_() {}
-
-void TelemetryProcessor::onEvent_(const TelemetryEvent &event) {
-  process(event.telemetry);
-}
+/**
+ * @file TelemetryProcessor.cpp
+ * @brief Code of the concrete implementation of IProcessor.
+ *
+ * @details This file contains the declaration of the concrete implementation of
+ *          telemetry processor.
+ *
+ * @author Szymon Bogus
+ * @date 2024-05-22
+ *
+ * @copyright Copyright 2024 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "../include/TelemetryProcessor.h"
+
+
+TelemetryProcessor::TelemetryProcessor(EventsBus &bus,
+                                       const configuration::FlightConfig &flightConfig,
+                                       const std::filesystem::path &sessionPath,
+                                       ProcessingMode mode,
+                                       bool isVerbose)
+    : m_localFrame(flightConfig.getOperatorPosition()),
+      m_guideline(flightConfig.getWaypoints(), m_localFrame,
+                  flightConfig.getExerciseInfo().coordinatesSystem,
+                  flightConfig.getExerciseInfo().guidelineOffset),
+      m_targetSpeed(flightConfig.getExerciseInfo().targetSpeed),
+      m_obstacles(flightConfig.getObstacles(), m_localFrame,
+                  flightConfig.getExerciseInfo().coordinatesSystem),
+      m_scoring(flightConfig.getExerciseInfo()),
+      m_progression(flightConfig.getWaypoints(), m_localFrame, flightConfig.getExerciseInfo()),
+      m_verbose(isVerbose) {
+  m_publisher = bus.getPublisher();
+  if (!sessionPath.empty()) {
+    m_session = std::make_unique<SessionRecorder>(sessionPath, m_verbose);
+  }
+  if (mode == ProcessingMode::PIPELINED) {
+    const std::vector<int> &cores = flightConfig.getConnectionConfigurationInfo().processingCores;
+    if (!cores.empty() && cores.size() != STAGES_NUM) {
+      throw std::runtime_error("TelemetryProcessor: ProcessingCores needs " + std::to_string(STAGES_NUM) +
+                               " cores, one per stage");
+    }
+    // Started from the last stage, so every stage exists before items are handed to it
+    m_stages = std::make_unique<std::array<Stage, STAGES_NUM>>();
+    const std::array<Stage::Handler, STAGES_NUM> handlers = {
+        [this](StageItem *items, std::size_t count) { transform_(items, count); },
+        [this](StageItem *items, std::size_t count) { score_(items, count); },
+        [this](StageItem *items, std::size_t count) { collide_(items, count); },
+        [this](StageItem *items, std::size_t count) { report_(items, count); },
+    };
+    for (std::size_t idx = STAGES_NUM; idx-- > 0;) {
+      (*m_stages)[idx].start(STAGE_NAMES[idx], handlers[idx],
+                             idx + 1 < STAGES_NUM ? &(*m_stages)[idx + 1] : nullptr,
+                             cores.empty() ? -1 : cores[idx]);
+    }
+  }
+  if (m_verbose) {
+    std::cout << "TelemetryProcessor: instantiated"
+              << (mode == ProcessingMode::PIPELINED ? ", pipelined\n" : "\n");
+  }
+}
+
+TelemetryProcessor::~TelemetryProcessor() {
+  stopPipeline_();
+}
+
+void TelemetryProcessor::process_(const TelemetrySample &telemetry) {
+  if (m_verbose) {
+    std::cout << "TelemetryProcessor received: \n"
+              << telemetry.roll << " " << telemetry.pitch << " "
+              << telemetry.yaw << " " << telemetry.latitudeDeg() << " "
+              << telemetry.longitudeDeg() << " " << telemetry.altitudeM()
+              << "\n";
+    if (telemetry.isTimeSynced) {
+      // Age since the autopilot captured attitude, skew between attitude and position captures
+      const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                           .count();
+      std::cout << "  capture age " << (now - telemetry.attitudeHostTimeNs) / 1E6
+                << " ms, attitude-position skew "
+                << (telemetry.attitudeHostTimeNs - telemetry.globalPositionHostTimeNs) / 1E6
+                << " ms\n";
+    }
+  }
+
+  // Every position fix is scored once, samples updated by other streams repeat it
+  if (telemetry.isPredicted ||
+      !telemetry.has(TelemetrySample::GLOBAL_POSITION) ||
+      (telemetry.updatedFields & TelemetrySample::GLOBAL_POSITION) == 0) {
+    return;
+  }
+
+  StageItem item;
+  item.telemetry = telemetry;
+  if (m_stages) {
+    // Callbacks come from several threads, the queue takes one producer
+    std::lock_guard<std::mutex> lock(m_entryMtx);
+    if (!m_isStopped) {
+      item.entryNs = pipelineNowNs();
+      (*m_stages)[0].push(&item, 1);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_scoringMtx);
+    transform_(&item, 1);
+    score_(&item, 1);
+    collide_(&item, 1);
+    if (m_session) {
+      m_session->append(item.row);
+    }
+  }
+  // Published only on transitions, outside the lock
+  if (item.isTransition) {
+    publishProgress_(item.progress);
+  }
+}
+
+void TelemetryProcessor::transform_(StageItem *items, std::size_t count) const {
+  // Positions without a local one are converted in one batch
+  std::array<std::int32_t, STAGE_BATCH_SIZE> latE7{}, lonE7{}, altMm{};
+  std::array<double, STAGE_BATCH_SIZE> east, north, up;
+  std::array<std::size_t, STAGE_BATCH_SIZE> convertedIdxs;
+  std::size_t convertedNum = 0;
+  for (std::size_t idx = 0; idx < count; ++idx) {
+    const TelemetrySample &telemetry = items[idx].telemetry;
+    if (telemetry.has(TelemetrySample::LOCAL_FRAME)) {
+      items[idx].east = telemetry.east;
+      items[idx].north = telemetry.north;
+      items[idx].up = telemetry.up;
+    } else {
+      latE7[convertedNum] = telemetry.latE7;
+      lonE7[convertedNum] = telemetry.lonE7;
+      altMm[convertedNum] = telemetry.altMm;
+      convertedIdxs[convertedNum++] = idx;
+    }
+  }
+  m_localFrame.toEnu(latE7.data(), lonE7.data(), altMm.data(), convertedNum, east.data(), north.data(),
+                     up.data());
+  for (std::size_t idx = 0; idx < convertedNum; ++idx) {
+    StageItem &item = items[convertedIdxs[idx]];
+    item.east = east[idx];
+    item.north = north[idx];
+    item.up = up[idx];
+  }
+
+  for (std::size_t idx = 0; idx < count; ++idx) {
+    StageItem &item = items[idx];
+    const TelemetrySample &telemetry = item.telemetry;
+    SessionRecorder::Row &row = item.row;
+    row.hostTimeNs = telemetry.isTimeSynced ? telemetry.globalPositionHostTimeNs : 0;
+    row.timeBootMs = telemetry.globalPositionTimeBootMs;
+    row.vehicleId = telemetry.systemId;
+    row.flags = telemetry.isTimeSynced ? SessionRecorder::FLAG_TIME_SYNCED : 0;
+    row.east = static_cast<float>(item.east);
+    row.north = static_cast<float>(item.north);
+    row.up = static_cast<float>(item.up);
+    row.roll = telemetry.roll;
+    row.pitch = telemetry.pitch;
+    row.yaw = telemetry.yaw;
+  }
+}
+
+void TelemetryProcessor::score_(StageItem *items, std::size_t count) {
+  for (std::size_t idx = 0; idx < count; ++idx) {
+    StageItem &item = items[idx];
+    const TelemetrySample &telemetry = item.telemetry;
+    SessionRecorder::Row &row = item.row;
+    item.isTransition = m_progression.update(telemetry, item.east, item.north, item.up, item.progress);
+    row.waypointIdx = m_progression.getWaypointIdx(telemetry.systemId);
+    if (item.isTransition && item.progress.isCaptured) {
+      row.flags |= SessionRecorder::FLAG_WAYPOINT_CAPTURED;
+      row.flags |= item.progress.isBearingCompliant ? SessionRecorder::FLAG_BEARING_COMPLIANT : 0;
+    }
+    if (!m_guideline.isEmpty()) {
+      GuidelineState &state = m_guidelineStates[telemetry.systemId];
+      const GuidelineTracker::Projection projection =
+          m_guideline.track(state.cursor, item.east, item.north, item.up);
+      state.progress = projection.progress;
+      const ScoringEngine::Errors errors = computeErrors_(projection, telemetry);
+      m_scoring.add(telemetry.systemId, errors);
+      row.distanceError = static_cast<float>(errors.distance);
+      row.altitudeError = static_cast<float>(errors.altitude);
+      row.speedError = static_cast<float>(errors.speed);
+      row.segmentIdx = static_cast<std::uint32_t>(projection.segmentIdx);
+      row.progress = static_cast<float>(projection.progress);
+    }
+  }
+}
+
+void TelemetryProcessor::collide_(StageItem *items, std::size_t count) {
+  for (std::size_t idx = 0; idx < count; ++idx) {
+    StageItem &item = items[idx];
+    ObstacleIndex::Proximity proximity;
+    if (!m_obstacles.findNearest(item.east, item.north, item.up, proximity)) {
+      continue;
+    }
+    const std::uint8_t vehicleId = item.telemetry.systemId;
+    ObstacleStats &stats = m_obstacleStats[vehicleId];
+    const bool isInside = proximity.distance <= 0.0;
+    item.row.clearance = static_cast<float>(proximity.distance);
+    item.row.flags |= isInside ? SessionRecorder::FLAG_INSIDE_OBSTACLE : 0;
+    if (isInside && !stats.isInside) {
+      item.row.flags |= SessionRecorder::FLAG_COLLISION;
+      stats.collisionsNum++;
+      if (m_verbose) {
+        std::cout << "TelemetryProcessor: vehicle " << static_cast<int>(vehicleId)
+                  << " hit obstacle " << proximity.obstacleId << "\n";
+      }
+    }
+    stats.isInside = isInside;
+    stats.positionsInsideNum += isInside;
+    if (proximity.distance < stats.minClearance) {
+      stats.minClearance = proximity.distance;
+      stats.closestObstacleId = proximity.obstacleId;
+    }
+  }
+}
+
+void TelemetryProcessor::report_(StageItem *items, std::size_t count) {
+  for (std::size_t idx = 0; idx < count; ++idx) {
+    if (m_session) {
+      m_session->append(items[idx].row);
+    }
+    if (items[idx].isTransition) {
+      publishProgress_(items[idx].progress);
+    }
+  }
+  // Up to the end of the batch, as stages measure theirs
+  const std::int64_t nowNs = pipelineNowNs();
+  for (std::size_t idx = 0; idx < count; ++idx) {
+    m_pipelineLatency.add(nowNs - items[idx].entryNs);
+  }
+}
+
+void TelemetryProcessor::publishProgress_(const WaypointProgress &progress) {
+  if (m_verbose) {
+    std::cout << "TelemetryProcessor: vehicle " << static_cast<int>(progress.vehicleId)
+              << " waypoint " << progress.waypointIdx << "/" << progress.waypointsNum
+              << (progress.state == WaypointState::HOVERING    ? " hovering"
+                  : progress.state == WaypointState::COMPLETED ? " completed"
+                                                               : " approaching")
+              << "\n";
+  }
+  ProgressEvent progressEvent(progress);
+  m_publisher->publish(EventType::PROGRESS_UPDATE, progressEvent);
+}
+
+ScoringEngine::Errors TelemetryProcessor::computeErrors_(const GuidelineTracker::Projection &projection,
+                                                         const TelemetrySample &telemetry) const {
+  ScoringEngine::Errors errors;
+  errors.distance = projection.distance;
+  errors.altitude = projection.altitude;
+  errors.speed = std::hypot(telemetry.velocityNorth, telemetry.velocityEast) - m_targetSpeed;
+  return errors;
+}
+
+void TelemetryProcessor::generateReport_() {
+  closeSession_();
+  std::lock_guard<std::mutex> lock(m_scoringMtx);
+  if (m_session && m_session->isEnabled()) {
+    fmt::print("TelemetryProcessor: {} positions recorded to {}, {} dropped\n",
+               m_session->getRowsNum(), m_session->getPath().string(),
+               m_session->getDroppedNum());
+  }
+  if (m_stages) {
+    for (std::size_t idx = 0; idx < STAGES_NUM; ++idx) {
+      const Stage::Metrics metrics = (*m_stages)[idx].getMetrics();
+      fmt::print("TelemetryProcessor: stage {:<9} {} positions, {:.0f} ns each, {:.2f} % busy, latency p50 "
+                 "{:.1f} us, p99 {:.1f} us, max {:.1f} us, queue max {} of {}, {} dropped, {} stalls\n",
+                 STAGE_NAMES[idx], metrics.itemsNum, metrics.serviceNs, 100.0 * metrics.utilisation,
+                 metrics.latencyP50Ns / 1E3, metrics.latencyP99Ns / 1E3, metrics.latencyMaxNs / 1E3,
+                 metrics.queueMaxDepth, metrics.queueCapacity, metrics.droppedNum, metrics.stallsNum);
+    }
+    fmt::print("TelemetryProcessor: pipeline latency p50 {:.1f} us, p99 {:.1f} us, max {:.1f} us\n",
+               m_pipelineLatency.getPercentileNs(50.0) / 1E3, m_pipelineLatency.getPercentileNs(99.0) / 1E3,
+               m_pipelineLatency.getMaxNs() / 1E3);
+  }
+  const char *method = m_scoring.getScoringMethod() == ScoringMethod::RMSE ? "RMSE" : "MAE";
+  const std::uint8_t *vehicleIds;
+  const std::size_t vehiclesNum = m_scoring.getVehicles(vehicleIds);
+  if (vehiclesNum == 0) {
+    fmt::print("TelemetryProcessor: no positions were scored\n");
+    return;
+  }
+  for (std::size_t idx = 0; idx < vehiclesNum; ++idx) {
+    const std::uint8_t vehicleId = vehicleIds[idx];
+    const ScoringEngine::Score score = m_scoring.getScore(vehicleId);
+    fmt::print("TelemetryProcessor: vehicle {}, {} positions, score ({}) {:.3f}\n", vehicleId,
+               score.samplesNum, method, score.weighted);
+    auto printErrors = [&](const char *name, const char *unit, double value,
+                           const ErrorAccumulator &errors) {
+      fmt::print("  {:<9}{} {:.3f} {}, bias {:+.3f}, std dev {:.3f}, max {:.3f}\n", name, method,
+                 value, unit, errors.getMean(), errors.getStdDev(), errors.getMaxAbs());
+    };
+    printErrors("distance", "m", score.distance, m_scoring.getDistanceErrors(vehicleId));
+    printErrors("altitude", "m", score.altitude, m_scoring.getAltitudeErrors(vehicleId));
+    printErrors("speed", "m/s", score.speed, m_scoring.getSpeedErrors(vehicleId));
+    fmt::print("  guideline: progress {:.1f} of {:.1f} m\n", m_guidelineStates[vehicleId].progress,
+               m_guideline.getLength());
+    if (m_progression.getWaypointsNum() > 0) {
+      const WaypointProgression::Stats &progressionStats = m_progression.getStats(vehicleId);
+      fmt::print("  waypoints: {} of {} captured, {} at the target bearing", progressionStats.capturedNum,
+                 m_progression.getWaypointsNum(), progressionStats.compliantNum);
+      if (m_progression.getState(vehicleId) == WaypointState::COMPLETED) {
+        fmt::print(", completed in {:.1f} s",
+                   (progressionStats.completionTimeBootMs - progressionStats.startTimeBootMs) / 1E3);
+      }
+      fmt::print("\n");
+    }
+    if (m_obstacles.getObstaclesNum() > 0) {
+      const ObstacleStats &stats = m_obstacleStats[vehicleId];
+      fmt::print("  obstacles: {} collisions, {} positions inside, min clearance {:.2f} m (obstacle {})\n",
+                 stats.collisionsNum, stats.positionsInsideNum, stats.minClearance,
+                 stats.closestObstacleId);
+    }
+  }
+}
+
+void TelemetryProcessor::onEvent_(const TelemetryEvent &event) {
+  process(event.telemetry);
+}
+
+void TelemetryProcessor::onEvent_(const AppTerminationEvent &event) {
+  if (event.isAppTerminating) {
+    closeSession_();
+  }
+}
+
+TelemetryProcessor::Stage::Metrics TelemetryProcessor::getStageMetrics(std::size_t stageIdx) const {
+  return m_stages && stageIdx < STAGES_NUM ? (*m_stages)[stageIdx].getMetrics() : Stage::Metrics{};
+}
+
+ScoringEngine::Score TelemetryProcessor::getScore(std::uint8_t vehicleId) {
+  std::lock_guard<std::mutex> lock(m_scoringMtx);
+  return m_scoring.getScore(vehicleId);
+}
+
+void TelemetryProcessor::stopPipeline_() {
+  if (!m_stages) {
+    return;
+  }
+  std::lock_guard<std::mutex> stopLock(m_stopMtx);
+  {
+    std::lock_guard<std::mutex> lock(m_entryMtx);
+    if (m_isStopped) {
+      return;
+    }
+    m_isStopped = true;
+  }
+  // Every stage drains its queue into the next one before that one is stopped
+  for (Stage &stage : *m_stages) {
+    stage.stop();
+  }
+}
+
+void TelemetryProcessor::closeSession_() {
+  stopPipeline_();
+  if (!m_session) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_scoringMtx);
+    m_session->close(&m_scoring);
+  }
+  // Outside the lock, telemetry still arriving isn't held up by the disk
+  if (!m_session->waitClosed(SESSION_CLOSE_TIMEOUT)) {
+    std::cout << "TelemetryProcessor: session files are still being written\n";
+  }
+}
@@ -1,319 +1,429 @@
-/**
- * @file TelemetryReceiver.cpp
- * @brief Code of the concrete implementation of ITelemetryReceiver interface.
- *
- * @details This file contains the declaration of the concrete telemetry receiver, which
- *          utilizes:
- *          - serial port connection for receiving telemetry data (windows.h)
- *          - mavlink protocol for receiving telemetry data
- *
- * @author Szymon Bogus
- * @date 2024-05-22
- *
- * @copyright Copyright 2024 Szymon Bogus
- * @license Apache License, Version 2.0 (see
- * https://www.apache.org/licenses/LICENSE-2.0)
- *
- * @version 1.0
- *
- * @note Emergency shutdown from TelemetryReceiver::receive_ result in deadlock in DronePositioningWinAppBacked.cpp.
- *       This might not be directly related to some bad code in the method here. However, another issue is the fact that,
- *       from the level of constructor of TelemetryReceiver it cannot use
- *       EventsBus to signal some ConnectionEvent- deadlock as subscription map is empty and there's nothing to lock on. 
- *       This is due to the fact that instantiaion of TelemetryReceiver happend before anything can subscribe to EventsBus- 
- *       - I'm talking about ConnectionManager. Switching the order in the MainController.cpp should help resolve that issue.
- *       However ConnectionManager requires TelemetryReceiver as its constructor argument. Apparently TelemetryReceiver should be 
- *       passed to ConnectionManager::connect, instead of the constructor and some sort of reference to it shoudl be created inside
- *       ConnectionManager so later on it can also call ConnectionManager::disconnect and ask TelemetryReceiver::stop.
- */
-
-#include "../include/TelemetryReceiver.h"
-
-
-TelemetryReceiver::TelemetryReceiver(EventsBus &bus, const std::string &portCom,
-                                     bool isVerbose) 
-    : m_portCom(portCom), m_verbose(isVerbose) { 
-
-  m_publisher = bus.getPublisher();
-  m_running.store(false);
-
-  // Initializing serial port connection
-  // Validating, if port COM works
-  int retryCnt = 5;
-  DWORD isCOM = 0;
-  CHAR lpTargetPath[5000];
-  while (retryCnt > 0) {
-    isCOM = QueryDosDeviceA(m_portCom.c_str(), lpTargetPath, 5000);
-    if (isCOM) {
-      break;
-    } else {
-      std::cout << "You have: " << retryCnt * 5
-                << " s to plug in the receiver..\n";
-      std::this_thread::sleep_for(std::chrono::milliseconds(5000)); // wait 5 seconds before checking again
-      retryCnt--;
-    }
-  } // wait overall 25 seconds for connection
-  
-  if (!isCOM) {
-    throw std::runtime_error("Receiving device is not connected or port COM "
-                             "has been incorrectly specified");
-  }
-
-  // Establishing connection
-  m_comSerial = HANDLE(INVALID_HANDLE_VALUE);
-  m_dcbSerialParams = {0};
-
-  std::wstring wideComPort(m_portCom.begin(), m_portCom.end());
-  LPCWSTR comPortName = wideComPort.c_str();
-
-  m_comSerial = CreateFile(
-	  comPortName,
-	  GENERIC_READ | GENERIC_WRITE,
-	  0,
-	  0,
-	  OPEN_EXISTING, 
-	  FILE_ATTRIBUTE_NORMAL,
-	  0
-  );
-
-  if (m_comSerial == INVALID_HANDLE_VALUE) {
-    throw std::runtime_error("Error opening serial port");
-  }
-
-  SecureZeroMemory(&m_dcbSerialParams, sizeof(m_dcbSerialParams));
-  m_dcbSerialParams.DCBlength = sizeof(m_dcbSerialParams);
-
-  if (!GetCommState(m_comSerial, &m_dcbSerialParams)) {
-    throw std::runtime_error("Error getting com state");
-  }
-
-  //  Fill in some DCB values and set the com state:
-  //  57,600 bps, 8 data bits, no parity, and 1 stop bit.
-  m_dcbSerialParams.BaudRate = CBR_57600;  //  baud rate
-  m_dcbSerialParams.ByteSize = 8;          //  data size, xmit and rcv
-  m_dcbSerialParams.Parity = NOPARITY;     //  parity bit
-  m_dcbSerialParams.StopBits = ONESTOPBIT; //  stop bit
-
-  if (!SetCommState(m_comSerial, &m_dcbSerialParams)) {
-    throw std::runtime_error("Error setting serial port state");
-  }
-
-  if (!GetCommState(m_comSerial, &m_dcbSerialParams)) {
-    throw std::runtime_error("Error getting serial port state");
-  }
-
-  if (m_verbose) {
-    std::cout << "TelemetryReceiver: instanitated\n";
-  }
-}
-
-TelemetryReceiver::~TelemetryReceiver() { m_publisher = nullptr; }
-
-void TelemetryReceiver::receive_() {
-	// Launching Processor thread
-    m_running.store(true);
-	if (m_verbose) {
-      ConnectionEvent connEvent(true, "TelemetryReceiver",
-                                "Running receiver thread");
-      m_publisher->publish(EventType::CONNECTION_UPDATE, connEvent);
-	}
-
-    // Mavlink data structures
-    mavlink_message_t message;
-    mavlink_status_t status;
-    
-    // Lambda function for setting up mavlink data interval
-    auto requestDataStream = [&](uint16_t messageId, uint32_t intervalUs) {
-      mavlink_command_ack_t command_ack;
-      uint8_t intervalRequestData[MAVLINK_MAX_PACKET_LEN];
-
-      mavlink_msg_command_long_pack(255, 0, &message, 1, 1,
-                                    MAV_CMD_SET_MESSAGE_INTERVAL, 0, messageId,
-                                    intervalUs, 0, 0, 0, 0, NULL);
-      
-      int requestMessageLenght =
-          mavlink_msg_to_send_buffer(intervalRequestData, &message);
-
-      DWORD bytesWritten;
-      if (!WriteFile(m_comSerial, intervalRequestData, requestMessageLenght,
-                     &bytesWritten, NULL)) {
-        ConnectionEvent connEvent(false, "TelemetryReceiver",
-                                  "Couldnt request data interval: " +
-                                      GetLastError());
-        AppTerminationEvent terminationEvent(true);
-        m_publisher->publish(EventType::CONNECTION_UPDATE, connEvent);
-        m_publisher->publish(EventType::APP_TERMINATION, terminationEvent);
-      }
-
-      // Wait for acknowledgement
-      while (true) {
-        DWORD dwBytesReadAcknowledgeRqst = 0;
-        uint8_t acknowledgeData;
-
-        if (ReadFile(m_comSerial, &acknowledgeData, 1,
-                     &dwBytesReadAcknowledgeRqst, NULL) &&
-            dwBytesReadAcknowledgeRqst == 1) {
-          if (mavlink_parse_char(MAVLINK_COMM_1, acknowledgeData, &message,
-                                 &status) == 1) {
-            if (message.msgid == MAVLINK_MSG_ID_COMMAND_ACK) {
-              mavlink_msg_command_ack_decode(&message, &command_ack);
-              if (command_ack.command == MAV_CMD_SET_MESSAGE_INTERVAL &&
-                  command_ack.result == MAV_RESULT_ACCEPTED) {
-
-                ConnectionEvent connEvent(
-                    true, "TelemetryReceiver",
-                    "Received mavlink request ack from UAV");
-                m_publisher->publish(EventType::CONNECTION_UPDATE, connEvent);
-
-                break;
-              } else {
-
-                ConnectionEvent connEvent(false, "TelemetryReceiver",
-                                          "Didnt receive mavlink request ack from UAV");
-                AppTerminationEvent terminationEvent(true);
-                m_publisher->publish(EventType::CONNECTION_UPDATE, connEvent);
-                m_publisher->publish(EventType::APP_TERMINATION,
-                                     terminationEvent);
-
-                break;
-              }
-            }
-          }
-        } else {
-          ConnectionEvent connEvent(false, "TelemetryReceiver",
-                                    "Serial connection error");
-          AppTerminationEvent terminationEvent(true);
-          m_publisher->publish(EventType::CONNECTION_UPDATE, connEvent);
-          m_publisher->publish(EventType::APP_TERMINATION, terminationEvent);
-        }
-      }
-    }; // End of lambda function
-
-    /****************************************************
-    * Request attitude, GPS, and heartbeat
-    * data interval frequency
-    * IMPORTANT: frequency for both attitude and GPS 
-    * must be the same, otherwise if attitude has it
-    * higher than GPS, then GPS is not being received.
-    * Asio boost serial connection reader would be nice.
-    * Read asynchornously both values- TODO.
-    ****************************************************/
-    requestDataStream(MAVLINK_MSG_ID_ATTITUDE,            10000);   // 10 Hz
-    requestDataStream(MAVLINK_MSG_ID_GLOBAL_POSITION_INT, 10000);   // 10 Hz 
-    requestDataStream(MAVLINK_MSG_ID_HEARTBEAT,           1000000); // 1 Hz
-    
-    /****************************************************
-    * Main loop for receiving telemetry
-    ****************************************************/
-	while (m_running.load()) { 
-        DWORD dwBytesRead = 0;
-        uint8_t raw_data;
-
-        // Telemetry data
-        // Angular
-        float roll{0.0};
-        float pitch{0.0};
-        float yaw{0.0};
-        
-        // GPS
-        float lat{0.0};
-        float lon{0.0};
-        float alt{0.0};
-        
-        // Read data
-        if (ReadFile(m_comSerial, &raw_data, 1, &dwBytesRead, NULL) &&
-            dwBytesRead == 1) {
-          if (mavlink_parse_char(MAVLINK_COMM_1, raw_data, &message, &status) ==
-              1) {
-            switch (message.msgid) {
-                case MAVLINK_MSG_ID_ATTITUDE: {
-                  mavlink_attitude_t attitude;
-                  mavlink_msg_attitude_decode(&message, &attitude);
-                  roll  = attitude.roll;
-                  pitch = attitude.pitch;
-                  yaw   = attitude.yaw;
-                } break;
-                
-                case MAVLINK_MSG_ID_GLOBAL_POSITION_INT: {
-                  mavlink_global_position_int_t gps;
-                  
-                  mavlink_msg_global_position_int_decode(&message, &gps);
-                  lat = gps.lat / 1E7f; // Latitude in degrees * 1E7
-                  lon = gps.lon / 1E7f; // Longitude in degrees * 1E7
-                  alt = gps.alt / 1E7f; // Altitude in millimeters (above MSL)
-                } break;
-                
-                case MAVLINK_MSG_ID_HEARTBEAT: {
-                  mavlink_heartbeat_t heartbeat;
-                  mavlink_msg_heartbeat_decode(&message, &heartbeat);
-                  switch (heartbeat.system_status) {
-                      case MAV_STATE_ACTIVE: {
-                        if (m_verbose) {
-                          ConnectionEvent connEvent(true, "TelemetryReceiver",
-                                                    "Mavlink ON");
-                          m_publisher->publish(EventType::CONNECTION_UPDATE,
-                                               connEvent);
-                        }
-                      } break;
-
-                      case MAV_STATE_EMERGENCY: {
-                        ConnectionEvent connEvent(false, "TelemetryReceiver",
-                                                  "Mavlink Heartbeat EMERGENCY");
-                        m_publisher->publish(EventType::CONNECTION_UPDATE,
-                                             connEvent);
-                      } break;
-
-                      case MAV_STATE_CRITICAL: {
-                        ConnectionEvent connEvent(false, "TelemetryReceiver",
-                                                  "Mavlink Heartbeat CRITICAL");
-                        m_publisher->publish(EventType::CONNECTION_UPDATE,
-                                             connEvent);
-                      } break;
-                       
-                      default: {
-                        if (m_verbose) {
-                          ConnectionEvent connEvent(
-                              true, "TelemetryReceiver",
-                              "Mavlink Heartbeat UNDEFINED");
-                          m_publisher->publish(EventType::CONNECTION_UPDATE,
-                                               connEvent);
-                        }
-                      }
-                  }
-                } break;
-
-                default: {
-                  ConnectionEvent connEvent(
-                      true, "TelemetryReceiver",
-                      "No telemetry data from UAV");
-                  m_publisher->publish(EventType::CONNECTION_UPDATE, connEvent);
-                }
-            }
-
-            // After collecting mavlink telemetry aggregate them into vector
-            // TODO: synchronize angular position with GPS. Right now
-            // m_currTelemetry has either angular position and (0,0,0) for GPS or otherwise.
-            m_currTelemetry = {roll, pitch, yaw, lat, lon, alt};
-            registerTelemetryEvent_();
-          } 
-
-        } else {
-          ConnectionEvent connEvent(false, "TelemetryReceiver",
-                                    "Serial connection error");
-          m_publisher->publish(EventType::CONNECTION_UPDATE, connEvent);
-        }
-	}
-}
-
-void TelemetryReceiver::stop_() { 
-	if (m_verbose) {
-        std::cout << "TelemetryReceiver: terminating\n";
-    }
-	m_running.store(false);
-    CloseHandle(m_comSerial);
-}
-
-void TelemetryReceiver::registerTelemetryEvent_() { 
-	TelemetryEvent telemetry(m_currTelemetry);
-	m_publisher->publish(EventType::TELEMETRY_UPDATE, telemetry); 
-}
+/**
+ * @file TelemetryReceiver.cpp
+ * @brief Code of the concrete implementation of ITelemetryReceiver interface.
+ *
+ * @details This file contains the declaration of the concrete telemetry receiver, which
+ *          utilizes:
+ *          - serial port connection for receiving telemetry data (SerialPort)
+ *          - mavlink protocol for receiving telemetry data
+ *
+ * @author Szymon Bogus
+ * @date 2024-05-22
+ *
+ * @copyright Copyright 2024 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ *
+ * @note Emergency shutdown from TelemetryReceiver::receive_ result in deadlock in DronePositioningWinAppBacked.cpp.
+ *       This might not be directly related to some bad code in the method here. However, another issue is the fact that,
+ *       from the level of constructor of TelemetryReceiver it cannot use
+ *       EventsBus to signal some ConnectionEvent- deadlock as subscription map is empty and there's nothing to lock on. 
+ *       This is due to the fact that instantiaion of TelemetryReceiver happend before anything can subscribe to EventsBus- 
+ *       - I'm talking about ConnectionManager. Switching the order in the MainController.cpp should help resolve that issue.
+ *       However ConnectionManager requires TelemetryReceiver as its constructor argument. Apparently TelemetryReceiver should be 
+ *       passed to ConnectionManager::connect, instead of the constructor and some sort of reference to it shoudl be created inside
+ *       ConnectionManager so later on it can also call ConnectionManager::disconnect and ask TelemetryReceiver::stop.
+ */
+
+#include "../include/TelemetryReceiver.h"
+
+
+const std::array<StreamConfig, 7> TelemetryReceiver::STREAMS{{
+    {MAVLINK_MSG_ID_ATTITUDE,            StreamPriority::POSE,         frameBytes_(MAVLINK_MSG_ID_ATTITUDE_LEN),            10.0f, 50.0f},
+    {MAVLINK_MSG_ID_LOCAL_POSITION_NED,  StreamPriority::POSE,         frameBytes_(MAVLINK_MSG_ID_LOCAL_POSITION_NED_LEN),  10.0f, 50.0f},
+    {MAVLINK_MSG_ID_GLOBAL_POSITION_INT, StreamPriority::POSE,         frameBytes_(MAVLINK_MSG_ID_GLOBAL_POSITION_INT_LEN), 2.0f,  10.0f},
+    {MAVLINK_MSG_ID_HIGHRES_IMU,         StreamPriority::HOUSEKEEPING, frameBytes_(MAVLINK_MSG_ID_HIGHRES_IMU_LEN),         1.0f,  50.0f},
+    {MAVLINK_MSG_ID_VFR_HUD,             StreamPriority::HOUSEKEEPING, frameBytes_(MAVLINK_MSG_ID_VFR_HUD_LEN),             1.0f,  10.0f},
+    {MAVLINK_MSG_ID_HEARTBEAT,           StreamPriority::HOUSEKEEPING, frameBytes_(MAVLINK_MSG_ID_HEARTBEAT_LEN),           1.0f,  1.0f},
+    {MAVLINK_MSG_ID_SYSTEM_TIME,         StreamPriority::HOUSEKEEPING, frameBytes_(MAVLINK_MSG_ID_SYSTEM_TIME_LEN),         1.0f,  1.0f}
+}};
+
+TelemetryReceiver::TelemetryReceiver(EventsBus &bus,
+                                     const std::vector<std::string> &portsCom,
+                                     uint32_t baudRate, bool isVerbose) 
+    : m_verbose(isVerbose) { 
+
+  m_publisher = bus.getPublisher();
+  m_running.store(false);
+
+  if (portsCom.empty() || portsCom.size() > MAX_LINKS_NUM) {
+    throw std::runtime_error("Between 1 and " + std::to_string(MAX_LINKS_NUM) +
+                             " ports COM have to be specified");
+  }
+
+  m_linkMonitor = std::make_unique<LinkMonitor>(
+      m_publisher, "TelemetryReceiver", MAVLINK_MSG_ID_ATTITUDE, m_verbose);
+
+  // Initializing serial port connections, throws if any port doesn't work
+  uint32_t slowestBaudRate = 0;
+  for (std::size_t idx = 0; idx < portsCom.size(); ++idx) {
+    auto link = std::make_unique<SerialLink>();
+    link->port = std::make_unique<SerialPort>(portsCom[idx], baudRate, m_verbose);
+    link->linkId = m_linkMonitor->addLink();
+    link->channel = static_cast<mavlink_channel_t>(MAVLINK_COMM_1 + idx);
+    if (slowestBaudRate == 0 || link->port->getBaudRate() < slowestBaudRate) {
+      slowestBaudRate = link->port->getBaudRate();
+    }
+    m_links.push_back(std::move(link));
+  }
+
+  // The same rates are requested over every link,
+  // so they are fitted into what the slowest one can carry
+  m_rateController = std::make_unique<StreamRateController>(
+      slowestBaudRate, m_verbose);
+  for (const StreamConfig &stream : STREAMS) {
+    m_rateController->addStream(stream);
+  }
+
+  if (m_verbose) {
+    std::cout << "TelemetryReceiver: instanitated\n";
+  }
+}
+
+TelemetryReceiver::~TelemetryReceiver() { 
+  m_linkMonitor.reset(); // stops its ticking thread before the publisher is gone
+  m_publisher = nullptr; 
+}
+
+void TelemetryReceiver::receive_() {
+	// Launching Processor thread
+    m_running.store(true);
+	if (m_verbose) {
+      ConnectionEvent connEvent(true, "TelemetryReceiver",
+                                "Running receiver thread");
+      m_publisher->publish(EventType::CONNECTION_UPDATE, connEvent);
+	}
+
+    m_linkMonitor->start();
+
+    /****************************************************
+    * Request initial data interval of every stream. Rates
+    * are independent, since every message only updates
+    * the aggregated sample. Acknowledgements are handled
+    * by the parser, so requests don't block on them.
+    ****************************************************/
+    for (const std::size_t idx : m_rateController->allocate()) {
+      sendMessageInterval_(m_rateController->getStream(idx).messageId,
+                           m_rateController->getIntervalUs(idx));
+    }
+    m_lastRateUpdate = std::chrono::steady_clock::now();
+    m_lastReportTime = std::chrono::steady_clock::now();
+
+    // Parsing and publishing take the bus mutex and may stall,
+    // so reading runs on separate threads and is never delayed
+    for (auto &link : m_links) {
+      link->ioThread = std::jthread(&TelemetryReceiver::ioLoop_, this, std::ref(*link));
+    }
+
+    parseLoop_();
+
+    for (auto &link : m_links) {
+      link->ioThread.join();
+    }
+}
+
+void TelemetryReceiver::ioLoop_(SerialLink &link) {
+  uint8_t chunk[READ_CHUNK_SIZE];
+  auto lastStatusPoll = std::chrono::steady_clock::now();
+  while (m_running.load()) {
+    const int bytesRead = link.port->read(chunk, READ_CHUNK_SIZE);
+    if (bytesRead > 0) {
+      m_linkMonitor->onBytes(link.linkId, bytesRead);
+      link.ring.push(chunk, bytesRead); // bytes which don't fit are counted as overflow
+      m_dataSignal.fetch_add(1, std::memory_order_release);
+      m_dataSignal.notify_one();
+    } else if (bytesRead < 0) {
+      m_linkMonitor->onReadError(link.linkId);
+    } // 0 bytes- read timeout, nothing arrived
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - lastStatusPoll >= SERIAL_STATUS_POLL_PERIOD) {
+      lastStatusPoll = now;
+      pollSerialStatus_(link);
+    }
+  }
+}
+
+void TelemetryReceiver::parseLoop_() {
+  uint8_t chunk[READ_CHUNK_SIZE];
+
+  while (m_running.load()) {
+    // Read the signal before checking rings, so a push in between isn't missed
+    const uint32_t signal = m_dataSignal.load(std::memory_order_acquire);
+    bool isAnyData = false;
+    for (auto &link : m_links) {
+      const std::size_t bytesNum = link->ring.pop(chunk, READ_CHUNK_SIZE);
+      if (bytesNum == 0) {
+        continue;
+      }
+      isAnyData = true;
+      const std::int64_t arrivalNs =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now().time_since_epoch())
+              .count();
+      parseBytes_(*link, chunk, bytesNum, arrivalNs);
+    }
+
+    if (!isAnyData) {
+      m_dataSignal.wait(signal, std::memory_order_acquire);
+      continue;
+    }
+
+    if (m_verbose) {
+      reportCpuUsage_();
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (now - m_lastRateUpdate >= RATE_UPDATE_PERIOD) {
+      updateStreamRates_();
+    }
+    if (now - m_lastTimesyncRequest >= ClockSync::REQUEST_PERIOD) {
+      m_lastTimesyncRequest = now;
+      sendTimesync_(false, 0);
+    }
+  }
+}
+
+void TelemetryReceiver::parseBytes_(SerialLink &link, const uint8_t *bytes,
+                                    std::size_t bytesNum,
+                                    std::int64_t arrivalNs) {
+  // Mavlink data structures
+  mavlink_message_t message;
+  mavlink_status_t status;
+
+  for (std::size_t idx = 0; idx < bytesNum; ++idx) {
+    const uint8_t isFrame =
+        mavlink_parse_char(link.channel, bytes[idx], &message, &status);
+    if (status.packet_rx_drop_count) {
+      m_linkMonitor->onParseErrors(link.linkId, status.packet_rx_drop_count);
+    }
+    if (isFrame != 1) {
+      continue;
+    }
+
+    // Loss, jitter and heartbeat watchdog are tracked per link, before deduplication
+    m_linkMonitor->onFrame(link.linkId, message);
+    if (message.msgid == MAVLINK_MSG_ID_HEARTBEAT) {
+      // Link state changes (including CRITICAL/EMERGENCY heartbeats)
+      // are announced by LinkMonitor, not per message
+      mavlink_heartbeat_t heartbeat;
+      mavlink_msg_heartbeat_decode(&message, &heartbeat);
+      m_linkMonitor->onHeartbeat(link.linkId, heartbeat.system_status);
+    }
+
+    if (m_links.size() > 1) {
+      // Copies arrive within a few ms of each other, so parse time is
+      // a good enough proxy of arrival time for comparing links
+      const FrameDeduplicator::Result result =
+          m_deduplicator.onFrame(message, link.linkId, arrivalNs);
+      m_linkMonitor->onRelativeLatency(link.linkId, result.lagNs / 1E6f);
+      if (!result.isFirst) {
+        continue;
+      }
+    }
+
+    if (handleMessage_(message, arrivalNs)) {
+      registerTelemetryEvent_();
+    }
+  }
+}
+
+void TelemetryReceiver::pollSerialStatus_(SerialLink &link) {
+  DWORD inQueueBytes = 0;
+  bool isOverrun = false;
+  if (!link.port->getInputStatus(inQueueBytes, isOverrun)) {
+    return;
+  }
+  if (inQueueBytes > link.maxDriverQueueBytes.load(std::memory_order_relaxed)) {
+    link.maxDriverQueueBytes.store(inQueueBytes, std::memory_order_relaxed);
+  }
+  if (isOverrun) {
+    link.driverOverrunsNum.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+bool TelemetryReceiver::handleMessage_(const mavlink_message_t &message,
+                                       std::int64_t arrivalNs) {
+  m_decodedMsgsNum++;
+  const TelemetryDecoder::Result result = m_decoder.decode(message, arrivalNs);
+  switch (result.action) {
+    case TelemetryDecoder::Action::PUBLISH: {
+      return true;
+    }
+
+    case TelemetryDecoder::Action::REPLY_TIMESYNC: {
+      sendTimesync_(true, result.timesyncTs1);
+      return false;
+    }
+
+    case TelemetryDecoder::Action::INTERVAL_ACK: {
+      if (result.ackResult != MAV_RESULT_ACCEPTED) {
+        ConnectionEvent connEvent(false, "TelemetryReceiver",
+                                  "UAV rejected mavlink interval request, result: " +
+                                      std::to_string(result.ackResult));
+        m_publisher->publish(EventType::CONNECTION_UPDATE, connEvent);
+      } else if (m_verbose) {
+        ConnectionEvent connEvent(true, "TelemetryReceiver",
+                                  "Received mavlink request ack from UAV");
+        m_publisher->publish(EventType::CONNECTION_UPDATE, connEvent);
+      }
+      return false;
+    }
+
+    default: {
+      return false;
+    }
+  }
+}
+
+void TelemetryReceiver::sendMessageInterval_(uint16_t messageId,
+                                             uint32_t intervalUs) {
+  mavlink_message_t request;
+  mavlink_msg_command_long_pack(255, 0, &request, 1, 1,
+                                MAV_CMD_SET_MESSAGE_INTERVAL, 0, messageId,
+                                intervalUs, 0, 0, 0, 0, NULL);
+
+  // A failing radio is reported, the receiver gives up only if no link works
+  const std::size_t writtenNum = sendToLinks_(request);
+  if (writtenNum < m_links.size()) {
+    ConnectionEvent connEvent(false, "TelemetryReceiver",
+                              "Couldnt request data interval on " +
+                                  std::to_string(m_links.size() - writtenNum) +
+                                  " link(s): " + std::to_string(GetLastError()));
+    m_publisher->publish(EventType::CONNECTION_UPDATE, connEvent);
+  }
+  if (writtenNum == 0) {
+    AppTerminationEvent terminationEvent(true);
+    m_publisher->publish(EventType::APP_TERMINATION, terminationEvent);
+  }
+}
+
+std::size_t TelemetryReceiver::sendToLinks_(const mavlink_message_t &message) {
+  uint8_t data[MAVLINK_MAX_PACKET_LEN];
+  const int messageLenght = mavlink_msg_to_send_buffer(data, &message);
+
+  std::size_t writtenNum = 0;
+  for (auto &link : m_links) {
+    if (link->port->write(data, messageLenght)) {
+      writtenNum++;
+    }
+  }
+  return writtenNum;
+}
+
+void TelemetryReceiver::sendTimesync_(bool isReply, std::int64_t ts1) {
+  // Stamped right before the write of every link, which doesn't wait for the pending read,
+  // so the time carried is the time the frame is handed to the driver
+  uint8_t data[MAVLINK_MAX_PACKET_LEN];
+  for (auto &link : m_links) {
+    mavlink_message_t timesync;
+    const std::int64_t nowNs = ClockSync::nowNs();
+    mavlink_msg_timesync_pack(255, 0, &timesync, isReply ? nowNs : 0, isReply ? ts1 : nowNs, 1, 1);
+    const int messageLenght = mavlink_msg_to_send_buffer(data, &timesync);
+    link->port->write(data, messageLenght);
+  }
+}
+
+void TelemetryReceiver::updateStreamRates_() {
+  // Called by the parse stage. The port is overlapped, so writes don't wait
+  // for the pending read of the I/O stage
+  m_lastRateUpdate = std::chrono::steady_clock::now();
+
+  // Rates must fit the worst radio which still works, a lost one tells nothing
+  LinkQuality quality = m_linkMonitor->getQuality(m_links.front()->linkId);
+  for (const auto &link : m_links) {
+    const LinkQuality linkQuality = m_linkMonitor->getQuality(link->linkId);
+    if (linkQuality.state == LinkState::LOST) {
+      continue;
+    }
+    if (quality.state == LinkState::LOST || linkQuality.lossRate > quality.lossRate) {
+      quality = linkQuality;
+    }
+  }
+  for (const std::size_t idx : m_rateController->update(quality)) {
+    sendMessageInterval_(m_rateController->getStream(idx).messageId,
+                         m_rateController->getIntervalUs(idx));
+  }
+}
+
+void TelemetryReceiver::reportCpuUsage_() {
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_lastReportTime < std::chrono::seconds(5)) {
+    return;
+  }
+
+  FILETIME creationTime, exitTime, kernelTime, userTime;
+  if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime,
+                      &userTime)) {
+    return;
+  }
+  auto toUint64 = [](const FILETIME &ft) {
+    return (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+  };
+  const uint64_t cpuTime = toUint64(kernelTime) + toUint64(userTime);
+
+  const uint64_t msgsNum = m_decodedMsgsNum - m_lastReportMsgsNum;
+  const double elapsedS = std::chrono::duration<double>(now - m_lastReportTime).count();
+  if (msgsNum > 0) {
+    // Whole parsing thread is accounted: popping, parsing, decoding and publishing
+    const double cpuUsPerMsg = (cpuTime - m_lastReportCpuTime) / 10.0 / msgsNum;
+    std::cout << "TelemetryReceiver: " << msgsNum / elapsedS << " msgs/s, "
+              << cpuUsPerMsg << " us CPU/msg, "
+              << cpuUsPerMsg * 1000.0 / 1E6 * 100.0
+              << " % of a core per 1000 msgs/s\n";
+  }
+  for (const auto &link : m_links) {
+    std::cout << "TelemetryReceiver: " << link->port->getPortCom()
+              << " I/O stage max driver queue "
+              << link->maxDriverQueueBytes.load(std::memory_order_relaxed) << " B, "
+              << link->driverOverrunsNum.load(std::memory_order_relaxed)
+              << " overrun(s); parse stage ring depth " << link->ring.size()
+              << " B (max " << link->ring.getMaxDepth() << " of "
+              << link->ring.capacity() << "), "
+              << link->ring.getOverflowNum() << " B overflow";
+    if (m_links.size() > 1) {
+      std::cout << "; first copy of " << m_deduplicator.getFirstNum(link->linkId)
+                << " frames";
+    }
+    std::cout << "\n";
+  }
+  if (m_links.size() > 1) {
+    std::cout << "TelemetryReceiver: " << m_deduplicator.getDuplicatesNum()
+              << " duplicate frames dropped\n";
+  }
+  const ClockSync &clockSync = m_decoder.getClockSync();
+  if (clockSync.isSynced()) {
+    std::cout << "TelemetryReceiver: clock offset "
+              << clockSync.getOffsetNs() / 1E6 << " ms, drift "
+              << clockSync.getDriftPpm() << " ppm, "
+              << (clockSync.isPrecise()
+                      ? "TIMESYNC RTT " + std::to_string(clockSync.getRttNs() / 1E6) + " ms"
+                      : std::string("SYSTEM_TIME only"))
+              << "\n";
+  }
+
+  m_lastReportTime = now;
+  m_lastReportMsgsNum = m_decodedMsgsNum;
+  m_lastReportCpuTime = cpuTime;
+}
+
+void TelemetryReceiver::stop_() { 
+	if (m_verbose) {
+        std::cout << "TelemetryReceiver: terminating\n";
+    }
+	m_running.store(false);
+    m_dataSignal.fetch_add(1, std::memory_order_release);
+    m_dataSignal.notify_one();
+    m_linkMonitor->stop();
+    for (auto &link : m_links) {
+      link->port->close();
+    }
+}
+
+void TelemetryReceiver::registerTelemetryEvent_() { 
+	TelemetrySample &sample = m_decoder.getSample();
+	TelemetryEvent telemetry(sample);
+	m_publisher->publish(EventType::TELEMETRY_UPDATE, telemetry); 
+    sample.updatedFields = 0;
+}
@@ -1,82 +1,563 @@
-/**
- * @file TelemetrySender.cpp
- * @brief Code of the concrete implementation of ITelemetrySender interface.
- *
- * @details This file contains the declaration of the concrete telemetry sender, that uses UDP protocol 
- *          to send telemetry data to some remote endpoint. It uses WinSock library.
- *
- * @author Szymon Bogus
- * @date 2024-05-22
- *
- * @copyright Copyright 2024 Szymon Bogus
- * @license Apache License, Version 2.0 (see
- * https://www.apache.org/licenses/LICENSE-2.0)
- *
- * @version 1.0
- *
- * @note The issue of TelemetrySender not being able to post information from
- *       its constructor via EventsBus is the same as described in TelemetryReceiver.cpp.
- */
-
-#include "../include/TelemetrySender.h"
-
-
-TelemetrySender::TelemetrySender(EventsBus &bus, const std::string &ip,
-                                 const std::string &port,
-                                 bool isVerbose)
-    : m_verbose(isVerbose), m_ip(ip.c_str()), m_port(std::stoi(port)) {
-
-  m_publisher = bus.getPublisher();
-
-  m_winSockVersion = MAKEWORD(2, 2);
-
-  // Starting WinSock
-  int wsOk = WSAStartup(m_winSockVersion, &m_winSockdata);
-  if (wsOk != 0) {
-    std::cout << "Couldnt start WinSock: " << wsOk << "\n";
-    return;
-  }
-
-  // Connecting to the remote target
-  m_remoteTarget.sin_family = AF_INET;              // IPv4 address
-  inet_pton(AF_INET, m_ip, &m_remoteTarget.sin_addr);
-  m_remoteTarget.sin_port = htons(m_port); 
-  
-  // Socket creation
-  if ((m_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)) == INVALID_SOCKET) {
-    std::cout << "Failed to create socket: " << WSAGetLastError() << "\n";
-    return;
-  }
-
-  if (m_verbose) {
-    std::cout << "TelemetrySender: instantiated"
-              << "\n";
-  }
-}
-
-TelemetrySender::~TelemetrySender() {
-  closesocket(m_socket);
-  WSACleanup();
-  m_publisher = nullptr;
-}
-
-void TelemetrySender::onEvent_(const TelemetryEvent &event) {
-  sendPosition(event.telemetry);
-}
-
-void TelemetrySender::sendPosition_(const std::vector<float> &telemetry) {
-  // Message preparation
-  std::string message;
-  for (const float &value : telemetry) {
-    message += std::to_string(value) + " ";
-  }
-  
-  int sendOK = sendto(m_socket, message.c_str(), message.size() + 1, 0,
-                      (sockaddr *)&m_remoteTarget, sizeof(m_remoteTarget));
-
-  // TODO: send to the bus error message
-  if (sendOK == SOCKET_ERROR) {
-    std::cout << "Couldnt send package: " << WSAGetLastError() << "\n";
-  }
-
-}
+/**
+ * @file TelemetrySender.cpp
+ * @brief Code of the concrete implementation of ITelemetrySender interface.
+ *
+ * @details This file contains the declaration of the concrete telemetry sender, that uses UDP protocol 
+ *          to send telemetry data to some remote endpoint. It uses WinSock library.
+ *
+ * @author Szymon Bogus
+ * @date 2024-05-22
+ *
+ * @copyright Copyright 2024 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ *
+ * @note The issue of TelemetrySender not being able to post information from
+ *       its constructor via EventsBus is the same as described in TelemetryReceiver.cpp.
+ */
+
+#include <cstring>
+
+#include "../include/TelemetrySender.h"
+#include "../include/TelemetryPacket.h"
+#include "../include/ClockSync.h"
+
+
+TelemetrySender::TelemetrySender(
+    EventsBus &bus,
+    const std::vector<ConnectionConfigurationInfo::Endpoint> &endpoints,
+    WireFormat wireFormat, std::uint32_t coalescingWindowUs,
+    std::uint32_t outputRateHz, std::uint32_t predictionHorizonMs, bool isVerbose,
+    const std::optional<OperatorPosition> &localFrameOrigin)
+    : m_verbose(isVerbose), m_wireFormat(wireFormat),
+      m_outputPeriod(outputRateHz > 0 ? std::chrono::nanoseconds(
+                                            1'000'000'000 / outputRateHz)
+                                      : std::chrono::nanoseconds(0)),
+      m_coalescingWindow(std::chrono::microseconds(coalescingWindowUs)) {
+
+  m_publisher = bus.getPublisher();
+
+  if (localFrameOrigin) {
+    m_localFrame.emplace(*localFrameOrigin);
+  }
+  if (predictionHorizonMs > 0) {
+    if (m_outputPeriod.count() > 0) {
+      m_extrapolator.emplace(std::chrono::milliseconds(predictionHorizonMs));
+    } else {
+      std::cout << "TelemetrySender: prediction needs an output rate, sending samples as received\n";
+    }
+  }
+
+#ifndef _WIN32
+  try {
+    m_fanoutSocket = std::make_unique<UdpSocket>();
+  } catch (const std::runtime_error &socketErr) {
+    std::cout << "TelemetrySender: " << socketErr.what()
+              << ", sending to every endpoint separately\n";
+  }
+#endif
+
+  for (const auto &endpoint : endpoints) {
+    if (!addEndpoint(endpoint.ip, endpoint.port)) {
+      std::cout << "TelemetrySender: skipping endpoint " << endpoint.ip << ":"
+                << endpoint.port << "\n";
+    }
+  }
+
+  if (m_coalescingWindow.count() > 0) {
+    m_flushThread = std::jthread(
+        [this](std::stop_token stopToken) { flushLoop_(stopToken); });
+  }
+  if (m_outputPeriod.count() > 0) {
+    m_paceThread = std::jthread(
+        [this](std::stop_token stopToken) { paceLoop_(stopToken); });
+  }
+
+  if (m_verbose) {
+    std::cout << "TelemetrySender: instantiated"
+              << "\n";
+  }
+}
+
+TelemetrySender::~TelemetrySender() {
+  if (m_sceneThread.joinable()) {
+    m_sceneThread.request_stop();
+    m_sceneThread.join();
+  }
+  // Pacing feeds the batch, so it stops first
+  if (m_paceThread.joinable()) {
+    m_paceThread.request_stop();
+    m_paceThread.join();
+  }
+  if (m_flushThread.joinable()) {
+    m_flushThread.request_stop(); // sends the pending batch
+    m_flushThread.join();
+  }
+  if (m_verbose) {
+    std::cout << "TelemetrySender: " << getSamplesNum() << " samples in "
+              << getDatagramsNum() << " datagrams (" << getSendCallsNum()
+              << " send calls), hold time mean "
+              << getMeanHoldTime().count() / 1000 << " us, max "
+              << getMaxHoldTime().count() / 1000 << " us, "
+              << getSupersededNum() << " superseded by newer samples\n";
+  }
+  std::unique_lock<std::shared_mutex> lock(m_endpointsMtx);
+  for (auto &endpoint : m_endpoints) {
+    endpoint.reset();
+  }
+  m_publisher = nullptr;
+}
+
+void TelemetrySender::onEvent_(const TelemetryEvent &event) {
+  sendPosition(event.telemetry);
+}
+
+void TelemetrySender::onEvent_(const ProgressEvent &event) {
+  std::array<std::uint8_t, wire::PROGRESS_PACKET_SIZE> packet;
+  const std::size_t size = wire::serializeProgress(event.progress, packet.data());
+  sendDatagram_(reinterpret_cast<const char *>(packet.data()), size);
+}
+
+void TelemetrySender::sendPosition_(const TelemetrySample &telemetry) {
+  if (m_outputPeriod.count() > 0) {
+    m_mailbox.put(telemetry.systemId, telemetry); // converted and sent by paceLoop_
+  } else if (m_localFrame) {
+    TelemetrySample localTelemetry = telemetry;
+    m_localFrame->transform(localTelemetry);
+    sendSample_(localTelemetry);
+  } else {
+    sendSample_(telemetry);
+  }
+}
+
+void TelemetrySender::paceLoop_(std::stop_token stopToken) {
+  auto nextTick = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> lock(m_paceMtx);
+  while (!stopToken.stop_requested()) {
+    std::size_t takenNum = 0;
+    if (m_extrapolator) {
+      // New samples only refresh the extrapolation, every vehicle gets a pose per tick
+      for (std::size_t vehicleId = 0; vehicleId < m_mailbox.size(); ++vehicleId) {
+        if (m_mailbox.take(vehicleId, m_paceBatch[0])) {
+          m_extrapolator->update(m_paceBatch[0]);
+        }
+      }
+      takenNum = m_extrapolator->predictAll(ClockSync::nowNs(), m_paceBatch.data());
+    } else {
+      for (std::size_t vehicleId = 0; vehicleId < m_mailbox.size(); ++vehicleId) {
+        if (m_mailbox.take(vehicleId, m_paceBatch[takenNum])) {
+          takenNum++;
+        }
+      }
+    }
+    if (m_localFrame) {
+      m_localFrame->transform(m_paceBatch.data(), takenNum);
+    }
+    for (std::size_t idx = 0; idx < takenNum; ++idx) {
+      sendSample_(m_paceBatch[idx]);
+    }
+
+    nextTick += m_outputPeriod;
+    const auto now = std::chrono::steady_clock::now();
+    if (nextTick < now) {
+      nextTick = now; // fell behind, skip the missed ticks instead of catching up in a burst
+    }
+    m_paceCv.wait_until(lock, stopToken, nextTick, []() { return false; });
+  }
+}
+
+void TelemetrySender::sendSample_(const TelemetrySample &telemetry) {
+  // Message preparation on the stack, no allocation per packet
+  static_assert(wire::MAX_TEXT_PACKET_SIZE >= wire::BINARY_PACKET_SIZE);
+  static_assert(wire::MAX_TEXT_PACKET_SIZE >= wire::MAX_DELTA_PACKET_SIZE);
+  alignas(8) char message[wire::MAX_TEXT_PACKET_SIZE];
+  std::size_t messageSize = 0;
+  switch (m_wireFormat) {
+  case WireFormat::BINARY:
+    messageSize = wire::serializeBinary(
+        telemetry, m_sequence.fetch_add(1, std::memory_order_relaxed), ClockSync::nowNs(),
+        reinterpret_cast<std::uint8_t *>(message));
+    break;
+  case WireFormat::DELTA: {
+    std::lock_guard<std::mutex> lock(m_deltaEncoderMtx);
+    messageSize = m_deltaEncoder.encode(
+        telemetry, m_sequence.fetch_add(1, std::memory_order_relaxed), ClockSync::nowNs(),
+        reinterpret_cast<std::uint8_t *>(message));
+    break;
+  }
+  case WireFormat::TEXT:
+    // Legacy: roll pitch yaw lat lon alt
+    messageSize = wire::serializeText(telemetry, message);
+    break;
+  }
+
+  m_samplesNum.fetch_add(1, std::memory_order_relaxed);
+
+  if (m_coalescingWindow.count() > 0) {
+    enqueue_(message, messageSize);
+  } else {
+    sendDatagram_(message, messageSize);
+  }
+}
+
+void TelemetrySender::enqueue_(const char *packet, std::size_t size) {
+  std::lock_guard<std::mutex> lock(m_batchMtx);
+  if (m_batchSize + size > MAX_DATAGRAM_SIZE) {
+    flushBatch_();
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  if (m_batchSize == 0) {
+    m_batchStart = now;
+    m_batchCv.notify_one(); // arm the window
+  }
+  std::memcpy(m_batch.data() + m_batchSize, packet, size);
+  m_batchSize += size;
+  m_batchSamplesNum++;
+  m_batchHoldSumNs += now.time_since_epoch().count();
+
+  // Packets of a stream have the same size, so a batch without room for
+  // another one is sent right away instead of waiting for the window
+  if (m_batchSize + size > MAX_DATAGRAM_SIZE) {
+    flushBatch_();
+  }
+}
+
+void TelemetrySender::flushBatch_() {
+  if (m_batchSize == 0) {
+    return;
+  }
+  sendDatagram_(m_batch.data(), m_batchSize);
+
+  const std::int64_t nowNs =
+      std::chrono::steady_clock::now().time_since_epoch().count();
+  const std::int64_t maxHoldNs = nowNs - m_batchStart.time_since_epoch().count();
+  m_holdSumNs.fetch_add(static_cast<std::int64_t>(m_batchSamplesNum) * nowNs -
+                            m_batchHoldSumNs,
+                        std::memory_order_relaxed);
+  if (maxHoldNs > m_maxHoldNs.load(std::memory_order_relaxed)) {
+    m_maxHoldNs.store(maxHoldNs, std::memory_order_relaxed); // only updated under m_batchMtx
+  }
+
+  m_batchSize = 0;
+  m_batchSamplesNum = 0;
+  m_batchHoldSumNs = 0;
+  m_batchGeneration++;
+}
+
+void TelemetrySender::flushLoop_(std::stop_token stopToken) {
+  std::unique_lock<std::mutex> lock(m_batchMtx);
+  while (!stopToken.stop_requested()) {
+    if (!m_batchCv.wait(lock, stopToken, [this]() { return m_batchSize > 0; })) {
+      break;
+    }
+    const std::uint64_t generation = m_batchGeneration;
+    const bool isFlushed =
+        m_batchCv.wait_until(lock, stopToken, m_batchStart + m_coalescingWindow,
+                             [this, generation]() {
+                               return m_batchGeneration != generation;
+                             });
+    if (!isFlushed) {
+      flushBatch_(); // window elapsed
+    }
+  }
+  flushBatch_();
+}
+
+bool TelemetrySender::addEndpoint(const std::string &ip, int port) {
+  sockaddr_in address{};
+  if (!UdpSocket::toAddress(ip, port, address)) {
+    return false;
+  }
+
+  {
+    std::shared_lock<std::shared_mutex> lock(m_endpointsMtx);
+    if (m_endpointsNum == MAX_ENDPOINTS_NUM) {
+      return false;
+    }
+  }
+
+  // The socket is created before taking the exclusive lock, so sending isn't stalled
+  std::unique_ptr<Endpoint> endpoint;
+  try {
+    endpoint = std::make_unique<Endpoint>(ip, port);
+  } catch (const std::runtime_error &socketErr) {
+    std::cout << "TelemetrySender: " << socketErr.what() << "\n";
+    return false;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(m_endpointsMtx);
+  if (m_endpointsNum == MAX_ENDPOINTS_NUM) {
+    return false;
+  }
+  for (std::size_t idx = 0; idx < m_endpointsNum; ++idx) {
+    const sockaddr_in &added = m_endpoints[idx]->socket.getAddress();
+    if (added.sin_addr.s_addr == address.sin_addr.s_addr &&
+        added.sin_port == address.sin_port) {
+      return false;
+    }
+  }
+  m_endpoints[m_endpointsNum++] = std::move(endpoint);
+  return true;
+}
+
+bool TelemetrySender::removeEndpoint(const std::string &ip, int port) {
+  sockaddr_in address{};
+  if (!UdpSocket::toAddress(ip, port, address)) {
+    return false;
+  }
+
+  std::unique_ptr<Endpoint> removed; // closed after releasing the lock
+  std::unique_lock<std::shared_mutex> lock(m_endpointsMtx);
+  for (std::size_t idx = 0; idx < m_endpointsNum; ++idx) {
+    const sockaddr_in &added = m_endpoints[idx]->socket.getAddress();
+    if (added.sin_addr.s_addr == address.sin_addr.s_addr &&
+        added.sin_port == address.sin_port) {
+      removed = std::move(m_endpoints[idx]);
+      m_endpoints[idx] = std::move(m_endpoints[--m_endpointsNum]); // order doesn't matter
+      lock.unlock();
+      return true;
+    }
+  }
+  return false;
+}
+
+std::size_t TelemetrySender::getEndpointsNum() const {
+  std::shared_lock<std::shared_mutex> lock(m_endpointsMtx);
+  return m_endpointsNum;
+}
+
+void TelemetrySender::sendDatagram_(const char *data, std::size_t size) {
+  m_datagramsNum.fetch_add(1, std::memory_order_relaxed);
+
+  std::shared_lock<std::shared_mutex> lock(m_endpointsMtx);
+#ifndef _WIN32
+  // A single endpoint keeps its connected socket, which also reports its ICMP errors
+  if (m_fanoutSocket && m_endpointsNum > 1) {
+    std::array<const sockaddr_in *, MAX_ENDPOINTS_NUM> addresses;
+    std::array<int, MAX_ENDPOINTS_NUM> errorCodes;
+    for (std::size_t idx = 0; idx < m_endpointsNum; ++idx) {
+      addresses[idx] = &m_endpoints[idx]->socket.getAddress();
+    }
+    const std::size_t callsNum = m_fanoutSocket->sendToMany(
+        data, size, addresses.data(), m_endpointsNum, errorCodes.data());
+    m_sendCallsNum.fetch_add(callsNum, std::memory_order_relaxed);
+    for (std::size_t idx = 0; idx < m_endpointsNum; ++idx) {
+      onSendResult_(*m_endpoints[idx], errorCodes[idx]);
+    }
+    return;
+  }
+#endif
+  for (std::size_t idx = 0; idx < m_endpointsNum; ++idx) {
+    Endpoint &endpoint = *m_endpoints[idx];
+    onSendResult_(endpoint, endpoint.socket.send(data, size));
+    m_sendCallsNum.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void TelemetrySender::onSendResult_(Endpoint &endpoint, int errorCode) {
+  const std::int64_t nowNs = ClockSync::nowNs();
+  if (errorCode != 0) {
+    endpoint.lastErrorNs.store(nowNs, std::memory_order_relaxed);
+    if (!endpoint.isFailing.exchange(true)) {
+      ConnectionEvent connEvent(false, "TelemetrySender",
+                                "Couldnt send to " + endpoint.socket.getName() +
+                                    ": " + UdpSocket::describeError(errorCode));
+      m_publisher->publish(EventType::CONNECTION_UPDATE, connEvent);
+    }
+    return;
+  }
+
+  // Connected UDP reports a missing receiver only on some sends, so the endpoint
+  // recovers after a whole period without errors
+  if (endpoint.isFailing.load(std::memory_order_relaxed) &&
+      nowNs - endpoint.lastErrorNs.load(std::memory_order_relaxed) >
+          std::chrono::nanoseconds(ENDPOINT_RECOVERY_PERIOD).count() &&
+      endpoint.isFailing.exchange(false)) {
+    ConnectionEvent connEvent(true, "TelemetrySender",
+                              "Sending to " + endpoint.socket.getName() +
+                                  " recovered");
+    m_publisher->publish(EventType::CONNECTION_UPDATE, connEvent);
+  }
+}
+
+bool TelemetrySender::pushScene(const configuration::FlightConfig &flightConfig) {
+  std::vector<std::uint8_t> scene = wire::serializeScene(flightConfig);
+  const std::size_t chunksNum = wire::getSceneChunksNum(scene.size());
+  if (chunksNum > wire::MAX_SCENE_CHUNKS_NUM) {
+    return false;
+  }
+  const std::uint64_t hash = wire::fnv1a64(scene.data(), scene.size());
+
+  std::lock_guard<std::mutex> lock(m_sceneMtx);
+  m_scene = std::move(scene);
+  m_sceneHash = hash;
+  m_sceneChunksNum = chunksNum;
+  {
+    // The rest of the state is reset by the scene thread when it sees the new hash
+    std::shared_lock<std::shared_mutex> endpointsLock(m_endpointsMtx);
+    for (std::size_t idx = 0; idx < m_endpointsNum; ++idx) {
+      m_endpoints[idx]->isSceneAcked.store(false, std::memory_order_relaxed);
+    }
+  }
+  if (!m_sceneThread.joinable()) {
+    m_sceneThread = std::jthread(
+        [this](std::stop_token stopToken) { sceneLoop_(stopToken); });
+  }
+  if (m_verbose) {
+    std::cout << "TelemetrySender: pushing scene of " << m_scene.size()
+              << " bytes in " << m_sceneChunksNum << " chunks\n";
+  }
+  return true;
+}
+
+bool TelemetrySender::isSceneAcknowledged() const {
+  std::shared_lock<std::shared_mutex> lock(m_endpointsMtx);
+  for (std::size_t idx = 0; idx < m_endpointsNum; ++idx) {
+    const Endpoint &endpoint = *m_endpoints[idx];
+    if (!endpoint.socket.isMulticast() &&
+        !endpoint.isSceneAcked.load(std::memory_order_relaxed)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TelemetrySender::sceneLoop_(std::stop_token stopToken) {
+  std::unique_lock<std::mutex> lock(m_sceneMtx);
+  while (!stopToken.stop_requested()) {
+    const auto now = std::chrono::steady_clock::now();
+    {
+      std::shared_lock<std::shared_mutex> endpointsLock(m_endpointsMtx);
+      for (std::size_t idx = 0; idx < m_endpointsNum; ++idx) {
+        Endpoint &endpoint = *m_endpoints[idx];
+        if (endpoint.sceneHash != m_sceneHash) { // new scene or new endpoint
+          endpoint.sceneHash = m_sceneHash;
+          endpoint.sceneAcked.fill(0);
+          endpoint.sceneAttemptsNum = 0;
+          endpoint.nextSceneSend = now;
+          endpoint.isSceneAcked.store(false, std::memory_order_relaxed);
+        }
+        if (!endpoint.socket.isMulticast()) {
+          receiveSceneAcks_(endpoint, now);
+        }
+        if (!endpoint.isSceneAcked.load(std::memory_order_relaxed) &&
+            now >= endpoint.nextSceneSend) {
+          sendScene_(endpoint, now);
+        }
+      }
+    }
+    m_sceneCv.wait_for(lock, stopToken, SCENE_POLL_PERIOD, []() { return false; });
+  }
+}
+
+void TelemetrySender::receiveSceneAcks_(Endpoint &endpoint,
+                                        std::chrono::steady_clock::time_point now) {
+  alignas(8) std::uint8_t datagram[wire::SCENE_DATAGRAM_SIZE];
+  std::size_t size;
+  while ((size = endpoint.socket.receive(reinterpret_cast<char *>(datagram),
+                                         sizeof(datagram))) > 0) {
+    std::uint64_t hash;
+    std::size_t chunksNum;
+    const std::uint8_t *bitmap;
+    if (!wire::parseSceneAck(datagram, size, hash, chunksNum, bitmap)) {
+      continue;
+    }
+
+    if (hash != m_sceneHash || chunksNum != m_sceneChunksNum) {
+      // The headset has another scene, e.g. it restarted: transfer again unless in progress
+      if (endpoint.isSceneAcked.load(std::memory_order_relaxed) ||
+          endpoint.sceneAttemptsNum >= MAX_SCENE_ATTEMPTS_NUM) {
+        endpoint.sceneAcked.fill(0);
+        endpoint.sceneAttemptsNum = 0;
+        endpoint.nextSceneSend = now;
+        endpoint.isSceneAcked.store(false, std::memory_order_relaxed);
+      }
+      continue;
+    }
+
+    bool isComplete = true;
+    for (std::size_t idx = 0; idx < chunksNum; ++idx) {
+      const std::uint8_t bit = static_cast<std::uint8_t>(1u << (idx % 8));
+      endpoint.sceneAcked[idx / 8] |= bitmap[idx / 8] & bit;
+      isComplete = isComplete && (endpoint.sceneAcked[idx / 8] & bit) != 0;
+    }
+    if (isComplete) {
+      if (!endpoint.isSceneAcked.exchange(true) && m_verbose) {
+        std::cout << "TelemetrySender: scene acknowledged by "
+                  << endpoint.socket.getName() << " after "
+                  << endpoint.sceneAttemptsNum << " attempts\n";
+      }
+    } else if (endpoint.sceneAttemptsNum < MAX_SCENE_ATTEMPTS_NUM) {
+      endpoint.nextSceneSend = now; // answer with the missing chunks right away
+    }
+  }
+}
+
+void TelemetrySender::sendScene_(Endpoint &endpoint,
+                                 std::chrono::steady_clock::time_point now) {
+  const bool isMulticast = endpoint.socket.isMulticast();
+  if (!isMulticast && endpoint.sceneAttemptsNum >= MAX_SCENE_ATTEMPTS_NUM) {
+    std::cout << "TelemetrySender: scene not acknowledged by "
+              << endpoint.socket.getName() << "\n";
+    endpoint.nextSceneSend = std::chrono::steady_clock::time_point::max(); // until the headset asks
+    return;
+  }
+
+  alignas(8) std::uint8_t datagram[wire::SCENE_DATAGRAM_SIZE];
+  if (isMulticast || endpoint.sceneAttemptsNum > 0) {
+    for (std::size_t idx = 0; idx < m_sceneChunksNum; ++idx) {
+      if ((endpoint.sceneAcked[idx / 8] & (1u << (idx % 8))) != 0) {
+        continue;
+      }
+      const std::size_t size = wire::writeSceneChunk(m_scene, m_sceneHash, idx, datagram);
+      onSendResult_(endpoint, endpoint.socket.send(reinterpret_cast<const char *>(datagram), size));
+      m_sceneChunksSentNum.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  // Sent last, so the ack it requests covers the chunks above
+  const std::size_t size = wire::writeSceneAnnounce(m_scene, m_sceneHash, datagram);
+  onSendResult_(endpoint, endpoint.socket.send(reinterpret_cast<const char *>(datagram), size));
+
+  endpoint.sceneAttemptsNum++;
+  if (isMulticast) {
+    endpoint.nextSceneSend = now + SCENE_CAROUSEL_PERIOD;
+  } else {
+    endpoint.nextSceneSend = now + SCENE_RETRANSMIT_PERIOD;
+  }
+}
+
+std::uint64_t TelemetrySender::getSceneChunksSentNum() const {
+  return m_sceneChunksSentNum.load(std::memory_order_relaxed);
+}
+
+std::uint64_t TelemetrySender::getSamplesNum() const {
+  return m_samplesNum.load(std::memory_order_relaxed);
+}
+
+std::uint64_t TelemetrySender::getSupersededNum() const {
+  return m_mailbox.getOverwrittenNum();
+}
+
+std::uint64_t TelemetrySender::getDatagramsNum() const {
+  return m_datagramsNum.load(std::memory_order_relaxed);
+}
+
+std::uint64_t TelemetrySender::getSendCallsNum() const {
+  return m_sendCallsNum.load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds TelemetrySender::getMeanHoldTime() const {
+  const std::uint64_t samplesNum = getSamplesNum();
+  if (samplesNum == 0) {
+    return std::chrono::nanoseconds(0);
+  }
+  return std::chrono::nanoseconds(m_holdSumNs.load(std::memory_order_relaxed) /
+                                  static_cast<std::int64_t>(samplesNum));
+}
+
+std::chrono::nanoseconds TelemetrySender::getMaxHoldTime() const {
+  return std::chrono::nanoseconds(m_maxHoldNs.load(std::memory_order_relaxed));
+}
@@ -0,0 +1,74 @@
+/**
+ * @file TimerWheel.cpp
+ * @brief Code of the hashed timer wheel.
+ *
+ * @details This file contains the definition of the timer wheel used to drive
+ *          watchdogs and periodic jobs without a dedicated thread for each of them.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ *
+ * @note Timers must be registered before the wheel begins to tick, as callbacks are
+ *       executed outside of the lock and m_timers must not reallocate meanwhile.
+ */
+
+#include "../include/TimerWheel.h"
+
+
+TimerWheel::TimerId TimerWheel::addTimer(Callback callback) {
+  std::lock_guard<std::mutex> lock(m_wheelMtx);
+  m_timers.push_back(Timer{std::move(callback)});
+  return m_timers.size() - 1;
+}
+
+void TimerWheel::arm(const TimerId id, const std::uint64_t ticks) {
+  std::lock_guard<std::mutex> lock(m_wheelMtx);
+  Timer &timer = m_timers.at(id);
+  timer.generation++;
+  timer.isArmed = true;
+  timer.expiryTick = m_currentTick + (ticks == 0 ? 1 : ticks);
+  m_slots[timer.expiryTick % SLOTS_NUM].push_back({id, timer.generation});
+}
+
+void TimerWheel::cancel(const TimerId id) {
+  std::lock_guard<std::mutex> lock(m_wheelMtx);
+  Timer &timer = m_timers.at(id);
+  timer.generation++; // invalidates entry left in the slot
+  timer.isArmed = false;
+}
+
+void TimerWheel::tick() {
+  m_expired.clear();
+  {
+    std::lock_guard<std::mutex> lock(m_wheelMtx);
+    m_currentTick++;
+    std::vector<SlotEntry> &slot = m_slots[m_currentTick % SLOTS_NUM];
+    std::size_t i = 0;
+    while (i < slot.size()) {
+      const SlotEntry entry = slot[i];
+      Timer &timer = m_timers[entry.id];
+      const bool isStale = !timer.isArmed || timer.generation != entry.generation;
+      if (!isStale && timer.expiryTick > m_currentTick) {
+        ++i; // expires in one of the next rounds of the wheel
+        continue;
+      }
+      if (!isStale) {
+        timer.isArmed = false;
+        m_expired.push_back(entry.id);
+      }
+      // Order within a slot doesn't matter, swap with the last one and pop
+      slot[i] = slot.back();
+      slot.pop_back();
+    }
+  }
+
+  for (const TimerId id : m_expired) {
+    m_timers[id].callback();
+  }
+}
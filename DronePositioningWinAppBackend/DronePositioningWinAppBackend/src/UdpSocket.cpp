@@ -0,0 +1,190 @@
+/**
+ * @file UdpSocket.cpp
+ * @brief Code of the portable connected UDP socket.
+ *
+ * @details This file contains the definition of UdpSocket. Platform differences are limited
+ *          to socket library startup, closing the socket and reading the last error.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+#include "../include/UdpSocket.h"
+
+#ifndef _WIN32
+#define INVALID_SOCKET (-1)
+#define SOCKET_ERROR (-1)
+#endif
+
+
+UdpSocket::UdpSocket(const std::string &ip, int port)
+    : m_name(ip + ":" + std::to_string(port)) {
+
+  if (!toAddress(ip, port, m_address)) {
+    throw std::runtime_error("Invalid endpoint address: " + m_name);
+  }
+  open_(isMulticast());
+
+  // UDP connect only records the peer, nothing is sent
+  if (connect(m_socket, reinterpret_cast<const sockaddr *>(&m_address),
+              sizeof(m_address)) == SOCKET_ERROR) {
+    const int error = lastError_();
+    close_();
+    throw std::runtime_error("Couldnt connect socket to " + m_name + ": " +
+                             describeError(error));
+  }
+}
+
+UdpSocket::UdpSocket() : m_name("unconnected") { open_(true); }
+
+UdpSocket::~UdpSocket() { close_(); }
+
+int UdpSocket::send(const char *data, std::size_t size) {
+#ifdef _WIN32
+  const int sent = ::send(m_socket, data, static_cast<int>(size), 0);
+#else
+  const ssize_t sent = ::send(m_socket, data, size, 0);
+#endif
+  return sent == SOCKET_ERROR ? lastError_() : 0;
+}
+
+#ifndef _WIN32
+std::size_t UdpSocket::sendToMany(const char *data, std::size_t size,
+                                  const sockaddr_in *const *addresses,
+                                  std::size_t addressesNum, int *errorCodes) {
+  iovec payload{const_cast<char *>(data), size}; // shared by all messages
+  std::array<mmsghdr, MAX_FANOUT_NUM> messages;
+  std::size_t callsNum = 0;
+  std::size_t doneNum = 0;
+  while (doneNum < addressesNum) {
+    const std::size_t messagesNum = std::min(addressesNum - doneNum, MAX_FANOUT_NUM);
+    for (std::size_t idx = 0; idx < messagesNum; ++idx) {
+      messages[idx] = mmsghdr{};
+      messages[idx].msg_hdr.msg_name = const_cast<sockaddr_in *>(addresses[doneNum + idx]);
+      messages[idx].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+      messages[idx].msg_hdr.msg_iov = &payload;
+      messages[idx].msg_hdr.msg_iovlen = 1;
+    }
+    const int sentNum = sendmmsg(m_socket, messages.data(),
+                                 static_cast<unsigned int>(messagesNum), 0);
+    callsNum++;
+    if (sentNum == SOCKET_ERROR) {
+      // Only the first message failed, the rest go with the next call
+      errorCodes[doneNum++] = lastError_();
+      continue;
+    }
+    for (int idx = 0; idx < sentNum; ++idx) {
+      errorCodes[doneNum++] = 0;
+    }
+  }
+  return callsNum;
+}
+#endif
+
+std::size_t UdpSocket::receive(char *buffer, std::size_t size) {
+  // Zero timeout select keeps the socket blocking for send
+  fd_set readSet;
+  FD_ZERO(&readSet);
+  FD_SET(m_socket, &readSet);
+  timeval timeout{};
+  if (select(static_cast<int>(m_socket + 1), &readSet, nullptr, nullptr, &timeout) <= 0) {
+    return 0;
+  }
+#ifdef _WIN32
+  const int received = recv(m_socket, buffer, static_cast<int>(size), 0);
+#else
+  const ssize_t received = recv(m_socket, buffer, size, 0);
+#endif
+  // ICMP errors of the endpoint are reported by send as well
+  return received == SOCKET_ERROR ? 0 : static_cast<std::size_t>(received);
+}
+
+bool UdpSocket::isMulticast() const {
+  return IN_MULTICAST(ntohl(m_address.sin_addr.s_addr));
+}
+
+const sockaddr_in &UdpSocket::getAddress() const { return m_address; }
+
+const std::string &UdpSocket::getName() const { return m_name; }
+
+bool UdpSocket::toAddress(const std::string &ip, int port,
+                          sockaddr_in &address) {
+  if (port <= 0 || port > 65535) {
+    return false;
+  }
+  address = sockaddr_in{};
+  address.sin_family = AF_INET; // IPv4 address
+  address.sin_port = htons(static_cast<unsigned short>(port));
+  return inet_pton(AF_INET, ip.c_str(), &address.sin_addr) == 1;
+}
+
+std::string UdpSocket::describeError(int errorCode) {
+  // WinSock codes are system error codes, errno values are POSIX ones
+  return std::system_category().message(errorCode) + " (" +
+         std::to_string(errorCode) + ")";
+}
+
+int UdpSocket::lastError_() {
+#ifdef _WIN32
+  return WSAGetLastError();
+#else
+  return errno;
+#endif
+}
+
+void UdpSocket::open_(bool isMulticastSender) {
+#ifdef _WIN32
+  // WinSock counts startups, every socket holds one until closed
+  WSADATA winSockData;
+  const int wsOk = WSAStartup(MAKEWORD(2, 2), &winSockData);
+  if (wsOk != 0) {
+    throw std::runtime_error("Couldnt start WinSock: " + describeError(wsOk));
+  }
+#endif
+
+  m_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (m_socket == INVALID_SOCKET) {
+    const int error = lastError_();
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    throw std::runtime_error("Failed to create socket: " + describeError(error));
+  }
+
+  // Both are hints, sending works without them
+  const int sendBufferSize = SEND_BUFFER_SIZE;
+  setsockopt(m_socket, SOL_SOCKET, SO_SNDBUF,
+             reinterpret_cast<const char *>(&sendBufferSize),
+             sizeof(sendBufferSize));
+  if (isMulticastSender) {
+    const int multicastTtl = MULTICAST_TTL;
+    setsockopt(m_socket, IPPROTO_IP, IP_MULTICAST_TTL,
+               reinterpret_cast<const char *>(&multicastTtl),
+               sizeof(multicastTtl));
+  }
+}
+
+void UdpSocket::close_() {
+  if (m_socket == INVALID_SOCKET) {
+    return;
+  }
+#ifdef _WIN32
+  closesocket(m_socket);
+  WSACleanup();
+#else
+  ::close(m_socket);
+#endif
+  m_socket = INVALID_SOCKET;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file WaypointProgression.cpp
+ * @brief Code of the progress of vehicles through the waypoints of the exercise.
+ *
+ * @details This file contains the definition of WaypointProgression.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include "../include/WaypointProgression.h"
+
+
+namespace {
+
+constexpr double RAD_TO_DEG = 180.0 / std::numbers::pi;
+
+} // namespace
+
+WaypointProgression::WaypointProgression(const std::vector<Waypoint> &waypoints,
+                                         const LocalFrame &frame,
+                                         const ExerciseInfo &exerciseInfo)
+    : m_accuracySq(static_cast<double>(std::max(exerciseInfo.accuracy, 0)) *
+                   std::max(exerciseInfo.accuracy, 0)),
+      m_exitDistanceSq((std::max(exerciseInfo.accuracy, 0) + EXIT_MARGIN) *
+                       (std::max(exerciseInfo.accuracy, 0) + EXIT_MARGIN)),
+      m_pausingTimeMs(static_cast<std::uint32_t>(std::max(exerciseInfo.pausingTime, 0)) * 1000) {
+  m_targets.reserve(waypoints.size());
+  for (const Waypoint &waypoint : waypoints) {
+    Target target{};
+    frame.toEnu(waypoint, exerciseInfo.coordinatesSystem, target.east, target.north, target.up);
+    target.up += exerciseInfo.guidelineOffset;
+    target.hasBearing = exerciseInfo.targetBearings >= 0;
+    target.bearing = exerciseInfo.targetBearings;
+    m_targets.push_back(target);
+  }
+
+  // -1: face the next waypoint, there's none after the last one
+  if (exerciseInfo.targetBearings == -1) {
+    for (std::size_t idx = 0; idx + 1 < m_targets.size(); ++idx) {
+      m_targets[idx].hasBearing = true;
+      m_targets[idx].bearing = std::atan2(m_targets[idx + 1].east - m_targets[idx].east,
+                                          m_targets[idx + 1].north - m_targets[idx].north) *
+                               RAD_TO_DEG;
+    }
+  }
+}
+
+bool WaypointProgression::update(const TelemetrySample &telemetry, double east, double north,
+                                 double up, WaypointProgress &progress) {
+  if (m_targets.empty()) {
+    return false;
+  }
+  VehicleState &vehicle = m_vehicles[telemetry.systemId];
+  const std::uint32_t timeBootMs = telemetry.globalPositionTimeBootMs;
+  if (!vehicle.stats.isStarted) {
+    vehicle.stats.isStarted = true;
+    vehicle.stats.startTimeBootMs = timeBootMs;
+  }
+  if (vehicle.state == WaypointState::COMPLETED) {
+    return false;
+  }
+
+  auto distanceSqTo = [&](const Target &target) {
+    return (east - target.east) * (east - target.east) +
+           (north - target.north) * (north - target.north) + (up - target.up) * (up - target.up);
+  };
+  const double distanceSq = distanceSqTo(m_targets[vehicle.waypointIdx]);
+  progress = WaypointProgress{};
+  progress.vehicleId = telemetry.systemId;
+  progress.waypointsNum = static_cast<std::uint16_t>(m_targets.size());
+  progress.timeBootMs = timeBootMs;
+  progress.distance = static_cast<float>(std::sqrt(distanceSq));
+
+  switch (vehicle.state) {
+  case WaypointState::APPROACHING:
+    if (distanceSq > m_accuracySq) {
+      return false;
+    }
+    if (m_pausingTimeMs == 0) {
+      capture_(vehicle, telemetry, progress);
+    } else {
+      vehicle.state = WaypointState::HOVERING;
+      vehicle.hoveredMs = 0;
+      vehicle.lastInsideTimeBootMs = timeBootMs;
+      vehicle.isInside = true;
+      vehicle.isExiting = false;
+    }
+    break;
+  case WaypointState::HOVERING: {
+    // Time since boot wraps after 49 days, going back means the autopilot rebooted
+    if (distanceSq > m_exitDistanceSq) {
+      vehicle.isInside = false;
+      if (!vehicle.isExiting) {
+        vehicle.isExiting = true;
+        vehicle.exitStartTimeBootMs = timeBootMs;
+        return false;
+      }
+      const std::int32_t exitMs = static_cast<std::int32_t>(timeBootMs - vehicle.exitStartTimeBootMs);
+      if (exitMs < 0) {
+        vehicle.exitStartTimeBootMs = timeBootMs;
+        return false;
+      }
+      if (static_cast<std::uint32_t>(exitMs) < EXIT_TIME_MS) {
+        return false;
+      }
+      vehicle.state = WaypointState::APPROACHING;
+      break;
+    }
+    vehicle.isExiting = false;
+    // Between the radius and the exit distance the hover is paused
+    if (distanceSq > m_accuracySq) {
+      vehicle.isInside = false;
+      return false;
+    }
+    const std::int32_t sinceLastMs = static_cast<std::int32_t>(timeBootMs - vehicle.lastInsideTimeBootMs);
+    if (vehicle.isInside && sinceLastMs > 0) {
+      vehicle.hoveredMs += static_cast<std::uint32_t>(sinceLastMs);
+    }
+    vehicle.isInside = true;
+    vehicle.lastInsideTimeBootMs = timeBootMs;
+    if (vehicle.hoveredMs < m_pausingTimeMs) {
+      return false;
+    }
+    capture_(vehicle, telemetry, progress);
+    break;
+  }
+  default:
+    return false;
+  }
+
+  if (vehicle.state != WaypointState::COMPLETED && progress.isCaptured) {
+    progress.distance = static_cast<float>(std::sqrt(distanceSqTo(m_targets[vehicle.waypointIdx])));
+  }
+  progress.state = vehicle.state;
+  progress.waypointIdx = vehicle.waypointIdx;
+  vehicle.stats.transitionsNum++;
+  return true;
+}
+
+void WaypointProgression::capture_(VehicleState &vehicle, const TelemetrySample &telemetry,
+                                   WaypointProgress &progress) const {
+  const Target &target = m_targets[vehicle.waypointIdx];
+  bool isCompliant = true;
+  if (target.hasBearing) {
+    // Yaw of ATTITUDE is the heading, clockwise from north as bearings
+    isCompliant = telemetry.has(TelemetrySample::ATTITUDE) &&
+                  std::abs(std::remainder(telemetry.yaw * RAD_TO_DEG - target.bearing, 360.0)) <=
+                      BEARING_TOLERANCE;
+  }
+  progress.isCaptured = true;
+  progress.isBearingCompliant = isCompliant;
+  vehicle.stats.capturedNum++;
+  vehicle.stats.compliantNum += isCompliant;
+
+  if (++vehicle.waypointIdx == m_targets.size()) {
+    vehicle.state = WaypointState::COMPLETED;
+    vehicle.stats.completionTimeBootMs = telemetry.globalPositionTimeBootMs;
+  } else {
+    vehicle.state = WaypointState::APPROACHING;
+  }
+}
@@ -0,0 +1,602 @@
+/**
+ * @file TelemetryLoopbackClient.cpp
+ * @brief Loopback client measuring latency, jitter and loss of telemetry sent by TelemetrySender.
+ *
+ * @details This file contains a standalone client receiving the sender's output the way the
+ *          headset does, decoding every wire format and computing, from sequence numbers and
+ *          timestamps embedded in the packets:
+ *            - latency from sending to receiving and age from capture to receiving, percentiles,
+ *            - inter-arrival time and RFC 3550 jitter of the transit time,
+ *            - lost, duplicated and reordered packets.
+ *          Timestamps are host steady clock ns, the same clock in both processes on one machine.
+ *          Legacy text packets carry neither, only their arrivals are measured.
+ *          The summary is printed as a single JSON object, so runs can be compared by scripts.
+ *          With --generate the client runs a TelemetrySender itself, fed with synthetic telemetry,
+ *          so changes to the sender can be measured without a vehicle.
+ *          Build from the project directory, e.g.:
+ *            g++ -std=c++20 -O2 -DFMT_HEADER_ONLY -Iinclude -Iinclude/base tests/TelemetryLoopbackClient.cpp
+ *                src/*.cpp include/base/*.cpp -lpthread
+ *            cl /std:c++20 /O2 /EHsc /Iinclude /Iinclude\base tests\TelemetryLoopbackClient.cpp
+ *                src\*.cpp include\base\*.cpp ws2_32.lib
+ *          (src/DronePositioningWinAppBackend.cpp excluded, it has its own main).
+ *          Usage:
+ *            TelemetryLoopbackClient [--ip 127.0.0.1] [--port 54000] [--duration 10] [--json FILE]
+ *                                    [--generate VEHICLES RATE_HZ [--format text|binary|delta]
+ *                                     [--coalescing-us US] [--output-rate HZ] [--horizon-ms MS]]
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#ifdef _WIN32
+#include <WS2tcpip.h>
+#else
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "../include/ClockSync.h"
+#include "../include/DeltaCodec.h"
+#include "../include/EventsBus.h"
+#include "../include/ScenePacket.h"
+#include "../include/TelemetryPacket.h"
+#include "../include/TelemetrySender.h"
+
+
+namespace {
+
+constexpr std::size_t MAX_DATAGRAM_SIZE = 65536;
+constexpr int RECEIVE_BUFFER_SIZE = 4 * 1024 * 1024; // bursts of the generator aren't dropped by the client
+constexpr auto POLL_PERIOD = std::chrono::milliseconds(100);
+constexpr std::int64_t SEQUENCE_WINDOW = 1 << 15;    // unwrapping, half of the u16 delta sequence
+
+#ifdef _WIN32
+using NativeHandle = SOCKET;
+#else
+using NativeHandle = int;
+constexpr NativeHandle INVALID_SOCKET = -1;
+#endif
+
+struct Options {
+  std::string ip{"127.0.0.1"};
+  int port{54000};
+  double durationS{10.0};
+  std::string jsonPath;
+  bool isGenerating{false};
+  int vehiclesNum{1};
+  double rateHz{50.0};
+  WireFormat wireFormat{WireFormat::BINARY};
+  std::uint32_t coalescingWindowUs{0};
+  std::uint32_t outputRateHz{0};
+  std::uint32_t predictionHorizonMs{0};
+};
+
+/**
+ * @brief Socket bound to the address the sender sends to.
+ */
+class ReceiveSocket {
+public:
+
+  ReceiveSocket(const std::string &ip, int port) {
+#ifdef _WIN32
+    WSADATA winSockData;
+    if (WSAStartup(MAKEWORD(2, 2), &winSockData) != 0) {
+      throw std::runtime_error("Couldnt start WinSock");
+    }
+#endif
+    m_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (m_socket == INVALID_SOCKET) {
+      throw std::runtime_error("Failed to create socket");
+    }
+    const int receiveBufferSize = RECEIVE_BUFFER_SIZE;
+    setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF,
+               reinterpret_cast<const char *>(&receiveBufferSize), sizeof(receiveBufferSize));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<std::uint16_t>(port));
+    if (inet_pton(AF_INET, ip.c_str(), &address.sin_addr) != 1 ||
+        bind(m_socket, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0) {
+      close_();
+      throw std::runtime_error("Couldnt bind socket to " + ip + ":" + std::to_string(port));
+    }
+  }
+
+  ~ReceiveSocket() { close_(); }
+
+  ReceiveSocket(const ReceiveSocket &) = delete;
+  ReceiveSocket &operator=(const ReceiveSocket &) = delete;
+
+  /**
+   * @brief Wait for a datagram at most the timeout.
+   * @return Size of the datagram, 0 if none arrived.
+   */
+  std::size_t receive(std::uint8_t *buffer, std::size_t size, std::chrono::microseconds timeout) {
+    fd_set readable;
+    FD_ZERO(&readable);
+    FD_SET(m_socket, &readable);
+    timeval wait{static_cast<long>(timeout.count() / 1'000'000), static_cast<long>(timeout.count() % 1'000'000)};
+    if (select(static_cast<int>(m_socket) + 1, &readable, nullptr, nullptr, &wait) <= 0) {
+      return 0;
+    }
+    const auto received = recv(m_socket, reinterpret_cast<char *>(buffer), static_cast<int>(size), 0);
+    return received > 0 ? static_cast<std::size_t>(received) : 0;
+  }
+
+private:
+
+  void close_() {
+    if (m_socket == INVALID_SOCKET) {
+      return;
+    }
+#ifdef _WIN32
+    closesocket(m_socket);
+    WSACleanup();
+#else
+    ::close(m_socket);
+#endif
+    m_socket = INVALID_SOCKET;
+  }
+
+  NativeHandle m_socket{INVALID_SOCKET};
+};
+
+/**
+ * @brief Percentiles of a set of values, in the unit of the values.
+ */
+struct Distribution {
+  double mean{0.0}, p50{0.0}, p90{0.0}, p99{0.0}, p999{0.0}, max{0.0};
+};
+
+Distribution distributionOf(std::vector<double> values) {
+  Distribution distribution;
+  if (values.empty()) {
+    return distribution;
+  }
+  auto percentile = [&](double fraction) {
+    const auto nth = values.begin() + static_cast<std::ptrdiff_t>(fraction * (values.size() - 1));
+    std::nth_element(values.begin(), nth, values.end());
+    return *nth;
+  };
+  double sum = 0.0;
+  for (const double value : values) {
+    sum += value;
+  }
+  distribution.mean = sum / values.size();
+  distribution.p50 = percentile(0.5);
+  distribution.p90 = percentile(0.9);
+  distribution.p99 = percentile(0.99);
+  distribution.p999 = percentile(0.999);
+  distribution.max = *std::max_element(values.begin(), values.end());
+  return distribution;
+}
+
+/**
+ * @brief Statistics of received packets.
+ */
+class Statistics {
+public:
+
+  explicit Statistics(int sequenceBits) : m_sequenceModulo(std::int64_t{1} << sequenceBits) {}
+
+  /**
+   * @brief Record a packet with an embedded sequence number and timestamps.
+   * @param sendTimeNs: host steady clock time of sending, capture time plus the capture age.
+   */
+  void addPacket(std::uint32_t sequence, std::int64_t captureTimeNs, std::int64_t sendTimeNs,
+                 std::int64_t receiveTimeNs, bool isPredicted) {
+    m_packetsNum++;
+    m_predictedNum += isPredicted;
+
+    // Unwrapped sequence closest to the highest one received
+    std::int64_t extended = sequence;
+    if (m_hasSequence) {
+      const std::int64_t window = std::min(SEQUENCE_WINDOW, m_sequenceModulo / 2);
+      const std::int64_t base = m_highestSequence - (m_highestSequence % m_sequenceModulo);
+      extended = base + sequence;
+      if (extended - m_highestSequence > window) {
+        extended -= m_sequenceModulo;
+      } else if (m_highestSequence - extended > window) {
+        extended += m_sequenceModulo;
+      }
+    }
+    if (!m_received.insert(extended).second) {
+      m_duplicatesNum++;
+      return;
+    }
+    if (!m_hasSequence) {
+      m_lowestSequence = m_highestSequence = extended;
+      m_hasSequence = true;
+    } else if (extended < m_highestSequence) {
+      m_reorderedNum++;
+    }
+    m_lowestSequence = std::min(m_lowestSequence, extended);
+    m_highestSequence = std::max(m_highestSequence, extended);
+
+    m_latenciesUs.push_back((receiveTimeNs - sendTimeNs) * 1E-3);
+    m_agesUs.push_back((receiveTimeNs - captureTimeNs) * 1E-3);
+
+    // RFC 3550: J += (|D(i-1, i)| - J) / 16, D the difference of transit times
+    const std::int64_t transitNs = receiveTimeNs - sendTimeNs;
+    if (m_hasTransit) {
+      m_jitterUs += (std::abs(transitNs - m_lastTransitNs) * 1E-3 - m_jitterUs) / 16.0;
+    }
+    m_lastTransitNs = transitNs;
+    m_hasTransit = true;
+  }
+
+  /**
+   * @brief Record a packet without sequence number and timestamps.
+   */
+  void addUntimedPacket() { m_packetsNum++; }
+
+  void addArrival(std::int64_t receiveTimeNs, std::size_t size) {
+    m_datagramsNum++;
+    m_bytesNum += size;
+    if (m_lastArrivalNs != 0) {
+      m_interArrivalsUs.push_back((receiveTimeNs - m_lastArrivalNs) * 1E-3);
+    }
+    m_lastArrivalNs = receiveTimeNs;
+  }
+
+  void addUndecodable() { m_undecodableNum++; }
+  void addKeyframeMissing() { m_keyframeMissingNum++; }
+  void addScenePacket() { m_scenePacketsNum++; }
+  void addProgressPacket() { m_progressPacketsNum++; }
+
+  /**
+   * @brief Write the summary as a JSON object.
+   */
+  void write(std::FILE *out, const Options &options, double elapsedS) const {
+    const std::uint64_t expectedNum =
+        m_hasSequence ? static_cast<std::uint64_t>(m_highestSequence - m_lowestSequence + 1) : 0;
+    const std::uint64_t lostNum = expectedNum - m_received.size();
+
+    double interArrivalMean = 0.0, interArrivalVariance = 0.0;
+    for (const double value : m_interArrivalsUs) {
+      interArrivalMean += value;
+    }
+    if (!m_interArrivalsUs.empty()) {
+      interArrivalMean /= m_interArrivalsUs.size();
+      for (const double value : m_interArrivalsUs) {
+        interArrivalVariance += (value - interArrivalMean) * (value - interArrivalMean);
+      }
+      interArrivalVariance /= m_interArrivalsUs.size();
+    }
+
+    auto writeDistribution = [&](const char *name, const std::vector<double> &values, const char *separator) {
+      if (values.empty()) {
+        std::fprintf(out, "  \"%s\": null%s\n", name, separator); // nothing timed, e.g. legacy text
+        return;
+      }
+      const Distribution distribution = distributionOf(values);
+      std::fprintf(out,
+                   "  \"%s\": {\"mean\": %.1f, \"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, "
+                   "\"p99.9\": %.1f, \"max\": %.1f}%s\n",
+                   name, distribution.mean, distribution.p50, distribution.p90, distribution.p99,
+                   distribution.p999, distribution.max, separator);
+    };
+
+    static constexpr const char *FORMAT_NAMES[] = {"text", "binary", "delta"};
+    std::fprintf(out, "{\n");
+    std::fprintf(out, "  \"format\": \"%s\",\n", FORMAT_NAMES[static_cast<int>(m_format)]);
+    if (options.isGenerating) {
+      std::fprintf(out,
+                   "  \"generator\": {\"vehicles\": %d, \"rate_hz\": %.1f, \"coalescing_us\": %u, "
+                   "\"output_rate_hz\": %u, \"horizon_ms\": %u},\n",
+                   options.vehiclesNum, options.rateHz, options.coalescingWindowUs,
+                   options.outputRateHz, options.predictionHorizonMs);
+    }
+    std::fprintf(out, "  \"duration_s\": %.3f,\n", elapsedS);
+    std::fprintf(out, "  \"datagrams\": %llu,\n", static_cast<unsigned long long>(m_datagramsNum));
+    std::fprintf(out, "  \"bytes\": %llu,\n", static_cast<unsigned long long>(m_bytesNum));
+    std::fprintf(out, "  \"packets\": %llu,\n", static_cast<unsigned long long>(m_packetsNum));
+    std::fprintf(out, "  \"predicted\": %llu,\n", static_cast<unsigned long long>(m_predictedNum));
+    std::fprintf(out, "  \"scene_packets\": %llu,\n", static_cast<unsigned long long>(m_scenePacketsNum));
+    std::fprintf(out, "  \"progress_packets\": %llu,\n", static_cast<unsigned long long>(m_progressPacketsNum));
+    std::fprintf(out, "  \"undecodable\": %llu,\n", static_cast<unsigned long long>(m_undecodableNum));
+    std::fprintf(out, "  \"keyframe_missing\": %llu,\n", static_cast<unsigned long long>(m_keyframeMissingNum));
+    std::fprintf(out, "  \"lost\": %llu,\n", static_cast<unsigned long long>(lostNum));
+    std::fprintf(out, "  \"loss_ratio\": %.6f,\n", expectedNum > 0 ? static_cast<double>(lostNum) / expectedNum : 0.0);
+    std::fprintf(out, "  \"duplicates\": %llu,\n", static_cast<unsigned long long>(m_duplicatesNum));
+    std::fprintf(out, "  \"reordered\": %llu,\n", static_cast<unsigned long long>(m_reorderedNum));
+    writeDistribution("latency_us", m_latenciesUs, ",");
+    writeDistribution("capture_age_us", m_agesUs, ",");
+    if (m_hasTransit) {
+      std::fprintf(out, "  \"jitter_us\": %.1f,\n", m_jitterUs);
+    } else {
+      std::fprintf(out, "  \"jitter_us\": null,\n");
+    }
+    std::fprintf(out, "  \"inter_arrival_us\": {\"mean\": %.1f, \"stddev\": %.1f}\n",
+                 interArrivalMean, std::sqrt(interArrivalVariance));
+    std::fprintf(out, "}\n");
+  }
+
+  void setFormat(WireFormat format) { m_format = format; }
+
+  bool isReceived() const { return m_datagramsNum > 0; }
+
+private:
+
+  const std::int64_t m_sequenceModulo;
+  WireFormat m_format{WireFormat::TEXT};
+  std::uint64_t m_datagramsNum{0};
+  std::uint64_t m_bytesNum{0};
+  std::uint64_t m_packetsNum{0};
+  std::uint64_t m_predictedNum{0};
+  std::uint64_t m_scenePacketsNum{0};
+  std::uint64_t m_progressPacketsNum{0};
+  std::uint64_t m_undecodableNum{0};
+  std::uint64_t m_keyframeMissingNum{0};
+  std::uint64_t m_duplicatesNum{0};
+  std::uint64_t m_reorderedNum{0};
+  std::unordered_set<std::int64_t> m_received;
+  bool m_hasSequence{false};
+  std::int64_t m_lowestSequence{0};
+  std::int64_t m_highestSequence{0};
+  std::vector<double> m_latenciesUs;
+  std::vector<double> m_agesUs;
+  std::vector<double> m_interArrivalsUs;
+  std::int64_t m_lastArrivalNs{0};
+  std::int64_t m_lastTransitNs{0};
+  bool m_hasTransit{false};
+  double m_jitterUs{0.0};
+};
+
+template <typename T>
+T readLe(const std::uint8_t *data) {
+  T value;
+  std::memcpy(&value, data, sizeof(T)); // the wire is little-endian, as x86 and ARM hosts
+  return value;
+}
+
+/**
+ * @brief Decode all packets of a datagram, which may be coalesced.
+ */
+void decodeDatagram(const std::uint8_t *data, std::size_t size, std::int64_t receiveTimeNs,
+                    wire::DeltaDecoder &deltaDecoder, Statistics &binaryStatistics,
+                    Statistics &deltaStatistics, Statistics &textStatistics) {
+  const std::uint16_t magic = size >= 2 ? readLe<std::uint16_t>(data) : 0;
+  if (magic == wire::SCENE_MAGIC || magic == wire::SCENE_ANNOUNCE_MAGIC ||
+      magic == wire::SCENE_CHUNK_MAGIC) {
+    binaryStatistics.addScenePacket();
+    return;
+  }
+  if (magic == wire::PROGRESS_MAGIC) {
+    binaryStatistics.addProgressPacket();
+    return;
+  }
+
+  if (magic == wire::MAGIC) {
+    binaryStatistics.setFormat(WireFormat::BINARY);
+    binaryStatistics.addArrival(receiveTimeNs, size);
+    std::size_t offset = 0;
+    for (; offset + wire::BINARY_PACKET_SIZE <= size; offset += wire::BINARY_PACKET_SIZE) {
+      const std::uint8_t *packet = data + offset;
+      if (readLe<std::uint16_t>(packet) != wire::MAGIC || packet[2] != wire::VERSION) {
+        binaryStatistics.addUndecodable();
+        return;
+      }
+      const auto timestampNs = readLe<std::int64_t>(packet + 8);
+      const auto captureAgeUs = readLe<std::uint32_t>(packet + 60);
+      binaryStatistics.addPacket(readLe<std::uint32_t>(packet + 4), timestampNs,
+                                 timestampNs + std::int64_t{captureAgeUs} * 1000, receiveTimeNs,
+                                 (packet[18] & wire::FLAG_PREDICTED) != 0);
+    }
+    if (offset != size) {
+      binaryStatistics.addUndecodable();
+    }
+    return;
+  }
+
+  if (magic == wire::DELTA_MAGIC) {
+    deltaStatistics.setFormat(WireFormat::DELTA);
+    deltaStatistics.addArrival(receiveTimeNs, size);
+    std::size_t offset = 0;
+    while (offset < size) {
+      std::uint8_t vehicleId;
+      wire::QuantisedSample sample;
+      const wire::DeltaResult result = deltaDecoder.decode(data + offset, size - offset, vehicleId, sample);
+      if (result.status == wire::DeltaStatus::MALFORMED) {
+        deltaStatistics.addUndecodable(); // the rest is unreadable
+        return;
+      }
+      offset += result.consumedNum;
+      if (result.status == wire::DeltaStatus::KEYFRAME_MISSING) {
+        deltaStatistics.addKeyframeMissing(); // only this packet is skipped
+        continue;
+      }
+      deltaStatistics.addPacket(sample.sequence, sample.timestampNs,
+                                sample.timestampNs + std::int64_t{sample.captureAgeUs} * 1000,
+                                receiveTimeNs, (sample.flags & wire::DELTA_FLAG_PREDICTED) != 0);
+    }
+    return;
+  }
+
+  // Legacy text: NUL-terminated "roll pitch yaw lat lon alt "
+  textStatistics.addArrival(receiveTimeNs, size);
+  for (std::size_t offset = 0; offset < size;) {
+    const auto *end = static_cast<const std::uint8_t *>(std::memchr(data + offset, '\0', size - offset));
+    if (end == nullptr) {
+      textStatistics.addUndecodable();
+      return;
+    }
+    textStatistics.addUntimedPacket();
+    offset = static_cast<std::size_t>(end - data) + 1;
+  }
+}
+
+/**
+ * @brief Feed the sender with circling vehicles at the given rate until stopped.
+ */
+void generate(TelemetrySender &sender, const Options &options, const std::atomic<bool> &isStopped) {
+  const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(1.0 / options.rateHz));
+  auto next = std::chrono::steady_clock::now();
+  for (std::uint64_t tick = 0; !isStopped.load(std::memory_order_relaxed); ++tick) {
+    const double t = tick / options.rateHz;
+    for (int vehicle = 0; vehicle < options.vehiclesNum; ++vehicle) {
+      const double angle = 0.2 * t + vehicle;
+      TelemetrySample sample;
+      sample.systemId = static_cast<std::uint8_t>(vehicle + 1);
+      sample.validFields = TelemetrySample::ATTITUDE | TelemetrySample::GLOBAL_POSITION;
+      sample.attitudeHostTimeNs = sample.globalPositionHostTimeNs = ClockSync::nowNs();
+      sample.yaw = static_cast<float>(std::remainder(angle + 1.5707963, 6.2831853));
+      sample.yawSpeed = 0.2f;
+      sample.latE7 = 530097792 + static_cast<std::int32_t>(3600.0 * std::sin(angle));
+      sample.lonE7 = 209265921 + static_cast<std::int32_t>(6000.0 * std::cos(angle));
+      sample.altMm = 180000 + vehicle * 5000;
+      sample.relativeAltMm = 40000 + vehicle * 5000;
+      sample.velocityNorth = static_cast<float>(8.0 * std::cos(angle));
+      sample.velocityEast = static_cast<float>(-8.0 * std::sin(angle));
+      sender.sendPosition(sample);
+    }
+    next += period;
+    std::this_thread::sleep_until(next);
+  }
+}
+
+bool parseOptions(int argc, char **argv, Options &options) {
+  for (int idx = 1; idx < argc; ++idx) {
+    const std::string option = argv[idx];
+    const bool hasValue = idx + 1 < argc;
+    if (option == "--ip" && hasValue) {
+      options.ip = argv[++idx];
+    } else if (option == "--port" && hasValue) {
+      options.port = std::stoi(argv[++idx]);
+    } else if (option == "--duration" && hasValue) {
+      options.durationS = std::stod(argv[++idx]);
+    } else if (option == "--json" && hasValue) {
+      options.jsonPath = argv[++idx];
+    } else if (option == "--generate" && idx + 2 < argc) {
+      options.isGenerating = true;
+      options.vehiclesNum = std::clamp(std::stoi(argv[++idx]), 1, 250);
+      options.rateHz = std::max(std::stod(argv[++idx]), 0.1);
+    } else if (option == "--format" && hasValue) {
+      const std::string format = argv[++idx];
+      if (format == "text") {
+        options.wireFormat = WireFormat::TEXT;
+      } else if (format == "binary") {
+        options.wireFormat = WireFormat::BINARY;
+      } else if (format == "delta") {
+        options.wireFormat = WireFormat::DELTA;
+      } else {
+        return false;
+      }
+    } else if (option == "--coalescing-us" && hasValue) {
+      options.coalescingWindowUs = static_cast<std::uint32_t>(std::stoul(argv[++idx]));
+    } else if (option == "--output-rate" && hasValue) {
+      options.outputRateHz = static_cast<std::uint32_t>(std::stoul(argv[++idx]));
+    } else if (option == "--horizon-ms" && hasValue) {
+      options.predictionHorizonMs = static_cast<std::uint32_t>(std::stoul(argv[++idx]));
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  try {
+    if (!parseOptions(argc, argv, options)) {
+      std::fprintf(stderr,
+                   "usage: %s [--ip IP] [--port PORT] [--duration S] [--json FILE]\n"
+                   "          [--generate VEHICLES RATE_HZ [--format text|binary|delta]\n"
+                   "           [--coalescing-us US] [--output-rate HZ] [--horizon-ms MS]]\n",
+                   argv[0]);
+      return 2;
+    }
+  } catch (const std::exception &) {
+    std::fprintf(stderr, "invalid value of an option\n");
+    return 2;
+  }
+
+  try {
+    ReceiveSocket socket(options.ip, options.port);
+    wire::DeltaDecoder deltaDecoder;
+    Statistics binaryStatistics(32), deltaStatistics(16), textStatistics(32);
+
+    EventsBus bus;
+    std::unique_ptr<TelemetrySender> sender;
+    std::atomic<bool> isStopped{false};
+    std::thread generator;
+    if (options.isGenerating) {
+      sender = std::make_unique<TelemetrySender>(
+          bus, std::vector<ConnectionConfigurationInfo::Endpoint>{{options.ip, options.port}},
+          options.wireFormat, options.coalescingWindowUs, options.outputRateHz,
+          options.predictionHorizonMs);
+      generator = std::thread(generate, std::ref(*sender), std::cref(options), std::cref(isStopped));
+    }
+
+    std::vector<std::uint8_t> buffer(MAX_DATAGRAM_SIZE);
+    const auto start = std::chrono::steady_clock::now();
+    const auto end = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                 std::chrono::duration<double>(options.durationS));
+    for (auto now = start; now < end; now = std::chrono::steady_clock::now()) {
+      const auto timeout = std::min<std::chrono::steady_clock::duration>(end - now, POLL_PERIOD);
+      const std::size_t size = socket.receive(
+          buffer.data(), buffer.size(), std::chrono::duration_cast<std::chrono::microseconds>(timeout));
+      if (size > 0) {
+        decodeDatagram(buffer.data(), size, ClockSync::nowNs(), deltaDecoder, binaryStatistics,
+                       deltaStatistics, textStatistics);
+      }
+    }
+    const double elapsedS = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    isStopped = true;
+    if (generator.joinable()) {
+      generator.join();
+    }
+    sender.reset();
+
+    // Summary of the format which was received, binary if nothing was
+    const Statistics *statistics = &binaryStatistics;
+    if (options.isGenerating ? options.wireFormat == WireFormat::DELTA : deltaStatistics.isReceived()) {
+      statistics = &deltaStatistics;
+    } else if (options.isGenerating ? options.wireFormat == WireFormat::TEXT : textStatistics.isReceived()) {
+      statistics = &textStatistics;
+    }
+
+    std::FILE *out = stdout;
+    if (!options.jsonPath.empty()) {
+      out = std::fopen(options.jsonPath.c_str(), "w");
+      if (out == nullptr) {
+        std::fprintf(stderr, "couldnt open %s\n", options.jsonPath.c_str());
+        return 1;
+      }
+    }
+    statistics->write(out, options, elapsedS);
+    if (out != stdout) {
+      std::fclose(out);
+    }
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  return 0;
+}
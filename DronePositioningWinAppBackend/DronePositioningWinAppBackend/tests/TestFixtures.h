@@ -0,0 +1,702 @@
+/**
+ * @file TestFixtures.h
+ * @brief Generated flights, streams, exercises and files of the tests and benchmarks.
+ *
+ * @details This file contains the inputs both the test suites in tests/test<Component>.cpp and
+ *          the standalone benchmarks in tests/bench<Component>.cpp run on, so the checks and the
+ *          measurements can't drift apart. Generators take their sizes, which differ between the
+ *          two, and random generators are seeded by the caller. MAVLink streams are encoded with
+ *          the headers of external/c_library_v2, which has to be on the include path of every
+ *          file including it.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include <common/mavlink.h>
+
+#include "../include/ConfigUtilities.h"
+#include "../include/FlightConfig.h"
+#include "../include/Geodesy.h"
+#include "../include/LocalFrame.h"
+#include "../include/ObstacleBoxes.h"
+#include "../include/SessionRecorder.h"
+#include "../include/TelemetrySample.h"
+
+
+namespace fixtures {
+
+/**
+ * @brief Operator of every generated exercise.
+ */
+inline const OperatorPosition ORIGIN(53.009779233998756, 20.92659215232849, 140.0);
+
+/****************************************************
+* Telemetry
+*****************************************************/
+/**
+ * @brief Drone circling 50 m around a point at 8 m/s and 30 m height at 50 Hz, with sensor noise.
+ */
+inline std::vector<TelemetrySample> makeFlight(std::size_t samplesNum) {
+  constexpr double rateHz = 50.0;
+  std::mt19937 rng(42);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  std::vector<TelemetrySample> samples(samplesNum);
+  for (std::size_t idx = 0; idx < samplesNum; ++idx) {
+    const double t = idx / rateHz;
+    const double angle = t * 8.0 / 50.0;
+    TelemetrySample &sample = samples[idx];
+    sample.systemId = 1;
+    sample.validFields = 0x1F;
+    sample.isTimeSynced = true;
+    sample.attitudeHostTimeNs = static_cast<std::int64_t>(t * 1E9) + 1'000'000'000;
+    sample.roll = static_cast<float>(0.15 + 0.01 * noise(rng));
+    sample.pitch = static_cast<float>(-0.05 + 0.01 * noise(rng));
+    sample.yaw = static_cast<float>(std::remainder(angle + std::numbers::pi / 2, 2 * std::numbers::pi));
+    sample.latE7 = static_cast<std::int32_t>(521234567 + 50.0 * std::sin(angle) / 0.0111 + noise(rng) * 3);
+    sample.lonE7 = static_cast<std::int32_t>(210123456 + 50.0 * std::cos(angle) / 0.0068 + noise(rng) * 3);
+    sample.altMm = static_cast<std::int32_t>(130000 + noise(rng) * 50);
+    sample.relativeAltMm = sample.altMm - 100000;
+    sample.velocityNorth = static_cast<float>(8.0 * std::cos(angle) + 0.05 * noise(rng));
+    sample.velocityEast = static_cast<float>(-8.0 * std::sin(angle) + 0.05 * noise(rng));
+    sample.velocityDown = static_cast<float>(0.05 * noise(rng));
+  }
+  return samples;
+}
+
+/****************************************************
+* MAVLink streams
+*****************************************************/
+constexpr std::uint32_t STREAMS_TICK_HZ = 50;                // the fastest stream
+constexpr std::uint32_t STREAMS_START_TIME_BOOT_MS = 10'000;
+
+struct StreamCounts {
+  std::uint64_t framesNum{0};
+  std::uint64_t publishedNum{0};
+  std::uint64_t timesyncRequestsNum{0};
+  std::uint64_t droppedNum{0};                // frames the parser dropped, e.g. on a bad CRC
+  std::uint64_t wrongTs1Num{0};               // TIMESYNC replies not echoing the request
+};
+
+inline void appendFrame(std::vector<std::uint8_t> &bytes, const mavlink_message_t &message) {
+  std::uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+  const std::uint16_t size = mavlink_msg_to_send_buffer(buffer, &message);
+  bytes.insert(bytes.end(), buffer, buffer + size);
+}
+
+/**
+ * @brief ts1 of the autopilot TIMESYNC request sent at the boot time.
+ */
+inline std::int64_t timesyncTs1(std::uint32_t timeBootMs) {
+  return timeBootMs * 1'000'000ll;
+}
+
+/**
+ * @brief A vehicle circling at the highest rates the receiver requests, with autopilot
+ *        TIMESYNC requests twice a second from STREAMS_START_TIME_BOOT_MS.
+ * @param durationS: seconds of streams to generate.
+ * @param expected: frames and samples the bytes hold.
+ */
+inline std::vector<std::uint8_t> generateStreams(std::uint32_t durationS, StreamCounts &expected) {
+  std::vector<std::uint8_t> bytes;
+  mavlink_message_t message;
+  for (std::uint32_t tick = 0; tick < durationS * STREAMS_TICK_HZ; ++tick) {
+    const std::uint32_t timeBootMs = STREAMS_START_TIME_BOOT_MS + tick * (1000 / STREAMS_TICK_HZ);
+    const double angle = tick / static_cast<double>(STREAMS_TICK_HZ) * 0.16;
+
+    mavlink_attitude_t attitude{};
+    attitude.time_boot_ms = timeBootMs;
+    attitude.roll = 0.15f;
+    attitude.yaw = static_cast<float>(std::remainder(angle, 2 * std::numbers::pi));
+    attitude.yawspeed = 0.16f;
+    mavlink_msg_attitude_encode(1, 1, &message, &attitude);
+    appendFrame(bytes, message);
+
+    mavlink_local_position_ned_t local{};
+    local.time_boot_ms = timeBootMs;
+    local.x = static_cast<float>(50.0 * std::cos(angle));
+    local.y = static_cast<float>(50.0 * std::sin(angle));
+    local.z = -30.0f;
+    mavlink_msg_local_position_ned_encode(1, 1, &message, &local);
+    appendFrame(bytes, message);
+
+    mavlink_highres_imu_t imu{};
+    imu.time_usec = timeBootMs * 1000ull;
+    imu.zacc = -9.81f;
+    mavlink_msg_highres_imu_encode(1, 1, &message, &imu);
+    appendFrame(bytes, message);
+    expected.framesNum += 3;
+    expected.publishedNum++;
+
+    if (tick % (STREAMS_TICK_HZ / 10) == 0) {
+      mavlink_global_position_int_t gps{};
+      gps.time_boot_ms = timeBootMs;
+      gps.lat = static_cast<std::int32_t>(521234567 + 50.0 * std::sin(angle) / 0.0111);
+      gps.lon = static_cast<std::int32_t>(210123456 + 50.0 * std::cos(angle) / 0.0068);
+      gps.alt = 130000;
+      gps.relative_alt = 30000;
+      mavlink_msg_global_position_int_encode(1, 1, &message, &gps);
+      appendFrame(bytes, message);
+
+      mavlink_vfr_hud_t hud{};
+      hud.groundspeed = 8.0f;
+      mavlink_msg_vfr_hud_encode(1, 1, &message, &hud);
+      appendFrame(bytes, message);
+      expected.framesNum += 2;
+    }
+    if (tick % (STREAMS_TICK_HZ / 2) == 0) {
+      mavlink_timesync_t timesync{};
+      timesync.ts1 = timesyncTs1(timeBootMs);
+      mavlink_msg_timesync_encode(1, 1, &message, &timesync);
+      appendFrame(bytes, message);
+      expected.framesNum++;
+      expected.timesyncRequestsNum++;
+    }
+    if (tick % STREAMS_TICK_HZ == 0) {
+      mavlink_heartbeat_t heartbeat{};
+      heartbeat.system_status = MAV_STATE_ACTIVE;
+      mavlink_msg_heartbeat_encode(1, 1, &message, &heartbeat);
+      appendFrame(bytes, message);
+
+      mavlink_system_time_t systemTime{};
+      systemTime.time_boot_ms = timeBootMs;
+      mavlink_msg_system_time_encode(1, 1, &message, &systemTime);
+      appendFrame(bytes, message);
+      expected.framesNum += 2;
+    }
+  }
+  return bytes;
+}
+
+/****************************************************
+* Poses
+*****************************************************/
+constexpr double METRES_PER_DEG_E7_LAT = 0.011131949;
+constexpr std::int32_t ORIGIN_LAT_E7 = 530097792;
+constexpr std::int32_t ORIGIN_LON_E7 = 209265921;
+
+struct Truth {
+  double north, east, up;
+  double velocityNorth, velocityEast, velocityUp;
+  double yaw, yawRate;
+};
+
+/**
+ * @brief Legs of 20 s at 8 m/s: straight north, then a full circle climbing 0.5 m/s.
+ */
+inline Truth truthAt(double t) {
+  constexpr double speed = 8.0, legS = 20.0, climbRate = 0.5;
+  constexpr double radius = speed * legS / (2 * std::numbers::pi);
+  const double pairsNum = std::floor(t / (2 * legS)); // every pair starts where the previous ended
+  const double leg = t - pairsNum * 2 * legS;
+  const double pairNorth = speed * legS * pairsNum;
+  Truth truth{};
+  truth.up = climbRate * legS * pairsNum;
+  if (leg < legS) {
+    truth.north = pairNorth + speed * leg;
+    truth.velocityNorth = speed;
+    truth.yaw = 0.0;
+  } else {
+    const double rate = speed / radius;
+    const double angle = rate * (leg - legS);
+    truth.north = pairNorth + speed * legS + radius * std::sin(angle);
+    truth.east = radius * (1.0 - std::cos(angle));
+    truth.velocityNorth = speed * std::cos(angle);
+    truth.velocityEast = speed * std::sin(angle);
+    truth.yaw = std::remainder(angle, 2 * std::numbers::pi);
+    truth.yawRate = rate;
+    truth.up += climbRate * (leg - legS);
+    truth.velocityUp = climbRate;
+  }
+  return truth;
+}
+
+/**
+ * @brief Sample of vehicle 1 captured at t, with sensor noise.
+ */
+inline TelemetrySample sampleAt(double t, std::mt19937 &rng) {
+  std::normal_distribution<double> noise(0.0, 1.0);
+  const Truth truth = truthAt(t);
+  const double metresPerDegE7Lon = METRES_PER_DEG_E7_LAT * std::cos(53.0097792 * std::numbers::pi / 180.0);
+  TelemetrySample sample;
+  sample.systemId = 1;
+  sample.validFields = TelemetrySample::ATTITUDE | TelemetrySample::GLOBAL_POSITION;
+  sample.attitudeHostTimeNs = sample.globalPositionHostTimeNs = static_cast<std::int64_t>(t * 1E9);
+  sample.yaw = static_cast<float>(truth.yaw + 0.002 * noise(rng));
+  sample.yawSpeed = static_cast<float>(truth.yawRate + 0.01 * noise(rng));
+  sample.latE7 = ORIGIN_LAT_E7 + static_cast<std::int32_t>(std::lround((truth.north + 0.02 * noise(rng)) /
+                                                                        METRES_PER_DEG_E7_LAT));
+  sample.lonE7 = ORIGIN_LON_E7 + static_cast<std::int32_t>(std::lround((truth.east + 0.02 * noise(rng)) /
+                                                                        metresPerDegE7Lon));
+  sample.altMm = 140000 + static_cast<std::int32_t>(std::lround(truth.up * 1E3));
+  sample.velocityNorth = static_cast<float>(truth.velocityNorth + 0.05 * noise(rng));
+  sample.velocityEast = static_cast<float>(truth.velocityEast + 0.05 * noise(rng));
+  sample.velocityDown = static_cast<float>(-truth.velocityUp);
+  return sample;
+}
+
+inline double positionError(const TelemetrySample &sample, const Truth &truth) {
+  const double metresPerDegE7Lon = METRES_PER_DEG_E7_LAT * std::cos(53.0097792 * std::numbers::pi / 180.0);
+  const double north = (sample.latE7 - ORIGIN_LAT_E7) * METRES_PER_DEG_E7_LAT - truth.north;
+  const double east = (sample.lonE7 - ORIGIN_LON_E7) * metresPerDegE7Lon - truth.east;
+  const double up = (sample.altMm - 140000) * 1E-3 - truth.up;
+  return std::sqrt(north * north + east * east + up * up);
+}
+
+/****************************************************
+* Obstacles
+*****************************************************/
+/**
+ * @brief Slalom of gates along z every 15 m: two poles and a wall between them, all rotated.
+ */
+inline std::vector<Obstackle> makeSlalom(std::size_t obstaclesNum, std::mt19937 &rng) {
+  std::uniform_real_distribution<double> angle(-30.0, 30.0);
+  std::vector<Obstackle> obstacles;
+  for (std::size_t idx = 0; obstacles.size() < obstaclesNum; ++idx) {
+    const double forward = 15.0 * (idx / 3);
+    const double side = (idx / 3) % 2 == 0 ? -8.0 : 8.0;
+    switch (idx % 3) {
+    case 0:
+      obstacles.emplace_back(side - 4.0, 5.0, forward, 0.5, 0.5, 10.0, 0.0, angle(rng), 0.0);
+      break;
+    case 1:
+      obstacles.emplace_back(side + 4.0, 5.0, forward, 0.5, 0.5, 10.0, 0.0, angle(rng), 0.0);
+      break;
+    default:
+      obstacles.emplace_back(-side, 3.0, forward, 10.0, 0.3, 6.0, angle(rng), angle(rng), angle(rng));
+      break;
+    }
+  }
+  return obstacles;
+}
+
+/**
+ * @brief Boxes along north every 5 m, rotated about all axes, of 0.3 to 10 m.
+ */
+inline std::vector<OrientedBox> makeBoxes(std::size_t boxesNum, std::mt19937 &rng) {
+  std::uniform_real_distribution<double> angle(-std::numbers::pi, std::numbers::pi);
+  std::uniform_real_distribution<double> side(-10.0, 10.0), extent(0.15, 5.0);
+  std::vector<OrientedBox> boxes(boxesNum);
+  for (std::size_t idx = 0; idx < boxesNum; ++idx) {
+    OrientedBox &box = boxes[idx];
+    box.obstacleId = idx;
+    box.center = {side(rng), 5.0 * idx, 5.0 + side(rng) / 4.0};
+    box.halfExtents = {extent(rng), extent(rng), extent(rng)};
+    // Rotation about z, then about x: rows of its transpose
+    const double a = angle(rng), b = angle(rng);
+    box.toBox = {std::cos(a),  std::sin(a) * std::cos(b), std::sin(a) * std::sin(b),
+                 -std::sin(a), std::cos(a) * std::cos(b), std::cos(a) * std::sin(b),
+                 0.0,          -std::sin(b),              std::cos(b)};
+  }
+  return boxes;
+}
+
+/****************************************************
+* Courses
+*****************************************************/
+/**
+ * @brief Course heading north, a waypoint every 20 m, zig-zagging east and west, climbing and
+ *        descending. Waypoints are UCS: x east, y up, z north.
+ */
+inline std::vector<Waypoint> makeCourse(std::size_t waypointsNum, std::mt19937 &rng) {
+  std::uniform_real_distribution<double> east(-20.0, 20.0), up(5.0, 15.0);
+  std::vector<Waypoint> waypoints;
+  for (std::size_t idx = 0; idx < waypointsNum; ++idx) {
+    waypoints.emplace_back(east(rng), up(rng), 20.0 * idx);
+  }
+  return waypoints;
+}
+
+/****************************************************
+* Waypoint progression
+*****************************************************/
+constexpr double PROGRESSION_RATE_HZ = 50.0;
+constexpr double PROGRESSION_SPEED = 5.0;           // m/s
+constexpr double PROGRESSION_HOVER_S = 6.0;         // at every waypoint
+constexpr int PROGRESSION_ACCURACY = 2;             // m
+constexpr int PROGRESSION_PAUSING_TIME = 3;         // s
+constexpr double PROGRESSION_GUIDELINE_OFFSET = 1.5;
+
+/**
+ * @brief Behaviour of a simulated vehicle.
+ */
+struct Pilot {
+  const char *name;
+  double yawOffset;            // from the bearing to the next waypoint, deg
+  bool isGlitching;            // a fix 10 m away 0.5 s into every hover, then 1 s away from 1 s
+  std::uint32_t startTimeBootMs;
+  std::uint32_t expectedCompliantNum;
+  std::uint32_t expectedTransitionsNum;
+};
+
+/**
+ * @brief Position of a vehicle in the local frame with the telemetry it came with.
+ */
+struct FlightSample {
+  TelemetrySample telemetry;
+  double east;
+  double north;
+  double up;
+};
+
+/**
+ * @brief Zig-zag 25 m forward per waypoint, UCS x east, y up, z north.
+ */
+inline std::vector<Waypoint> makeZigZag(std::size_t waypointsNum, std::mt19937 &rng) {
+  std::uniform_real_distribution<double> east(-30.0, 30.0), up(5.0, 20.0);
+  std::vector<Waypoint> waypoints;
+  for (std::size_t idx = 0; idx < waypointsNum; ++idx) {
+    waypoints.emplace_back(east(rng), up(rng), 25.0 * idx);
+  }
+  return waypoints;
+}
+
+/**
+ * @brief Exercise captured at PROGRESSION_ACCURACY after PROGRESSION_PAUSING_TIME, every bearing
+ *        targeted.
+ */
+inline ExerciseInfo makeProgressionInfo() {
+  ExerciseInfo exerciseInfo{};
+  exerciseInfo.coordinatesSystem = CoorindatesSystem::UCS;
+  exerciseInfo.guidelineOffset = static_cast<float>(PROGRESSION_GUIDELINE_OFFSET);
+  exerciseInfo.accuracy = PROGRESSION_ACCURACY;
+  exerciseInfo.pausingTime = PROGRESSION_PAUSING_TIME;
+  exerciseInfo.targetBearings = -1;
+  return exerciseInfo;
+}
+
+/**
+ * @brief Vehicles on the bearing to the next waypoint, facing away from it, glitching during
+ *        hovers and with the boot clock wrapping around mid flight.
+ */
+inline std::array<Pilot, 4> makePilots(std::uint32_t waypointsNum) {
+  // Every waypoint is hovered at and captured, leaving for 1 s adds leaving and entering again
+  // The last waypoint has no bearing, so it's compliant whatever the heading
+  const std::uint32_t cleanTransitionsNum = 2 * waypointsNum;
+  return {{
+      {"on the bearing", 5.0, false, 1000, waypointsNum, cleanTransitionsNum},
+      {"facing away", 90.0, false, 1000, 1, cleanTransitionsNum},
+      {"glitching", -5.0, true, 1000, waypointsNum, cleanTransitionsNum + 2 * waypointsNum},
+      {"clock wrapping", 0.0, false, 0xFFFFFFFF - 60'000, waypointsNum, cleanTransitionsNum},
+  }};
+}
+
+/**
+ * @brief Fly every pilot, vehicle n+1 for pilots[n], through the waypoints at PROGRESSION_SPEED,
+ *        hovering PROGRESSION_HOVER_S at each, with 0.3 m of position noise.
+ * @return Samples of all vehicles interleaved, as the bus delivers them.
+ */
+inline std::vector<FlightSample> flyPilots(const std::vector<Waypoint> &waypoints, const LocalFrame &frame,
+                                           const std::array<Pilot, 4> &pilots, std::mt19937 &rng) {
+  constexpr double degToRad = std::numbers::pi / 180.0;
+  std::normal_distribution<double> noise(0.0, 0.3);
+  const std::size_t waypointsNum = waypoints.size();
+  std::vector<std::array<double, 3>> targets(waypointsNum);
+  for (std::size_t idx = 0; idx < waypointsNum; ++idx) {
+    frame.toEnu(waypoints[idx], CoorindatesSystem::UCS, targets[idx][0], targets[idx][1], targets[idx][2]);
+    targets[idx][2] += PROGRESSION_GUIDELINE_OFFSET;
+  }
+
+  std::vector<std::vector<FlightSample>> flights(pilots.size());
+  for (std::size_t pilotIdx = 0; pilotIdx < pilots.size(); ++pilotIdx) {
+    const Pilot &pilot = pilots[pilotIdx];
+    std::vector<FlightSample> &flight = flights[pilotIdx];
+    std::uint32_t timeBootMs = pilot.startTimeBootMs;
+    std::array<double, 3> position = {targets[0][0], targets[0][1] - 50.0, targets[0][2]};
+    auto addSample = [&](const std::array<double, 3> &at, double bearing) {
+      FlightSample sample;
+      sample.telemetry.systemId = static_cast<std::uint8_t>(pilotIdx + 1);
+      sample.telemetry.validFields = TelemetrySample::ATTITUDE | TelemetrySample::GLOBAL_POSITION;
+      sample.telemetry.globalPositionTimeBootMs = timeBootMs;
+      sample.telemetry.yaw = static_cast<float>(std::remainder(bearing + pilot.yawOffset, 360.0) * degToRad);
+      sample.east = at[0] + noise(rng);
+      sample.north = at[1] + noise(rng);
+      sample.up = at[2] + noise(rng);
+      flight.push_back(sample);
+      timeBootMs += static_cast<std::uint32_t>(1000.0 / PROGRESSION_RATE_HZ);
+    };
+    for (std::size_t idx = 0; idx < waypointsNum; ++idx) {
+      const std::array<double, 3> &target = targets[idx];
+      const double distance = std::hypot(target[0] - position[0], target[1] - position[1], target[2] - position[2]);
+      const double legBearing = std::atan2(target[0] - position[0], target[1] - position[1]) / degToRad;
+      const std::size_t legTicks = static_cast<std::size_t>(distance / PROGRESSION_SPEED * PROGRESSION_RATE_HZ);
+      for (std::size_t tick = 0; tick < legTicks; ++tick) {
+        const double fraction = static_cast<double>(tick) / legTicks;
+        addSample({position[0] + fraction * (target[0] - position[0]), position[1] + fraction * (target[1] - position[1]),
+                   position[2] + fraction * (target[2] - position[2])},
+                  legBearing);
+      }
+      const std::array<double, 3> &next = targets[std::min(idx + 1, waypointsNum - 1)];
+      const double nextBearing = std::atan2(next[0] - target[0], next[1] - target[1]) / degToRad;
+      for (std::size_t tick = 0; tick < static_cast<std::size_t>(PROGRESSION_HOVER_S * PROGRESSION_RATE_HZ); ++tick) {
+        const bool isGlitch = tick == static_cast<std::size_t>(PROGRESSION_RATE_HZ / 2) ||
+                              (tick >= static_cast<std::size_t>(PROGRESSION_RATE_HZ) &&
+                               tick < static_cast<std::size_t>(2 * PROGRESSION_RATE_HZ));
+        if (pilot.isGlitching && isGlitch) {
+          addSample({target[0] + 10.0, target[1], target[2]}, nextBearing);
+        } else {
+          addSample(target, nextBearing);
+        }
+      }
+      position = target;
+    }
+  }
+
+  std::vector<FlightSample> samples;
+  for (std::size_t tick = 0;; ++tick) {
+    bool isAnyLeft = false;
+    for (const std::vector<FlightSample> &flight : flights) {
+      if (tick < flight.size()) {
+        samples.push_back(flight[tick]);
+        isAnyLeft = true;
+      }
+    }
+    if (!isAnyLeft) {
+      break;
+    }
+  }
+  return samples;
+}
+
+/****************************************************
+* Sessions
+*****************************************************/
+constexpr std::size_t SESSION_VEHICLES_NUM = 6;
+constexpr std::uint32_t SESSION_RATE_HZ = 50;
+
+/**
+ * @brief Row idx of a session of SESSION_VEHICLES_NUM vehicles circling at SESSION_RATE_HZ.
+ */
+inline SessionRecorder::Row makeRow(std::size_t idx) {
+  SessionRecorder::Row row;
+  const std::uint32_t tick = static_cast<std::uint32_t>(idx / SESSION_VEHICLES_NUM);
+  const double phase = tick / static_cast<double>(SESSION_RATE_HZ) * 0.1;
+  row.hostTimeNs = static_cast<std::int64_t>(tick) * 1'000'000'000 / SESSION_RATE_HZ;
+  row.timeBootMs = tick * (1000 / SESSION_RATE_HZ);
+  row.vehicleId = static_cast<std::uint8_t>(idx % SESSION_VEHICLES_NUM + 1);
+  row.flags = SessionRecorder::FLAG_TIME_SYNCED | (tick % 500 == 0 ? SessionRecorder::FLAG_WAYPOINT_CAPTURED : 0);
+  row.east = static_cast<float>(50.0 * std::sin(phase) + row.vehicleId);
+  row.north = static_cast<float>(50.0 * std::cos(phase));
+  row.up = 10.0f;
+  row.yaw = static_cast<float>(phase);
+  row.distanceError = static_cast<float>(std::sin(7.0 * phase));
+  row.altitudeError = 0.5f * row.distanceError;
+  row.speedError = 0.1f;
+  row.segmentIdx = tick / 500;
+  row.progress = static_cast<float>(tick) * 0.1f;
+  row.clearance = 20.0f;
+  row.waypointIdx = static_cast<std::uint16_t>(tick / 500);
+  return row;
+}
+
+/**
+ * @brief Read a session file, checking its structure, and the time column against makeRow
+ *        if nothing was dropped.
+ * @return Rows number, or -1 if the file is malformed.
+ */
+inline long long readSession(const std::filesystem::path &path, std::uint64_t expectedDroppedNum) {
+  std::ifstream file(path, std::ios::binary);
+  auto read = [&file](auto &value) {
+    file.read(reinterpret_cast<char *>(&value), sizeof(value));
+  };
+  std::uint32_t magic;
+  std::uint16_t version, columnsNum;
+  read(magic);
+  read(version);
+  read(columnsNum);
+  if (!file || magic != SessionRecorder::FILE_MAGIC || version != SessionRecorder::FILE_VERSION ||
+      columnsNum != SessionRecorder::COLUMNS.size()) {
+    return -1;
+  }
+  std::vector<std::size_t> sizes;
+  for (std::size_t idx = 0; idx < columnsNum; ++idx) {
+    char descriptor[SessionRecorder::COLUMN_NAME_SIZE + 4];
+    file.read(descriptor, sizeof(descriptor));
+    if (std::strcmp(descriptor, SessionRecorder::COLUMNS[idx].name) != 0) {
+      return -1;
+    }
+    const std::size_t typeSizes[] = {1, 2, 4, 8, 4};
+    sizes.push_back(typeSizes[static_cast<std::uint8_t>(descriptor[SessionRecorder::COLUMN_NAME_SIZE])]);
+  }
+
+  std::uint64_t rowsNum = 0;
+  std::uint32_t rowGroupsNum = 0;
+  std::vector<std::int64_t> hostTimeNs;
+  while (true) {
+    read(magic);
+    if (!file || magic != SessionRecorder::ROW_GROUP_MAGIC) {
+      break;
+    }
+    std::uint32_t groupRowsNum;
+    read(groupRowsNum);
+    hostTimeNs.resize(groupRowsNum);
+    file.read(reinterpret_cast<char *>(hostTimeNs.data()), groupRowsNum * sizeof(std::int64_t));
+    for (std::uint32_t idx = 0; idx < groupRowsNum; ++idx) {
+      if (expectedDroppedNum == 0 && hostTimeNs[idx] != makeRow(rowsNum + idx).hostTimeNs) {
+        return -1;
+      }
+    }
+    std::size_t skipped = 0;
+    for (std::size_t idx = 1; idx < sizes.size(); ++idx) {
+      skipped += sizes[idx] * groupRowsNum;
+    }
+    file.seekg(static_cast<std::streamoff>(skipped), std::ios::cur);
+    rowsNum += groupRowsNum;
+    rowGroupsNum++;
+  }
+  std::uint32_t footerRowGroupsNum;
+  std::uint64_t footerRowsNum, droppedNum;
+  read(footerRowGroupsNum);
+  read(footerRowsNum);
+  read(droppedNum);
+  if (!file || magic != SessionRecorder::FOOTER_MAGIC || footerRowGroupsNum != rowGroupsNum ||
+      footerRowsNum != rowsNum || droppedNum != expectedDroppedNum) {
+    return -1;
+  }
+  return static_cast<long long>(rowsNum);
+}
+
+/****************************************************
+* Geodesy
+*****************************************************/
+struct Positions {
+  std::vector<std::int32_t> latE7, lonE7, altMm;
+  std::vector<double> east, north, up;  // reference
+};
+
+/**
+ * @brief Textbook conversion: ECEF of both points, difference rotated into ENU of the origin.
+ */
+inline void referenceToEnu(std::int32_t latE7, std::int32_t lonE7, std::int32_t altMm,
+                           double &east, double &north, double &up) {
+  using Real = long double;
+  const Real f = 1.0L / 298.257223563L;
+  const Real e2 = f * (2.0L - f);
+  const Real degToRad = std::numbers::pi_v<Real> / 180.0L;
+  auto toEcef = [&](Real lat, Real lon, Real alt, Real &x, Real &y, Real &z) {
+    const Real n = 6378137.0L / std::sqrt(1.0L - e2 * std::sin(lat) * std::sin(lat));
+    x = (n + alt) * std::cos(lat) * std::cos(lon);
+    y = (n + alt) * std::cos(lat) * std::sin(lon);
+    z = (n * (1.0L - e2) + alt) * std::sin(lat);
+  };
+  const Real lat0 = ORIGIN.latitude * degToRad;
+  const Real lon0 = ORIGIN.longitude * degToRad;
+  Real x0, y0, z0, x, y, z;
+  toEcef(lat0, lon0, ORIGIN.altitude, x0, y0, z0);
+  toEcef(latE7 * 1E-7L * degToRad, lonE7 * 1E-7L * degToRad, altMm * 1E-3L, x, y, z);
+  const Real dx = x - x0, dy = y - y0, dz = z - z0;
+  east = static_cast<double>(-std::sin(lon0) * dx + std::cos(lon0) * dy);
+  north = static_cast<double>(-std::sin(lat0) * std::cos(lon0) * dx -
+                              std::sin(lat0) * std::sin(lon0) * dy + std::cos(lat0) * dz);
+  up = static_cast<double>(std::cos(lat0) * std::cos(lon0) * dx +
+                           std::cos(lat0) * std::sin(lon0) * dy + std::sin(lat0) * dz);
+}
+
+/**
+ * @brief Positions uniformly within the radius and up to 120 m above the operator.
+ */
+inline Positions makePositions(double radius, std::size_t positionsNum, std::mt19937 &rng) {
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  const double sinLat = std::sin(ORIGIN.latitude * geodesy::DEG_TO_RAD);
+  const double metresPerDegLat = geodesy::meridionalRadius(sinLat) * geodesy::DEG_TO_RAD;
+  const double metresPerDegLon = geodesy::primeVerticalRadius(sinLat) *
+                                 std::cos(ORIGIN.latitude * geodesy::DEG_TO_RAD) * geodesy::DEG_TO_RAD;
+  Positions positions;
+  positions.latE7.resize(positionsNum);
+  positions.lonE7.resize(positionsNum);
+  positions.altMm.resize(positionsNum);
+  positions.east.resize(positionsNum);
+  positions.north.resize(positionsNum);
+  positions.up.resize(positionsNum);
+  for (std::size_t idx = 0; idx < positionsNum; ++idx) {
+    const double distance = radius * std::sqrt(unit(rng));
+    const double bearing = 2.0 * std::numbers::pi * unit(rng);
+    positions.latE7[idx] = static_cast<std::int32_t>(
+        std::lround((ORIGIN.latitude + distance * std::cos(bearing) / metresPerDegLat) * 1E7));
+    positions.lonE7[idx] = static_cast<std::int32_t>(
+        std::lround((ORIGIN.longitude + distance * std::sin(bearing) / metresPerDegLon) * 1E7));
+    positions.altMm[idx] = static_cast<std::int32_t>(std::lround((ORIGIN.altitude + 120.0 * unit(rng)) * 1E3));
+    referenceToEnu(positions.latE7[idx], positions.lonE7[idx], positions.altMm[idx], positions.east[idx],
+                   positions.north[idx], positions.up[idx]);
+  }
+  return positions;
+}
+
+/****************************************************
+* Exercises
+*****************************************************/
+constexpr std::size_t EXERCISE_WAYPOINTS_NUM = 40;
+
+/**
+ * @brief Zigzag of 50 m legs, scored by RMSE at 5 m/s, through a gate of two poles in the
+ *        middle of each of the first gatesNum legs. UCS x right, y up, z forward.
+ */
+inline configuration::FlightConfig makeExercise(std::size_t gatesNum) {
+  std::vector<Waypoint> waypoints;
+  std::vector<Obstackle> obstacles;
+  for (std::size_t idx = 0; idx < EXERCISE_WAYPOINTS_NUM; ++idx) {
+    waypoints.emplace_back(idx % 2 == 0 ? -20.0 : 20.0, 10.0 + idx % 3, 30.0 * idx);
+  }
+  for (std::size_t idx = 0; idx < gatesNum; ++idx) {
+    obstacles.emplace_back(-4.0, 5.0, 30.0 * idx + 15.0, 0.5, 0.5, 10.0, 0.0, 0.0, 0.0);
+    obstacles.emplace_back(4.0, 5.0, 30.0 * idx + 15.0, 0.5, 0.5, 10.0, 0.0, 0.0, 0.0);
+  }
+  ExerciseInfo exerciseInfo{};
+  exerciseInfo.coordinatesSystem = CoorindatesSystem::UCS;
+  exerciseInfo.altitudeDifference = AltitudeDifference::DEFAULT;
+  exerciseInfo.distanceWeight = 2;
+  exerciseInfo.altitudeWeight = 1;
+  exerciseInfo.speedWeight = 1;
+  exerciseInfo.targetSpeed = 5.0f;
+  exerciseInfo.scoringMethod = ScoringMethod::RMSE;
+  return configuration::FlightConfig(ORIGIN, std::move(waypoints), {}, std::move(obstacles), exerciseInfo,
+                                     ConnectionConfigurationInfo());
+}
+
+/**
+ * @brief Vehicles flying the middle of the makeExercise zigzag with noise, a tick of all
+ *        vehicles at a time, positions in GPS as the receiver publishes them.
+ */
+inline std::vector<TelemetrySample> makeSamples(std::size_t vehiclesNum, double rateHz, double durationS) {
+  constexpr double metresPerDegLat = 111319.49;
+  std::mt19937 rng(42);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  const double metresPerDegLon = metresPerDegLat * std::cos(ORIGIN.latitude * std::numbers::pi / 180.0);
+  const std::size_t ticksNum = static_cast<std::size_t>(durationS * rateHz);
+  std::vector<TelemetrySample> samples(ticksNum * vehiclesNum);
+  for (std::size_t tick = 0; tick < ticksNum; ++tick) {
+    const double along = std::fmod(5.0 * tick / rateHz, 30.0 * (EXERCISE_WAYPOINTS_NUM - 1));
+    for (std::size_t vehicle = 0; vehicle < vehiclesNum; ++vehicle) {
+      TelemetrySample &sample = samples[tick * vehiclesNum + vehicle];
+      sample.systemId = static_cast<std::uint8_t>(vehicle + 1);
+      sample.validFields = sample.updatedFields = TelemetrySample::GLOBAL_POSITION;
+      sample.globalPositionTimeBootMs = static_cast<std::uint32_t>(tick * 1000 / rateHz);
+      sample.latE7 = static_cast<std::int32_t>(std::lround((ORIGIN.latitude + (along + noise(rng)) / metresPerDegLat) * 1E7));
+      sample.lonE7 = static_cast<std::int32_t>(std::lround((ORIGIN.longitude + noise(rng) / metresPerDegLon) * 1E7));
+      sample.altMm = static_cast<std::int32_t>(std::lround((ORIGIN.altitude + 11.0 + 0.5 * noise(rng)) * 1E3));
+      sample.velocityNorth = static_cast<float>(5.0 + 0.3 * noise(rng));
+    }
+  }
+  return samples;
+}
+
+} // namespace fixtures
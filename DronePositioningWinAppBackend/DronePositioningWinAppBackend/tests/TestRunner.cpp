@@ -0,0 +1,75 @@
+/**
+ * @file TestRunner.cpp
+ * @brief Entry point of the test project.
+ *
+ * @details This file contains the main function running every suite declared in TestRunner.h and
+ *          reporting failed checks. It exits with a failure if any check failed or a suite threw,
+ *          so running it after the build fails the build.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iterator>
+
+#include "TestRunner.h"
+
+
+namespace {
+
+std::size_t failuresNum = 0;
+
+struct Suite {
+  const char *name;
+  void (*run)();
+};
+
+constexpr Suite SUITES[] = {
+    {"DeltaCodec", tests::testDeltaCodec},
+    {"Geodesy", tests::testGeodesy},
+    {"GuidelineTracker", tests::testGuidelineTracker},
+    {"ObstacleBoxes", tests::testObstacleBoxes},
+    {"ObstacleIndex", tests::testObstacleIndex},
+    {"PoseExtrapolator", tests::testPoseExtrapolator},
+    {"ProcessingPipeline", tests::testProcessingPipeline},
+    {"ScoringEngine", tests::testScoringEngine},
+    {"SessionRecorder", tests::testSessionRecorder},
+    {"TelemetryDecoder", tests::testTelemetryDecoder},
+    {"WaypointProgression", tests::testWaypointProgression},
+};
+
+} // namespace
+
+void tests::fail(const char *expression, const char *file, int line) {
+  std::printf("  %s:%d: CHECK(%s) failed\n", file, line, expression);
+  failuresNum++;
+}
+
+std::size_t tests::getFailuresNum() { return failuresNum; }
+
+int main() {
+  std::size_t failedSuitesNum = 0;
+  for (const Suite &suite : SUITES) {
+    std::printf("%s\n", suite.name);
+    const std::size_t previousFailuresNum = failuresNum;
+    try {
+      suite.run();
+    } catch (const std::exception &err) {
+      std::printf("  threw: %s\n", err.what());
+      failuresNum++;
+    }
+    failedSuitesNum += failuresNum != previousFailuresNum;
+  }
+  std::printf("%zu of %zu suites passed, %zu failed checks\n", std::size(SUITES) - failedSuitesNum,
+              std::size(SUITES), failuresNum);
+  return failuresNum == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
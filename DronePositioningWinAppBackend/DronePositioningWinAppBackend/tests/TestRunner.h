@@ -0,0 +1,57 @@
+/**
+ * @file TestRunner.h
+ * @brief Checks of the test project.
+ *
+ * @details This file contains the declarations of the test suites run by TestRunner.cpp, each
+ *          defined in tests/test<Component>.cpp, and the CHECK macro. A failed check is reported
+ *          with its expression and location, and the suite carries on. Suites only check
+ *          behaviour; timing is left to the standalone benchmarks in tests/bench*.cpp.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+
+
+namespace tests {
+
+/**
+ * @brief Report a failed check.
+ * @param expression: text of the checked expression.
+ * @param file: source file of the check.
+ * @param line: line of the check.
+ */
+void fail(const char *expression, const char *file, int line);
+
+/**
+ * @brief Get the number of failed checks so far.
+ */
+std::size_t getFailuresNum();
+
+/****************************************************
+* Suites
+*****************************************************/
+void testDeltaCodec();
+void testGeodesy();
+void testGuidelineTracker();
+void testObstacleBoxes();
+void testObstacleIndex();
+void testPoseExtrapolator();
+void testProcessingPipeline();
+void testScoringEngine();
+void testSessionRecorder();
+void testTelemetryDecoder();
+void testWaypointProgression();
+
+} // namespace tests
+
+#define CHECK(condition) ((condition) ? static_cast<void>(0) : ::tests::fail(#condition, __FILE__, __LINE__))
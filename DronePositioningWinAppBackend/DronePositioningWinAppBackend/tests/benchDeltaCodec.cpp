@@ -0,0 +1,136 @@
+/**
+ * @file benchDeltaCodec.cpp
+ * @brief Benchmark of telemetry wire formats.
+ *
+ * @details This file contains a standalone benchmark comparing bytes per sample and encoding time
+ *          of the text, binary and delta wire formats on a synthetic 50 Hz flight. It also checks that
+ *          delta packets of interleaved vehicles decode to the quantised samples, how many samples
+ *          survive packet loss, and that a delta whose keyframe was lost is skipped without losing
+ *          the packet after it in the same datagram.
+ *          Build from the project directory, e.g.:
+ *            g++ -std=c++20 -O2 -Iexternal/c_library_v2 tests/benchDeltaCodec.cpp src/DeltaCodec.cpp src/TelemetryPacket.cpp
+ *            cl /std:c++20 /O2 /EHsc /Iexternal\c_library_v2 tests\benchDeltaCodec.cpp src\DeltaCodec.cpp src\TelemetryPacket.cpp
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "../include/DeltaCodec.h"
+#include "../include/TelemetryPacket.h"
+#include "TestFixtures.h"
+
+
+namespace {
+
+constexpr std::size_t SAMPLES_NUM = 200'000;
+constexpr double LOSS_RATE = 0.05;
+constexpr std::size_t VEHICLES_NUM = 8;
+
+template <typename Encode>
+void bench(const char *name, const std::vector<TelemetrySample> &samples, Encode encode) {
+  std::uint8_t buffer[wire::MAX_TEXT_PACKET_SIZE];
+  std::size_t bytes = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t idx = 0; idx < samples.size(); ++idx) {
+    bytes += encode(samples[idx], static_cast<std::uint32_t>(idx), buffer);
+  }
+  const double elapsedNs =
+      std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  std::printf("%-8s %6.1f B/sample %8.1f ns/sample\n", name,
+              static_cast<double>(bytes) / samples.size(), elapsedNs / samples.size());
+}
+
+} // namespace
+
+int main() {
+  const std::vector<TelemetrySample> samples = fixtures::makeFlight(SAMPLES_NUM);
+
+  bench("text", samples, [](const TelemetrySample &sample, std::uint32_t, std::uint8_t *buffer) {
+    return wire::serializeText(sample, reinterpret_cast<char *>(buffer));
+  });
+  bench("binary", samples, [](const TelemetrySample &sample, std::uint32_t sequence, std::uint8_t *buffer) {
+    return wire::serializeBinary(sample, sequence, sample.attitudeHostTimeNs + 30'000'000, buffer);
+  });
+  wire::DeltaEncoder encoder;
+  bench("delta", samples, [&encoder](const TelemetrySample &sample, std::uint32_t sequence, std::uint8_t *buffer) {
+    return encoder.encode(sample, sequence, sample.attitudeHostTimeNs + 30'000'000, buffer);
+  });
+
+  // Round trip with loss, vehicles sharing the sequence: every decoded sample must equal the
+  // quantised one and packets are either decoded or skipped for their keyframe, never malformed
+  wire::DeltaEncoder lossyEncoder;
+  wire::DeltaDecoder decoder;
+  std::mt19937 rng(7);
+  std::bernoulli_distribution isLost(LOSS_RATE);
+  std::size_t receivedNum = 0;
+  std::size_t decodedNum = 0;
+  std::size_t keyframeMissingNum = 0;
+  std::size_t mismatchesNum = 0;
+  std::uint8_t buffer[2 * wire::MAX_DELTA_PACKET_SIZE];
+  for (std::size_t idx = 0; idx < samples.size(); ++idx) {
+    TelemetrySample sample = samples[idx];
+    sample.systemId = static_cast<std::uint8_t>(idx % VEHICLES_NUM + 1);
+    const std::size_t size = lossyEncoder.encode(sample, static_cast<std::uint32_t>(idx),
+                                                 sample.attitudeHostTimeNs, buffer);
+    if (isLost(rng)) {
+      continue;
+    }
+    receivedNum++;
+    std::uint8_t vehicleId;
+    wire::QuantisedSample decoded;
+    const wire::DeltaResult result = decoder.decode(buffer, size, vehicleId, decoded);
+    if (result.consumedNum != size) {
+      mismatchesNum++;
+      continue;
+    }
+    if (result.status == wire::DeltaStatus::KEYFRAME_MISSING) {
+      keyframeMissingNum++;
+      continue;
+    }
+    decodedNum++;
+    const wire::QuantisedSample expected = wire::DeltaEncoder::quantise(sample);
+    // Timestamps of deltas have microsecond resolution
+    if (vehicleId != sample.systemId || decoded.values != expected.values ||
+        decoded.validFields != expected.validFields ||
+        std::llabs(decoded.timestampNs - expected.timestampNs) >= 1000) {
+      mismatchesNum++;
+    }
+  }
+  std::printf("%.0f %% loss, %zu vehicles: %zu received, %zu decoded (%.2f %%), %zu without keyframe, "
+              "%zu mismatches\n",
+              LOSS_RATE * 100, VEHICLES_NUM, receivedNum, decodedNum, 100.0 * decodedNum / receivedNum,
+              keyframeMissingNum, mismatchesNum);
+
+  // A delta of a vehicle whose keyframe was lost, coalesced with a keyframe of another one
+  wire::DeltaEncoder coalescingEncoder;
+  wire::DeltaDecoder coalescedDecoder;
+  TelemetrySample first = samples[0];
+  TelemetrySample second = samples[1];
+  second.systemId = 2;
+  coalescingEncoder.encode(first, 0, first.attitudeHostTimeNs, buffer); // lost keyframe
+  std::size_t size = coalescingEncoder.encode(samples[2], 1, samples[2].attitudeHostTimeNs, buffer);
+  size += coalescingEncoder.encode(second, 2, second.attitudeHostTimeNs, buffer + size);
+  std::uint8_t vehicleId;
+  wire::QuantisedSample decoded;
+  const wire::DeltaResult skipped = coalescedDecoder.decode(buffer, size, vehicleId, decoded);
+  const wire::DeltaResult next = coalescedDecoder.decode(buffer + skipped.consumedNum, size - skipped.consumedNum,
+                                                         vehicleId, decoded);
+  const bool isSkipped = skipped.status == wire::DeltaStatus::KEYFRAME_MISSING &&
+                         next.status == wire::DeltaStatus::DECODED && vehicleId == 2 &&
+                         skipped.consumedNum + next.consumedNum == size &&
+                         decoded.values == wire::DeltaEncoder::quantise(second).values;
+  std::printf("coalesced delta without keyframe: %s\n", isSkipped ? "skipped alone" : "UNEXPECTED");
+  return mismatchesNum == 0 && isSkipped ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file benchGeodesy.cpp
+ * @brief Benchmark of the speed and accuracy of geodesy methods.
+ *
+ * @details This file contains a standalone benchmark converting positions scattered within the
+ *          exercise radius of the operator with every method of Geodesy.h and LocalFrame, single
+ *          and batched, and reporting the time per position and the largest error against the
+ *          textbook geodetic->ECEF->ENU conversion evaluated in long double. Horizontal errors
+ *          are of the position, or of the distance from the operator for haversine.
+ *          Build from the project directory, e.g.:
+ *            g++ -std=c++20 -O2 -Iexternal/c_library_v2 tests/benchGeodesy.cpp src/LocalFrame.cpp
+ *            cl /std:c++20 /O2 /EHsc /Iexternal\c_library_v2 tests\benchGeodesy.cpp src\LocalFrame.cpp
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "../include/Geodesy.h"
+#include "../include/LocalFrame.h"
+#include "TestFixtures.h"
+
+
+namespace {
+
+constexpr std::size_t POSITIONS_NUM = 1'000'000;
+constexpr std::size_t REPEATS_NUM = 10;
+
+template <typename Convert>
+double timeNs(Convert convert) {
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t repeat = 0; repeat < REPEATS_NUM; ++repeat) {
+    convert();
+  }
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+         (REPEATS_NUM * POSITIONS_NUM);
+}
+
+void report(const char *method, double singleNs, double batchNs, double horizontalError, double verticalError) {
+  std::printf("  %-24s %6.1f ns single, %6.1f ns batched, max error %.2e m horizontal, ", method, singleNs,
+              batchNs, horizontalError);
+  if (verticalError >= 0.0) {
+    std::printf("%.2e m vertical\n", verticalError);
+  } else {
+    std::printf("no vertical\n");
+  }
+}
+
+} // namespace
+
+int main() {
+  std::mt19937 rng(42);
+  const LocalFrame localFrame(fixtures::ORIGIN);
+  const geodesy::EcefFrame ecefFrame(fixtures::ORIGIN);
+  const geodesy::TangentPlane tangentPlane(fixtures::ORIGIN);
+  std::vector<double> east(POSITIONS_NUM), north(POSITIONS_NUM), up(POSITIONS_NUM);
+  std::vector<double> batchEast(POSITIONS_NUM), batchNorth(POSITIONS_NUM), batchUp(POSITIONS_NUM);
+  int status = 0;
+
+  for (const double radius : {1000.0, 5000.0}) {
+    const fixtures::Positions positions = fixtures::makePositions(radius, POSITIONS_NUM, rng);
+    const std::int32_t *latE7 = positions.latE7.data();
+    const std::int32_t *lonE7 = positions.lonE7.data();
+    const std::int32_t *altMm = positions.altMm.data();
+    std::printf("%.0f m around the operator:\n", radius);
+
+    // Errors of single conversions, batched ones must give the same positions
+    auto measure = [&](const char *method, auto single, auto batch) {
+      const double singleNs = timeNs([&]() {
+        for (std::size_t idx = 0; idx < POSITIONS_NUM; ++idx) {
+          const geodesy::Enu enu = single(latE7[idx], lonE7[idx], altMm[idx]);
+          east[idx] = enu.east;
+          north[idx] = enu.north;
+          up[idx] = enu.up;
+        }
+      });
+      const double batchNs = timeNs([&]() {
+        batch(latE7, lonE7, altMm, POSITIONS_NUM, batchEast.data(), batchNorth.data(), batchUp.data());
+      });
+      double horizontalError = 0.0, verticalError = 0.0, batchDifference = 0.0;
+      for (std::size_t idx = 0; idx < POSITIONS_NUM; ++idx) {
+        horizontalError = std::max(horizontalError, std::hypot(east[idx] - positions.east[idx],
+                                                               north[idx] - positions.north[idx]));
+        verticalError = std::max(verticalError, std::abs(up[idx] - positions.up[idx]));
+        batchDifference = std::max({batchDifference, std::abs(batchEast[idx] - east[idx]),
+                                    std::abs(batchNorth[idx] - north[idx]), std::abs(batchUp[idx] - up[idx])});
+      }
+      report(method, singleNs, batchNs, horizontalError, verticalError);
+      status |= batchDifference < 1E-6 ? 0 : 1;
+    };
+
+    measure(
+        "ECEF->ENU", [&](std::int32_t lat, std::int32_t lon, std::int32_t alt) { return ecefFrame.toEnu(lat, lon, alt); },
+        [&](auto... args) { ecefFrame.toEnu(args...); });
+    measure(
+        "LocalFrame",
+        [&](std::int32_t lat, std::int32_t lon, std::int32_t alt) {
+          geodesy::Enu enu;
+          localFrame.toEnu(lat, lon, alt, enu.east, enu.north, enu.up);
+          return enu;
+        },
+        [&](auto... args) { localFrame.toEnu(args...); });
+    measure(
+        "tangent plane, 2nd order",
+        [&](std::int32_t lat, std::int32_t lon, std::int32_t alt) { return tangentPlane.toEnuCurved(lat, lon, alt); },
+        [&](auto... args) { tangentPlane.toEnuCurved(args...); });
+    measure(
+        "tangent plane, flat", [&](std::int32_t lat, std::int32_t lon, std::int32_t alt) { return tangentPlane.toEnu(lat, lon, alt); },
+        [&](auto... args) { tangentPlane.toEnu(args...); });
+
+    // Haversine only gives the distance from the operator
+    std::vector<double> &distances = east;
+    std::vector<double> &batchDistances = batchEast;
+    const double origin[2] = {fixtures::ORIGIN.latitude * geodesy::DEG_TO_RAD,
+                              fixtures::ORIGIN.longitude * geodesy::DEG_TO_RAD};
+    const double singleNs = timeNs([&]() {
+      for (std::size_t idx = 0; idx < POSITIONS_NUM; ++idx) {
+        distances[idx] = geodesy::haversineDistance(origin[0], origin[1], latE7[idx] * geodesy::DEG_E7_TO_RAD,
+                                                    lonE7[idx] * geodesy::DEG_E7_TO_RAD);
+      }
+    });
+    const double batchNs = timeNs([&]() { geodesy::haversineDistances(fixtures::ORIGIN, latE7, lonE7, POSITIONS_NUM, batchDistances.data()); });
+    double distanceError = 0.0, batchDifference = 0.0;
+    for (std::size_t idx = 0; idx < POSITIONS_NUM; ++idx) {
+      distanceError = std::max(distanceError,
+                               std::abs(distances[idx] - std::hypot(positions.east[idx], positions.north[idx])));
+      batchDifference = std::max(batchDifference, std::abs(batchDistances[idx] - distances[idx]));
+    }
+    report("haversine", singleNs, batchNs, distanceError, -1.0);
+    status |= batchDifference < 1E-6 ? 0 : 1;
+  }
+  return status;
+}
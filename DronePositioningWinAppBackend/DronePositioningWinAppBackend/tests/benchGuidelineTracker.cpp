@@ -0,0 +1,114 @@
+/**
+ * @file benchGuidelineTracker.cpp
+ * @brief Benchmark of tracking vehicles along the guideline.
+ *
+ * @details This file contains a standalone benchmark flying a simulated vehicle along generated
+ *          guidelines of growing length, with noise and occasional jumps to another part of the
+ *          course, and comparing GuidelineTracker::track with a search of all segments, which
+ *          must give the same projections.
+ *          Build from the project directory, e.g.:
+ *            g++ -std=c++20 -O2 -Iexternal/c_library_v2 tests/benchGuidelineTracker.cpp src/GuidelineTracker.cpp src/LocalFrame.cpp
+ *            cl /std:c++20 /O2 /EHsc /Iexternal\c_library_v2 tests\benchGuidelineTracker.cpp src\GuidelineTracker.cpp src\LocalFrame.cpp
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../include/GuidelineTracker.h"
+#include "TestFixtures.h"
+
+
+namespace {
+
+constexpr std::size_t SAMPLES_NUM = 200'000;
+constexpr double STEP = 0.2;                  // m, 10 m/s at 50 Hz
+constexpr std::size_t JUMP_INTERVAL = 20'000; // samples between jumps along the course
+
+double elapsedNs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / SAMPLES_NUM;
+}
+
+} // namespace
+
+int main() {
+  const LocalFrame frame(fixtures::ORIGIN);
+  std::mt19937 rng(42);
+  int status = 0;
+
+  for (const std::size_t waypointsNum : {10, 100, 1000, 10000}) {
+    const std::vector<Waypoint> waypoints = fixtures::makeCourse(waypointsNum, rng);
+    const GuidelineTracker guideline(waypoints, frame, CoorindatesSystem::UCS, 2.0);
+
+    // Flight along the guideline with a few metres of noise, looping over the course
+    std::vector<std::array<double, 3>> vertices(waypoints.size());
+    for (std::size_t idx = 0; idx < waypoints.size(); ++idx) {
+      frame.toEnu(waypoints[idx], CoorindatesSystem::UCS, vertices[idx][0], vertices[idx][1], vertices[idx][2]);
+    }
+    std::normal_distribution<double> noise(0.0, 2.0);
+    std::uniform_int_distribution<std::size_t> jumpSegment(0, waypoints.size() - 2);
+    std::vector<std::array<double, 3>> positions(SAMPLES_NUM);
+    std::size_t segmentIdx = 0;
+    double fraction = 0.0;
+    for (std::size_t idx = 0; idx < SAMPLES_NUM; ++idx) {
+      if (idx % JUMP_INTERVAL == JUMP_INTERVAL - 1) {
+        segmentIdx = jumpSegment(rng);
+      }
+      const std::array<double, 3> &start = vertices[segmentIdx];
+      const std::array<double, 3> &end = vertices[segmentIdx + 1];
+      const double length = std::hypot(end[0] - start[0], end[1] - start[1], end[2] - start[2]);
+      positions[idx] = {start[0] + fraction * (end[0] - start[0]) + noise(rng),
+                        start[1] + fraction * (end[1] - start[1]) + noise(rng),
+                        start[2] + fraction * (end[2] - start[2]) + noise(rng)};
+      fraction += STEP / length;
+      if (fraction >= 1.0) {
+        fraction = 0.0;
+        segmentIdx = (segmentIdx + 1) % (waypoints.size() - 1);
+      }
+    }
+
+    std::vector<GuidelineTracker::Projection> tracked(SAMPLES_NUM);
+    GuidelineTracker::Cursor cursor;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < SAMPLES_NUM; ++idx) {
+      tracked[idx] = guideline.track(cursor, positions[idx][0], positions[idx][1], positions[idx][2]);
+    }
+    const double trackNs = elapsedNs(start);
+
+    std::vector<GuidelineTracker::Projection> searched(SAMPLES_NUM);
+    start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < SAMPLES_NUM; ++idx) {
+      searched[idx] = guideline.findClosest(positions[idx][0], positions[idx][1], positions[idx][2]);
+    }
+    const double searchNs = elapsedNs(start);
+
+    std::size_t differentNum = 0;
+    double maxDistanceDifference = 0.0;
+    for (std::size_t idx = 0; idx < SAMPLES_NUM; ++idx) {
+      differentNum += tracked[idx].segmentIdx != searched[idx].segmentIdx ||
+                      tracked[idx].distance != searched[idx].distance ||
+                      tracked[idx].progress != searched[idx].progress;
+      maxDistanceDifference =
+          std::max(maxDistanceDifference, tracked[idx].distance - searched[idx].distance);
+    }
+    std::printf("%5zu waypoints (%6.1f km): tracked %5.1f ns, full search %8.1f ns per sample, "
+                "%zu different, max %.3f m further\n",
+                waypointsNum, guideline.getLength() / 1E3, trackNs, searchNs, differentNum,
+                maxDistanceDifference);
+    status |= differentNum == 0 ? 0 : 1;
+  }
+  return status;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file benchLocalFrame.cpp
+ * @brief Benchmark of the conversion of GPS positions into the local frame.
+ *
+ * @details This file contains a standalone benchmark comparing the scalar and batched LocalFrame
+ *          conversions of positions scattered around the operator, and checking both against
+ *          the textbook geodetic->ECEF->ENU conversion evaluated in long double.
+ *          Build from the project directory, e.g.:
+ *            g++ -std=c++20 -O2 tests/benchLocalFrame.cpp src/LocalFrame.cpp
+ *            cl /std:c++20 /O2 /EHsc tests\benchLocalFrame.cpp src\LocalFrame.cpp
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "../include/LocalFrame.h"
+
+
+namespace {
+
+constexpr std::size_t POSITIONS_NUM = 1'000'000;
+constexpr std::size_t REPEATS_NUM = 20;
+const OperatorPosition ORIGIN(53.009779233998756, 20.92659215232849, 140.0);
+
+/**
+ * @brief Textbook conversion: ECEF of both points, difference rotated into ENU of the origin.
+ */
+void referenceToEnu(std::int32_t latE7, std::int32_t lonE7, std::int32_t altMm,
+                    double &east, double &north, double &up) {
+  using Real = long double;
+  const Real f = 1.0L / 298.257223563L;
+  const Real e2 = f * (2.0L - f);
+  const Real degToRad = std::numbers::pi_v<Real> / 180.0L;
+  auto toEcef = [&](Real lat, Real lon, Real alt, Real &x, Real &y, Real &z) {
+    const Real n = 6378137.0L / std::sqrt(1.0L - e2 * std::sin(lat) * std::sin(lat));
+    x = (n + alt) * std::cos(lat) * std::cos(lon);
+    y = (n + alt) * std::cos(lat) * std::sin(lon);
+    z = (n * (1.0L - e2) + alt) * std::sin(lat);
+  };
+  const Real lat0 = ORIGIN.latitude * degToRad;
+  const Real lon0 = ORIGIN.longitude * degToRad;
+  Real x0, y0, z0, x, y, z;
+  toEcef(lat0, lon0, ORIGIN.altitude, x0, y0, z0);
+  toEcef(latE7 * 1E-7L * degToRad, lonE7 * 1E-7L * degToRad, altMm * 1E-3L, x, y, z);
+  const Real dx = x - x0, dy = y - y0, dz = z - z0;
+  east = static_cast<double>(-std::sin(lon0) * dx + std::cos(lon0) * dy);
+  north = static_cast<double>(-std::sin(lat0) * std::cos(lon0) * dx -
+                              std::sin(lat0) * std::sin(lon0) * dy + std::cos(lat0) * dz);
+  up = static_cast<double>(std::cos(lat0) * std::cos(lon0) * dx +
+                           std::cos(lat0) * std::sin(lon0) * dy + std::sin(lat0) * dz);
+}
+
+} // namespace
+
+int main() {
+  // Positions within 5 km and 500 m of height of the operator, a few far ones take the scalar path
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> offset(-1.0, 1.0);
+  std::vector<std::int32_t> latE7(POSITIONS_NUM), lonE7(POSITIONS_NUM), altMm(POSITIONS_NUM);
+  for (std::size_t idx = 0; idx < POSITIONS_NUM; ++idx) {
+    const double range = idx % 1000 == 0 ? 5.0 : 0.045; // deg
+    latE7[idx] = static_cast<std::int32_t>(std::lround((ORIGIN.latitude + range * offset(rng)) * 1E7));
+    lonE7[idx] = static_cast<std::int32_t>(std::lround((ORIGIN.longitude + range * offset(rng)) * 1E7));
+    altMm[idx] = static_cast<std::int32_t>(std::lround((ORIGIN.altitude + 500.0 * offset(rng)) * 1E3));
+  }
+
+  const LocalFrame frame(ORIGIN);
+  std::vector<double> scalarEast(POSITIONS_NUM), scalarNorth(POSITIONS_NUM), scalarUp(POSITIONS_NUM);
+  std::vector<double> east(POSITIONS_NUM), north(POSITIONS_NUM), up(POSITIONS_NUM);
+
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t repeat = 0; repeat < REPEATS_NUM; ++repeat) {
+    for (std::size_t idx = 0; idx < POSITIONS_NUM; ++idx) {
+      frame.toEnu(latE7[idx], lonE7[idx], altMm[idx], scalarEast[idx], scalarNorth[idx], scalarUp[idx]);
+    }
+  }
+  const double scalarNs =
+      std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+      (REPEATS_NUM * POSITIONS_NUM);
+
+  start = std::chrono::steady_clock::now();
+  for (std::size_t repeat = 0; repeat < REPEATS_NUM; ++repeat) {
+    frame.toEnu(latE7.data(), lonE7.data(), altMm.data(), POSITIONS_NUM, east.data(), north.data(), up.data());
+  }
+  const double batchNs =
+      std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+      (REPEATS_NUM * POSITIONS_NUM);
+
+  double maxBatchDiff = 0.0, maxReferenceDiff = 0.0;
+  for (std::size_t idx = 0; idx < POSITIONS_NUM; ++idx) {
+    maxBatchDiff = std::max({maxBatchDiff, std::abs(east[idx] - scalarEast[idx]),
+                             std::abs(north[idx] - scalarNorth[idx]), std::abs(up[idx] - scalarUp[idx])});
+    double refEast, refNorth, refUp;
+    referenceToEnu(latE7[idx], lonE7[idx], altMm[idx], refEast, refNorth, refUp);
+    maxReferenceDiff = std::max({maxReferenceDiff, std::abs(east[idx] - refEast),
+                                 std::abs(north[idx] - refNorth), std::abs(up[idx] - refUp)});
+  }
+
+  std::printf("scalar  %6.1f ns/position\n", scalarNs);
+  std::printf("batched %6.1f ns/position\n", batchNs);
+  std::printf("max |batched - scalar|    %.3g m\n", maxBatchDiff);
+  std::printf("max |batched - reference| %.3g m\n", maxReferenceDiff);
+  return maxReferenceDiff < 1E-6 ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file benchObstacleBoxes.cpp
+ * @brief Benchmark of the SIMD kernels testing positions against oriented boxes.
+ *
+ * @details This file contains a standalone benchmark comparing containment tests of positions
+ *          against all boxes of a generated course: box by box with OrientedBox, by blocks of
+ *          ObstacleBoxes one position at a time and as a batch. Distances of the kernels must be
+ *          bit-identical to OrientedBox::signedDistance and all paths must find the same boxes.
+ *          Build from the project directory with and without AVX2, e.g. as below. GCC contracts
+ *          multiplies and adds into FMA once it is enabled, e.g. by -mfma or -march=native, so
+ *          ObstacleBoxes.cpp needs -ffp-contract=off to stay bit-identical.
+ *            g++ -std=c++20 -O2 -ffp-contract=off -Iexternal/c_library_v2 [-mavx2] tests/benchObstacleBoxes.cpp src/ObstacleBoxes.cpp
+ *            cl /std:c++20 /O2 /EHsc /Iexternal\c_library_v2 [/arch:AVX2] tests\benchObstacleBoxes.cpp src\ObstacleBoxes.cpp
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "../include/ObstacleBoxes.h"
+#include "TestFixtures.h"
+
+
+namespace {
+
+constexpr std::size_t POSITIONS_NUM = 20'000;
+
+double elapsedNs(std::chrono::steady_clock::time_point start, std::size_t count) {
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+}
+
+} // namespace
+
+int main() {
+#if defined(__AVX2__)
+  std::printf("kernels: AVX2\n");
+#elif defined(_M_X64) || defined(__SSE2__)
+  std::printf("kernels: SSE2\n");
+#else
+  std::printf("kernels: scalar\n");
+#endif
+  std::mt19937 rng(42);
+  int status = 0;
+
+  for (const std::size_t boxesNum : {8, 64, 512}) {
+    const std::vector<OrientedBox> boxes = fixtures::makeBoxes(boxesNum, rng);
+    const ObstacleBoxes packed(boxes);
+
+    std::uniform_real_distribution<double> east(-15.0, 15.0), north(-5.0, 5.0 * boxesNum), up(0.0, 10.0);
+    std::vector<double> easts(POSITIONS_NUM), norths(POSITIONS_NUM), ups(POSITIONS_NUM);
+    for (std::size_t idx = 0; idx < POSITIONS_NUM; ++idx) {
+      easts[idx] = east(rng);
+      norths[idx] = north(rng);
+      ups[idx] = up(rng);
+    }
+
+    // Box by box, as the first box containing the position
+    std::vector<std::uint32_t> scalarIds(POSITIONS_NUM, ObstacleBoxes::NO_OBSTACLE);
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < POSITIONS_NUM; ++idx) {
+      for (const OrientedBox &box : boxes) {
+        if (box.signedDistance(easts[idx], norths[idx], ups[idx]) <= 0.0) {
+          scalarIds[idx] = static_cast<std::uint32_t>(box.obstacleId);
+          break;
+        }
+      }
+    }
+    const double scalarNs = elapsedNs(start, POSITIONS_NUM);
+
+    std::vector<std::uint32_t> blockIds(POSITIONS_NUM);
+    start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < POSITIONS_NUM; ++idx) {
+      blockIds[idx] = packed.findContaining(easts[idx], norths[idx], ups[idx]);
+    }
+    const double blockNs = elapsedNs(start, POSITIONS_NUM);
+
+    std::vector<std::uint32_t> batchIds(POSITIONS_NUM);
+    start = std::chrono::steady_clock::now();
+    packed.findContaining(easts.data(), norths.data(), ups.data(), POSITIONS_NUM, batchIds.data());
+    const double batchNs = elapsedNs(start, POSITIONS_NUM);
+
+    // Distances of all boxes, compared bit by bit
+    std::size_t differentNum = 0;
+    double distances[ObstacleBoxes::BLOCK_SIZE];
+    for (std::size_t idx = 0; idx < POSITIONS_NUM; ++idx) {
+      for (std::size_t blockIdx = 0; blockIdx < packed.getBlocksNum(); ++blockIdx) {
+        ObstacleBoxes::signedDistances(packed.getBlock(blockIdx), easts[idx], norths[idx], ups[idx], distances);
+        for (std::size_t lane = 0; lane < ObstacleBoxes::BLOCK_SIZE; ++lane) {
+          const std::size_t boxIdx = blockIdx * ObstacleBoxes::BLOCK_SIZE + lane;
+          if (boxIdx < boxes.size()) {
+            const double expected = boxes[boxIdx].signedDistance(easts[idx], norths[idx], ups[idx]);
+            differentNum += std::memcmp(&expected, &distances[lane], sizeof(double)) != 0;
+          } else {
+            differentNum += !std::isinf(distances[lane]);
+          }
+        }
+      }
+    }
+
+    std::size_t insideNum = 0;
+    for (const std::uint32_t obstacleId : scalarIds) {
+      insideNum += obstacleId != ObstacleBoxes::NO_OBSTACLE;
+    }
+    const bool isMatching = scalarIds == blockIds && scalarIds == batchIds && differentNum == 0;
+    std::printf("%4zu boxes: box by box %8.1f ns, blocks %7.1f ns, batch %7.1f ns per position, "
+                "%5.2f %% inside, %s\n",
+                boxesNum, scalarNs, blockNs, batchNs, 100.0 * insideNum / POSITIONS_NUM,
+                isMatching ? "same results" : "RESULTS DIFFER");
+    status |= isMatching ? 0 : 1;
+  }
+  return status;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file benchObstacleIndex.cpp
+ * @brief Benchmark of proximity queries against obstacles.
+ *
+ * @details This file contains a standalone benchmark building ObstacleIndex over generated slalom
+ *          courses of rotated poles and walls, and comparing its queries of positions around the
+ *          course with a linear scan of all boxes, which must give the same answers.
+ *          Build from the project directory, e.g.:
+ *            g++ -std=c++20 -O2 -Iexternal/c_library_v2 tests/benchObstacleIndex.cpp src/ObstacleIndex.cpp src/ObstacleBoxes.cpp src/LocalFrame.cpp
+ *            cl /std:c++20 /O2 /EHsc /Iexternal\c_library_v2 tests\benchObstacleIndex.cpp src\ObstacleIndex.cpp src\ObstacleBoxes.cpp src\LocalFrame.cpp
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "../include/ObstacleIndex.h"
+#include "TestFixtures.h"
+
+
+namespace {
+
+constexpr std::size_t QUERIES_NUM = 200'000;
+
+} // namespace
+
+int main() {
+  const LocalFrame frame(fixtures::ORIGIN);
+  std::mt19937 rng(42);
+  int status = 0;
+
+  for (const std::size_t obstaclesNum : {12, 60, 300, 1500}) {
+    const std::vector<Obstackle> obstacles = fixtures::makeSlalom(obstaclesNum, rng);
+    const ObstacleIndex index(obstacles, frame, CoorindatesSystem::UCS);
+    std::vector<OrientedBox> boxes;
+    for (std::size_t idx = 0; idx < obstacles.size(); ++idx) {
+      boxes.push_back(ObstacleIndex::toBox(obstacles[idx], idx, frame, CoorindatesSystem::UCS));
+    }
+
+    // Positions over the course, a few percent inside obstacles
+    const double courseLength = 15.0 * (obstaclesNum / 3);
+    std::uniform_real_distribution<double> east(-15.0, 15.0), north(-5.0, courseLength + 5.0), up(0.0, 12.0);
+    std::vector<std::array<double, 3>> positions(QUERIES_NUM);
+    for (auto &position : positions) {
+      position = {east(rng), north(rng), up(rng)};
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    double distanceSum = 0.0;
+    for (const auto &position : positions) {
+      ObstacleIndex::Proximity proximity;
+      index.findNearest(position[0], position[1], position[2], proximity);
+      distanceSum += proximity.distance;
+    }
+    const double nearestNs =
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / QUERIES_NUM;
+
+    start = std::chrono::steady_clock::now();
+    std::size_t insideNum = 0;
+    for (const auto &position : positions) {
+      std::size_t obstacleId;
+      insideNum += index.isInside(position[0], position[1], position[2], obstacleId);
+    }
+    const double insideNs =
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / QUERIES_NUM;
+
+    start = std::chrono::steady_clock::now();
+    std::size_t scanInsideNum = 0;
+    double scanDistanceSum = 0.0;
+    for (const auto &position : positions) {
+      double nearest = std::numeric_limits<double>::infinity();
+      for (const OrientedBox &box : boxes) {
+        nearest = std::min(nearest, box.signedDistance(position[0], position[1], position[2]));
+      }
+      scanDistanceSum += nearest;
+      scanInsideNum += nearest <= 0.0;
+    }
+    const double scanNs =
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / QUERIES_NUM;
+
+    const bool isMatching = insideNum == scanInsideNum && std::abs(distanceSum - scanDistanceSum) < 1E-6;
+    std::printf("%5zu obstacles: nearest %6.1f ns, inside %5.1f ns, linear scan %8.1f ns, %4.2f %% inside, %s\n",
+                obstaclesNum, nearestNs, insideNs, scanNs, 100.0 * insideNum / QUERIES_NUM,
+                isMatching ? "same results" : "RESULTS DIFFER");
+    status |= isMatching ? 0 : 1;
+  }
+  return status;
+}
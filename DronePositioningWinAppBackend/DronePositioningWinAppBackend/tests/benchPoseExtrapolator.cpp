@@ -0,0 +1,96 @@
+/**
+ * @file benchPoseExtrapolator.cpp
+ * @brief Benchmark of pose extrapolation.
+ *
+ * @details This file contains a standalone benchmark feeding PoseExtrapolator with 10 Hz telemetry
+ *          of a simulated flight, delayed by the link, and comparing poses predicted at 60 Hz with
+ *          the true ones, against sending the latest sample as it is.
+ *          Build from the project directory, e.g.:
+ *            g++ -std=c++20 -O2 -Iexternal/c_library_v2 tests/benchPoseExtrapolator.cpp src/PoseExtrapolator.cpp
+ *            cl /std:c++20 /O2 /EHsc /Iexternal\c_library_v2 tests\benchPoseExtrapolator.cpp src\PoseExtrapolator.cpp
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numbers>
+#include <random>
+
+#include "../include/PoseExtrapolator.h"
+#include "TestFixtures.h"
+
+
+namespace {
+
+constexpr double TELEMETRY_RATE_HZ = 10.0;
+constexpr double OUTPUT_RATE_HZ = 60.0;
+constexpr double LINK_LATENCY_S = 0.08;
+constexpr double DURATION_S = 600.0;
+
+} // namespace
+
+int main() {
+  std::mt19937 rng(42);
+  PoseExtrapolator extrapolator(std::chrono::milliseconds(500));
+
+  // Received samples arrive LINK_LATENCY_S after their capture, host times are capture times
+  double nextSampleS = 0.0;
+  TelemetrySample latest, prediction;
+  bool hasLatest = false;
+  double holdSq = 0.0, predictedSq = 0.0, holdMax = 0.0, predictedMax = 0.0;
+  double holdYawSq = 0.0, predictedYawSq = 0.0;
+  std::size_t outputsNum = 0;
+  double predictNs = 0.0;
+
+  for (double t = 1.0; t < DURATION_S; t += 1.0 / OUTPUT_RATE_HZ) {
+    while (nextSampleS + LINK_LATENCY_S <= t) {
+      latest = fixtures::sampleAt(nextSampleS, rng);
+      extrapolator.update(latest);
+      hasLatest = true;
+      nextSampleS += 1.0 / TELEMETRY_RATE_HZ;
+    }
+    if (!hasLatest) {
+      continue;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const bool isPredicted = extrapolator.predict(1, static_cast<std::int64_t>(t * 1E9), prediction);
+    predictNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    if (!isPredicted) {
+      continue;
+    }
+
+    const fixtures::Truth truth = fixtures::truthAt(t);
+    const double holdError = fixtures::positionError(latest, truth);
+    const double predictedError = fixtures::positionError(prediction, truth);
+    holdSq += holdError * holdError;
+    predictedSq += predictedError * predictedError;
+    holdMax = std::max(holdMax, holdError);
+    predictedMax = std::max(predictedMax, predictedError);
+    const double holdYaw = std::remainder(latest.yaw - truth.yaw, 2 * std::numbers::pi);
+    const double predictedYaw = std::remainder(prediction.yaw - truth.yaw, 2 * std::numbers::pi);
+    holdYawSq += holdYaw * holdYaw;
+    predictedYawSq += predictedYaw * predictedYaw;
+    outputsNum++;
+  }
+
+  std::printf("%zu poses at %.0f Hz from %.0f Hz telemetry, %.0f ms link latency\n", outputsNum,
+              OUTPUT_RATE_HZ, TELEMETRY_RATE_HZ, LINK_LATENCY_S * 1E3);
+  std::printf("latest sample: position RMS %.3f m, max %.3f m, yaw RMS %.2f deg\n",
+              std::sqrt(holdSq / outputsNum), holdMax,
+              std::sqrt(holdYawSq / outputsNum) * 180.0 / std::numbers::pi);
+  std::printf("extrapolated:  position RMS %.3f m, max %.3f m, yaw RMS %.2f deg\n",
+              std::sqrt(predictedSq / outputsNum), predictedMax,
+              std::sqrt(predictedYawSq / outputsNum) * 180.0 / std::numbers::pi);
+  std::printf("%.1f ns per prediction\n", predictNs / outputsNum);
+  return 0;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file benchProcessingPipeline.cpp
+ * @brief Benchmark of the pipelined telemetry processor.
+ *
+ * @details This file contains a standalone benchmark feeding TelemetryProcessor with 10 minutes of
+ *          50 Hz telemetry of 6 vehicles flying a slalom, paced at 100 times the real rate, inline
+ *          and pipelined. It reports the time the feeding thread spends per position, per-stage
+ *          occupancy and latency, and checks both modes give the same scores without dropping
+ *          positions. A second part runs a 3-stage pipeline of PipelineStage alone, with an ever
+ *          heavier last stage, reporting the latency of the first stage against it. With a core per
+ *          stage the first one isn't affected; with fewer cores, only through sharing a core.
+ *          Build from the project directory, e.g.:
+ *            g++ -std=c++20 -O2 -DFMT_HEADER_ONLY -Iexternal/c_library_v2 -Iinclude -Iinclude/base tests/benchProcessingPipeline.cpp
+ *                src/TelemetryProcessor.cpp src/PipelineStage.cpp src/ScoringEngine.cpp src/ObstacleIndex.cpp
+ *                src/GuidelineTracker.cpp src/ObstacleBoxes.cpp src/WaypointProgression.cpp src/SessionRecorder.cpp
+ *                src/LocalFrame.cpp src/EventsBus.cpp src/FlightConfig.cpp src/Events.cpp include/base/IProcessor.cpp
+ *                include/base/ISubscriber.cpp include/base/IPublisher.cpp -lpthread
+ *            cl /std:c++20 /O2 /EHsc /Iexternal\c_library_v2 /Iinclude /Iinclude\base tests\benchProcessingPipeline.cpp
+ *                src\TelemetryProcessor.cpp src\PipelineStage.cpp src\ScoringEngine.cpp src\ObstacleIndex.cpp
+ *                src\GuidelineTracker.cpp src\ObstacleBoxes.cpp src\WaypointProgression.cpp src\SessionRecorder.cpp
+ *                src\LocalFrame.cpp src\EventsBus.cpp src\FlightConfig.cpp src\Events.cpp include\base\IProcessor.cpp
+ *                include\base\ISubscriber.cpp include\base\IPublisher.cpp
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "../include/PipelineStage.h"
+#include "../include/TelemetryProcessor.h"
+#include "TestFixtures.h"
+
+
+namespace {
+
+constexpr std::size_t VEHICLES_NUM = 6;
+constexpr double RATE_HZ = 50.0;
+constexpr double DURATION_S = 600.0;
+constexpr double SPEEDUP = 100.0;
+constexpr std::size_t GATES_NUM = 40;
+
+/**
+ * @brief Feed samples a tick of all vehicles at a time, paced at SPEEDUP times the real rate.
+ * @return Time the feeding thread spent per sample, ns.
+ */
+double feed(IProcessor &processor, const std::vector<TelemetrySample> &samples) {
+  const auto start = std::chrono::steady_clock::now();
+  std::chrono::nanoseconds feedingTime{0};
+  for (std::size_t tick = 0; tick * VEHICLES_NUM < samples.size(); ++tick) {
+    const auto tickStart = std::chrono::steady_clock::now();
+    for (std::size_t vehicle = 0; vehicle < VEHICLES_NUM; ++vehicle) {
+      processor.process(samples[tick * VEHICLES_NUM + vehicle]);
+    }
+    feedingTime += std::chrono::steady_clock::now() - tickStart;
+    std::this_thread::sleep_until(start + std::chrono::duration<double>((tick + 1) / (RATE_HZ * SPEEDUP)));
+  }
+  return static_cast<double>(feedingTime.count()) / samples.size();
+}
+
+/**
+ * @brief Item of the PipelineStage-only pipeline.
+ */
+struct ToyItem {
+  std::uint64_t value{0};
+  std::int64_t enqueueNs{0};
+};
+
+void spinNs(std::int64_t durationNs) {
+  const std::int64_t endNs = pipelineNowNs() + durationNs;
+  while (pipelineNowNs() < endNs) {
+  }
+}
+
+} // namespace
+
+int main() {
+  const configuration::FlightConfig exercise = fixtures::makeExercise(GATES_NUM);
+  const std::vector<TelemetrySample> samples = fixtures::makeSamples(VEHICLES_NUM, RATE_HZ, DURATION_S);
+  EventsBus bus;
+  int status = 0;
+  std::printf("%zu samples (%zu vehicles, %.0f Hz, %.0f s) fed at %.0fx, %zu waypoints, %zu obstacles\n",
+              samples.size(), VEHICLES_NUM, RATE_HZ, DURATION_S, SPEEDUP, fixtures::EXERCISE_WAYPOINTS_NUM,
+              2 * GATES_NUM);
+
+  TelemetryProcessor inlineProcessor(bus, exercise);
+  const double inlineNs = feed(inlineProcessor, samples);
+  std::printf("inline:    %.1f ns per sample on the feeding thread\n", inlineNs);
+
+  TelemetryProcessor pipelinedProcessor(bus, exercise, {}, TelemetryProcessor::ProcessingMode::PIPELINED);
+  const double pipelinedNs = feed(pipelinedProcessor, samples);
+  std::printf("pipelined: %.1f ns per sample on the feeding thread\n", pipelinedNs);
+  IProcessor &pipelined = pipelinedProcessor;
+  pipelined.generateReport();
+
+  // Same order of positions through every stage, so the same scores, but for batched conversions
+  // being within nanometres of single ones
+  bool isExpected = true;
+  for (std::size_t vehicle = 1; vehicle <= VEHICLES_NUM; ++vehicle) {
+    const ScoringEngine::Score inlineScore = inlineProcessor.getScore(static_cast<std::uint8_t>(vehicle));
+    const ScoringEngine::Score pipelinedScore = pipelinedProcessor.getScore(static_cast<std::uint8_t>(vehicle));
+    isExpected &= inlineScore.samplesNum == pipelinedScore.samplesNum &&
+                  std::abs(inlineScore.weighted - pipelinedScore.weighted) < 1E-6;
+  }
+  for (std::size_t idx = 0; idx < TelemetryProcessor::STAGES_NUM; ++idx) {
+    const TelemetryProcessor::Stage::Metrics metrics = pipelinedProcessor.getStageMetrics(idx);
+    isExpected &= metrics.itemsNum == samples.size() && metrics.droppedNum == 0;
+  }
+  std::printf("scores of both modes %s, %s\n", isExpected ? "equal" : "DIFFER",
+              isExpected ? "nothing dropped" : "check drops");
+  status |= isExpected ? 0 : 1;
+
+  // Heavier last stage: its own latency grows, the first stage keeps its own
+  constexpr std::size_t TOY_ITEMS_NUM = 100'000;
+  constexpr double TOY_RATE_HZ = 20'000.0;
+  using ToyStage = PipelineStage<ToyItem, 1024, 64>;
+  for (const std::int64_t heavyNs : {0, 5'000, 25'000}) {
+    ToyStage first, second, heavy;
+    heavy.start("heavy", [heavyNs](ToyItem *, std::size_t count) { spinNs(heavyNs * static_cast<std::int64_t>(count)); },
+                nullptr, -1);
+    second.start("second", [](ToyItem *items, std::size_t count) {
+      for (std::size_t idx = 0; idx < count; ++idx) {
+        items[idx].value *= 3;
+      }
+    }, &heavy, -1);
+    first.start("first", [](ToyItem *items, std::size_t count) {
+      for (std::size_t idx = 0; idx < count; ++idx) {
+        items[idx].value += 1;
+      }
+    }, &second, -1);
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < TOY_ITEMS_NUM; ++idx) {
+      ToyItem item{idx, 0};
+      first.push(&item, 1);
+      if (idx % 20 == 19) {
+        std::this_thread::sleep_until(start + std::chrono::duration<double>((idx + 1) / TOY_RATE_HZ));
+      }
+    }
+    first.stop();
+    second.stop();
+    heavy.stop();
+    const ToyStage::Metrics firstMetrics = first.getMetrics();
+    const ToyStage::Metrics heavyMetrics = heavy.getMetrics();
+    std::printf("heavy stage %5.1f us per item: first stage p50 %.1f us, p99 %.1f us; heavy stage p50 %.1f us, "
+                "p99 %.1f us, %.0f %% busy, queue max %zu of %zu, %llu dropped\n",
+                heavyNs / 1E3, firstMetrics.latencyP50Ns / 1E3, firstMetrics.latencyP99Ns / 1E3,
+                heavyMetrics.latencyP50Ns / 1E3, heavyMetrics.latencyP99Ns / 1E3, 100.0 * heavyMetrics.utilisation,
+                heavyMetrics.queueMaxDepth, heavyMetrics.queueCapacity,
+                static_cast<unsigned long long>(firstMetrics.droppedNum));
+    status |= heavyMetrics.itemsNum == TOY_ITEMS_NUM ? 0 : 1;
+  }
+  return status;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file benchScoringEngine.cpp
+ * @brief Benchmark of the streaming scoring of flights.
+ *
+ * @details This file contains a standalone benchmark feeding TelemetryProcessor with an hour of
+ *          100 Hz telemetry of several vehicles flying the guideline of a generated exercise,
+ *          measuring the time per sample, and checking ErrorAccumulator against sums evaluated
+ *          in long double on errors with a large bias, where naive sums lose precision.
+ *          Build from the project directory, e.g.:
+ *            g++ -std=c++20 -O2 -DFMT_HEADER_ONLY -Iexternal/c_library_v2 -Iinclude -Iinclude/base tests/benchScoringEngine.cpp
+ *                src/TelemetryProcessor.cpp src/PipelineStage.cpp src/ScoringEngine.cpp src/ObstacleIndex.cpp
+ *                src/GuidelineTracker.cpp src/ObstacleBoxes.cpp src/WaypointProgression.cpp src/SessionRecorder.cpp
+ *                src/LocalFrame.cpp src/EventsBus.cpp src/FlightConfig.cpp src/Events.cpp include/base/IProcessor.cpp
+ *                include/base/ISubscriber.cpp include/base/IPublisher.cpp -lpthread
+ *            cl /std:c++20 /O2 /EHsc /Iexternal\c_library_v2 /Iinclude /Iinclude\base tests\benchScoringEngine.cpp
+ *                src\TelemetryProcessor.cpp src\PipelineStage.cpp src\ScoringEngine.cpp src\ObstacleIndex.cpp
+ *                src\GuidelineTracker.cpp src\ObstacleBoxes.cpp src\WaypointProgression.cpp src\SessionRecorder.cpp
+ *                src\LocalFrame.cpp src\EventsBus.cpp src\FlightConfig.cpp src\Events.cpp include\base\IProcessor.cpp
+ *                include\base\ISubscriber.cpp include\base\IPublisher.cpp
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../include/ScoringEngine.h"
+#include "../include/TelemetryProcessor.h"
+#include "TestFixtures.h"
+
+
+namespace {
+
+constexpr std::size_t VEHICLES_NUM = 6;
+constexpr double RATE_HZ = 100.0;
+constexpr double DURATION_S = 3600.0;
+
+} // namespace
+
+int main() {
+  const configuration::FlightConfig exercise = fixtures::makeExercise(0);
+  const std::vector<TelemetrySample> samples = fixtures::makeSamples(VEHICLES_NUM, RATE_HZ, DURATION_S);
+  EventsBus bus;
+  TelemetryProcessor processor(bus, exercise);
+  IProcessor &scoring = processor;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (const TelemetrySample &sample : samples) {
+    scoring.process(sample);
+  }
+  const double sampleNs =
+      std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / samples.size();
+  std::printf("%zu samples (%zu vehicles, %.0f Hz, %.0f s), %zu waypoints\n", samples.size(), VEHICLES_NUM,
+              RATE_HZ, DURATION_S, fixtures::EXERCISE_WAYPOINTS_NUM);
+  std::printf("%.1f ns/sample, %.4f %% of one core at the stream rate\n", sampleNs,
+              sampleNs * VEHICLES_NUM * RATE_HZ * 1E-7);
+  scoring.generateReport();
+
+  // Errors of 1000 m +- 1 mm: one-pass sums of squares cancel, two passes in long double are the reference
+  std::mt19937 rng(42);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  const std::size_t errorsNum = samples.size();
+  std::vector<double> errors(errorsNum);
+  ErrorAccumulator accumulator;
+  double naiveSum = 0.0, naiveSquareSum = 0.0;
+  long double sum = 0.0L;
+  for (double &error : errors) {
+    error = 1000.0 + 1E-3 * noise(rng);
+    accumulator.add(error);
+    naiveSum += error;
+    naiveSquareSum += error * error;
+    sum += error;
+  }
+  const long double mean = sum / errorsNum;
+  long double deviationSq = 0.0L, squareSum = 0.0L;
+  for (const double error : errors) {
+    deviationSq += (error - mean) * (error - mean);
+    squareSum += static_cast<long double>(error) * error;
+  }
+  const double stdDev = static_cast<double>(std::sqrt(deviationSq / (errorsNum - 1)));
+  const double naiveMean = naiveSum / errorsNum;
+  const double naiveStdDev = std::sqrt(std::max((naiveSquareSum - naiveSum * naiveMean) / (errorsNum - 1), 0.0));
+  std::printf("mean    reference %.12f, accumulator %.12f, naive %.12f\n", static_cast<double>(mean),
+              accumulator.getMean(), naiveMean);
+  std::printf("std dev reference %.9f, accumulator %.9f, naive %.9f\n", stdDev, accumulator.getStdDev(),
+              naiveStdDev);
+  const double rmse = static_cast<double>(std::sqrt(squareSum / errorsNum));
+  std::printf("RMSE    reference %.12f, accumulator %.12f\n", rmse, accumulator.getRmse());
+  return std::abs(accumulator.getStdDev() - stdDev) < 1E-9 ? 0 : 1;
+}
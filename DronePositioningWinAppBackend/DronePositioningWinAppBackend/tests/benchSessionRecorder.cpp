@@ -0,0 +1,149 @@
+/**
+ * @file benchSessionRecorder.cpp
+ * @brief Benchmark of recording sessions.
+ *
+ * @details This file contains a standalone benchmark recording an hour of 6 vehicles at 50 Hz,
+ *          fed at 1000 times the real rate, timing appends and closing the session at the
+ *          end, then reading the session file back, which must hold every row. A second session
+ *          is fed at once, as fast as the core allows, so rows the writer can't keep up with are
+ *          dropped instead of waited for; written and dropped rows must add up. Summaries of a
+ *          third session must hold the errors as the ScoringEngine reduced them, MAE here.
+ *          Build from the project directory, e.g.:
+ *            g++ -std=c++20 -O2 -DFMT_HEADER_ONLY -Iexternal/c_library_v2 tests/benchSessionRecorder.cpp src/SessionRecorder.cpp src/ScoringEngine.cpp
+ *            cl /std:c++20 /O2 /EHsc /Iexternal\c_library_v2 tests\benchSessionRecorder.cpp src\SessionRecorder.cpp src\ScoringEngine.cpp
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include "../include/SessionRecorder.h"
+#include "TestFixtures.h"
+
+
+namespace {
+
+constexpr std::size_t VEHICLES_NUM = fixtures::SESSION_VEHICLES_NUM;
+constexpr std::uint32_t RATE_HZ = fixtures::SESSION_RATE_HZ;
+constexpr std::uint32_t SESSION_S = 3600;
+constexpr double SPEEDUP = 1000.0;
+constexpr std::size_t ROWS_NUM = VEHICLES_NUM * RATE_HZ * SESSION_S;
+
+} // namespace
+
+int main() {
+  const std::filesystem::path directory = std::filesystem::temp_directory_path() / "benchSessionRecorder";
+  std::vector<SessionRecorder::Row> rows(ROWS_NUM);
+  for (std::size_t idx = 0; idx < ROWS_NUM; ++idx) {
+    rows[idx] = fixtures::makeRow(idx);
+  }
+  int status = 0;
+
+  // Fed a second of telemetry at a time, 1000 times faster than it arrives
+  {
+    SessionRecorder recorder(directory / "paced");
+    const std::size_t secondRowsNum = VEHICLES_NUM * RATE_HZ;
+    std::vector<double> secondNs(SESSION_S);
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t second = 0; second < SESSION_S; ++second) {
+      const auto secondStart = std::chrono::steady_clock::now();
+      for (std::size_t idx = second * secondRowsNum; idx < (second + 1) * secondRowsNum; ++idx) {
+        recorder.append(rows[idx]);
+      }
+      secondNs[second] =
+          std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - secondStart).count();
+      std::this_thread::sleep_until(start + std::chrono::duration<double>((second + 1) / SPEEDUP));
+    }
+    // Per second of telemetry, the slowest ones include the writer taking the core, if it's the only one
+    std::sort(secondNs.begin(), secondNs.end());
+    const auto closeStart = std::chrono::steady_clock::now();
+    recorder.close();
+    const bool isClosed = recorder.waitClosed(std::chrono::seconds(5));
+    const double closeMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - closeStart).count();
+    const long long readNum = fixtures::readSession(recorder.getPath(), 0);
+    const double fileMb = std::filesystem::file_size(recorder.getPath()) / 1E6;
+    const bool isExpected = isClosed && recorder.getDroppedNum() == 0 && readNum == static_cast<long long>(ROWS_NUM);
+    std::printf("%zu rows (%u s of %zu vehicles at %u Hz), paced: append %.1f ns median, %.1f ns "
+                "p99, %llu dropped, closed in %.2f ms, %.1f MB (%.1f B per row), %s\n",
+                ROWS_NUM, SESSION_S, VEHICLES_NUM, RATE_HZ, secondNs[SESSION_S / 2] / secondRowsNum,
+                secondNs[SESSION_S * 99 / 100] / secondRowsNum,
+                static_cast<unsigned long long>(recorder.getDroppedNum()), closeMs, fileMb,
+                fileMb * 1E6 / ROWS_NUM, isExpected ? "as expected" : "UNEXPECTED");
+    status |= isExpected ? 0 : 1;
+  }
+
+  // Fed at once, whatever the writer can't keep up with is dropped
+  {
+    SessionRecorder recorder(directory / "burst");
+    const auto start = std::chrono::steady_clock::now();
+    for (const SessionRecorder::Row &row : rows) {
+      recorder.append(row);
+    }
+    const double appendNs =
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ROWS_NUM;
+    const auto closeStart = std::chrono::steady_clock::now();
+    recorder.close();
+    const bool isClosed = recorder.waitClosed(std::chrono::seconds(5));
+    const double closeMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - closeStart).count();
+    const long long readNum = fixtures::readSession(recorder.getPath(), recorder.getDroppedNum());
+    const bool isExpected = isClosed && readNum >= 0 &&
+                            readNum + recorder.getDroppedNum() == ROWS_NUM;
+    std::printf("%zu rows, burst: append %.1f ns, %lld written, %llu dropped, closed in %.2f ms, %s\n",
+                ROWS_NUM, appendNs, readNum, static_cast<unsigned long long>(recorder.getDroppedNum()),
+                closeMs, isExpected ? "as expected" : "UNEXPECTED");
+    status |= isExpected ? 0 : 1;
+  }
+
+  // Scored by the engine, the summary has to carry its MAE, not one of its own
+  {
+    ExerciseInfo exerciseInfo{};
+    exerciseInfo.scoringMethod = ScoringMethod::MAE;
+    exerciseInfo.distanceWeight = 1;
+    exerciseInfo.altitudeWeight = 1;
+    exerciseInfo.speedWeight = 1;
+    ScoringEngine scoring(exerciseInfo);
+    SessionRecorder recorder(directory / "scored");
+    const std::size_t scoredRowsNum = VEHICLES_NUM * RATE_HZ * 60;
+    for (std::size_t idx = 0; idx < scoredRowsNum; ++idx) {
+      const SessionRecorder::Row &row = rows[idx];
+      recorder.append(row);
+      scoring.add(row.vehicleId, {row.distanceError, row.altitudeError, row.speedError});
+    }
+    recorder.close(&scoring);
+    const bool isClosed = recorder.waitClosed(std::chrono::seconds(5));
+
+    std::ifstream csv(directory / "scored_summary.csv");
+    std::string header, line;
+    std::getline(csv, header);
+    std::getline(csv, line);
+    const ScoringEngine::Score score = scoring.getScore(1);
+    const double duration = (rows[scoredRowsNum - 1].timeBootMs - rows[0].timeBootMs) / 1E3;
+    const std::string expected = fmt::format("1,{},{:.3f},{},{:.3f},{:.3f},", scoredRowsNum / VEHICLES_NUM,
+                                             duration, score.samplesNum, score.weighted, score.distance);
+    const bool isExpected = isClosed && header.find("distance_mae_m") != std::string::npos &&
+                            line.rfind(expected, 0) == 0;
+    std::printf("%zu rows, scored: summary %s\n", scoredRowsNum, isExpected ? "as expected" : "UNEXPECTED");
+    status |= isExpected ? 0 : 1;
+  }
+
+  std::filesystem::remove_all(directory);
+  return status;
+}
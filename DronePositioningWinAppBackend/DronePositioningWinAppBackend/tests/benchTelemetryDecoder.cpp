@@ -0,0 +1,151 @@
+/**
+ * @file benchTelemetryDecoder.cpp
+ * @brief Benchmark of parsing and decoding received MAVLink bytes.
+ *
+ * @details This file contains a standalone benchmark running the parse/publish stage of
+ *          TelemetryReceiver without the serial port: bytes are parsed in chunks of the I/O stage
+ *          with mavlink_parse_char and every frame is decoded by TelemetryDecoder. It reports the
+ *          CPU time of the thread per message. Bytes come from a file recorded from the serial
+ *          port, e.g. with a terminal logging raw bytes, or, without one, from a minute of the
+ *          streams the receiver requests at their highest rates. Every frame of the generated
+ *          bytes must be decoded and one sample published per ATTITUDE; timing doesn't fail it.
+ *          Build from the project directory, e.g.:
+ *            g++ -std=c++20 -O2 -Iexternal/c_library_v2 tests/benchTelemetryDecoder.cpp src/TelemetryDecoder.cpp src/ClockSync.cpp
+ *            cl /std:c++20 /O2 /EHsc /Iexternal\c_library_v2 tests\benchTelemetryDecoder.cpp src\TelemetryDecoder.cpp src\ClockSync.cpp
+ *          and run with an optional path of the recording.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "../include/TelemetryDecoder.h"
+#include "TestFixtures.h"
+
+
+namespace {
+
+constexpr std::size_t READ_CHUNK_SIZE = 512; // as read by the I/O stage
+constexpr std::size_t PASSES_NUM = 20;
+constexpr std::uint32_t GENERATED_S = 60;
+
+/**
+ * @brief CPU time of the calling thread.
+ */
+std::int64_t threadCpuNs() {
+#ifdef _WIN32
+  FILETIME creationTime, exitTime, kernelTime, userTime;
+  GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime);
+  auto toUint64 = [](const FILETIME &ft) {
+    return (static_cast<std::uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+  };
+  return static_cast<std::int64_t>(toUint64(kernelTime) + toUint64(userTime)) * 100;
+#else
+  timespec time;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+  return static_cast<std::int64_t>(time.tv_sec) * 1'000'000'000 + time.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Parse and decode the bytes as the parse/publish stage does.
+ * @return CPU time of the pass.
+ */
+std::int64_t runPass(const std::vector<std::uint8_t> &bytes, fixtures::StreamCounts &counts) {
+  TelemetryDecoder decoder;
+  mavlink_message_t message;
+  mavlink_status_t status;
+  mavlink_reset_channel_status(MAVLINK_COMM_1);
+  const std::int64_t startNs = threadCpuNs();
+  for (std::size_t offset = 0; offset < bytes.size(); offset += READ_CHUNK_SIZE) {
+    const std::size_t end = std::min(offset + READ_CHUNK_SIZE, bytes.size());
+    const std::int64_t arrivalNs = ClockSync::nowNs();
+    for (std::size_t idx = offset; idx < end; ++idx) {
+      if (mavlink_parse_char(MAVLINK_COMM_1, bytes[idx], &message, &status) != 1) {
+        continue;
+      }
+      counts.framesNum++;
+      const TelemetryDecoder::Result result = decoder.decode(message, arrivalNs);
+      if (result.action == TelemetryDecoder::Action::PUBLISH) {
+        counts.publishedNum++;
+        decoder.getSample().updatedFields = 0;
+      } else if (result.action == TelemetryDecoder::Action::REPLY_TIMESYNC) {
+        counts.timesyncRequestsNum++;
+      }
+    }
+  }
+  const std::int64_t elapsedNs = threadCpuNs() - startNs;
+  counts.droppedNum = mavlink_get_channel_status(MAVLINK_COMM_1)->packet_rx_drop_count;
+  return elapsedNs;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  fixtures::StreamCounts expected;
+  std::vector<std::uint8_t> bytes;
+  const bool isRecorded = argc > 1;
+  if (isRecorded) {
+    std::ifstream file(argv[1], std::ios::binary);
+    if (!file) {
+      std::printf("couldn't open %s\n", argv[1]);
+      return EXIT_FAILURE;
+    }
+    bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  } else {
+    bytes = fixtures::generateStreams(GENERATED_S, expected);
+  }
+
+  fixtures::StreamCounts counts;
+  std::vector<double> nsPerMessage;
+  for (std::size_t pass = 0; pass < PASSES_NUM; ++pass) {
+    counts = fixtures::StreamCounts{};
+    const std::int64_t elapsedNs = runPass(bytes, counts);
+    if (counts.framesNum > 0) {
+      nsPerMessage.push_back(static_cast<double>(elapsedNs) / counts.framesNum);
+    }
+  }
+  if (nsPerMessage.empty()) {
+    std::printf("%s: %zu B, no MAVLink frames\n", isRecorded ? argv[1] : "generated", bytes.size());
+    return EXIT_FAILURE;
+  }
+  std::sort(nsPerMessage.begin(), nsPerMessage.end());
+  std::printf("%s: %zu B, %llu frames (%.1f B each), %llu dropped by the parser, %llu samples, "
+              "%llu TIMESYNC requests\n",
+              isRecorded ? argv[1] : "generated", bytes.size(),
+              static_cast<unsigned long long>(counts.framesNum),
+              static_cast<double>(bytes.size()) / counts.framesNum,
+              static_cast<unsigned long long>(counts.droppedNum),
+              static_cast<unsigned long long>(counts.publishedNum),
+              static_cast<unsigned long long>(counts.timesyncRequestsNum));
+  std::printf("parse and decode: %.1f ns CPU per message (best of %zu passes), median %.1f ns\n",
+              nsPerMessage.front(), PASSES_NUM, nsPerMessage[nsPerMessage.size() / 2]);
+
+  if (isRecorded) {
+    return EXIT_SUCCESS;
+  }
+  const bool isExpected = counts.framesNum == expected.framesNum && counts.droppedNum == 0 &&
+                          counts.publishedNum == expected.publishedNum &&
+                          counts.timesyncRequestsNum == expected.timesyncRequestsNum;
+  std::printf("generated bytes decoded %s\n", isExpected ? "as expected" : "UNEXPECTEDLY");
+  return isExpected ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file benchWaypointProgression.cpp
+ * @brief Benchmark of the waypoint progression state machine.
+ *
+ * @details This file contains a standalone benchmark flying simulated vehicles through the
+ *          waypoints of a generated exercise at 50 Hz, hovering at every waypoint a little longer
+ *          than the pausing time. Vehicles differ in heading, position glitches during hovers and
+ *          the autopilot clock, which one of them wraps. Every vehicle must capture all waypoints,
+ *          with the expected bearing compliance and number of transitions.
+ *          Build from the project directory, e.g.:
+ *            g++ -std=c++20 -O2 -Iexternal/c_library_v2 tests/benchWaypointProgression.cpp src/WaypointProgression.cpp src/LocalFrame.cpp
+ *            cl /std:c++20 /O2 /EHsc /Iexternal\c_library_v2 tests\benchWaypointProgression.cpp src\WaypointProgression.cpp src\LocalFrame.cpp
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../include/WaypointProgression.h"
+#include "TestFixtures.h"
+
+
+namespace {
+
+constexpr std::size_t WAYPOINTS_NUM = 50;
+
+} // namespace
+
+int main() {
+  const LocalFrame frame(fixtures::ORIGIN);
+  std::mt19937 rng(42);
+  const std::vector<Waypoint> waypoints = fixtures::makeZigZag(WAYPOINTS_NUM, rng);
+  WaypointProgression progression(waypoints, frame, fixtures::makeProgressionInfo());
+  const std::array<fixtures::Pilot, 4> pilots = fixtures::makePilots(WAYPOINTS_NUM);
+  const std::vector<fixtures::FlightSample> samples = fixtures::flyPilots(waypoints, frame, pilots, rng);
+
+  std::size_t transitionsNum = 0;
+  WaypointProgress progress;
+  const auto start = std::chrono::steady_clock::now();
+  for (const fixtures::FlightSample &sample : samples) {
+    transitionsNum += progression.update(sample.telemetry, sample.east, sample.north, sample.up, progress);
+  }
+  const double updateNs =
+      std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / samples.size();
+  std::printf("%zu positions of %zu vehicles, %zu waypoints: %.1f ns per position, %zu transitions "
+              "(1 per %.0f positions)\n",
+              samples.size(), pilots.size(), WAYPOINTS_NUM, updateNs, transitionsNum,
+              static_cast<double>(samples.size()) / transitionsNum);
+
+  int status = 0;
+  for (std::size_t pilotIdx = 0; pilotIdx < pilots.size(); ++pilotIdx) {
+    const fixtures::Pilot &pilot = pilots[pilotIdx];
+    const std::uint8_t vehicleId = static_cast<std::uint8_t>(pilotIdx + 1);
+    const WaypointProgression::Stats &stats = progression.getStats(vehicleId);
+    const bool isExpected = progression.getState(vehicleId) == WaypointState::COMPLETED &&
+                            stats.capturedNum == WAYPOINTS_NUM &&
+                            stats.compliantNum == pilot.expectedCompliantNum &&
+                            stats.transitionsNum == pilot.expectedTransitionsNum;
+    std::printf("  %-15s %2u captured, %2u at the bearing, %3u transitions, completed in %6.1f s, %s\n",
+                pilot.name, stats.capturedNum, stats.compliantNum, stats.transitionsNum,
+                (stats.completionTimeBootMs - stats.startTimeBootMs) / 1E3,
+                isExpected ? "as expected" : "UNEXPECTED");
+    status |= isExpected ? 0 : 1;
+  }
+  return status;
+}
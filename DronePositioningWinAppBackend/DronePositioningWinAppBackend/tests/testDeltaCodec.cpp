@@ -0,0 +1,108 @@
+/**
+ * @file testDeltaCodec.cpp
+ * @brief Tests of the delta wire format.
+ *
+ * @details This file contains checks that delta packets of interleaved vehicles decode to the
+ *          quantised samples despite packet loss, and that a delta whose keyframe was lost is
+ *          skipped without losing the packet after it in the same datagram.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "../include/DeltaCodec.h"
+#include "TestFixtures.h"
+#include "TestRunner.h"
+
+
+namespace {
+
+constexpr std::size_t SAMPLES_NUM = 20'000;
+constexpr double LOSS_RATE = 0.05;
+constexpr std::size_t VEHICLES_NUM = 8;
+
+/**
+ * @brief Vehicles sharing the sequence, 5 % of packets lost: every packet is decoded or skipped
+ *        for its keyframe, never malformed, and decoded samples equal the quantised ones.
+ */
+void checkLossyRoundTrip(const std::vector<TelemetrySample> &samples) {
+  wire::DeltaEncoder encoder;
+  wire::DeltaDecoder decoder;
+  std::mt19937 rng(7);
+  std::bernoulli_distribution isLost(LOSS_RATE);
+  std::size_t decodedNum = 0;
+  std::size_t malformedNum = 0;
+  std::size_t mismatchesNum = 0;
+  std::uint8_t buffer[wire::MAX_DELTA_PACKET_SIZE];
+  for (std::size_t idx = 0; idx < samples.size(); ++idx) {
+    TelemetrySample sample = samples[idx];
+    sample.systemId = static_cast<std::uint8_t>(idx % VEHICLES_NUM + 1);
+    const std::size_t size = encoder.encode(sample, static_cast<std::uint32_t>(idx),
+                                            sample.attitudeHostTimeNs, buffer);
+    if (isLost(rng)) {
+      continue;
+    }
+    std::uint8_t vehicleId;
+    wire::QuantisedSample decoded;
+    const wire::DeltaResult result = decoder.decode(buffer, size, vehicleId, decoded);
+    if (result.status == wire::DeltaStatus::MALFORMED || result.consumedNum != size) {
+      malformedNum++;
+      continue;
+    }
+    if (result.status == wire::DeltaStatus::KEYFRAME_MISSING) {
+      continue;
+    }
+    decodedNum++;
+    const wire::QuantisedSample expected = wire::DeltaEncoder::quantise(sample);
+    // Timestamps of deltas have microsecond resolution
+    mismatchesNum += vehicleId != sample.systemId || decoded.values != expected.values ||
+                     decoded.validFields != expected.validFields ||
+                     std::llabs(decoded.timestampNs - expected.timestampNs) >= 1000;
+  }
+  CHECK(malformedNum == 0);
+  CHECK(mismatchesNum == 0);
+  CHECK(decodedNum > samples.size() / 2);
+}
+
+/**
+ * @brief A delta of a vehicle whose keyframe was lost, coalesced with a keyframe of another one.
+ */
+void checkCoalescedWithoutKeyframe(const std::vector<TelemetrySample> &samples) {
+  wire::DeltaEncoder encoder;
+  wire::DeltaDecoder decoder;
+  std::uint8_t buffer[2 * wire::MAX_DELTA_PACKET_SIZE];
+  TelemetrySample second = samples[1];
+  second.systemId = 2;
+  encoder.encode(samples[0], 0, samples[0].attitudeHostTimeNs, buffer); // lost keyframe
+  std::size_t size = encoder.encode(samples[2], 1, samples[2].attitudeHostTimeNs, buffer);
+  size += encoder.encode(second, 2, second.attitudeHostTimeNs, buffer + size);
+
+  std::uint8_t vehicleId;
+  wire::QuantisedSample decoded;
+  const wire::DeltaResult skipped = decoder.decode(buffer, size, vehicleId, decoded);
+  CHECK(skipped.status == wire::DeltaStatus::KEYFRAME_MISSING);
+  const wire::DeltaResult next = decoder.decode(buffer + skipped.consumedNum, size - skipped.consumedNum,
+                                                vehicleId, decoded);
+  CHECK(next.status == wire::DeltaStatus::DECODED);
+  CHECK(skipped.consumedNum + next.consumedNum == size);
+  CHECK(vehicleId == 2);
+  CHECK(decoded.values == wire::DeltaEncoder::quantise(second).values);
+}
+
+} // namespace
+
+void tests::testDeltaCodec() {
+  const std::vector<TelemetrySample> samples = fixtures::makeFlight(SAMPLES_NUM);
+  checkLossyRoundTrip(samples);
+  checkCoalescedWithoutKeyframe(samples);
+}
@@ -0,0 +1,147 @@
+/**
+ * @file testGeodesy.cpp
+ * @brief Tests of the geodesy methods and LocalFrame.
+ *
+ * @details This file contains checks of every method of Geodesy.h and LocalFrame against the
+ *          textbook geodetic->ECEF->ENU conversion evaluated in long double, within the error the
+ *          method is documented with 5 km around the operator, and of batched conversions giving
+ *          the same positions as single ones. LocalFrame is also checked far from its origin,
+ *          where it takes the exact path.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "../include/Geodesy.h"
+#include "../include/LocalFrame.h"
+#include "TestFixtures.h"
+#include "TestRunner.h"
+
+
+namespace {
+
+constexpr std::size_t POSITIONS_NUM = 20'000;
+constexpr double RADIUS = 5000.0; // m
+
+struct Errors {
+  double horizontal{0.0};
+  double vertical{0.0};
+  double batchDifference{0.0};
+};
+
+/**
+ * @brief Errors of single conversions against the reference and their difference to batched ones.
+ */
+template <typename Single, typename Batch>
+Errors measure(const fixtures::Positions &positions, Single single, Batch batch) {
+  std::vector<double> east(POSITIONS_NUM), north(POSITIONS_NUM), up(POSITIONS_NUM);
+  batch(positions.latE7.data(), positions.lonE7.data(), positions.altMm.data(), POSITIONS_NUM, east.data(),
+        north.data(), up.data());
+  Errors errors;
+  for (std::size_t idx = 0; idx < POSITIONS_NUM; ++idx) {
+    const geodesy::Enu enu = single(positions.latE7[idx], positions.lonE7[idx], positions.altMm[idx]);
+    errors.horizontal = std::max(errors.horizontal, std::hypot(enu.east - positions.east[idx],
+                                                               enu.north - positions.north[idx]));
+    errors.vertical = std::max(errors.vertical, std::abs(enu.up - positions.up[idx]));
+    errors.batchDifference = std::max({errors.batchDifference, std::abs(east[idx] - enu.east),
+                                       std::abs(north[idx] - enu.north), std::abs(up[idx] - enu.up)});
+  }
+  return errors;
+}
+
+void checkMethods(const fixtures::Positions &positions) {
+  const LocalFrame localFrame(fixtures::ORIGIN);
+  const geodesy::EcefFrame ecefFrame(fixtures::ORIGIN);
+  const geodesy::TangentPlane tangentPlane(fixtures::ORIGIN);
+
+  const Errors ecef = measure(
+      positions, [&](std::int32_t lat, std::int32_t lon, std::int32_t alt) { return ecefFrame.toEnu(lat, lon, alt); },
+      [&](auto... args) { ecefFrame.toEnu(args...); });
+  CHECK(ecef.horizontal < 1E-6 && ecef.vertical < 1E-6);
+  CHECK(ecef.batchDifference < 1E-6);
+
+  const Errors local = measure(
+      positions,
+      [&](std::int32_t lat, std::int32_t lon, std::int32_t alt) {
+        geodesy::Enu enu;
+        localFrame.toEnu(lat, lon, alt, enu.east, enu.north, enu.up);
+        return enu;
+      },
+      [&](auto... args) { localFrame.toEnu(args...); });
+  CHECK(local.horizontal < 1E-6 && local.vertical < 1E-6);
+  CHECK(local.batchDifference < 1E-6);
+
+  const Errors curved = measure(
+      positions,
+      [&](std::int32_t lat, std::int32_t lon, std::int32_t alt) { return tangentPlane.toEnuCurved(lat, lon, alt); },
+      [&](auto... args) { tangentPlane.toEnuCurved(args...); });
+  CHECK(curved.horizontal < 1E-2 && curved.vertical < 1E-2);
+  CHECK(curved.batchDifference < 1E-6);
+
+  const Errors flat = measure(
+      positions, [&](std::int32_t lat, std::int32_t lon, std::int32_t alt) { return tangentPlane.toEnu(lat, lon, alt); },
+      [&](auto... args) { tangentPlane.toEnu(args...); });
+  CHECK(flat.horizontal < 5.0 && flat.vertical < 5.0);
+  CHECK(flat.batchDifference < 1E-6);
+
+  // Haversine only gives the distance from the operator, on a sphere
+  std::vector<double> distances(POSITIONS_NUM);
+  geodesy::haversineDistances(fixtures::ORIGIN, positions.latE7.data(), positions.lonE7.data(), POSITIONS_NUM,
+                              distances.data());
+  double distanceError = 0.0, batchDifference = 0.0;
+  for (std::size_t idx = 0; idx < POSITIONS_NUM; ++idx) {
+    const double distance = geodesy::haversineDistance(
+        fixtures::ORIGIN.latitude * geodesy::DEG_TO_RAD, fixtures::ORIGIN.longitude * geodesy::DEG_TO_RAD,
+        positions.latE7[idx] * geodesy::DEG_E7_TO_RAD, positions.lonE7[idx] * geodesy::DEG_E7_TO_RAD);
+    distanceError = std::max(distanceError,
+                             std::abs(distance - std::hypot(positions.east[idx], positions.north[idx])));
+    batchDifference = std::max(batchDifference, std::abs(distances[idx] - distance));
+  }
+  CHECK(distanceError < 25.0);
+  CHECK(batchDifference < 1E-6);
+}
+
+/**
+ * @brief Positions up to 5 deg away take the exact path of LocalFrame, mixed with near ones.
+ */
+void checkLocalFrameFarPositions(std::mt19937 &rng) {
+  std::uniform_real_distribution<double> offset(-1.0, 1.0);
+  std::vector<std::int32_t> latE7(POSITIONS_NUM), lonE7(POSITIONS_NUM), altMm(POSITIONS_NUM);
+  for (std::size_t idx = 0; idx < POSITIONS_NUM; ++idx) {
+    const double range = idx % 10 == 0 ? 5.0 : 0.045; // deg
+    latE7[idx] = static_cast<std::int32_t>(std::lround((fixtures::ORIGIN.latitude + range * offset(rng)) * 1E7));
+    lonE7[idx] = static_cast<std::int32_t>(std::lround((fixtures::ORIGIN.longitude + range * offset(rng)) * 1E7));
+    altMm[idx] = static_cast<std::int32_t>(std::lround((fixtures::ORIGIN.altitude + 500.0 * offset(rng)) * 1E3));
+  }
+  const LocalFrame frame(fixtures::ORIGIN);
+  std::vector<double> east(POSITIONS_NUM), north(POSITIONS_NUM), up(POSITIONS_NUM);
+  frame.toEnu(latE7.data(), lonE7.data(), altMm.data(), POSITIONS_NUM, east.data(), north.data(), up.data());
+  double maxReferenceDiff = 0.0;
+  for (std::size_t idx = 0; idx < POSITIONS_NUM; ++idx) {
+    double refEast, refNorth, refUp;
+    fixtures::referenceToEnu(latE7[idx], lonE7[idx], altMm[idx], refEast, refNorth, refUp);
+    maxReferenceDiff = std::max({maxReferenceDiff, std::abs(east[idx] - refEast),
+                                 std::abs(north[idx] - refNorth), std::abs(up[idx] - refUp)});
+  }
+  CHECK(maxReferenceDiff < 1E-6);
+}
+
+} // namespace
+
+void tests::testGeodesy() {
+  std::mt19937 rng(42);
+  checkMethods(fixtures::makePositions(RADIUS, POSITIONS_NUM, rng));
+  checkLocalFrameFarPositions(rng);
+}
@@ -0,0 +1,79 @@
+/**
+ * @file testGuidelineTracker.cpp
+ * @brief Tests of tracking vehicles along the guideline.
+ *
+ * @details This file contains checks that GuidelineTracker::track, following a vehicle with a
+ *          cursor, gives the same projections as a search of all segments, for a noisy flight
+ *          along guidelines of growing length with occasional jumps to another part of the course.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../include/GuidelineTracker.h"
+#include "TestFixtures.h"
+#include "TestRunner.h"
+
+
+namespace {
+
+constexpr std::size_t SAMPLES_NUM = 20'000;
+constexpr double STEP = 0.2;                 // m, 10 m/s at 50 Hz
+constexpr std::size_t JUMP_INTERVAL = 2'000; // samples between jumps along the course
+
+} // namespace
+
+void tests::testGuidelineTracker() {
+  const LocalFrame frame(fixtures::ORIGIN);
+  std::mt19937 rng(42);
+
+  for (const std::size_t waypointsNum : {10, 100, 1000}) {
+    const std::vector<Waypoint> waypoints = fixtures::makeCourse(waypointsNum, rng);
+    const GuidelineTracker guideline(waypoints, frame, CoorindatesSystem::UCS, 2.0);
+    std::vector<std::array<double, 3>> vertices(waypoints.size());
+    for (std::size_t idx = 0; idx < waypoints.size(); ++idx) {
+      frame.toEnu(waypoints[idx], CoorindatesSystem::UCS, vertices[idx][0], vertices[idx][1], vertices[idx][2]);
+    }
+
+    // Flight along the guideline with a few metres of noise, looping over the course
+    std::normal_distribution<double> noise(0.0, 2.0);
+    std::uniform_int_distribution<std::size_t> jumpSegment(0, waypoints.size() - 2);
+    GuidelineTracker::Cursor cursor;
+    std::size_t segmentIdx = 0;
+    double fraction = 0.0;
+    std::size_t differentNum = 0;
+    for (std::size_t idx = 0; idx < SAMPLES_NUM; ++idx) {
+      if (idx % JUMP_INTERVAL == JUMP_INTERVAL - 1) {
+        segmentIdx = jumpSegment(rng);
+      }
+      const std::array<double, 3> &start = vertices[segmentIdx];
+      const std::array<double, 3> &end = vertices[segmentIdx + 1];
+      const double length = std::hypot(end[0] - start[0], end[1] - start[1], end[2] - start[2]);
+      const double east = start[0] + fraction * (end[0] - start[0]) + noise(rng);
+      const double north = start[1] + fraction * (end[1] - start[1]) + noise(rng);
+      const double up = start[2] + fraction * (end[2] - start[2]) + noise(rng);
+      fraction += STEP / length;
+      if (fraction >= 1.0) {
+        fraction = 0.0;
+        segmentIdx = (segmentIdx + 1) % (waypoints.size() - 1);
+      }
+
+      const GuidelineTracker::Projection tracked = guideline.track(cursor, east, north, up);
+      const GuidelineTracker::Projection searched = guideline.findClosest(east, north, up);
+      differentNum += tracked.segmentIdx != searched.segmentIdx || tracked.distance != searched.distance ||
+                      tracked.progress != searched.progress;
+    }
+    CHECK(differentNum == 0);
+  }
+}
@@ -0,0 +1,89 @@
+/**
+ * @file testObstacleBoxes.cpp
+ * @brief Tests of the packed obstacle boxes.
+ *
+ * @details This file contains checks that ObstacleBoxes finds the same obstacle containing a
+ *          position as testing box by box, one position at a time and batched, and that the
+ *          signed distances of its blocks equal those of OrientedBox bit by bit, whichever
+ *          kernels the build selects.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "../include/ObstacleBoxes.h"
+#include "TestFixtures.h"
+#include "TestRunner.h"
+
+
+namespace {
+
+constexpr std::size_t POSITIONS_NUM = 5'000;
+
+} // namespace
+
+void tests::testObstacleBoxes() {
+  std::mt19937 rng(42);
+
+  // 13 boxes leave a partly filled block
+  for (const std::size_t boxesNum : {1, 13, 64, 512}) {
+    const std::vector<OrientedBox> boxes = fixtures::makeBoxes(boxesNum, rng);
+    const ObstacleBoxes packed(boxes);
+
+    std::uniform_real_distribution<double> east(-15.0, 15.0), north(-5.0, 5.0 * boxesNum), up(0.0, 10.0);
+    std::vector<double> easts(POSITIONS_NUM), norths(POSITIONS_NUM), ups(POSITIONS_NUM);
+    for (std::size_t idx = 0; idx < POSITIONS_NUM; ++idx) {
+      easts[idx] = east(rng);
+      norths[idx] = north(rng);
+      ups[idx] = up(rng);
+    }
+    std::vector<std::uint32_t> batchIds(POSITIONS_NUM);
+    packed.findContaining(easts.data(), norths.data(), ups.data(), POSITIONS_NUM, batchIds.data());
+
+    std::size_t differentIdsNum = 0;
+    std::size_t differentDistancesNum = 0;
+    std::size_t insideNum = 0;
+    double distances[ObstacleBoxes::BLOCK_SIZE];
+    for (std::size_t idx = 0; idx < POSITIONS_NUM; ++idx) {
+      // The first box containing the position
+      std::uint32_t expectedId = ObstacleBoxes::NO_OBSTACLE;
+      for (const OrientedBox &box : boxes) {
+        if (box.signedDistance(easts[idx], norths[idx], ups[idx]) <= 0.0) {
+          expectedId = static_cast<std::uint32_t>(box.obstacleId);
+          break;
+        }
+      }
+      insideNum += expectedId != ObstacleBoxes::NO_OBSTACLE;
+      differentIdsNum += packed.findContaining(easts[idx], norths[idx], ups[idx]) != expectedId ||
+                         batchIds[idx] != expectedId;
+
+      // Lanes past the last box are infinitely far
+      for (std::size_t blockIdx = 0; blockIdx < packed.getBlocksNum(); ++blockIdx) {
+        ObstacleBoxes::signedDistances(packed.getBlock(blockIdx), easts[idx], norths[idx], ups[idx], distances);
+        for (std::size_t lane = 0; lane < ObstacleBoxes::BLOCK_SIZE; ++lane) {
+          const std::size_t boxIdx = blockIdx * ObstacleBoxes::BLOCK_SIZE + lane;
+          if (boxIdx < boxes.size()) {
+            const double expected = boxes[boxIdx].signedDistance(easts[idx], norths[idx], ups[idx]);
+            differentDistancesNum += std::memcmp(&expected, &distances[lane], sizeof(double)) != 0;
+          } else {
+            differentDistancesNum += !std::isinf(distances[lane]);
+          }
+        }
+      }
+    }
+    CHECK(differentIdsNum == 0);
+    CHECK(differentDistancesNum == 0);
+    CHECK(boxesNum == 1 || insideNum > 0);
+  }
+}
@@ -0,0 +1,73 @@
+/**
+ * @file testObstacleIndex.cpp
+ * @brief Tests of the obstacle index.
+ *
+ * @details This file contains checks that ObstacleIndex finds the same positions inside
+ *          obstacles and the same distances to the nearest one as a linear scan of all obstacle
+ *          boxes, over slaloms of rotated gates of growing length.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "../include/ObstacleIndex.h"
+#include "TestFixtures.h"
+#include "TestRunner.h"
+
+
+namespace {
+
+constexpr std::size_t QUERIES_NUM = 20'000;
+
+} // namespace
+
+void tests::testObstacleIndex() {
+  const LocalFrame frame(fixtures::ORIGIN);
+  std::mt19937 rng(42);
+
+  for (const std::size_t obstaclesNum : {12, 60, 300}) {
+    const std::vector<Obstackle> obstacles = fixtures::makeSlalom(obstaclesNum, rng);
+    const ObstacleIndex index(obstacles, frame, CoorindatesSystem::UCS);
+    std::vector<OrientedBox> boxes;
+    for (std::size_t idx = 0; idx < obstacles.size(); ++idx) {
+      boxes.push_back(ObstacleIndex::toBox(obstacles[idx], idx, frame, CoorindatesSystem::UCS));
+    }
+
+    // Positions over the course, a few percent inside obstacles
+    const double courseLength = 15.0 * (obstaclesNum / 3);
+    std::uniform_real_distribution<double> east(-15.0, 15.0), north(-5.0, courseLength + 5.0), up(0.0, 12.0);
+    std::size_t differentInsideNum = 0;
+    std::size_t insideNum = 0;
+    double maxDistanceDifference = 0.0;
+    for (std::size_t query = 0; query < QUERIES_NUM; ++query) {
+      const double queryEast = east(rng), queryNorth = north(rng), queryUp = up(rng);
+      double nearest = std::numeric_limits<double>::infinity();
+      for (const OrientedBox &box : boxes) {
+        nearest = std::min(nearest, box.signedDistance(queryEast, queryNorth, queryUp));
+      }
+
+      ObstacleIndex::Proximity proximity;
+      index.findNearest(queryEast, queryNorth, queryUp, proximity);
+      maxDistanceDifference = std::max(maxDistanceDifference, std::abs(proximity.distance - nearest));
+      std::size_t obstacleId;
+      const bool isInside = index.isInside(queryEast, queryNorth, queryUp, obstacleId);
+      differentInsideNum += isInside != (nearest <= 0.0);
+      insideNum += isInside;
+    }
+    CHECK(differentInsideNum == 0);
+    CHECK(maxDistanceDifference < 1E-9);
+    CHECK(insideNum > 0);
+  }
+}
@@ -0,0 +1,133 @@
+/**
+ * @file testPoseExtrapolator.cpp
+ * @brief Tests of predicting poses of vehicles.
+ *
+ * @details This file contains checks of PoseExtrapolator on a simulated vehicle flying straight
+ *          legs and climbing circles, sampled at 10 Hz over a link with 80 ms latency: poses
+ *          predicted at 60 Hz have to be far closer to the true ones than the latest sample.
+ *          Attitude of a banked coordinated turn has to advance by the turn rate, which needs
+ *          body rates converted into rates of the Euler angles. Stale and unknown vehicles
+ *          aren't predicted.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+
+#include "../include/PoseExtrapolator.h"
+#include "TestFixtures.h"
+#include "TestRunner.h"
+
+
+namespace {
+
+constexpr double TELEMETRY_RATE_HZ = 10.0;
+constexpr double OUTPUT_RATE_HZ = 60.0;
+constexpr double LINK_LATENCY_S = 0.08;
+constexpr double DURATION_S = 120.0;
+constexpr std::chrono::milliseconds MAX_HORIZON{500};
+
+void checkFlight() {
+  std::mt19937 rng(42);
+  PoseExtrapolator extrapolator(MAX_HORIZON);
+
+  // Received samples arrive LINK_LATENCY_S after their capture, host times are capture times
+  double nextSampleS = 0.0;
+  TelemetrySample latest, prediction;
+  bool hasLatest = false;
+  double holdSq = 0.0, predictedSq = 0.0, predictedMax = 0.0, predictedYawSq = 0.0;
+  std::size_t outputsNum = 0;
+  std::size_t missedNum = 0;
+  for (double t = 1.0; t < DURATION_S; t += 1.0 / OUTPUT_RATE_HZ) {
+    while (nextSampleS + LINK_LATENCY_S <= t) {
+      latest = fixtures::sampleAt(nextSampleS, rng);
+      extrapolator.update(latest);
+      hasLatest = true;
+      nextSampleS += 1.0 / TELEMETRY_RATE_HZ;
+    }
+    if (!hasLatest) {
+      continue;
+    }
+    if (!extrapolator.predict(1, static_cast<std::int64_t>(t * 1E9), prediction)) {
+      missedNum++;
+      continue;
+    }
+    const fixtures::Truth truth = fixtures::truthAt(t);
+    const double holdError = fixtures::positionError(latest, truth);
+    const double predictedError = fixtures::positionError(prediction, truth);
+    holdSq += holdError * holdError;
+    predictedSq += predictedError * predictedError;
+    predictedMax = std::max(predictedMax, predictedError);
+    const double predictedYaw = std::remainder(prediction.yaw - truth.yaw, 2 * std::numbers::pi);
+    predictedYawSq += predictedYaw * predictedYaw;
+    outputsNum++;
+  }
+  CHECK(missedNum == 0);
+  CHECK(outputsNum > 0);
+  const double holdRms = std::sqrt(holdSq / outputsNum);
+  const double predictedRms = std::sqrt(predictedSq / outputsNum);
+  CHECK(predictedRms < 0.1);
+  CHECK(predictedRms < holdRms / 10.0);
+  CHECK(predictedMax < 0.3);
+  CHECK(std::sqrt(predictedYawSq / outputsNum) < 0.5 * std::numbers::pi / 180.0);
+}
+
+/**
+ * @brief Coordinated turn banked 30 deg: the yaw rate is split between the pitch and yaw body
+ *        rates, the roll stays.
+ */
+void checkBankedTurn() {
+  constexpr double roll = 30.0 * std::numbers::pi / 180.0;
+  constexpr double turnRate = 0.4; // rad/s
+  constexpr double horizonS = 0.25;
+  PoseExtrapolator extrapolator(MAX_HORIZON);
+  TelemetrySample sample;
+  sample.systemId = 2;
+  sample.validFields = TelemetrySample::ATTITUDE;
+  sample.attitudeHostTimeNs = 1'000'000'000;
+  sample.roll = static_cast<float>(roll);
+  sample.yaw = 1.0f;
+  sample.pitchSpeed = static_cast<float>(turnRate * std::sin(roll));
+  sample.yawSpeed = static_cast<float>(turnRate * std::cos(roll));
+  extrapolator.update(sample);
+
+  TelemetrySample prediction;
+  CHECK(extrapolator.predict(2, sample.attitudeHostTimeNs + static_cast<std::int64_t>(horizonS * 1E9),
+                             prediction));
+  CHECK(std::abs(prediction.yaw - (1.0 + turnRate * horizonS)) < 1E-5);
+  CHECK(std::abs(prediction.roll - roll) < 1E-5);
+  CHECK(std::abs(prediction.pitch) < 1E-5);
+}
+
+void checkNotPredicted() {
+  PoseExtrapolator extrapolator(MAX_HORIZON);
+  TelemetrySample prediction;
+  CHECK(!extrapolator.predict(3, 1'000'000'000, prediction));
+
+  TelemetrySample sample;
+  sample.systemId = 3;
+  sample.validFields = TelemetrySample::ATTITUDE;
+  sample.attitudeHostTimeNs = 1'000'000'000;
+  extrapolator.update(sample);
+  const std::int64_t maxHorizonNs = std::chrono::nanoseconds(MAX_HORIZON).count();
+  CHECK(extrapolator.predict(3, sample.attitudeHostTimeNs + maxHorizonNs, prediction));
+  CHECK(!extrapolator.predict(3, sample.attitudeHostTimeNs + maxHorizonNs + 1, prediction));
+}
+
+} // namespace
+
+void tests::testPoseExtrapolator() {
+  checkFlight();
+  checkBankedTurn();
+  checkNotPredicted();
+}
@@ -0,0 +1,137 @@
+/**
+ * @file testProcessingPipeline.cpp
+ * @brief Tests of the processing pipeline.
+ *
+ * @details This file contains checks that TelemetryProcessor scores a slalom of 6 vehicles the
+ *          same inline and pipelined, with every stage processing every position. Positions are
+ *          fed in chunks the entry queue holds, waiting for the pipeline to drain between them,
+ *          so nothing is dropped however the threads are scheduled. A pipeline of PipelineStage
+ *          alone with tiny queues, its last stage held up, checks that a stage facing a full
+ *          queue waits for room instead of losing items.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "../include/PipelineStage.h"
+#include "../include/TelemetryProcessor.h"
+#include "TestFixtures.h"
+#include "TestRunner.h"
+
+
+namespace {
+
+constexpr std::size_t VEHICLES_NUM = 6;
+constexpr double RATE_HZ = 50.0;
+constexpr double DURATION_S = 60.0;
+constexpr std::size_t GATES_NUM = 40;
+constexpr std::size_t FEED_CHUNK_SIZE = TelemetryProcessor::STAGE_QUEUE_CAPACITY / 2;
+
+void checkInlineAndPipelined() {
+  const configuration::FlightConfig exercise = fixtures::makeExercise(GATES_NUM);
+  const std::vector<TelemetrySample> samples = fixtures::makeSamples(VEHICLES_NUM, RATE_HZ, DURATION_S);
+  EventsBus bus;
+
+  TelemetryProcessor inlineProcessor(bus, exercise);
+  IProcessor &inlined = inlineProcessor;
+  for (const TelemetrySample &sample : samples) {
+    inlined.process(sample);
+  }
+
+  TelemetryProcessor pipelinedProcessor(bus, exercise, {}, TelemetryProcessor::ProcessingMode::PIPELINED);
+  IProcessor &pipelined = pipelinedProcessor;
+  constexpr std::size_t lastStageIdx = TelemetryProcessor::STAGES_NUM - 1;
+  for (std::size_t start = 0; start < samples.size(); start += FEED_CHUNK_SIZE) {
+    const std::size_t end = std::min(start + FEED_CHUNK_SIZE, samples.size());
+    for (std::size_t idx = start; idx < end; ++idx) {
+      pipelined.process(samples[idx]);
+    }
+    while (pipelinedProcessor.getStageMetrics(lastStageIdx).itemsNum < end) {
+      std::this_thread::yield();
+    }
+  }
+
+  // Same order of positions through every stage, so the same scores, but for batched conversions
+  // being within nanometres of single ones
+  for (std::size_t vehicle = 1; vehicle <= VEHICLES_NUM; ++vehicle) {
+    const ScoringEngine::Score inlineScore = inlineProcessor.getScore(static_cast<std::uint8_t>(vehicle));
+    const ScoringEngine::Score pipelinedScore = pipelinedProcessor.getScore(static_cast<std::uint8_t>(vehicle));
+    CHECK(inlineScore.samplesNum == samples.size() / VEHICLES_NUM);
+    CHECK(pipelinedScore.samplesNum == inlineScore.samplesNum);
+    CHECK(std::abs(inlineScore.weighted - pipelinedScore.weighted) < 1E-6);
+  }
+  for (std::size_t idx = 0; idx < TelemetryProcessor::STAGES_NUM; ++idx) {
+    const TelemetryProcessor::Stage::Metrics metrics = pipelinedProcessor.getStageMetrics(idx);
+    CHECK(metrics.itemsNum == samples.size());
+    CHECK(metrics.droppedNum == 0);
+  }
+}
+
+/**
+ * @brief Item of the PipelineStage-only pipeline.
+ */
+struct ToyItem {
+  std::uint64_t value{0};
+  std::int64_t enqueueNs{0};
+};
+
+/**
+ * @brief Queues of 8 items, the last stage holding its first batch until the first stage has
+ *        handled more items than the queue between them takes: the first stage has to wait for
+ *        room, and every item still arrives once and in order.
+ */
+void checkFullNextQueue() {
+  constexpr std::uint64_t ITEMS_NUM = 20'000;
+  constexpr std::size_t QUEUE_CAPACITY = 8;
+  using ToyStage = PipelineStage<ToyItem, QUEUE_CAPACITY, 4>;
+  ToyStage first, slow;
+  std::atomic<std::uint64_t> handledNum{0};
+  std::uint64_t receivedNum = 0;
+  std::uint64_t outOfOrderNum = 0;
+  bool isHolding = true;
+  slow.start("slow", [&](ToyItem *items, std::size_t count) {
+    for (std::size_t idx = 0; idx < count; ++idx) {
+      outOfOrderNum += items[idx].value != receivedNum;
+      receivedNum++;
+    }
+    while (isHolding && handledNum.load(std::memory_order_relaxed) <= receivedNum + QUEUE_CAPACITY) {
+      std::this_thread::yield();
+    }
+    isHolding = false;
+  }, nullptr, -1);
+  first.start("first", [&handledNum](ToyItem *, std::size_t count) {
+    handledNum.fetch_add(count, std::memory_order_relaxed);
+  }, &slow, -1);
+
+  for (std::uint64_t idx = 0; idx < ITEMS_NUM; ++idx) {
+    ToyItem item{idx, 0};
+    while (first.push(&item, 1) == 0) {
+      std::this_thread::yield();
+    }
+  }
+  first.stop();
+  slow.stop();
+  CHECK(receivedNum == ITEMS_NUM);
+  CHECK(outOfOrderNum == 0);
+  CHECK(slow.getMetrics().droppedNum == 0);
+  CHECK(first.getMetrics().stallsNum > 0);
+}
+
+} // namespace
+
+void tests::testProcessingPipeline() {
+  checkInlineAndPipelined();
+  checkFullNextQueue();
+}
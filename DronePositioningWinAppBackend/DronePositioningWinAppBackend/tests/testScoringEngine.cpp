@@ -0,0 +1,112 @@
+/**
+ * @file testScoringEngine.cpp
+ * @brief Tests of scoring flights from per-sample errors.
+ *
+ * @details This file contains checks of ErrorAccumulator against sums evaluated in long double on
+ *          errors with a large bias, where naive one-pass sums lose precision, and of the MAE,
+ *          RMSE and weighted score ScoringEngine reduces known errors to, in order of the vehicles.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../include/ScoringEngine.h"
+#include "TestRunner.h"
+
+
+namespace {
+
+constexpr std::size_t ERRORS_NUM = 1'000'000;
+
+/**
+ * @brief Errors of 1000 m +- 1 mm, two passes in long double are the reference.
+ */
+void checkAccumulatorPrecision() {
+  std::mt19937 rng(42);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  std::vector<double> errors(ERRORS_NUM);
+  ErrorAccumulator accumulator;
+  long double sum = 0.0L;
+  for (double &error : errors) {
+    error = 1000.0 + 1E-3 * noise(rng);
+    accumulator.add(error);
+    sum += error;
+  }
+  const long double mean = sum / ERRORS_NUM;
+  long double deviationSq = 0.0L, squareSum = 0.0L;
+  for (const double error : errors) {
+    deviationSq += (error - mean) * (error - mean);
+    squareSum += static_cast<long double>(error) * error;
+  }
+  CHECK(accumulator.getCount() == ERRORS_NUM);
+  CHECK(std::abs(accumulator.getMean() - static_cast<double>(mean)) < 1E-9);
+  CHECK(std::abs(accumulator.getStdDev() - static_cast<double>(std::sqrt(deviationSq / (ERRORS_NUM - 1)))) < 1E-9);
+  CHECK(std::abs(accumulator.getMae() - static_cast<double>(mean)) < 1E-9);
+  CHECK(std::abs(accumulator.getRmse() - static_cast<double>(std::sqrt(squareSum / ERRORS_NUM))) < 1E-9);
+}
+
+void checkAccumulatorValues() {
+  ErrorAccumulator accumulator;
+  CHECK(accumulator.getMae() == 0.0 && accumulator.getRmse() == 0.0 && accumulator.getStdDev() == 0.0);
+  for (const double error : {3.0, -4.0, 3.0, -4.0}) {
+    accumulator.add(error);
+  }
+  CHECK(accumulator.getMean() == -0.5);
+  CHECK(accumulator.getMae() == 3.5);
+  CHECK(std::abs(accumulator.getRmse() - std::sqrt(12.5)) < 1E-12);
+  CHECK(accumulator.getMaxAbs() == 4.0);
+}
+
+void checkScores() {
+  ExerciseInfo exerciseInfo{};
+  exerciseInfo.altitudeDifference = AltitudeDifference::DEFAULT;
+  exerciseInfo.distanceWeight = 2;
+  exerciseInfo.altitudeWeight = 1;
+  exerciseInfo.speedWeight = 1;
+
+  for (const ScoringMethod method : {ScoringMethod::MAE, ScoringMethod::RMSE}) {
+    exerciseInfo.scoringMethod = method;
+    ScoringEngine scoring(exerciseInfo);
+    scoring.add(7, {3.0, 1.0, -2.0});
+    scoring.add(2, {1.0, 1.0, 1.0});
+    scoring.add(7, {-4.0, -1.0, 2.0});
+
+    const ScoringEngine::Score score = scoring.getScore(7);
+    const double distance = method == ScoringMethod::MAE ? 3.5 : std::sqrt(12.5);
+    CHECK(score.samplesNum == 2);
+    CHECK(std::abs(score.distance - distance) < 1E-12);
+    CHECK(std::abs(score.altitude - 1.0) < 1E-12);
+    CHECK(std::abs(score.speed - 2.0) < 1E-12);
+    CHECK(std::abs(score.weighted - (2.0 * distance + 1.0 + 2.0) / 4.0) < 1E-12);
+    CHECK(scoring.getScore(3).samplesNum == 0 && scoring.getScore(3).weighted == 0.0);
+
+    const std::uint8_t *vehicleIds;
+    CHECK(scoring.getVehicles(vehicleIds) == 2);
+    CHECK(vehicleIds[0] == 7 && vehicleIds[1] == 2);
+  }
+
+  // Ignored altitude differences aren't weighted
+  exerciseInfo.altitudeDifference = AltitudeDifference::IGNORE_ALT_DIFF;
+  exerciseInfo.scoringMethod = ScoringMethod::MAE;
+  ScoringEngine scoring(exerciseInfo);
+  scoring.add(1, {2.0, 100.0, 1.0});
+  CHECK(std::abs(scoring.getScore(1).weighted - (2.0 * 2.0 + 1.0) / 3.0) < 1E-12);
+}
+
+} // namespace
+
+void tests::testScoringEngine() {
+  checkAccumulatorPrecision();
+  checkAccumulatorValues();
+  checkScores();
+}
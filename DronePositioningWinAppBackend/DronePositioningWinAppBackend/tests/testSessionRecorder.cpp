@@ -0,0 +1,109 @@
+/**
+ * @file testSessionRecorder.cpp
+ * @brief Tests of recording sessions.
+ *
+ * @details This file contains checks reading session files back: a session fitting the buffered
+ *          chunks must hold every row in order, and one appended faster than the writer may keep
+ *          up with must account every row as written or dropped, whatever the machine. Summaries
+ *          of a scored session must hold the errors as the ScoringEngine reduced them, MAE here.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <fmt/core.h>
+
+#include "../include/SessionRecorder.h"
+#include "TestFixtures.h"
+#include "TestRunner.h"
+
+
+namespace {
+
+constexpr std::size_t VEHICLES_NUM = fixtures::SESSION_VEHICLES_NUM;
+constexpr std::uint32_t RATE_HZ = fixtures::SESSION_RATE_HZ;
+constexpr std::size_t BUFFERED_ROWS_NUM = VEHICLES_NUM * RATE_HZ * 120; // fits the chunks
+constexpr std::size_t BURST_ROWS_NUM = 2 * SessionRecorder::CHUNK_ROWS_NUM * SessionRecorder::CHUNKS_NUM;
+constexpr std::chrono::seconds CLOSE_TIMEOUT{10};
+
+static_assert(BUFFERED_ROWS_NUM < SessionRecorder::CHUNK_ROWS_NUM * SessionRecorder::CHUNKS_NUM);
+
+void checkBuffered(const std::filesystem::path &directory) {
+  SessionRecorder recorder(directory / "buffered");
+  CHECK(recorder.isEnabled());
+  for (std::size_t idx = 0; idx < BUFFERED_ROWS_NUM; ++idx) {
+    recorder.append(fixtures::makeRow(idx));
+  }
+  recorder.close();
+  CHECK(recorder.waitClosed(CLOSE_TIMEOUT));
+  CHECK(recorder.getDroppedNum() == 0);
+  CHECK(fixtures::readSession(recorder.getPath(), 0) == static_cast<long long>(BUFFERED_ROWS_NUM));
+}
+
+void checkBurst(const std::filesystem::path &directory) {
+  SessionRecorder recorder(directory / "burst");
+  for (std::size_t idx = 0; idx < BURST_ROWS_NUM; ++idx) {
+    recorder.append(fixtures::makeRow(idx));
+  }
+  recorder.close();
+  CHECK(recorder.waitClosed(CLOSE_TIMEOUT));
+  const long long readNum = fixtures::readSession(recorder.getPath(), recorder.getDroppedNum());
+  CHECK(readNum >= 0);
+  CHECK(static_cast<std::uint64_t>(readNum) + recorder.getDroppedNum() == BURST_ROWS_NUM);
+}
+
+/**
+ * @brief Scored by the engine, the summary has to carry its MAE, not one of its own.
+ */
+void checkScoredSummary(const std::filesystem::path &directory) {
+  ExerciseInfo exerciseInfo{};
+  exerciseInfo.scoringMethod = ScoringMethod::MAE;
+  exerciseInfo.distanceWeight = 1;
+  exerciseInfo.altitudeWeight = 1;
+  exerciseInfo.speedWeight = 1;
+  ScoringEngine scoring(exerciseInfo);
+  const std::size_t rowsNum = VEHICLES_NUM * RATE_HZ * 60;
+  {
+    SessionRecorder recorder(directory / "scored");
+    for (std::size_t idx = 0; idx < rowsNum; ++idx) {
+      const SessionRecorder::Row row = fixtures::makeRow(idx);
+      recorder.append(row);
+      scoring.add(row.vehicleId, {row.distanceError, row.altitudeError, row.speedError});
+    }
+    recorder.close(&scoring);
+    CHECK(recorder.waitClosed(CLOSE_TIMEOUT));
+  }
+
+  std::ifstream csv(directory / "scored_summary.csv");
+  std::string header, line;
+  std::getline(csv, header);
+  std::getline(csv, line);
+  const ScoringEngine::Score score = scoring.getScore(1);
+  const double duration = (fixtures::makeRow(rowsNum - 1).timeBootMs - fixtures::makeRow(0).timeBootMs) / 1E3;
+  const std::string expected = fmt::format("1,{},{:.3f},{},{:.3f},{:.3f},", rowsNum / VEHICLES_NUM, duration,
+                                           score.samplesNum, score.weighted, score.distance);
+  CHECK(header.find("distance_mae_m") != std::string::npos);
+  CHECK(line.rfind(expected, 0) == 0);
+}
+
+} // namespace
+
+void tests::testSessionRecorder() {
+  const std::filesystem::path directory = std::filesystem::temp_directory_path() / "testSessionRecorder";
+  std::filesystem::remove_all(directory);
+  checkBuffered(directory);
+  checkBurst(directory);
+  checkScoredSummary(directory);
+  std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,94 @@
+/**
+ * @file testTelemetryDecoder.cpp
+ * @brief Tests of parsing and decoding received MAVLink bytes.
+ *
+ * @details This file contains checks of the parse/publish stage of TelemetryReceiver without the
+ *          serial port: bytes of the streams the receiver requests at their highest rates are
+ *          parsed in chunks of the I/O stage with mavlink_parse_char, and every frame has to be
+ *          decoded, one sample published per ATTITUDE and every autopilot TIMESYNC request
+ *          answered with its own ts1. Answers to SET_MESSAGE_INTERVAL have to be reported with
+ *          their result, answers to other commands not at all.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "../include/TelemetryDecoder.h"
+#include "TestFixtures.h"
+#include "TestRunner.h"
+
+
+namespace {
+
+constexpr std::size_t READ_CHUNK_SIZE = 512; // as read by the I/O stage
+constexpr std::uint32_t GENERATED_S = 10;
+
+void checkStreams() {
+  fixtures::StreamCounts expected;
+  const std::vector<std::uint8_t> bytes = fixtures::generateStreams(GENERATED_S, expected);
+
+  // Requests are sent twice a second, in order
+  fixtures::StreamCounts counts;
+  std::uint32_t nextRequestTimeBootMs = fixtures::STREAMS_START_TIME_BOOT_MS;
+  TelemetryDecoder decoder;
+  mavlink_message_t message;
+  mavlink_status_t status;
+  mavlink_reset_channel_status(MAVLINK_COMM_1);
+  for (std::size_t offset = 0; offset < bytes.size(); offset += READ_CHUNK_SIZE) {
+    const std::size_t end = std::min(offset + READ_CHUNK_SIZE, bytes.size());
+    const std::int64_t arrivalNs = ClockSync::nowNs();
+    for (std::size_t idx = offset; idx < end; ++idx) {
+      if (mavlink_parse_char(MAVLINK_COMM_1, bytes[idx], &message, &status) != 1) {
+        continue;
+      }
+      counts.framesNum++;
+      const TelemetryDecoder::Result result = decoder.decode(message, arrivalNs);
+      if (result.action == TelemetryDecoder::Action::PUBLISH) {
+        counts.publishedNum++;
+        decoder.getSample().updatedFields = 0;
+      } else if (result.action == TelemetryDecoder::Action::REPLY_TIMESYNC) {
+        counts.timesyncRequestsNum++;
+        counts.wrongTs1Num += result.timesyncTs1 != fixtures::timesyncTs1(nextRequestTimeBootMs);
+        nextRequestTimeBootMs += 1000 / 2;
+      }
+    }
+  }
+  CHECK(counts.framesNum == expected.framesNum);
+  CHECK(mavlink_get_channel_status(MAVLINK_COMM_1)->packet_rx_drop_count == 0);
+  CHECK(counts.publishedNum == expected.publishedNum);
+  CHECK(counts.timesyncRequestsNum == expected.timesyncRequestsNum);
+  CHECK(counts.wrongTs1Num == 0);
+  CHECK(decoder.getSample().systemId == 1);
+}
+
+void checkCommandAcks() {
+  TelemetryDecoder decoder;
+  mavlink_message_t message;
+  mavlink_command_ack_t commandAck{};
+  commandAck.command = MAV_CMD_SET_MESSAGE_INTERVAL;
+  commandAck.result = MAV_RESULT_DENIED;
+  mavlink_msg_command_ack_encode(1, 1, &message, &commandAck);
+  const TelemetryDecoder::Result result = decoder.decode(message, ClockSync::nowNs());
+  CHECK(result.action == TelemetryDecoder::Action::INTERVAL_ACK);
+  CHECK(result.ackResult == MAV_RESULT_DENIED);
+
+  commandAck.command = MAV_CMD_SET_MESSAGE_INTERVAL + 1;
+  mavlink_msg_command_ack_encode(1, 1, &message, &commandAck);
+  CHECK(decoder.decode(message, ClockSync::nowNs()).action == TelemetryDecoder::Action::NONE);
+}
+
+} // namespace
+
+void tests::testTelemetryDecoder() {
+  checkStreams();
+  checkCommandAcks();
+}
@@ -1,13 +1,258 @@
 """
 The following code implements UDP server which receives data
 from remote client. This script aims to test TelemetrySender implmenetation.
+All wire formats are accepted: legacy text, binary packets (see TelemetryPacket.h)
+and quantised delta packets (see DeltaCodec.h).
+A datagram may carry several coalesced samples.
+The scene of the exercise (see ScenePacket.h) is received and acknowledged the way
+the headset does it, received scenes are cached in SCENE_CACHE_DIR by their hash.
 """
+import os
 import socket
+import struct
 
 
 UDP_IP = "172.28.64.72"  
 UDP_PORT = 54000     
 
+# Little-endian layout of the binary packet, version 1
+BINARY_PACKET = struct.Struct("<HBBIqHBBfffiiiifffI")
+BINARY_MAGIC = 0x5044
+FLAG_TIME_SYNCED = 0x01
+FLAG_LOCAL_FRAME = 0x02  # position is east north up in mm from the operator position
+FLAG_PREDICTED = 0x04  # pose extrapolated to the timestamp
+
+# Quantised delta packets, version 1
+DELTA_MAGIC = b"DQ"
+DELTA_FLAG_KEYFRAME = 0x01
+DELTA_FLAG_TIME_SYNCED = 0x02
+DELTA_FLAG_LOCAL_FRAME = 0x04
+DELTA_FLAG_PREDICTED = 0x08
+ANGLE_RESOLUTION_RAD = 1E-4
+VELOCITY_RESOLUTION_MS = 1E-2
+QUANTISED_FIELDS_NUM = 10
+delta_keyframes = {}  # vehicle id -> (keyframe id, timestamp ns, values)
+
+# Scene transfer, version 1
+SCENE_HEADER = struct.Struct("<HBBQIHH")
+SCENE_ACK_HEADER = struct.Struct("<HBBQH")
+SCENE_ANNOUNCE_MAGIC = b"DA"
+SCENE_CHUNK_MAGIC = b"DC"
+SCENE_ACK_MAGIC = 0x4B44
+SCENE_VERSION = 1
+SCENE_CHUNK_PAYLOAD_SIZE = 1472 - SCENE_HEADER.size
+SCENE_CACHE_DIR = "scene_cache"
+scene_chunks = {}  # hash -> {chunk index: payload}
+
+
+def position(lat_e7, lon_e7, alt_mm, is_local):
+    """GPS lat lon alt, or east north up metres of the local frame."""
+    if is_local:
+        return {"east": lat_e7 * 1E-3, "north": lon_e7 * 1E-3, "up": alt_mm * 1E-3}
+    return (lat_e7 * 1E-7, lon_e7 * 1E-7, alt_mm * 1E-3)
+
+
+def parse_binary(data):
+    (magic, version, vehicle_id, seq, timestamp_ns, valid_fields, flags, _,
+     roll, pitch, yaw, lat_e7, lon_e7, alt_mm, relative_alt_mm,
+     v_north, v_east, v_down, capture_age_us) = BINARY_PACKET.unpack(data)
+    if magic != BINARY_MAGIC or version != 1:
+        raise ValueError(f"unsupported packet: magic {magic:#x}, version {version}")
+    return {
+        "vehicle": vehicle_id,
+        "seq": seq,
+        "timestamp_ns": timestamp_ns,
+        "valid_fields": valid_fields,
+        "time_synced": bool(flags & FLAG_TIME_SYNCED),
+        "predicted": bool(flags & FLAG_PREDICTED),
+        "attitude": (roll, pitch, yaw),
+        "position": position(lat_e7, lon_e7, alt_mm, flags & FLAG_LOCAL_FRAME),
+        "relative_alt": relative_alt_mm * 1E-3,
+        "velocity": (v_north, v_east, v_down),
+        "capture_age_ms": capture_age_us * 1E-3,
+    }
+
+
+def read_varint(data, offset):
+    value = 0
+    shift = 0
+    while True:
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value, offset
+        shift += 7
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def wrap_int32(value):
+    return (value + 2**31) % 2**32 - 2**31
+
+
+def parse_delta(data, offset):
+    """Decode the delta packet at offset, return the sample (None if its keyframe is missing) and its end."""
+    flags, vehicle_id, seq, keyframe_id = struct.unpack_from("<BBHB", data, offset + 2)
+    offset += 7
+    valid_fields, offset = read_varint(data, offset)
+    is_keyframe = bool(flags & DELTA_FLAG_KEYFRAME)
+    if is_keyframe:
+        (timestamp_ns,) = struct.unpack_from("<q", data, offset)
+        offset += 8
+    else:
+        timestamp_us, offset = read_varint(data, offset)
+        timestamp_ns = unzigzag(timestamp_us) * 1000
+    capture_age_us, offset = read_varint(data, offset)
+    values = []
+    for _ in range(QUANTISED_FIELDS_NUM):
+        value, offset = read_varint(data, offset)
+        values.append(unzigzag(value))
+
+    if is_keyframe:
+        delta_keyframes[vehicle_id] = (keyframe_id, timestamp_ns, values)
+    else:
+        keyframe = delta_keyframes.get(vehicle_id)
+        if keyframe is None or keyframe[0] != keyframe_id:
+            return None, offset  # the keyframe has been lost
+        timestamp_ns += keyframe[1]
+        values = [wrap_int32(base + delta) for base, delta in zip(keyframe[2], values)]
+
+    roll, pitch, yaw, lat_e7, lon_e7, alt_mm, relative_alt_mm, v_north, v_east, v_down = values
+    return {
+        "vehicle": vehicle_id,
+        "seq": seq,
+        "keyframe": is_keyframe,
+        "timestamp_ns": timestamp_ns,
+        "valid_fields": valid_fields,
+        "time_synced": bool(flags & DELTA_FLAG_TIME_SYNCED),
+        "predicted": bool(flags & DELTA_FLAG_PREDICTED),
+        "attitude": tuple(v * ANGLE_RESOLUTION_RAD for v in (roll, pitch, yaw)),
+        "position": position(lat_e7, lon_e7, alt_mm, flags & DELTA_FLAG_LOCAL_FRAME),
+        "relative_alt": relative_alt_mm * 1E-3,
+        "velocity": tuple(v * VELOCITY_RESOLUTION_MS for v in (v_north, v_east, v_down)),
+        "capture_age_ms": capture_age_us * 1E-3,
+    }, offset
+
+
+def parse_text(data):
+    telemetry_str = data.rstrip(b"\0").decode('utf-8')
+    return [float(x) for x in telemetry_str.split()]
+
+
+def fnv1a64(data):
+    value = 0xCBF29CE484222325
+    for byte in data:
+        value = ((value ^ byte) * 0x100000001B3) & 0xFFFFFFFFFFFFFFFF
+    return value
+
+
+def scene_path(scene_hash):
+    return os.path.join(SCENE_CACHE_DIR, f"{scene_hash:016x}.bin")
+
+
+def parse_scene(blob):
+    """Decode the scene blob into a dictionary."""
+    magic, version, _, coordinates, altitude_diff, scoring, flags = struct.unpack_from("<HBBBBBB", blob)
+    if magic != 0x5344 or version != SCENE_VERSION:
+        raise ValueError(f"unsupported scene: magic {magic:#x}, version {version}")
+    offset = 8
+    (guideline_offset, target_speed, accuracy, pausing_time, target_bearings,
+     distance_weight, altitude_weight, speed_weight) = struct.unpack_from("<ffiiiiii", blob, offset)
+    offset += 32
+    texts = []
+    for _ in range(2):
+        (length,) = struct.unpack_from("<H", blob, offset)
+        texts.append(blob[offset + 2:offset + 2 + length].decode("utf-8"))
+        offset += 2 + length
+    operator = struct.unpack_from("<ddd", blob, offset)
+    offset += 24
+
+    def read_list(item_format):
+        nonlocal offset
+        (count,) = struct.unpack_from("<H", blob, offset)
+        offset += 2
+        items = [struct.unpack_from(item_format, blob, offset + idx * struct.calcsize(item_format))
+                 for idx in range(count)]
+        offset += count * struct.calcsize(item_format)
+        return items
+
+    return {
+        "title": texts[0],
+        "author": texts[1],
+        "coordinates_system": coordinates,
+        "altitude_difference": altitude_diff,
+        "scoring_method": scoring,
+        "show_waypoints": bool(flags & 0x01),
+        "show_guideline": bool(flags & 0x02),
+        "guideline_offset": guideline_offset,
+        "target_speed": target_speed,
+        "accuracy": accuracy,
+        "pausing_time": pausing_time,
+        "target_bearings": target_bearings,
+        "weights": (distance_weight, altitude_weight, speed_weight),
+        "operator": operator,
+        "waypoints": read_list("<ddd"),
+        "markers": read_list("<dddf"),
+        "obstacles": read_list("<fffffffff"),
+    }
+
+
+def handle_scene(data, addr, sock):
+    """Store a chunk or answer an announce, acknowledging the received chunks."""
+    _, version, _, scene_hash, blob_size, chunk_idx, chunks_num = SCENE_HEADER.unpack_from(data)
+    if version != SCENE_VERSION:
+        return
+    if os.path.exists(scene_path(scene_hash)):
+        received = set(range(chunks_num))  # cached, nothing to download
+    else:
+        chunks = scene_chunks.setdefault(scene_hash, {})
+        if data[:2] == SCENE_CHUNK_MAGIC:
+            chunks[chunk_idx] = data[SCENE_HEADER.size:]
+            if len(chunks) < chunks_num:
+                return  # acknowledged on the announce following the chunks
+            blob = b"".join(chunks[idx] for idx in range(chunks_num))
+            del scene_chunks[scene_hash]
+            if len(blob) != blob_size or fnv1a64(blob) != scene_hash:
+                print("Corrupted scene, downloading again")
+                return
+            os.makedirs(SCENE_CACHE_DIR, exist_ok=True)
+            with open(scene_path(scene_hash), "wb") as scene_file:
+                scene_file.write(blob)
+            print(f"Received scene {scene_hash:016x}: {parse_scene(blob)} from {addr}")
+            received = set(range(chunks_num))
+        else:
+            received = set(chunks)
+
+    bitmap = bytearray((chunks_num + 7) // 8)
+    for idx in received:
+        bitmap[idx // 8] |= 1 << (idx % 8)
+    sock.sendto(SCENE_ACK_HEADER.pack(SCENE_ACK_MAGIC, SCENE_VERSION, 0, scene_hash, chunks_num) + bitmap, addr)
+
+
+def split_datagram(data):
+    """Split a datagram into packets: binary ones have a fixed size, text ones end with NUL,
+    delta ones are decoded right away to find their end."""
+    packets = []
+    offset = 0
+    while offset < len(data):
+        if data[offset:offset + 2] == DELTA_MAGIC:
+            telemetry, end = parse_delta(data, offset)
+            packets.append(telemetry)
+            offset = end
+            continue
+        if data[offset:offset + 2] == b"DP" and len(data) - offset >= BINARY_PACKET.size:
+            end = offset + BINARY_PACKET.size
+        else:
+            end = data.find(b"\0", offset)
+            end = len(data) if end == -1 else end + 1
+        packets.append(data[offset:end])
+        offset = end
+    return packets
+
+
 if __name__ == "__main__":
 
     sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)  
@@ -15,14 +260,38 @@ if __name__ == "__main__":
 
     print(f"Telemetry receiver listening on {UDP_IP}:{UDP_PORT}")
 
+    last_seq = None
     while True:
-        data, addr = sock.recvfrom(1024)  # Buffer size of 1024 bytes
-        telemetry_str = data.decode('utf-8')
+        data, addr = sock.recvfrom(2048)  # Buffer size above the sender's MTU limit
+
+        if data[:2] in (SCENE_ANNOUNCE_MAGIC, SCENE_CHUNK_MAGIC) and len(data) >= SCENE_HEADER.size:
+            try:
+                handle_scene(data, addr, sock)
+            except (ValueError, UnicodeDecodeError, struct.error):
+                print(f"Invalid scene format from {addr}")
+            continue
 
-        # Parse the telemetry string
+        # Parse the telemetry packets
         try:
-            telemetry_values = [float(x) for x in telemetry_str.split()] 
-            print(f"Received telemetry: {telemetry_values} from {addr}")
+            packets = split_datagram(data)
+        except (struct.error, IndexError):
+            print(f"Invalid telemetry format: {data}")
+            continue
+        for packet in packets:
+            try:
+                if packet is None:
+                    print("Delta packet without its keyframe, skipped")
+                elif isinstance(packet, dict):
+                    print(f"Received telemetry: {packet} from {addr}")
+                elif len(packet) == BINARY_PACKET.size and packet[:2] == b"DP":
+                    telemetry = parse_binary(packet)
+                    if last_seq is not None and telemetry["seq"] != (last_seq + 1) & 0xFFFFFFFF:
+                        print(f"Lost {(telemetry['seq'] - last_seq - 1) & 0xFFFFFFFF} packets")
+                    last_seq = telemetry["seq"]
+                    print(f"Received telemetry: {telemetry} from {addr}")
+                else:
+                    telemetry_values = parse_text(packet)
+                    print(f"Received telemetry: {telemetry_values} from {addr}")
 
-        except ValueError:
-            print(f"Invalid telemetry format: {telemetry_str}")
\ No newline at end of file
+            except (ValueError, UnicodeDecodeError, struct.error, IndexError):
+                print(f"Invalid telemetry format: {packet}")
\ No newline at end of file
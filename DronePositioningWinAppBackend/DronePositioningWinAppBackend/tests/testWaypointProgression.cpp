@@ -0,0 +1,101 @@
+/**
+ * @file testWaypointProgression.cpp
+ * @brief Tests of progressing through waypoints.
+ *
+ * @details This file contains checks of WaypointProgression on vehicles hovering at every
+ *          waypoint of a zig-zag, interleaved as the bus delivers them: one on the bearing to the
+ *          next waypoint, one facing away from it, one whose fixes glitch away during hovers and
+ *          one whose boot clock wraps around mid flight. Every one has to complete the exercise
+ *          having captured every waypoint, with the expected bearing compliance and transitions.
+ *          A vehicle hovering just outside the accuracy radius mustn't capture the waypoint.
+ *
+ * @author Szymon Bogus
+ * @date 2026-10-19
+ *
+ * @copyright Copyright 2026 Szymon Bogus
+ * @license Apache License, Version 2.0 (see
+ * https://www.apache.org/licenses/LICENSE-2.0)
+ *
+ * @version 1.0
+ */
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include "../include/WaypointProgression.h"
+#include "TestFixtures.h"
+#include "TestRunner.h"
+
+
+namespace {
+
+constexpr std::size_t WAYPOINTS_NUM = 10;
+
+void checkPilots() {
+  const LocalFrame frame(fixtures::ORIGIN);
+  std::mt19937 rng(42);
+  const std::vector<Waypoint> waypoints = fixtures::makeZigZag(WAYPOINTS_NUM, rng);
+  WaypointProgression progression(waypoints, frame, fixtures::makeProgressionInfo());
+  const std::array<fixtures::Pilot, 4> pilots = fixtures::makePilots(WAYPOINTS_NUM);
+
+  WaypointProgress progress;
+  for (const fixtures::FlightSample &sample : fixtures::flyPilots(waypoints, frame, pilots, rng)) {
+    progression.update(sample.telemetry, sample.east, sample.north, sample.up, progress);
+  }
+
+  for (std::size_t pilotIdx = 0; pilotIdx < pilots.size(); ++pilotIdx) {
+    const fixtures::Pilot &pilot = pilots[pilotIdx];
+    const std::uint8_t vehicleId = static_cast<std::uint8_t>(pilotIdx + 1);
+    const WaypointProgression::Stats &stats = progression.getStats(vehicleId);
+    CHECK(progression.getState(vehicleId) == WaypointState::COMPLETED);
+    CHECK(stats.capturedNum == WAYPOINTS_NUM);
+    CHECK(stats.compliantNum == pilot.expectedCompliantNum);
+    CHECK(stats.transitionsNum == pilot.expectedTransitionsNum);
+  }
+}
+
+/**
+ * @brief Vehicle entering the radius of a waypoint, then hovering half the exit margin outside it
+ *        for twice the pausing time: it stays HOVERING without capturing, and only the time back
+ *        within the radius counts towards the capture.
+ */
+void checkMarginBand() {
+  const LocalFrame frame(fixtures::ORIGIN);
+  const std::vector<Waypoint> waypoints = {Waypoint(0.0, 10.0, 0.0)};
+  WaypointProgression progression(waypoints, frame, fixtures::makeProgressionInfo());
+  double east = 0.0, north = 0.0, up = 0.0;
+  frame.toEnu(waypoints[0], CoorindatesSystem::UCS, east, north, up);
+  up += fixtures::PROGRESSION_GUIDELINE_OFFSET;
+
+  TelemetrySample telemetry;
+  telemetry.systemId = 1;
+  telemetry.validFields = TelemetrySample::ATTITUDE | TelemetrySample::GLOBAL_POSITION;
+  telemetry.globalPositionTimeBootMs = 1000;
+  WaypointProgress progress;
+  auto hover = [&](double offset, double durationS) {
+    for (std::size_t tick = 0; tick < static_cast<std::size_t>(durationS * fixtures::PROGRESSION_RATE_HZ); ++tick) {
+      progression.update(telemetry, east + offset, north, up, progress);
+      telemetry.globalPositionTimeBootMs += static_cast<std::uint32_t>(1000.0 / fixtures::PROGRESSION_RATE_HZ);
+    }
+  };
+  const double pausingTime = fixtures::PROGRESSION_PAUSING_TIME;
+
+  hover(0.0, 1.0);
+  CHECK(progression.getState(1) == WaypointState::HOVERING);
+  hover(fixtures::PROGRESSION_ACCURACY + WaypointProgression::EXIT_MARGIN / 2.0, 2.0 * pausingTime);
+  CHECK(progression.getState(1) == WaypointState::HOVERING);
+  CHECK(progression.getStats(1).capturedNum == 0);
+  hover(0.0, pausingTime - 1.5);
+  CHECK(progression.getStats(1).capturedNum == 0);
+  hover(0.0, 1.0);
+  CHECK(progression.getState(1) == WaypointState::COMPLETED);
+  CHECK(progression.getStats(1).capturedNum == 1);
+}
+
+} // namespace
+
+void tests::testWaypointProgression() {
+  checkPilots();
+  checkMarginBand();
+}